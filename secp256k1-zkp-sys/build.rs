@@ -57,8 +57,15 @@ fn main() {
         base_config.define("ECMULT_WINDOW_SIZE", Some("4")); // A low-enough value to consume neglible memory
     } else {
         base_config.define("ECMULT_WINDOW_SIZE", Some("15")); // This is the default in the configure file (`auto`)
+        if cfg!(feature = "sign-tables") {
+            base_config.define("ECMULT_GEN_ALL_PREC_TABLES", Some("1")); // Lets contexts choose the ecmult_gen table at runtime
+        }
     }
     base_config.define("USE_EXTERNAL_DEFAULT_CALLBACKS", Some("1"));
+    // Hardware SHA256 is only used if the CPU supports it at runtime.
+    base_config.define("USE_SHA256_HW", Some("1"));
+    // Likewise for batched field multiplication with AVX-512 IFMA.
+    base_config.define("USE_FIELD_IFMA", Some("1"));
 
     if let Ok(target_endian) = env::var("CARGO_CFG_TARGET_ENDIAN") {
         if target_endian == "big" {
@@ -71,6 +78,11 @@ fn main() {
         base_config.include("wasm-sysroot");
     }
 
+    // Mapping table files is only implemented for POSIX systems.
+    if env::var("CARGO_CFG_TARGET_FAMILY").map_or(false, |family| family == "unix") {
+        base_config.file("depend/secp256k1/contrib/ecmult_tables_mmap.c");
+    }
+
     // secp256k1
     base_config
         .file("depend/secp256k1/contrib/lax_der_parsing.c")
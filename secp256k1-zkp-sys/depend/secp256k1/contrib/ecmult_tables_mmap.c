@@ -0,0 +1,42 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ecmult_tables_mmap.h"
+
+int rustsecp256k1zkp_v0_8_1_ecmult_tables_mmap(const rustsecp256k1zkp_v0_8_1_context* ctx, const char *path) {
+    struct stat st;
+    void *data;
+    size_t len;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    len = (size_t)st.st_size;
+    data = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    /* The mapping keeps the file open. */
+    close(fd);
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+
+    if (!rustsecp256k1zkp_v0_8_1_ecmult_tables_load(ctx, (const unsigned char *)data, len)) {
+        munmap(data, len);
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,55 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+/****
+ * Please do not link this file directly. It is not part of the libsecp256k1
+ * project and does not promise any stability in its API, functionality or
+ * presence. Projects which use this code should instead copy this header
+ * and its accompanying .c file directly into their codebase.
+ ****/
+
+/* This file provides a helper for POSIX systems that maps a file with
+ * precomputed tables, as written by precompute_ecmult, and passes it to
+ * rustsecp256k1zkp_v0_8_1_ecmult_tables_load. The mapping is shared with every other process
+ * that maps the same file. */
+
+#ifndef SECP256K1_CONTRIB_ECMULT_TABLES_MMAP_H
+#define SECP256K1_CONTRIB_ECMULT_TABLES_MMAP_H
+
+/* #include secp256k1.h only when it hasn't been included yet.
+   This enables this file to be #included directly in other project
+   files (such as tests.c) without the need to set an explicit -I flag,
+   which would be necessary to locate secp256k1.h. */
+#ifndef SECP256K1_H
+#include <secp256k1.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Map a table file and load the tables from it
+ *
+ *  Returns: 1 when the tables were loaded, 0 if the file could not be mapped,
+ *           is not a valid table file, or tables were already loaded.
+ *  Args: ctx:  a secp256k1 context object
+ *  In:   path: the path of the file (not NULL)
+ *
+ *  On success the file stays mapped until the process exits. The same
+ *  threading rules as for rustsecp256k1zkp_v0_8_1_ecmult_tables_load apply. As changes to the file are
+ *  visible through the mapping, whoever can write to the file can change the
+ *  tables after their checksum was verified, so the file must only be
+ *  writable by trusted users.
+ */
+int rustsecp256k1zkp_v0_8_1_ecmult_tables_mmap(
+    const rustsecp256k1zkp_v0_8_1_context* ctx,
+    const char *path
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_CONTRIB_ECMULT_TABLES_MMAP_H */
@@ -198,6 +198,8 @@ typedef int (*rustsecp256k1zkp_v0_8_1_nonce_function)(
 #define SECP256K1_FLAGS_BIT_CONTEXT_VERIFY (1 << 8)
 #define SECP256K1_FLAGS_BIT_CONTEXT_SIGN (1 << 9)
 #define SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY (1 << 10)
+#define SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_SMALL (1 << 11)
+#define SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_LARGE (1 << 12)
 #define SECP256K1_FLAGS_BIT_COMPRESSION (1 << 8)
 
 /** Context flags to pass to rustsecp256k1zkp_v0_8_1_context_create, rustsecp256k1zkp_v0_8_1_context_preallocated_size, and
@@ -208,6 +210,18 @@ typedef int (*rustsecp256k1zkp_v0_8_1_nonce_function)(
 #define SECP256K1_CONTEXT_VERIFY (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_VERIFY)
 #define SECP256K1_CONTEXT_SIGN (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_SIGN)
 
+/** Context flags selecting the precomputed table for multiplications with the
+ *  generator, which are done by signing, key generation and the commitment and
+ *  proof functions of the modules. The small table takes 32 KiB and the large
+ *  table 512 KiB, against 64 KiB for the default table in the usual build
+ *  configuration. Since every lookup scans a whole row of the table to stay
+ *  constant time, the large table needs fewer point additions but reads more
+ *  memory; which table is fastest depends on the CPU and its caches. Whether
+ *  the small and large tables are available depends on the build
+ *  configuration. */
+#define SECP256K1_CONTEXT_SIGN_TABLE_SMALL (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_SMALL)
+#define SECP256K1_CONTEXT_SIGN_TABLE_LARGE (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_LARGE)
+
 /* Testing flag. Do not use. */
 #define SECP256K1_CONTEXT_DECLASSIFY (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY)
 
@@ -268,11 +282,11 @@ SECP256K1_API void rustsecp256k1zkp_v0_8_1_selftest(void);
  *  Returns: a newly created context object.
  *  In:      flags: Always set to SECP256K1_CONTEXT_NONE (see below).
  *
- *  The only valid non-deprecated flag in recent library versions is
- *  SECP256K1_CONTEXT_NONE, which will create a context sufficient for all functionality
- *  offered by the library. All other (deprecated) flags will be treated as equivalent
- *  to the SECP256K1_CONTEXT_NONE flag. Though the flags parameter primarily exists for
- *  historical reasons, future versions of the library may introduce new flags.
+ *  SECP256K1_CONTEXT_NONE will create a context sufficient for all functionality
+ *  offered by the library. SECP256K1_CONTEXT_SIGN_TABLE_SMALL and
+ *  SECP256K1_CONTEXT_SIGN_TABLE_LARGE create the same kind of context with a
+ *  different precomputed table, see rustsecp256k1zkp_v0_8_1_context_set_sign_table. All other
+ *  (deprecated) flags will be treated as equivalent to the SECP256K1_CONTEXT_NONE flag.
  *
  *  If the context is intended to be used for API functions that perform computations
  *  involving secret keys, e.g., signing and public key generation, then it is highly
@@ -844,6 +858,101 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_context_r
     const unsigned char *seed32
 ) SECP256K1_ARG_NONNULL(1);
 
+/** Select the precomputed table a context uses for multiplications with the
+ *  generator.
+ *
+ *  Returns: 1: the table was selected
+ *           0: the requested table is not available in this build, or the
+ *              arguments were invalid. The context is left unchanged.
+ *  Args:    ctx:   pointer to a context object (not rustsecp256k1zkp_v0_8_1_context_static).
+ *  In:      flags: SECP256K1_CONTEXT_NONE for the default table,
+ *                  SECP256K1_CONTEXT_SIGN_TABLE_SMALL or
+ *                  SECP256K1_CONTEXT_SIGN_TABLE_LARGE.
+ *
+ *  This has the same effect as passing the flags to rustsecp256k1zkp_v0_8_1_context_create,
+ *  and allows changing the table of a context created elsewhere. The
+ *  randomization of the context is kept. The context must not be used by
+ *  another thread while this function runs.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_context_set_sign_table(
+    rustsecp256k1zkp_v0_8_1_context *ctx,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1);
+
+/** Use precomputed tables from a file instead of the compiled-in ones.
+ *
+ *  Returns: 1: the tables were loaded and are used from now on
+ *           0: data is not a valid table file for this build and machine,
+ *              or tables were already loaded. The tables in use are left
+ *              unchanged.
+ *  Args:    ctx:     pointer to a context object.
+ *  In:      data:    pointer to the contents of a file written by
+ *                    precompute_ecmult, aligned like a uint64_t (not NULL).
+ *           datalen: the length of data.
+ *
+ *  The file holds the tables for the a*P + b*G multiplications done by
+ *  verification, with a window size that can be larger than the one
+ *  compiled in, and the default table for multiplications with G. Its
+ *  checksum is verified before anything is used. The checksum only detects
+ *  corrupted files and files for a different build; it does not authenticate
+ *  the tables, and data is not checked again after this function returns.
+ *
+ *  The tables are global to the library, and data must stay valid and
+ *  unmodified until the process exits. They can be loaded once per process.
+ *  This function may be called while other threads use the library: the new
+ *  tables are published together, so each operation uses either the
+ *  compiled-in tables or the loaded ones. With compilers that lack the GCC
+ *  atomic builtins, it must instead be called before any other thread uses
+ *  the library. It is meant to be called at startup with a read-only mapping
+ *  of the file, so that all processes using the same file share one copy of
+ *  it in memory. See contrib/ecmult_tables_mmap.h.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecmult_tables_load(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    const unsigned char *data,
+    size_t datalen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Describe the precomputed tables in use.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:        pointer to a context object.
+ *  Out:     size:       the size in bytes of the tables.
+ *           checksum32: the SHA256 of the tables, as stored in a table file.
+ *                       For the compiled-in tables this is the checksum of
+ *                       the file precompute_ecmult writes for the same window.
+ *           window:     the window size of the tables for verification.
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_ecmult_tables_info(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    size_t *size,
+    unsigned char *checksum32,
+    unsigned int *window
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Flags for the optional implementations reported by rustsecp256k1zkp_v0_8_1_context_backends. */
+#define SECP256K1_BACKEND_ASM_X86_64 (1 << 0)
+#define SECP256K1_BACKEND_SHA256_HW (1 << 1)
+#define SECP256K1_BACKEND_SHA256_LANES_AVX2 (1 << 2)
+#define SECP256K1_BACKEND_FIELD_IFMA (1 << 3)
+
+/** Report which optional implementations the library uses on this machine.
+ *
+ *  Returns: a combination of the SECP256K1_BACKEND_* flags.
+ *  Args:    ctx: pointer to a context object.
+ *
+ *  Implementations that need instructions beyond the baseline of the target
+ *  are compiled in next to the portable code, and the fastest one the CPU
+ *  supports is selected when the first context is created, or when it is
+ *  first used if that happens earlier. The selection is made once, even if
+ *  several threads need it at the same time, and the result is the same for
+ *  all contexts. SECP256K1_BACKEND_ASM_X86_64 is chosen when the
+ *  library is built instead, and only reports that choice.
+ */
+SECP256K1_API unsigned int rustsecp256k1zkp_v0_8_1_context_backends(
+    const rustsecp256k1zkp_v0_8_1_context *ctx
+) SECP256K1_ARG_NONNULL(1);
+
 /** Add a number of public keys together.
  *
  *  Returns: 1: the sum of the public keys is valid.
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include "secp256k1.h"
+#include "secp256k1_extrakeys.h"
 
 /** This module implements single signer ECDSA adaptor signatures following
  *  "One-Time Verifiably Encrypted Signatures A.K.A. Adaptor Signatures" by
@@ -29,6 +30,17 @@ extern "C" {
  *  possible.
  */
 
+/** Opaque data structure that holds an encryption key together with a
+ *  precomputed table for multiplying it by secret scalars.
+ *
+ *  Guaranteed to be 65668 bytes in size. It can be safely copied/moved, but is
+ *  large enough that it should not be placed on the stack. The contents are
+ *  platform-dependent and must not be serialized.
+ */
+typedef struct {
+    unsigned char data[65668];
+} rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey;
+
 /** A pointer to a function to deterministically generate a nonce.
  *
  *  Same as rustsecp256k1zkp_v0_8_1_nonce_function_hardened with the exception of using the
@@ -95,6 +107,54 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(
     void *ndata
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Prepare an encryption key for creating many adaptor signatures
+ *
+ *  Precomputes multiples of the encryption key so that
+ *  rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared can avoid the two variable-base
+ *  multiplications by the encryption key that rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt
+ *  performs for every signature. Preparing costs roughly as much as creating a
+ *  few adaptor signatures, so it pays off when the same encryption key is used
+ *  for many messages.
+ *
+ *  Returns: 1 on success, 0 if the encryption key is invalid
+ *  Args:         ctx: a secp256k1 context object
+ *  Out:     prepared: pointer to the prepared encryption key object
+ *  In:        enckey: pointer to the encryption public key
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey *prepared,
+    const rustsecp256k1zkp_v0_8_1_pubkey *enckey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Encrypted Signing with a prepared encryption key
+ *
+ *  Same as rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt, producing identical signatures,
+ *  but takes an encryption key prepared with
+ *  rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare.
+ *
+ *  Returns: 1 on success, 0 on failure
+ *  Args:           ctx: a secp256k1 context object, initialized for signing
+ *  Out: adaptor_sig162: pointer to 162 byte to store the returned signature
+ *  In:        seckey32: pointer to 32 byte secret key that will be used for
+ *                       signing
+ *               enckey: pointer to the prepared encryption key
+ *                msg32: pointer to the 32-byte message hash to sign
+ *              noncefp: pointer to a nonce generation function. If NULL,
+ *                       rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor is used
+ *                ndata: pointer to arbitrary data used by the nonce generation
+ *                       function (can be NULL)
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    unsigned char *adaptor_sig162,
+    unsigned char *seckey32,
+    const rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey *enckey,
+    const unsigned char *msg32,
+    rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp,
+    void *ndata
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
 /** Encryption Verification
  *
  *  Verifies that the adaptor decryption key can be extracted from the adaptor signature
@@ -116,6 +176,38 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(
     const rustsecp256k1zkp_v0_8_1_pubkey *enckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Batch Encryption Verification
+ *
+ *  Verifies many adaptor signatures at once. Returns 1 if and only if
+ *  rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify would return 1 for every signature
+ *  (except with negligible probability).
+ *
+ *  The DLEQ proofs are checked one by one, but the ECDSA relations of all
+ *  signatures are combined with random weights into a single
+ *  multi-exponentiation. This is only faster than verifying each signature
+ *  individually if a scratch space is provided that is large enough for the
+ *  multi-exponentiation of 2*n_sigs points.
+ *
+ *  Returns: 1 if all signatures are valid, 0 otherwise
+ *  Args:             ctx: a secp256k1 context object
+ *                scratch: scratch space used for the multi-exponentiation (can be
+ *                         NULL, in which case there is no speedup)
+ *  In:   adaptor_sigs162: array of pointers to 162-byte signatures to verify
+ *                pubkeys: array of pointers to the signers' public keys
+ *                 msgs32: array of pointers to the 32-byte message hashes
+ *                enckeys: array of pointers to the adaptor encryption public keys
+ *                 n_sigs: number of signatures (the arrays may be NULL if 0)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    const unsigned char * const *adaptor_sigs162,
+    const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys,
+    const unsigned char * const *msgs32,
+    const rustsecp256k1zkp_v0_8_1_pubkey * const *enckeys,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1);
+
 /** Signature Decryption
  *
  *  Derives an ECDSA signature from an adaptor signature and an adaptor decryption key.
@@ -157,6 +249,49 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_recover(
     const rustsecp256k1zkp_v0_8_1_pubkey *enckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Compute all DLC Oracle Attestation Points for a Numeric Outcome
+ *
+ *  An oracle that attests to a numeric outcome signs each of its n_digits
+ *  digits with BIP-340 Schnorr under a dedicated nonce R_j. The point
+ *  S_{j,d} = R_j + H(R_j, m_d, P)*P is the public key of the signature the
+ *  oracle publishes if digit j has value d, and the adaptor encryption key of
+ *  an outcome is the sum of the points of its digits. This function computes
+ *  the encryption keys of all base^n_digits outcomes at once. Outcomes sharing
+ *  a prefix of digits share the partial sums of that prefix, so only one point
+ *  addition is needed per outcome, and the affine conversion of all
+ *  intermediate points is batched.
+ *
+ *  Returns: 1 on success, 0 on failure (if any of the points is the point at
+ *           infinity, which only happens with negligible probability; the
+ *           output arrays are zeroed in that case)
+ *  Args:             ctx: a secp256k1 context object
+ *  Out:     digit_points: array of n_digits*base public keys set to S_{j,d}
+ *                         at index j*base + d
+ *                 points: array of n_points public keys; the point of the
+ *                         outcome with digits (d_0, ..., d_{n_digits-1}),
+ *                         most significant digit first, is stored at index
+ *                         sum_j d_j*base^(n_digits-1-j)
+ *  In:     oracle_pubkey: pointer to the x-only public key P of the oracle
+ *                 nonces: array of the n_digits x-only nonces R_j announced
+ *                         by the oracle
+ *               n_digits: number of digits (must be at least 1)
+ *         outcome_msgs32: array of pointers to the base 32-byte messages the
+ *                         oracle signs for each digit value
+ *                   base: number of values of a digit (must be at least 2)
+ *               n_points: number of outcomes, must be equal to base^n_digits
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_pubkey *digit_points,
+    rustsecp256k1zkp_v0_8_1_pubkey *points,
+    const rustsecp256k1zkp_v0_8_1_xonly_pubkey *oracle_pubkey,
+    const rustsecp256k1zkp_v0_8_1_xonly_pubkey *nonces,
+    size_t n_digits,
+    const unsigned char * const *outcome_msgs32,
+    size_t base,
+    size_t n_points
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(7);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,18 @@ extern "C" {
  * For mathematical background about the scheme, see the doc/ellswift.md file.
  */
 
+/** Opaque data structure that holds a secret key prepared for
+ *  rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret.
+ *
+ *  The exact representation of data inside is implementation defined and not
+ *  guaranteed to be portable between different platforms or versions. It is
+ *  however guaranteed to be 35 bytes in size, and can be safely copied/moved.
+ *  It contains secret data and must be cleared like a secret key.
+ */
+typedef struct {
+    unsigned char data[35];
+} rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret;
+
 /** A pointer to a function used by rustsecp256k1zkp_v0_8_1_ellswift_xdh to hash the shared X
  *  coordinate along with the encoded public keys to a uniform shared secret.
  *
@@ -126,6 +138,28 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_ellswift_decode(
     const unsigned char *ell64
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Decode many 64-byte ElligatorSwift encoded public keys.
+ *
+ *  Returns: always 1
+ *  Args:    ctx:        pointer to a context object
+ *  Out:     pubkeys:    pointer to an array of n rustsecp256k1zkp_v0_8_1_pubkey that will be
+ *                       filled
+ *  In:      ell64s:     array of n pointers to 64-byte arrays to decode
+ *           n:          number of encodings (the arrays may be NULL if 0)
+ *
+ * pubkeys[i] is the same as rustsecp256k1zkp_v0_8_1_ellswift_decode gives for ell64s[i], but
+ * the field inversions of up to 32 encodings are combined into one, which
+ * makes this faster than decoding them one by one.
+ *
+ * This function runs in variable time.
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_pubkey *pubkeys,
+    const unsigned char * const *ell64s,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Compute an ElligatorSwift public key for a secret key.
  *
  *  Returns: 1: secret was valid, public key was stored.
@@ -158,6 +192,35 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ellswift_
     const unsigned char *auxrnd32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute ElligatorSwift public keys for many secret keys.
+ *
+ *  Returns: 1: all secrets were valid, all public keys were stored.
+ *           0: a secret was invalid, its public key is zeroed.
+ *  Args:    ctx:        pointer to a context object
+ *  Out:     ell64s:     pointer to an array of n 64-byte ElligatorSwift public
+ *                       keys
+ *  In:      seckeys32:  array of n pointers to 32-byte secret keys
+ *           auxrnds32:  (optional) array of n pointers to 32 bytes of
+ *                       randomness, each of which may be NULL
+ *           n:          number of secret keys (the arrays may be NULL if 0)
+ *
+ * The public key for seckeys32[i] is the same as rustsecp256k1zkp_v0_8_1_ellswift_create gives
+ * with auxrnds32[i], but the public keys of up to 32 secret keys are brought
+ * to affine coordinates with one inversion, and the candidate encodings of
+ * all of them are tried together with one inversion per round. This makes it
+ * faster than creating the public keys one by one.
+ *
+ * Constant time in the secret keys and auxrnds32, but not in the resulting
+ * public keys.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ellswift_create_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    unsigned char *ell64s,
+    const unsigned char * const *seckeys32,
+    const unsigned char * const *auxrnds32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Given a private key, and ElligatorSwift public keys sent in both directions,
  *  compute a shared secret using x-only Elliptic Curve Diffie-Hellman (ECDH).
  *
@@ -193,6 +256,60 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ellswift_
   void *data
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(7);
 
+/** Prepare a secret key for computing many shared secrets with
+ *  rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret.
+ *
+ *  Returns: 1: secret key was valid, secret was stored.
+ *           0: secret key was invalid, secret is zeroed.
+ *  Args:    ctx:       pointer to a context object.
+ *  Out:     secret:    pointer to the prepared secret.
+ *  In:      seckey32:  a pointer to a 32-byte secret key.
+ *
+ * The secret holds the signed digits the secret key is multiplied with in
+ * rustsecp256k1zkp_v0_8_1_ellswift_xdh, so a party with a long-lived key, such as a listening
+ * node, does not recompute them for every connection.
+ *
+ * Constant time in seckey32.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret,
+  const unsigned char *seckey32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Same as rustsecp256k1zkp_v0_8_1_ellswift_xdh, but with a secret key prepared by
+ *  rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create.
+ *
+ *  Returns: 1: shared secret was successfully computed
+ *           0: secret was invalid or hashfp returned 0
+ *  Args:    ctx:       pointer to a context object.
+ *  Out:     output:    pointer to an array to be filled by hashfp.
+ *  In:      ell_a64:   pointer to the 64-byte encoded public key of party A
+ *                      (will not be NULL)
+ *           ell_b64:   pointer to the 64-byte encoded public key of party B
+ *                      (will not be NULL)
+ *           secret:    a pointer to our prepared secret
+ *           party:     boolean indicating which party we are, as in
+ *                      rustsecp256k1zkp_v0_8_1_ellswift_xdh.
+ *           hashfp:    pointer to a hash function.
+ *           data:      arbitrary data pointer passed through to hashfp.
+ *
+ * The output is the same as rustsecp256k1zkp_v0_8_1_ellswift_xdh gives with the secret key
+ * the secret was prepared from.
+ *
+ * Constant time in secret.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  unsigned char *output,
+  const unsigned char *ell_a64,
+  const unsigned char *ell_b64,
+  const rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret,
+  int party,
+  rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function hashfp,
+  void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(7);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,15 @@ typedef struct {
     unsigned char data[64];
 } rustsecp256k1zkp_v0_8_1_generator;
 
+/** Opaque data structure that holds a running sum of Pedersen blinding factors.
+ *
+ *  Guaranteed to be 36 bytes in size. It can be safely copied/moved. Contains
+ *  secret data.
+ */
+typedef struct {
+    unsigned char data[36];
+} rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator;
+
 /**
  * Static constant generator 'h' maintained for historical reasons.
  */
@@ -152,6 +161,38 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_
   const rustsecp256k1zkp_v0_8_1_generator *gen
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(5);
 
+/** Generate multiple Pedersen commitments at once.
+ *  Returns 1: All commitments successfully created.
+ *          0: Error. A blinding factor is larger than the group order
+ *             (probability for random 32 byte number < 2^-127) or results in
+ *             infinity. Retry with different factor. The commitments for which
+ *             this happened are zeroed, the others are valid.
+ *  In:     ctx:        pointer to a context object, initialized for signing (cannot be NULL)
+ *          scratch:    scratch space used to bring all commitments to affine
+ *                      coordinates with a single field inversion (can be NULL, in
+ *                      which case they are converted in fixed-size batches)
+ *          blinds:     array of n pointers to 32-byte blinding factors (cannot be NULL unless n is 0)
+ *          values:     array of n unsigned 64-bit integer values to commit to (cannot be NULL unless n is 0)
+ *          gens:       array of n pointers to value generators (cannot be NULL unless n is 0)
+ *          n:          number of commitments to create
+ *  Out:    commits:    array of n commitments, commits[i] = blinds[i] * G + values[i] * gens[i]
+ *                      (cannot be NULL unless n is 0)
+ *
+ *  This produces the same output as calling rustsecp256k1zkp_v0_8_1_pedersen_commit on each
+ *  element. Runs of consecutive commitments that use the same generator share a
+ *  precomputed table of multiples of that generator, so callers should group
+ *  outputs by generator where possible.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+  rustsecp256k1zkp_v0_8_1_pedersen_commitment *commits,
+  const unsigned char * const *blinds,
+  const uint64_t *values,
+  const rustsecp256k1zkp_v0_8_1_generator * const *gens,
+  size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Computes the sum of multiple positive and negative blinding factors.
  *  Returns 1: Sum successfully computed.
  *          0: Error. A blinding factor is larger than the group order
@@ -234,6 +275,84 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_
   size_t n_inputs
 );
 
+/** Initialize an accumulator for incrementally balancing the blinding factors
+ *  of a transaction, see rustsecp256k1zkp_v0_8_1_pedersen_blind_generator_blind_sum.
+ *
+ * Returns 1 always.
+ * Args:    ctx: pointer to a context object
+ * Out:     acc: pointer to the accumulator to initialize
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_init(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Add the blinding factors of one commitment P = vA' + r'G with A' = A + rG to
+ *  an accumulator, i.e. add (vr + r') for outputs or subtract it for inputs.
+ *
+ * Returns 1: Entry successfully added.
+ *         0: Error. generator_blind or blinding_factor is larger than the group
+ *            order. The accumulator is left unchanged.
+ * Args:                ctx: pointer to a context object
+ * In/Out:              acc: pointer to an initialized accumulator
+ * In:                value: the committed value `v`
+ *          generator_blind: 32-byte asset blinding factor `r`
+ *          blinding_factor: 32-byte commitment blinding factor `r'`
+ *                 is_input: nonzero if the commitment is negated in the final sum
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc,
+  uint64_t value,
+  const unsigned char *generator_blind,
+  const unsigned char *blinding_factor,
+  int is_input
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
+/** Remove an entry previously added with rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add.
+ *  The arguments must be the same as those passed when adding it.
+ *
+ * Returns 1: Entry successfully removed.
+ *         0: Error. generator_blind or blinding_factor is larger than the group
+ *            order. The accumulator is left unchanged.
+ * Args:                ctx: pointer to a context object
+ * In/Out:              acc: pointer to an initialized accumulator
+ * In:                value: the committed value `v`
+ *          generator_blind: 32-byte asset blinding factor `r`
+ *          blinding_factor: 32-byte commitment blinding factor `r'`
+ *                 is_input: nonzero if the entry was added as an input
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc,
+  uint64_t value,
+  const unsigned char *generator_blind,
+  const unsigned char *blinding_factor,
+  int is_input
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
+/** Compute the blinding factor of a final output such that the blinding
+ *  factors of all accumulated entries and that output sum to zero. This gives
+ *  the same result as placing the output last in
+ *  rustsecp256k1zkp_v0_8_1_pedersen_blind_generator_blind_sum. The accumulator is not
+ *  modified, so entries can still be added or removed afterwards.
+ *
+ * Returns 1: Blinding factor successfully computed.
+ *         0: Error. generator_blind is larger than the group order.
+ * Args:                    ctx: pointer to a context object
+ * Out:     blinding_factor_out: 32-byte blinding factor `r'` of the final output
+ * In:                      acc: pointer to an initialized accumulator
+ *                        value: value of the final output
+ *              generator_blind: 32-byte asset blinding factor of the final output
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(
+  const rustsecp256k1zkp_v0_8_1_context *ctx,
+  unsigned char *blinding_factor_out,
+  const rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc,
+  uint64_t value,
+  const unsigned char *generator_blind
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(5);
+
 # ifdef __cplusplus
 }
 # endif
@@ -43,6 +43,25 @@ typedef struct {
     unsigned char data[197];
 } rustsecp256k1zkp_v0_8_1_musig_keyagg_cache;
 
+/** Opaque data structure that holds a public key prepared for aggregation with
+ *  `musig_pubkey_agg_prepared` and `musig_pubkey_agg_subsets`.
+ *
+ *  Guaranteed to be 101 bytes in size. It can be safely copied/moved.
+ */
+typedef struct {
+    unsigned char data[101];
+} rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey;
+
+/** Opaque data structure that holds precomputed multiples of a signer's public
+ *  key for verifying its partial signatures with
+ *  `musig_partial_sig_verify_table`.
+ *
+ *  Guaranteed to be 33316 bytes in size. It can be safely copied/moved.
+ */
+typedef struct {
+    unsigned char data[33316];
+} rustsecp256k1zkp_v0_8_1_musig_signer_table;
+
 /** Opaque data structure that holds a signer's _secret_ nonce.
  *
  *  Guaranteed to be 132 bytes in size.
@@ -91,6 +110,24 @@ typedef struct {
     unsigned char data[133];
 } rustsecp256k1zkp_v0_8_1_musig_session;
 
+/** Opaque data structure that holds a MuSig session together with the
+ *  keyagg_cache it was created with, in the internal representation used for
+ *  signing.
+ *
+ *  Created with `musig_session_expand` from a session and keyagg_cache, which
+ *  are then no longer loaded and checked by every `musig_partial_sign_expanded`,
+ *  `musig_partial_sig_verify_expanded` and `musig_partial_sig_agg_expanded`
+ *  call. If it is expanded for a signer, it also holds that signer's KeyAgg
+ *  coefficient, which `musig_partial_sign_expanded` then does not have to
+ *  hash again. Guaranteed to be 512 bytes in size. It can be safely copied/moved
+ *  within a process, but its contents depend on how the library was built, so
+ *  it must not be stored or sent; use `musig_expanded_session_get` to get back
+ *  the session and keyagg_cache instead.
+ */
+typedef struct {
+    unsigned char data[512];
+} rustsecp256k1zkp_v0_8_1_musig_expanded_session;
+
 /** Opaque data structure that holds a partial MuSig signature.
  *
  *  Guaranteed to be 36 bytes in size. Serialized and parsed with
@@ -262,6 +299,86 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(
     size_t n_pubkeys
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5);
 
+/** Prepares a public key for aggregation
+ *
+ *  Aggregating prepared pubkeys skips parsing and serializing them, which
+ *  matters when the same keys are aggregated many times, for example in
+ *  different combinations.
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:        ctx: pointer to a context object
+ *  Out:    prepared: pointer to a struct to store the prepared pubkey
+ *  In:       pubkey: the public key to prepare
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_pubkey_prepare(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *prepared,
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Like musig_pubkey_agg, but with prepared pubkeys
+ *
+ *  The results are the same as those of musig_pubkey_agg with the public keys
+ *  the prepared pubkeys were created from.
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:        ctx: pointer to a context object
+ *           scratch: scratch space for the multiexponentiation, or NULL to use
+ *                    an inefficient algorithm
+ *  Out:      agg_pk: the MuSig-aggregated x-only public key. If you do not need it,
+ *                    this arg can be NULL.
+ *      keyagg_cache: if non-NULL, pointer to a musig_keyagg_cache struct
+ *   In:    prepared: input array of pointers to prepared pubkeys to aggregate
+ *         n_pubkeys: length of prepared array. Must be greater than 0.
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pk,
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache,
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey * const *prepared,
+    size_t n_pubkeys
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5);
+
+/** Aggregates the public keys of consecutive subsets of k of the prepared
+ *  pubkeys
+ *
+ *  Subsets are lists of k increasing indices into prepared, and are
+ *  enumerated in lexicographic order, starting with {0, 1, ..., k - 1}. The
+ *  keys of a subset are aggregated in the order of prepared, with the same
+ *  result as musig_pubkey_agg_prepared. Consecutive subsets share their list
+ *  hash computation as far as they share their first keys if a scratch space
+ *  is given.
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:        ctx: pointer to a context object
+ *           scratch: scratch space, or NULL to use an inefficient algorithm
+ *  Out:     agg_pks: array of *n_subsets x-only public keys to store the
+ *                    aggregate keys in, or NULL
+ *     keyagg_caches: array of *n_subsets keyagg_caches, or NULL
+ *  In/Out: n_subsets: in: the maximum number of subsets to aggregate; out: the
+ *                    number of subsets aggregated, which is only smaller if
+ *                    the last subset was aggregated
+ *            subset: array of k indices of the first subset to aggregate; set
+ *                    to the subset following the last one aggregated. When all
+ *                    subsets have been aggregated, all indices are set to
+ *                    n_pubkeys, and no further subsets are aggregated.
+ *  In:            k: the number of keys in a subset, between 1 and n_pubkeys
+ *          prepared: input array of pointers to prepared pubkeys
+ *         n_pubkeys: length of prepared array
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pks,
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_caches,
+    size_t *n_subsets,
+    size_t *subset,
+    size_t k,
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey * const *prepared,
+    size_t n_pubkeys
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(6) SECP256K1_ARG_NONNULL(8);
+
 /** Obtain the aggregate public key from a keyagg_cache.
  *
  *  This is only useful if you need the non-xonly public key, in particular for
@@ -419,6 +536,46 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_nonce_gen(
     const unsigned char *extra_input32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(6);
 
+/** Generates many nonces for one signer ahead of time
+ *
+ *  This is equivalent to calling musig_nonce_gen for every session_ids32[i]
+ *  with the same seckey, pubkey and extra_input32 and without msg32 and
+ *  keyagg_cache, but the public nonces are computed in batches that share a
+ *  single field inversion. It lets a signer fill a pool of nonces before the
+ *  signing sessions they are used in are known.
+ *
+ *  The rules of musig_nonce_gen apply to every element: each session_ids32[i]
+ *  must be UNIQUE and, unless a seckey is given, UNIFORMLY RANDOM AND KEPT
+ *  SECRET. Every secnonce must be used in at most one session and should be
+ *  removed from the pool when it is taken, before it is used.
+ *
+ *  Returns: 0 if the arguments are invalid or a session_ids32[i] is invalid,
+ *           in which case the corresponding secnonces are invalidated and can
+ *           not be used for signing, and 1 otherwise
+ *  Args:          ctx: pointer to a context object (not rustsecp256k1zkp_v0_8_1_context_static)
+ *  Out:     secnonces: array of n secret nonces (can be NULL if n is 0)
+ *           pubnonces: array of n public nonces (can be NULL if n is 0)
+ *  In:  session_ids32: array of n pointers to 32-byte session ids as explained
+ *                      above (can be NULL if n is 0)
+ *              seckey: the 32-byte secret key that will later be used for signing, if
+ *                      already known (can be NULL)
+ *              pubkey: public key of the signer creating the nonces. The secnonces
+ *                      cannot be used to sign for any other public key.
+ *       extra_input32: an optional 32-byte array that is input to the nonce
+ *                      derivation function (can be NULL)
+ *                   n: number of nonces to generate
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonces,
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonces,
+    const unsigned char * const *session_ids32,
+    const unsigned char *seckey,
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey,
+    const unsigned char *extra_input32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(6);
+
 /** Aggregates the nonces of all signers into a single nonce
  *
  *  This can be done by an untrusted party to reduce the communication
@@ -442,6 +599,39 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_nonce_agg(
     size_t n_pubnonces
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Aggregates the nonces of many sessions at once
+ *
+ *  This is equivalent to calling musig_nonce_agg for every session, but the
+ *  aggregate nonces of all sessions are brought to affine coordinates with a
+ *  single field inversion, which is useful for a coordinator of many
+ *  concurrent sessions.
+ *
+ *  Returns: 0 if the arguments are invalid, in which case all aggnonces are
+ *           zeroed unless aggnonces is NULL, 1 otherwise
+ *  Args:           ctx: pointer to a context object
+ *              scratch: scratch space used to convert the nonces of all sessions
+ *                       at once (can be NULL, in which case they are converted
+ *                       in fixed-size batches)
+ *  Out:      aggnonces: array of n_sessions aggregate public nonces, one for
+ *                       each session (can be NULL if n_sessions is 0)
+ *  In:       pubnonces: array of pointers to the public nonces of all
+ *                       sessions, the n_pubnonces[0] nonces of the first
+ *                       session followed by those of the second one and so
+ *                       on (can be NULL if n_sessions is 0)
+ *          n_pubnonces: array of n_sessions numbers of public nonces per
+ *                       session, each greater than 0 (can be NULL if
+ *                       n_sessions is 0)
+ *           n_sessions: number of sessions
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    rustsecp256k1zkp_v0_8_1_musig_aggnonce *aggnonces,
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce * const *pubnonces,
+    const size_t *n_pubnonces,
+    size_t n_sessions
+) SECP256K1_ARG_NONNULL(1);
+
 /** Takes the public nonces of all signers and computes a session that is
  *  required for signing and verification of partial signatures.
  *
@@ -694,6 +884,49 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_without_key
     const int negate_seckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Produces blinded partial signatures for many sessions of one signer
+ *
+ *  Signs session i with secnonces[i] like blinded_musig_partial_sign, or like
+ *  blinded_musig_partial_sign_without_keyaggcoeff if keyaggcoef is NULL. The
+ *  keypair is loaded and multiplied by the KeyAgg coefficient only once for
+ *  all sessions.
+ *
+ *  Unlike the single-session functions, this function verifies the output
+ *  partial signatures against pubnonces, all at once. If any of them does not
+ *  verify, all partial signatures are overwritten with zeros and 0 is
+ *  returned.
+ *
+ *  All secnonces are overwritten with zeros, even if signing fails.
+ *
+ *  Returns: 0 if the arguments are invalid, any secnonce has already been used
+ *           for signing or the partial signatures do not verify, 1 otherwise
+ *  Args:         ctx: pointer to a context object
+ *            scratch: scratch space for the verification, or NULL to use an
+ *                     inefficient algorithm
+ *  Out: partial_sigs: array of n structs to store the partial signatures
+ *  In/Out: secnonces: array of n secnonces that have been created for the
+ *                     keypair and never used in a partial_sign call before
+ *  In:       keypair: pointer to keypair to sign the messages with
+ *           sessions: array of n sessions, session i for secnonces[i]
+ *          pubnonces: array of n pubnonces, pubnonces[i] for secnonces[i]
+ *         keyaggcoef: pointer to the 32-byte key aggregation coefficient, or
+ *                     NULL to sign without one
+ *      negate_seckey: flag indicating whether the secret key should be negated
+ *                  n: number of sessions
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sigs,
+    rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonces,
+    const rustsecp256k1zkp_v0_8_1_keypair *keypair,
+    const rustsecp256k1zkp_v0_8_1_musig_session *sessions,
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonces,
+    const unsigned char *keyaggcoef,
+    int negate_seckey,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5);
+
 /** Verifies an individual signer's partial signature
  *
  *  The signature is verified for a specific signing session. In order to avoid
@@ -735,6 +968,54 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_musig_par
     const rustsecp256k1zkp_v0_8_1_musig_session *session
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(6);
 
+/** Creates the table for verifying a signer's partial signatures with
+ *  `musig_partial_sig_verify_table`
+ *
+ *  The table depends on the signer's public key and the list of public keys
+ *  aggregated into the keyagg_cache, but not on tweaks, so it can be used for
+ *  all sessions with the same signers.
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:        ctx: pointer to a context object
+ *  Out:       table: pointer to a struct to store the table
+ *  In:       pubkey: public key of the signer
+ *      keyagg_cache: pointer to a keyagg_cache the public key was aggregated
+ *                    into
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_signer_table_create(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_signer_table *table,
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey,
+    const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Like musig_partial_sig_verify, but takes the signer's public key from a
+ *  table created with `musig_signer_table_create`
+ *
+ *  The multiplication of the signer's public key uses the precomputed table,
+ *  which makes verification faster than with musig_partial_sig_verify.
+ *
+ *  Returns: 0 if the arguments are invalid, the partial signature does not
+ *           verify or the table was created for a different list of public
+ *           keys, 1 otherwise
+ *  Args         ctx: pointer to a context object
+ *  In:  partial_sig: pointer to partial signature to verify
+ *          pubnonce: public nonce of the signer in the signing session
+ *             table: table of the signer's public key
+ *      keyagg_cache: pointer to the keyagg_cache that was output when the
+ *                    aggregate public key for this signing session
+ *           session: pointer to the session that was created with
+ *                    `musig_nonce_process`
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig,
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce,
+    const rustsecp256k1zkp_v0_8_1_musig_signer_table *table,
+    const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache,
+    const rustsecp256k1zkp_v0_8_1_musig_session *session
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(6);
+
 /** Verifies an individual signer's partial signature
  *
  *  The signature is verified for a specific signing session. In order to avoid
@@ -796,6 +1077,111 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(
     size_t n_sigs
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Combines a session and the keyagg_cache it was created with into an
+ *  expanded session
+ *
+ *  If signer is not NULL, the KeyAgg coefficient of that public key is
+ *  computed once and used by musig_partial_sign_expanded whenever it signs
+ *  with the matching keypair. Signing with any other keypair still works, but
+ *  computes the coefficient on every call.
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:         ctx: pointer to a context object
+ *  Out:     expanded: pointer to a struct to store the expanded session
+ *  In:  keyagg_cache: pointer to the keyagg_cache that was used to create the
+ *                     session
+ *            session: pointer to the session that was created with
+ *                     musig_nonce_process
+ *             signer: pointer to the public key of the signer that will sign
+ *                     with this expanded session (can be NULL)
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_session_expand(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded,
+    const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache,
+    const rustsecp256k1zkp_v0_8_1_musig_session *session,
+    const rustsecp256k1zkp_v0_8_1_pubkey *signer
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Gets the session and keyagg_cache back from an expanded session
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise
+ *  Args:         ctx: pointer to a context object
+ *  Out: keyagg_cache: pointer to a struct to store the keyagg_cache (can be
+ *                     NULL)
+ *            session: pointer to a struct to store the session (can be NULL)
+ *  In:      expanded: pointer to an expanded session created with
+ *                     musig_session_expand
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache,
+    rustsecp256k1zkp_v0_8_1_musig_session *session,
+    const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(4);
+
+/** Like musig_partial_sign, but with an expanded session instead of the
+ *  keyagg_cache and session
+ *
+ *  Returns: 0 if the arguments are invalid or the provided secnonce has already
+ *           been used for signing, 1 otherwise
+ *  Args:         ctx: pointer to a context object
+ *  Out:  partial_sig: pointer to struct to store the partial signature
+ *  In/Out:  secnonce: pointer to the secnonce struct created in
+ *                     musig_nonce_gen that has been never used in a
+ *                     partial_sign call before and has been created for the
+ *                     keypair
+ *  In:       keypair: pointer to keypair to sign the message with
+ *           expanded: pointer to the expanded session
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_partial_sign_expanded(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig,
+    rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonce,
+    const rustsecp256k1zkp_v0_8_1_keypair *keypair,
+    const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
+/** Like musig_partial_sig_verify, but with an expanded session instead of the
+ *  keyagg_cache and session
+ *
+ *  Returns: 0 if the arguments are invalid or the partial signature does not
+ *           verify, 1 otherwise
+ *  Args         ctx: pointer to a context object
+ *  In:  partial_sig: pointer to partial signature to verify, sent by
+ *                    the signer associated with `pubnonce` and `pubkey`
+ *          pubnonce: public nonce of the signer in the signing session
+ *            pubkey: public key of the signer in the signing session
+ *          expanded: pointer to the expanded session
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig,
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce,
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey,
+    const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
+/** Like musig_partial_sig_agg, but with an expanded session instead of the
+ *  session
+ *
+ *  Returns: 0 if the arguments are invalid, 1 otherwise (which does NOT mean
+ *           the resulting signature verifies).
+ *  Args:         ctx: pointer to a context object
+ *  Out:        sig64: complete (but possibly invalid) Schnorr signature
+ *  In:      expanded: pointer to the expanded session
+ *       partial_sigs: array of pointers to partial signatures to aggregate
+ *             n_sigs: number of elements in the partial_sigs array. Must be
+ *                     greater than 0.
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    unsigned char *sig64,
+    const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded,
+    const rustsecp256k1zkp_v0_8_1_musig_partial_sig * const *partial_sigs,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
 /** Extracts the nonce_parity bit from a session
  *
  *  This is used for adaptor signatures.
@@ -127,6 +127,146 @@ SECP256K1_API void rustsecp256k1zkp_v0_8_1_context_preallocated_destroy(
     rustsecp256k1zkp_v0_8_1_context *ctx
 ) SECP256K1_ARG_NONNULL(1);
 
+/** A function that provides memory to a growable scratch space.
+ *
+ *  Returns: a pointer to a rewritable contiguous block of memory of at least
+ *           *size bytes, suitably aligned to hold an object of any type, or
+ *           NULL if no memory is available.
+ *  In/Out:  size: on input the number of bytes needed. The function may
+ *                 provide more and store their number in *size.
+ *  In:      data: the arbitrary data pointer passed when creating the scratch
+ *                 space.
+ *
+ *  The block is owned by the scratch space until it is destroyed. It is the
+ *  responsibility of the caller to keep track of the blocks and deallocate
+ *  them afterwards.
+ */
+typedef void *(*rustsecp256k1zkp_v0_8_1_scratch_grow_function)(
+    size_t *size,
+    void *data
+);
+
+/** Determine the memory size of a scratch space to be created in
+ *  caller-provided memory.
+ *
+ *  Returns: the required size of the caller-provided memory block, or 0 if
+ *           size is too large.
+ *  In:      size: the number of bytes available for allocations before the
+ *                 scratch space needs to grow.
+ */
+SECP256K1_API size_t rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(
+    size_t size
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Create a scratch space in caller-provided memory.
+ *
+ *  A scratch space holds the temporary data of functions that take one, for
+ *  example multi-exponentiations. Its memory is only used by one function call
+ *  at a time and is reused by the next one.
+ *
+ *  If grow is NULL, the scratch space has a fixed size and functions fall back
+ *  to slower algorithms or fail if it is too small. Otherwise it grows by
+ *  calling grow for more memory whenever an allocation does not fit, until
+ *  max_size bytes are in use at once. Memory obtained this way is kept and
+ *  reused by later calls.
+ *
+ *  Returns: a newly created scratch space.
+ *  Args:    ctx:       an existing context object.
+ *  In:      prealloc:  a pointer to a rewritable contiguous block of memory of
+ *                      size at least
+ *                      rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(size) bytes,
+ *                      suitably aligned to hold an object of any type.
+ *           size:      the size passed to
+ *                      rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size.
+ *           max_size:  the maximum number of bytes allocated at once if grow is
+ *                      not NULL, ignored otherwise.
+ *           grow:      a function providing more memory, or NULL.
+ *           grow_data: arbitrary data pointer passed to grow.
+ *
+ *  See also rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size and
+ *  rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy.
+ */
+SECP256K1_API rustsecp256k1zkp_v0_8_1_scratch_space *rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    void *prealloc,
+    size_t size,
+    size_t max_size,
+    rustsecp256k1zkp_v0_8_1_scratch_grow_function grow,
+    void *grow_data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Determine the size of a scratch space with which a multi-exponentiation of
+ *  n_points points runs in one batch with the fastest algorithm.
+ *
+ *  Returns: the number of bytes to pass as size to
+ *           rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size.
+ *  In:      n_points: the number of points.
+ */
+SECP256K1_API size_t rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(
+    size_t n_points
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** A function that runs tasks for the library, possibly in parallel.
+ *
+ *  It must call task(index, task_data) exactly once for every index below
+ *  n_tasks, from any threads and in any order, and only return after all of
+ *  these calls have returned.
+ *
+ *  In:      task:      the task to run.
+ *           task_data: the data pointer to pass to task.
+ *           n_tasks:   the number of times to call task.
+ *           data:      the arbitrary data pointer passed to
+ *                      rustsecp256k1zkp_v0_8_1_scratch_space_set_workers.
+ */
+typedef void (*rustsecp256k1zkp_v0_8_1_scratch_run_function)(
+    void (*task)(size_t index, void *task_data),
+    void *task_data,
+    size_t n_tasks,
+    void *data
+);
+
+/** Let functions spread large multi-exponentiations over several workers.
+ *
+ *  A function given this scratch space splits a multi-exponentiation of
+ *  at least 2048 points into up to n_workers parts, runs them with run and
+ *  adds up the results. Every part gets its own share of the scratch space,
+ *  so a scratch space with workers needs up to n_workers times
+ *  rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(n_points / n_workers) bytes. If it is
+ *  too small for that, the multi-exponentiation is computed in the calling
+ *  thread as before.
+ *
+ *  Returns: 1 on success, 0 if scratch is not a scratch space or run is not
+ *           NULL and n_workers is 0.
+ *  Args:    ctx:       an existing context object.
+ *  In/Out:  scratch:   the scratch space.
+ *  In:      run:       a function running the parts, or NULL to compute
+ *                      everything in the calling thread.
+ *           data:      arbitrary data pointer passed to run.
+ *           n_workers: the largest number of parts to split into; must be
+ *                      at least 1 if run is not NULL.
+ */
+SECP256K1_API int rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    rustsecp256k1zkp_v0_8_1_scratch_run_function run,
+    void *data,
+    size_t n_workers
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Destroy a scratch space that has been created in caller-provided memory.
+ *
+ *  The scratch space pointer may not be used afterwards. It is the
+ *  responsibility of the caller to deallocate the preallocated block and the
+ *  blocks returned by the grow function after this function returns.
+ *
+ *  Args:   ctx:     an existing context object.
+ *          scratch: the scratch space to destroy (can be NULL).
+ */
+SECP256K1_API void rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch
+) SECP256K1_ARG_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
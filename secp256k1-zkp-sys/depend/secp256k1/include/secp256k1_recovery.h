@@ -106,6 +106,43 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecdsa_rec
     const unsigned char *msghash32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Verify many recoverable ECDSA signatures at once.
+ *
+ *  Returns 1 if and only if every signature is valid for its message hash and
+ *  public key and its recovery id is correct (except with negligible
+ *  probability). A signature is valid if rustsecp256k1zkp_v0_8_1_ecdsa_verify would
+ *  accept it after rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_convert,
+ *  so signatures with a high s value are rejected. A valid signature with a
+ *  wrong recovery id also makes the batch fail.
+ *
+ *  The recovery id determines the nonce point R of a signature, so the
+ *  verification equations s*R = m*G + r*P of all signatures can be combined
+ *  with random weights into a single multi-exponentiation. Plain
+ *  signatures do not determine R, which is why this function needs
+ *  recoverable ones. This is only faster than verifying each signature
+ *  individually if a scratch space is provided that is large enough for the
+ *  multi-exponentiation of 2*n_sigs points. If it also has room for 32 bytes
+ *  per signature, the random weights are derived once per signature instead
+ *  of three times.
+ *
+ *  Returns: 1 if all signatures are valid, 0 otherwise
+ *  Args:         ctx: pointer to a context object.
+ *            scratch: scratch space used for the multi-exponentiation (can be
+ *                     NULL, in which case there is no speedup)
+ *  In:          sigs: array of pointers to the signatures to verify
+ *        msghashes32: array of pointers to the 32-byte message hashes
+ *            pubkeys: array of pointers to the signers' public keys
+ *             n_sigs: number of signatures (the arrays may be NULL if 0)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(
+    const rustsecp256k1zkp_v0_8_1_context *ctx,
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch,
+    const rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature * const *sigs,
+    const unsigned char * const *msghashes32,
+    const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,11 +56,14 @@ static void help(int default_iters) {
 #endif
 
 #ifdef ENABLE_MODULE_ELLSWIFT
-    printf("    ellswift          : all ElligatorSwift benchmarks (encode, decode, keygen, ecdh)\n");
+    printf("    ellswift          : all ElligatorSwift benchmarks (encode, decode, keygen, ecdh, batch)\n");
     printf("    ellswift_encode   : ElligatorSwift encoding\n");
     printf("    ellswift_decode   : ElligatorSwift decoding\n");
     printf("    ellswift_keygen   : ElligatorSwift key generation\n");
+    printf("    ellswift_decode_batch : ElligatorSwift decoding of 256 keys at once\n");
+    printf("    ellswift_keygen_batch : ElligatorSwift key generation of 256 keys at once\n");
     printf("    ellswift_ecdh     : ECDH on ElligatorSwift keys\n");
+    printf("    ellswift_ecdh_secret : ECDH on ElligatorSwift keys with a prepared secret key\n");
 #endif
 
     printf("\n");
@@ -179,7 +182,8 @@ int main(int argc, char** argv) {
     char* valid_args[] = {"ecdsa", "verify", "ecdsa_verify", "sign", "ecdsa_sign", "ecdh", "recover",
                          "ecdsa_recover", "schnorrsig", "schnorrsig_verify", "schnorrsig_sign", "ec",
                          "keygen", "ec_keygen", "ellswift", "encode", "ellswift_encode", "decode",
-                         "ellswift_decode", "ellswift_keygen", "ellswift_ecdh"};
+                         "ellswift_decode", "ellswift_keygen", "ellswift_ecdh", "ellswift_decode_batch",
+                         "ellswift_keygen_batch", "ellswift_ecdh_secret"};
     size_t valid_args_size = sizeof(valid_args)/sizeof(valid_args[0]);
     int invalid_args = have_invalid_args(argc, argv, valid_args, valid_args_size);
 
@@ -224,7 +228,8 @@ int main(int argc, char** argv) {
 #ifndef ENABLE_MODULE_ELLSWIFT
     if (have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "ellswift_encode") || have_flag(argc, argv, "ellswift_decode") ||
         have_flag(argc, argv, "encode") || have_flag(argc, argv, "decode") || have_flag(argc, argv, "ellswift_keygen") ||
-        have_flag(argc, argv, "ellswift_ecdh")) {
+        have_flag(argc, argv, "ellswift_ecdh") || have_flag(argc, argv, "ellswift_decode_batch") ||
+        have_flag(argc, argv, "ellswift_keygen_batch") || have_flag(argc, argv, "ellswift_ecdh_secret")) {
         fprintf(stderr, "./bench: ElligatorSwift module not enabled.\n");
         fprintf(stderr, "Use ./configure --enable-module-ellswift.\n\n");
         return 1;
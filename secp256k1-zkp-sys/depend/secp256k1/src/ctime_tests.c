@@ -191,6 +191,32 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
     ret = rustsecp256k1zkp_v0_8_1_schnorrsig_sign32(ctx, sig, msg, &keypair, NULL);
     SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
     CHECK(ret == 1);
+
+    {
+        unsigned char sigs[2 * 64];
+        unsigned char aux_rand[2][32];
+        const unsigned char *msg_ptrs[2];
+        const unsigned char *aux_rand_ptrs[2];
+        size_t msglens[2];
+
+        for (i = 0; i < 2; i++) {
+            msg_ptrs[i] = msg;
+            msglens[i] = sizeof(msg);
+            memset(aux_rand[i], i + 3, sizeof(aux_rand[i]));
+            aux_rand_ptrs[i] = aux_rand[i];
+        }
+        SECP256K1_CHECKMEM_UNDEFINE(key, 32);
+        ret = rustsecp256k1zkp_v0_8_1_keypair_create(ctx, &keypair, key);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+        SECP256K1_CHECKMEM_UNDEFINE(aux_rand, sizeof(aux_rand));
+        ret = rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(ctx, sigs, msg_ptrs, msglens, &keypair, aux_rand_ptrs, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+        ret = rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(ctx, sigs, msg_ptrs, msglens, &keypair, NULL, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+    }
 #endif
 
 #ifdef ENABLE_MODULE_ELLSWIFT
@@ -204,6 +230,27 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
     SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
     CHECK(ret == 1);
 
+    {
+        unsigned char ellswifts[2 * 64];
+        unsigned char seckeys[2][32];
+        const unsigned char *seckey_ptrs[2];
+        const unsigned char *auxrnd_ptrs[2];
+
+        for (i = 0; i < 2; i++) {
+            memset(seckeys[i], i + 7, sizeof(seckeys[i]));
+            seckey_ptrs[i] = seckeys[i];
+        }
+        auxrnd_ptrs[0] = NULL;
+        auxrnd_ptrs[1] = ellswift;
+        SECP256K1_CHECKMEM_UNDEFINE(seckeys, sizeof(seckeys));
+        ret = rustsecp256k1zkp_v0_8_1_ellswift_create_batch(ctx, ellswifts, seckey_ptrs, auxrnd_ptrs, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+        ret = rustsecp256k1zkp_v0_8_1_ellswift_create_batch(ctx, ellswifts, seckey_ptrs, NULL, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+    }
+
     for (i = 0; i < 2; i++) {
         SECP256K1_CHECKMEM_UNDEFINE(key, 32);
         SECP256K1_CHECKMEM_DEFINE(&ellswift, sizeof(ellswift));
@@ -213,6 +260,23 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
         CHECK(ret == 1);
     }
+
+    {
+        rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret xdh_secret;
+
+        SECP256K1_CHECKMEM_UNDEFINE(key, 32);
+        ret = rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(ctx, &xdh_secret, key);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+
+        for (i = 0; i < 2; i++) {
+            SECP256K1_CHECKMEM_UNDEFINE(&xdh_secret, sizeof(xdh_secret));
+            SECP256K1_CHECKMEM_DEFINE(&ellswift, sizeof(ellswift));
+            ret = rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(ctx, msg, ellswift, ellswift, &xdh_secret, i, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL);
+            SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+            CHECK(ret == 1);
+        }
+    }
 #endif
 
 #ifdef ENABLE_MODULE_ECDSA_S2C
@@ -246,6 +310,7 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         unsigned char deckey[32];
         unsigned char expected_deckey[32];
         rustsecp256k1zkp_v0_8_1_pubkey enckey;
+        static rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey prepared;
 
         for (i = 0; i < 32; i++) {
             deckey[i] = i + 2;
@@ -260,6 +325,14 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
         CHECK(ret == 1);
 
+        ret = rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(ctx, &prepared, &enckey);
+        CHECK(ret == 1);
+        SECP256K1_CHECKMEM_UNDEFINE(key, 32);
+        ret = rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(ctx, adaptor_sig, key, &prepared, msg, NULL, NULL);
+        SECP256K1_CHECKMEM_DEFINE(adaptor_sig, sizeof(adaptor_sig));
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+
         SECP256K1_CHECKMEM_UNDEFINE(deckey, 32);
         ret = rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_decrypt(ctx, &signature, deckey, adaptor_sig);
         SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
@@ -286,6 +359,14 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         unsigned char session_id[32];
         rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce;
         rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce;
+        unsigned char session_ids[2][32];
+        const unsigned char *session_id_ptrs[2];
+        rustsecp256k1zkp_v0_8_1_musig_secnonce secnonces[2];
+        rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonces[2];
+        rustsecp256k1zkp_v0_8_1_musig_session sessions[2];
+        rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sigs[2];
+        unsigned char keyaggcoef[32];
+        int negate_seckey;
         const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce_ptr[1];
         rustsecp256k1zkp_v0_8_1_musig_aggnonce aggnonce;
         rustsecp256k1zkp_v0_8_1_musig_keyagg_cache cache;
@@ -320,6 +401,21 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         ret = rustsecp256k1zkp_v0_8_1_musig_nonce_gen(ctx, &secnonce, &pubnonce, session_id, key, &pk, msg, &cache, extra_input);
         SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
         CHECK(ret == 1);
+
+        for (i = 0; i < 2; i++) {
+            memset(session_ids[i], i + 5, sizeof(session_ids[i]));
+            session_id_ptrs[i] = session_ids[i];
+        }
+        SECP256K1_CHECKMEM_UNDEFINE(key, 32);
+        SECP256K1_CHECKMEM_UNDEFINE(session_ids, sizeof(session_ids));
+        SECP256K1_CHECKMEM_UNDEFINE(extra_input, sizeof(extra_input));
+        ret = rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(ctx, secnonces, pubnonces, session_id_ptrs, key, &pk, extra_input, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+        SECP256K1_CHECKMEM_UNDEFINE(session_ids, sizeof(session_ids));
+        ret = rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(ctx, secnonces, pubnonces, session_id_ptrs, NULL, &pk, NULL, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
         CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg(ctx, &aggnonce, pubnonce_ptr, 1));
         /* Make sure that previous tests don't undefine msg. It's not used as a secret here. */
         SECP256K1_CHECKMEM_DEFINE(msg, sizeof(msg));
@@ -332,6 +428,17 @@ static void run_tests(rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *key)
         SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
         CHECK(ret == 1);
 
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_get_keyaggcoef_and_negation_seckey(ctx, keyaggcoef, &negate_seckey, &cache, &pk));
+        for (i = 0; i < 2; i++) {
+            pubnonce_ptr[0] = &pubnonces[i];
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg(ctx, &aggnonce, pubnonce_ptr, 1));
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_process(ctx, &sessions[i], &aggnonce, msg, &cache, NULL) == 1);
+        }
+        pubnonce_ptr[0] = &pubnonce;
+        ret = rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(ctx, NULL, partial_sigs, secnonces, &keypair, sessions, pubnonces, keyaggcoef, negate_seckey, 2);
+        SECP256K1_CHECKMEM_DEFINE(&ret, sizeof(ret));
+        CHECK(ret == 1);
+
         SECP256K1_CHECKMEM_DEFINE(&partial_sig, sizeof(partial_sig));
         CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(ctx, pre_sig, &session, partial_sig_ptr, 1));
         SECP256K1_CHECKMEM_DEFINE(pre_sig, sizeof(pre_sig));
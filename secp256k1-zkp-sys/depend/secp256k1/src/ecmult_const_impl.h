@@ -130,17 +130,35 @@ static int rustsecp256k1zkp_v0_8_1_wnaf_const(int *wnaf, const rustsecp256k1zkp_
     return skew;
 }
 
-static void rustsecp256k1zkp_v0_8_1_ecmult_const(rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_ge *a, const rustsecp256k1zkp_v0_8_1_scalar *scalar) {
+/** The digits ecmult_const multiplies a point with. They only depend on the
+ *  scalar, so a scalar that is used with many points can be recoded once. */
+typedef struct {
+    int wnaf_1[1 + WNAF_SIZE(WINDOW_A - 1)];
+    int wnaf_lam[1 + WNAF_SIZE(WINDOW_A - 1)];
+    int skew_1;
+    int skew_lam;
+} rustsecp256k1zkp_v0_8_1_ecmult_const_recoding;
+
+/** Recode q for ecmult_const_recoded, in constant time. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_const_recode(rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec, const rustsecp256k1zkp_v0_8_1_scalar *scalar) {
+    rustsecp256k1zkp_v0_8_1_scalar q_1, q_lam;
+
+    /* build wnaf representation for q. */
+    /* split q into q_1 and q_lam (where q = q_1 + q_lam*lambda, and q_1 and q_lam are ~128 bit) */
+    rustsecp256k1zkp_v0_8_1_scalar_split_lambda(&q_1, &q_lam, scalar);
+    rec->skew_1   = rustsecp256k1zkp_v0_8_1_wnaf_const(rec->wnaf_1,   &q_1,   WINDOW_A - 1, 128);
+    rec->skew_lam = rustsecp256k1zkp_v0_8_1_wnaf_const(rec->wnaf_lam, &q_lam, WINDOW_A - 1, 128);
+}
+
+/** Same as ecmult_const, but with a scalar recoded by ecmult_const_recode. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_const_recoded(rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_ge *a, const rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec) {
     rustsecp256k1zkp_v0_8_1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
     rustsecp256k1zkp_v0_8_1_ge tmpa;
     rustsecp256k1zkp_v0_8_1_fe Z;
 
-    int skew_1;
     rustsecp256k1zkp_v0_8_1_ge pre_a_lam[ECMULT_TABLE_SIZE(WINDOW_A)];
-    int wnaf_lam[1 + WNAF_SIZE(WINDOW_A - 1)];
-    int skew_lam;
-    rustsecp256k1zkp_v0_8_1_scalar q_1, q_lam;
-    int wnaf_1[1 + WNAF_SIZE(WINDOW_A - 1)];
+    const int *wnaf_1 = rec->wnaf_1;
+    const int *wnaf_lam = rec->wnaf_lam;
 
     int i;
 
@@ -149,12 +167,6 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_const(rustsecp256k1zkp_v0_8_1_gej *r,
         return;
     }
 
-    /* build wnaf representation for q. */
-    /* split q into q_1 and q_lam (where q = q_1 + q_lam*lambda, and q_1 and q_lam are ~128 bit) */
-    rustsecp256k1zkp_v0_8_1_scalar_split_lambda(&q_1, &q_lam, scalar);
-    skew_1   = rustsecp256k1zkp_v0_8_1_wnaf_const(wnaf_1,   &q_1,   WINDOW_A - 1, 128);
-    skew_lam = rustsecp256k1zkp_v0_8_1_wnaf_const(wnaf_lam, &q_lam, WINDOW_A - 1, 128);
-
     /* Calculate odd multiples of a.
      * All multiples are brought to the same Z 'denominator', which is stored
      * in Z. Due to secp256k1' isomorphism we can do all operations pretending
@@ -206,17 +218,25 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_const(rustsecp256k1zkp_v0_8_1_gej *r,
 
         rustsecp256k1zkp_v0_8_1_ge_neg(&tmpa, &pre_a[0]);
         rustsecp256k1zkp_v0_8_1_gej_add_ge(&tmpj, r, &tmpa);
-        rustsecp256k1zkp_v0_8_1_gej_cmov(r, &tmpj, skew_1);
+        rustsecp256k1zkp_v0_8_1_gej_cmov(r, &tmpj, rec->skew_1);
 
         rustsecp256k1zkp_v0_8_1_ge_neg(&tmpa, &pre_a_lam[0]);
         rustsecp256k1zkp_v0_8_1_gej_add_ge(&tmpj, r, &tmpa);
-        rustsecp256k1zkp_v0_8_1_gej_cmov(r, &tmpj, skew_lam);
+        rustsecp256k1zkp_v0_8_1_gej_cmov(r, &tmpj, rec->skew_lam);
     }
 
     rustsecp256k1zkp_v0_8_1_fe_mul(&r->z, &r->z, &Z);
 }
 
-static int rustsecp256k1zkp_v0_8_1_ecmult_const_xonly(rustsecp256k1zkp_v0_8_1_fe* r, const rustsecp256k1zkp_v0_8_1_fe *n, const rustsecp256k1zkp_v0_8_1_fe *d, const rustsecp256k1zkp_v0_8_1_scalar *q, int known_on_curve) {
+static void rustsecp256k1zkp_v0_8_1_ecmult_const(rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_ge *a, const rustsecp256k1zkp_v0_8_1_scalar *scalar) {
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoding rec;
+
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recode(&rec, scalar);
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoded(r, a, &rec);
+}
+
+/** Same as ecmult_const_xonly, but with a scalar recoded by ecmult_const_recode. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_const_xonly_recoded(rustsecp256k1zkp_v0_8_1_fe* r, const rustsecp256k1zkp_v0_8_1_fe *n, const rustsecp256k1zkp_v0_8_1_fe *d, const rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec, int known_on_curve) {
 
     /* This algorithm is a generalization of Peter Dettman's technique for
      * avoiding the square root in a random-basepoint x-only multiplication
@@ -331,10 +351,7 @@ static int rustsecp256k1zkp_v0_8_1_ecmult_const_xonly(rustsecp256k1zkp_v0_8_1_fe
     p.infinity = 0;
 
     /* Perform x-only EC multiplication of P with q. */
-#ifdef VERIFY
-    VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_scalar_is_zero(q));
-#endif
-    rustsecp256k1zkp_v0_8_1_ecmult_const(&rj, &p, q);
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoded(&rj, &p, rec);
 #ifdef VERIFY
     VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_gej_is_infinity(&rj));
 #endif
@@ -351,4 +368,14 @@ static int rustsecp256k1zkp_v0_8_1_ecmult_const_xonly(rustsecp256k1zkp_v0_8_1_fe
     return 1;
 }
 
+static int rustsecp256k1zkp_v0_8_1_ecmult_const_xonly(rustsecp256k1zkp_v0_8_1_fe* r, const rustsecp256k1zkp_v0_8_1_fe *n, const rustsecp256k1zkp_v0_8_1_fe *d, const rustsecp256k1zkp_v0_8_1_scalar *q, int known_on_curve) {
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoding rec;
+
+#ifdef VERIFY
+    VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_scalar_is_zero(q));
+#endif
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recode(&rec, q);
+    return rustsecp256k1zkp_v0_8_1_ecmult_const_xonly_recoded(r, n, d, &rec, known_on_curve);
+}
+
 #endif /* SECP256K1_ECMULT_CONST_IMPL_H */
@@ -0,0 +1,47 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_ECMULT_FIXED_H
+#define SECP256K1_ECMULT_FIXED_H
+
+#include "scalar.h"
+#include "group.h"
+
+/* Variable-time multiplication of points that do not change with tables of
+ * their multiples. A scalar s is split into signed w-bit digits d_j with
+ * s = sum_j d_j 2^(j*w) and |d_j| <= 2^(w-1), so that s*P needs one addition
+ * of a multiple of 2^(j*w)*P per nonzero digit and no doublings.
+ *
+ * For many points, only the rows 2^(j*w)*P are stored per point, and
+ * d_j 2^(j*w) P is added to the bucket for |d_j| like in Pippenger's
+ * algorithm. As all windows share one set of buckets, the buckets are summed
+ * up only once, which makes a larger window worthwhile than ecmult_multi_var
+ * can use for the same number of points. */
+
+/* One window more than fits into 256 bits takes the carry out of the top
+ * digit. */
+#define ECMULT_FIXED_N_WINDOWS(w) (256 / (w) + 1)
+#define ECMULT_FIXED_MAX_WINDOW 12
+/* The number of buckets for window size w. */
+#define ECMULT_FIXED_N_BUCKETS(w) ((size_t)1 << ((w) - 1))
+
+/** Split s into ECMULT_FIXED_N_WINDOWS(w) signed digits of w bits, for
+ *  2 <= w <= ECMULT_FIXED_MAX_WINDOW. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_recode(int *digits, const rustsecp256k1zkp_v0_8_1_scalar *s, int w);
+
+/** Return the window size with the fewest additions for n points: one per
+ *  point and window, and about 2^w to sum up the buckets. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_fixed_window(size_t n);
+
+/** Set row[j] = 2^(j*w)*P for j < ECMULT_FIXED_N_WINDOWS(w). */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_row(rustsecp256k1zkp_v0_8_1_gej *row, const rustsecp256k1zkp_v0_8_1_ge *p, int w);
+
+/** Add s*P to the ECMULT_FIXED_N_BUCKETS(w) buckets, given the row of P. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_add(rustsecp256k1zkp_v0_8_1_gej *buckets, const rustsecp256k1zkp_v0_8_1_ge_storage *row, const rustsecp256k1zkp_v0_8_1_scalar *s, int w);
+
+/** Set r to the sum of the points added to the buckets, and clear them. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_sum(rustsecp256k1zkp_v0_8_1_gej *r, rustsecp256k1zkp_v0_8_1_gej *buckets, int w);
+
+#endif /* SECP256K1_ECMULT_FIXED_H */
@@ -0,0 +1,29 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_ECMULT_FIXED_CONST_H
+#define SECP256K1_ECMULT_FIXED_CONST_H
+
+#include "scalar.h"
+#include "group.h"
+
+/* A table for constant-time multiplication of a fixed point P by secret
+ * scalars below 16^windows, consisting of ge_storage prec[windows][16] with
+ * prec[i][j] = (j+1)*16^i*P, followed by ge_storage neg_offset =
+ * -(sum_i 16^i)*P. Adding the neg_offset cancels the +1 of every window, so
+ * that the lookups never have to add infinity.
+ *
+ * The table is a byte array so that it can be kept inside caller-provided
+ * opaque objects, and entries are copied out with memcpy instead of being
+ * accessed in place. */
+#define ECMULT_FIXED_CONST_TABLE_SIZE(windows) (((windows) * 16 + 1) * sizeof(rustsecp256k1zkp_v0_8_1_ge_storage))
+
+/** Fill a table of ECMULT_FIXED_CONST_TABLE_SIZE(windows) bytes for p. Variable time in p. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_const_table_build(unsigned char *table, const rustsecp256k1zkp_v0_8_1_ge *p, int windows);
+
+/** r = k*P for a table of P with the given number of windows and k < 16^windows. Constant time in k. */
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(rustsecp256k1zkp_v0_8_1_gej *r, const unsigned char *table, int windows, const rustsecp256k1zkp_v0_8_1_scalar *k);
+
+#endif /* SECP256K1_ECMULT_FIXED_CONST_H */
@@ -0,0 +1,66 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_ECMULT_FIXED_CONST_IMPL_H
+#define SECP256K1_ECMULT_FIXED_CONST_IMPL_H
+
+#include <string.h>
+
+#include "scalar.h"
+#include "group.h"
+#include "ecmult_fixed_const.h"
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_const_table_build(unsigned char *table, const rustsecp256k1zkp_v0_8_1_ge *p, int windows) {
+    rustsecp256k1zkp_v0_8_1_gej multj[16];
+    rustsecp256k1zkp_v0_8_1_ge mult[16];
+    rustsecp256k1zkp_v0_8_1_ge_storage s;
+    rustsecp256k1zkp_v0_8_1_gej base, offset;
+    int i, j;
+
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&base, p);
+    rustsecp256k1zkp_v0_8_1_gej_set_infinity(&offset);
+    for (i = 0; i < windows; i++) {
+        /* multj[j] = (j+1)*16^i*P, so multj[15] is the base of the next window. */
+        multj[0] = base;
+        for (j = 1; j < 16; j++) {
+            rustsecp256k1zkp_v0_8_1_gej_add_var(&multj[j], &multj[j - 1], &base, NULL);
+        }
+        rustsecp256k1zkp_v0_8_1_gej_add_var(&offset, &offset, &base, NULL);
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(mult, multj, 16);
+        for (j = 0; j < 16; j++) {
+            rustsecp256k1zkp_v0_8_1_ge_to_storage(&s, &mult[j]);
+            memcpy(&table[(i * 16 + j) * sizeof(s)], &s, sizeof(s));
+        }
+        base = multj[15];
+    }
+    rustsecp256k1zkp_v0_8_1_gej_neg(&offset, &offset);
+    rustsecp256k1zkp_v0_8_1_ge_set_gej_var(&mult[0], &offset);
+    rustsecp256k1zkp_v0_8_1_ge_to_storage(&s, &mult[0]);
+    memcpy(&table[windows * 16 * sizeof(s)], &s, sizeof(s));
+}
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(rustsecp256k1zkp_v0_8_1_gej *r, const unsigned char *table, int windows, const rustsecp256k1zkp_v0_8_1_scalar *k) {
+    rustsecp256k1zkp_v0_8_1_ge add;
+    rustsecp256k1zkp_v0_8_1_ge_storage adds, entry;
+    int i, j;
+
+    memcpy(&adds, &table[windows * 16 * sizeof(adds)], sizeof(adds));
+    rustsecp256k1zkp_v0_8_1_ge_from_storage(&add, &adds);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(r, &add);
+    for (i = 0; i < windows; i++) {
+        unsigned int bits = rustsecp256k1zkp_v0_8_1_scalar_get_bits(k, 4 * i, 4);
+        /* Constant-time lookup of entry bits, i.e. (bits+1)*16^i*P. */
+        for (j = 0; j < 16; j++) {
+            memcpy(&entry, &table[(i * 16 + j) * sizeof(entry)], sizeof(entry));
+            rustsecp256k1zkp_v0_8_1_ge_storage_cmov(&adds, &entry, j == (int)bits);
+        }
+        rustsecp256k1zkp_v0_8_1_ge_from_storage(&add, &adds);
+        rustsecp256k1zkp_v0_8_1_gej_add_ge(r, r, &add);
+    }
+    rustsecp256k1zkp_v0_8_1_ge_clear(&add);
+    memset(&adds, 0, sizeof(adds));
+}
+
+#endif /* SECP256K1_ECMULT_FIXED_CONST_IMPL_H */
@@ -0,0 +1,86 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_ECMULT_FIXED_IMPL_H
+#define SECP256K1_ECMULT_FIXED_IMPL_H
+
+#include "scalar.h"
+#include "group.h"
+#include "ecmult_fixed.h"
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_recode(int *digits, const rustsecp256k1zkp_v0_8_1_scalar *s, int w) {
+    int carry = 0;
+    int j;
+
+    VERIFY_CHECK(w >= 2 && w <= ECMULT_FIXED_MAX_WINDOW);
+    for (j = 0; j < ECMULT_FIXED_N_WINDOWS(w); j++) {
+        int offset = j * w;
+        int count = offset + w <= 256 ? w : 256 - offset;
+        int digit = carry + (count > 0 ? (int)rustsecp256k1zkp_v0_8_1_scalar_get_bits_var(s, offset, count) : 0);
+
+        carry = digit > (1 << (w - 1));
+        digits[j] = digit - (carry << w);
+    }
+    VERIFY_CHECK(carry == 0);
+}
+
+static int rustsecp256k1zkp_v0_8_1_ecmult_fixed_window(size_t n) {
+    int w, best = 2;
+    for (w = 3; w <= ECMULT_FIXED_MAX_WINDOW; w++) {
+        if (n * ECMULT_FIXED_N_WINDOWS(w) + ((size_t)1 << w) < n * ECMULT_FIXED_N_WINDOWS(best) + ((size_t)1 << best)) {
+            best = w;
+        }
+    }
+    return best;
+}
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_row(rustsecp256k1zkp_v0_8_1_gej *row, const rustsecp256k1zkp_v0_8_1_ge *p, int w) {
+    int j, k;
+
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&row[0], p);
+    for (j = 1; j < ECMULT_FIXED_N_WINDOWS(w); j++) {
+        rustsecp256k1zkp_v0_8_1_gej_double_var(&row[j], &row[j - 1], NULL);
+        for (k = 1; k < w; k++) {
+            rustsecp256k1zkp_v0_8_1_gej_double_var(&row[j], &row[j], NULL);
+        }
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_add(rustsecp256k1zkp_v0_8_1_gej *buckets, const rustsecp256k1zkp_v0_8_1_ge_storage *row, const rustsecp256k1zkp_v0_8_1_scalar *s, int w) {
+    int digits[ECMULT_FIXED_N_WINDOWS(2)];
+    int j;
+
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_recode(digits, s, w);
+    for (j = 0; j < ECMULT_FIXED_N_WINDOWS(w); j++) {
+        int digit = digits[j];
+        rustsecp256k1zkp_v0_8_1_ge p;
+
+        if (digit == 0) {
+            continue;
+        }
+        rustsecp256k1zkp_v0_8_1_ge_from_storage(&p, &row[j]);
+        if (digit < 0) {
+            rustsecp256k1zkp_v0_8_1_ge_neg(&p, &p);
+            digit = -digit;
+        }
+        rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&buckets[digit - 1], &buckets[digit - 1], &p, NULL);
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_sum(rustsecp256k1zkp_v0_8_1_gej *r, rustsecp256k1zkp_v0_8_1_gej *buckets, int w) {
+    rustsecp256k1zkp_v0_8_1_gej running;
+    size_t j;
+
+    /* r = sum_k (k + 1) buckets[k] */
+    rustsecp256k1zkp_v0_8_1_gej_set_infinity(&running);
+    rustsecp256k1zkp_v0_8_1_gej_set_infinity(r);
+    for (j = ECMULT_FIXED_N_BUCKETS(w); j > 0; j--) {
+        rustsecp256k1zkp_v0_8_1_gej_add_var(&running, &running, &buckets[j - 1], NULL);
+        rustsecp256k1zkp_v0_8_1_gej_add_var(r, r, &running, NULL);
+        rustsecp256k1zkp_v0_8_1_gej_clear(&buckets[j - 1]);
+    }
+}
+
+#endif /* SECP256K1_ECMULT_FIXED_IMPL_H */
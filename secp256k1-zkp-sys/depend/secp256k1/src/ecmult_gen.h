@@ -28,8 +28,18 @@
 #define ECMULT_GEN_PREC_G(bits) (1 << bits)
 #define ECMULT_GEN_PREC_N(bits) (256 / bits)
 
+/* With ECMULT_GEN_ALL_PREC_TABLES the tables for all precisions are compiled
+ * in and a context can select one at runtime. The exhaustive tests compute
+ * their single table at runtime instead. */
+#if defined(ECMULT_GEN_ALL_PREC_TABLES) && defined(EXHAUSTIVE_TEST_ORDER)
+#  undef ECMULT_GEN_ALL_PREC_TABLES
+#endif
+
 typedef struct {
-    /* Whether the context has been built. */
+    /* Zero if the context has not been built. Otherwise 1 if the context uses
+     * the table for ECMULT_GEN_PREC_BITS, or the precision of the table it
+     * uses instead. Contexts built by library versions that do not know about
+     * other tables always have 1 here, so they keep working. */
     int built;
 
     /* Blinding values used when computing (n-b)G + bG. */
@@ -40,6 +50,13 @@ typedef struct {
 static void rustsecp256k1zkp_v0_8_1_ecmult_gen_context_build(rustsecp256k1zkp_v0_8_1_ecmult_gen_context* ctx);
 static void rustsecp256k1zkp_v0_8_1_ecmult_gen_context_clear(rustsecp256k1zkp_v0_8_1_ecmult_gen_context* ctx);
 
+/** Whether the table with the given precision (2, 4 or 8 bits) is compiled in. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(int bits);
+
+/** Select the table with the given precision for a built context. Returns 0
+ *  if that table is not compiled in. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_gen_context_set_table(rustsecp256k1zkp_v0_8_1_ecmult_gen_context* ctx, int bits);
+
 /** Multiply with the generator: R = a*G */
 static void rustsecp256k1zkp_v0_8_1_ecmult_gen(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context* ctx, rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_scalar *a);
 
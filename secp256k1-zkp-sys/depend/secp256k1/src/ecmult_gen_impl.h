@@ -11,6 +11,7 @@
 #include "scalar.h"
 #include "group.h"
 #include "ecmult_gen.h"
+#include "ecmult_impl.h"
 #include "hash_impl.h"
 #include "precomputed_ecmult_gen.h"
 
@@ -29,6 +30,50 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_gen_context_clear(rustsecp256k1zkp_v0
     rustsecp256k1zkp_v0_8_1_gej_clear(&ctx->initial);
 }
 
+static int rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(int bits) {
+#ifdef ECMULT_GEN_ALL_PREC_TABLES
+    return bits == 2 || bits == 4 || bits == 8;
+#else
+    return bits == ECMULT_GEN_PREC_BITS;
+#endif
+}
+
+static int rustsecp256k1zkp_v0_8_1_ecmult_gen_context_set_table(rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ctx, int bits) {
+    VERIFY_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(ctx));
+    if (!rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(bits)) {
+        return 0;
+    }
+    ctx->built = bits == ECMULT_GEN_PREC_BITS ? 1 : bits;
+    return 1;
+}
+
+/* Returns the table selected in ctx and sets *bits to its precision. The
+ * blinding values do not depend on the table, so they stay valid when the
+ * table is changed. */
+static const rustsecp256k1zkp_v0_8_1_ge_storage* rustsecp256k1zkp_v0_8_1_ecmult_gen_context_table(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ctx, int *bits) {
+    const rustsecp256k1zkp_v0_8_1_ge_storage *table;
+#ifdef ECMULT_GEN_ALL_PREC_TABLES
+    switch (ctx->built) {
+    case 2:
+        *bits = 2;
+        return &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_2[0][0];
+    case 4:
+        *bits = 4;
+        return &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_4[0][0];
+    case 8:
+        *bits = 8;
+        return &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_8[0][0];
+    }
+#else
+    (void)ctx;
+#endif
+    *bits = ECMULT_GEN_PREC_BITS;
+    /* The default table can be replaced by one loaded with
+     * rustsecp256k1zkp_v0_8_1_ecmult_tables_load. */
+    table = rustsecp256k1zkp_v0_8_1_ecmult_tables_get()->gen;
+    return table != NULL ? table : &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[0][0];
+}
+
 /* For accelerating the computation of a*G:
  * To harden against timing attacks, use the following mechanism:
  * * Break up the multiplicand into groups of PREC_BITS bits, called n_0, n_1, n_2, ..., n_(PREC_N-1).
@@ -43,7 +88,8 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_gen_context_clear(rustsecp256k1zkp_v0
  * The prec values are stored in rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[i][n_i] = n_i * (PREC_G)^i * G + U_i.
  */
 static void rustsecp256k1zkp_v0_8_1_ecmult_gen(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ctx, rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_scalar *gn) {
-    int bits = ECMULT_GEN_PREC_BITS;
+    int bits;
+    const rustsecp256k1zkp_v0_8_1_ge_storage *table = rustsecp256k1zkp_v0_8_1_ecmult_gen_context_table(ctx, &bits);
     int g = ECMULT_GEN_PREC_G(bits);
     int n = ECMULT_GEN_PREC_N(bits);
 
@@ -70,7 +116,7 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_gen(const rustsecp256k1zkp_v0_8_1_ecm
              *    by Dag Arne Osvik, Adi Shamir, and Eran Tromer
              *    (https://www.tau.ac.il/~tromer/papers/cache.pdf)
              */
-            rustsecp256k1zkp_v0_8_1_ge_storage_cmov(&adds, &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[i][j], j == n_i);
+            rustsecp256k1zkp_v0_8_1_ge_storage_cmov(&adds, &table[i * g + j], j == n_i);
         }
         rustsecp256k1zkp_v0_8_1_ge_from_storage(&add, &adds);
         rustsecp256k1zkp_v0_8_1_gej_add_ge(r, r, &add);
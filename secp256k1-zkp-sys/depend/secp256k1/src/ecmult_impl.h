@@ -56,6 +56,39 @@
 
 #define ECMULT_MAX_POINTS_PER_BATCH 5000000
 
+/* The smallest number of points a multi-exponentiation is split into for a
+ * worker. Every part adds its own doublings and bucket sums. */
+#define ECMULT_PARALLEL_MIN_POINTS 1024
+
+/* A set of tables for multiplications with G: pre_g and pre_g_128 with their
+ * window size for the G part of ecmult, and the default table of ecmult_gen,
+ * which is NULL for its compiled-in table. checksum is the one stored in the
+ * table file, or NULL for the compiled-in set. */
+typedef struct {
+    const rustsecp256k1zkp_v0_8_1_ge_storage *pre_g;
+    const rustsecp256k1zkp_v0_8_1_ge_storage *pre_g_128;
+    int window_g;
+    const rustsecp256k1zkp_v0_8_1_ge_storage *gen;
+    const unsigned char *checksum;
+} rustsecp256k1zkp_v0_8_1_ecmult_tables;
+
+static const rustsecp256k1zkp_v0_8_1_ecmult_tables rustsecp256k1zkp_v0_8_1_ecmult_tables_builtin = {
+    rustsecp256k1zkp_v0_8_1_pre_g, rustsecp256k1zkp_v0_8_1_pre_g_128, WINDOW_G, NULL, NULL
+};
+
+/* The set in use, which rustsecp256k1zkp_v0_8_1_ecmult_tables_load replaces as a whole.
+ * Only read through rustsecp256k1zkp_v0_8_1_ecmult_tables_get, once per operation, so an
+ * operation never mixes tables of two sets. */
+static const rustsecp256k1zkp_v0_8_1_ecmult_tables *rustsecp256k1zkp_v0_8_1_ecmult_tables_current = &rustsecp256k1zkp_v0_8_1_ecmult_tables_builtin;
+
+static const rustsecp256k1zkp_v0_8_1_ecmult_tables *rustsecp256k1zkp_v0_8_1_ecmult_tables_get(void) {
+#ifdef __GNUC__
+    return __atomic_load_n(&rustsecp256k1zkp_v0_8_1_ecmult_tables_current, __ATOMIC_ACQUIRE);
+#else
+    return rustsecp256k1zkp_v0_8_1_ecmult_tables_current;
+#endif
+}
+
 /** Fill a table 'pre_a' with precomputed odd multiples of a.
  *  pre_a will contain [1*a,3*a,...,(2*n-1)*a], so it needs space for n group elements.
  *  zr needs space for n field elements.
@@ -244,6 +277,7 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_strauss_wnaf(const struct rustsecp256
     int bits = 0;
     size_t np;
     size_t no = 0;
+    const rustsecp256k1zkp_v0_8_1_ecmult_tables *tables = rustsecp256k1zkp_v0_8_1_ecmult_tables_get();
 
     rustsecp256k1zkp_v0_8_1_fe_set_int(&Z, 1);
     for (np = 0; np < num; ++np) {
@@ -303,8 +337,8 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_strauss_wnaf(const struct rustsecp256
         rustsecp256k1zkp_v0_8_1_scalar_split_128(&ng_1, &ng_128, ng);
 
         /* Build wnaf representation for ng_1 and ng_128 */
-        bits_ng_1   = rustsecp256k1zkp_v0_8_1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   WINDOW_G);
-        bits_ng_128 = rustsecp256k1zkp_v0_8_1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, WINDOW_G);
+        bits_ng_1   = rustsecp256k1zkp_v0_8_1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   tables->window_g);
+        bits_ng_128 = rustsecp256k1zkp_v0_8_1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, tables->window_g);
         if (bits_ng_1 > bits) {
             bits = bits_ng_1;
         }
@@ -329,11 +363,11 @@ static void rustsecp256k1zkp_v0_8_1_ecmult_strauss_wnaf(const struct rustsecp256
             }
         }
         if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
-            rustsecp256k1zkp_v0_8_1_ecmult_table_get_ge_storage(&tmpa, rustsecp256k1zkp_v0_8_1_pre_g, n, WINDOW_G);
+            rustsecp256k1zkp_v0_8_1_ecmult_table_get_ge_storage(&tmpa, tables->pre_g, n, tables->window_g);
             rustsecp256k1zkp_v0_8_1_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
         if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
-            rustsecp256k1zkp_v0_8_1_ecmult_table_get_ge_storage(&tmpa, rustsecp256k1zkp_v0_8_1_pre_g_128, n, WINDOW_G);
+            rustsecp256k1zkp_v0_8_1_ecmult_table_get_ge_storage(&tmpa, tables->pre_g_128, n, tables->window_g);
             rustsecp256k1zkp_v0_8_1_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
     }
@@ -813,6 +847,113 @@ static int rustsecp256k1zkp_v0_8_1_ecmult_multi_batch_size_helper(size_t *n_batc
     return 1;
 }
 
+/* Returns the scratch size with which rustsecp256k1zkp_v0_8_1_ecmult_multi_var computes a
+ * multi-exponentiation of n_points points (in addition to G) as a single
+ * batch. */
+static size_t rustsecp256k1zkp_v0_8_1_ecmult_multi_scratch_size(size_t n_points) {
+    if (n_points >= ECMULT_PIPPENGER_THRESHOLD) {
+        return rustsecp256k1zkp_v0_8_1_pippenger_scratch_size(n_points, rustsecp256k1zkp_v0_8_1_pippenger_bucket_window(n_points)) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    return rustsecp256k1zkp_v0_8_1_strauss_scratch_size(n_points) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+}
+
+/* One part of a multi-exponentiation that is split over the workers of a
+ * scratch space. Each part has a scratch space of its own, which is carved
+ * out of the caller's before the tasks are started. */
+typedef struct {
+    const rustsecp256k1zkp_v0_8_1_callback* error_callback;
+    rustsecp256k1zkp_v0_8_1_scratch *scratch;
+    const rustsecp256k1zkp_v0_8_1_scalar *inp_g_sc;
+    rustsecp256k1zkp_v0_8_1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t offset;
+    size_t n;
+    rustsecp256k1zkp_v0_8_1_gej r;
+    int ret;
+} rustsecp256k1zkp_v0_8_1_ecmult_multi_task;
+
+static int rustsecp256k1zkp_v0_8_1_ecmult_multi_task_callback(rustsecp256k1zkp_v0_8_1_scalar *sc, rustsecp256k1zkp_v0_8_1_ge *pt, size_t idx, void *data) {
+    const rustsecp256k1zkp_v0_8_1_ecmult_multi_task *task = (const rustsecp256k1zkp_v0_8_1_ecmult_multi_task *) data;
+    return task->cb(sc, pt, task->offset + idx, task->cbdata);
+}
+
+static void rustsecp256k1zkp_v0_8_1_ecmult_multi_task_run(size_t index, void *data) {
+    rustsecp256k1zkp_v0_8_1_ecmult_multi_task *task = &((rustsecp256k1zkp_v0_8_1_ecmult_multi_task *) data)[index];
+    task->ret = rustsecp256k1zkp_v0_8_1_ecmult_multi_var(task->error_callback, task->scratch, &task->r, task->inp_g_sc, rustsecp256k1zkp_v0_8_1_ecmult_multi_task_callback, (void *) task, task->n);
+}
+
+/* Splits the points into up to scratch->n_workers parts of at least
+ * ECMULT_PARALLEL_MIN_POINTS, computes the parts with scratch->run and adds
+ * up the results. Returns 0 without calling cb if this is not worthwhile or
+ * the scratch space is too small, and otherwise sets *ret to the result of
+ * the multi-exponentiation and returns 1. cb may be called from several
+ * threads at once. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_multi_parallel_var(int *ret, const rustsecp256k1zkp_v0_8_1_callback* error_callback, rustsecp256k1zkp_v0_8_1_scratch *scratch, rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_scalar *inp_g_sc, rustsecp256k1zkp_v0_8_1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    const size_t scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(error_callback, scratch);
+    rustsecp256k1zkp_v0_8_1_ecmult_multi_task *tasks;
+    size_t n_tasks, n_task_points, task_size, max_alloc;
+    size_t i;
+
+    if (scratch->run == NULL) {
+        return 0;
+    }
+    n_tasks = n / ECMULT_PARALLEL_MIN_POINTS;
+    if (n_tasks > scratch->n_workers) {
+        n_tasks = scratch->n_workers;
+    }
+    if (n_tasks < 2) {
+        return 0;
+    }
+    n_task_points = 1 + (n - 1) / n_tasks;
+
+    /* Give every part the space to run as a single batch if possible, and
+     * otherwise an equal share of what is left. */
+    task_size = rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(rustsecp256k1zkp_v0_8_1_ecmult_multi_scratch_size(n_task_points));
+    max_alloc = rustsecp256k1zkp_v0_8_1_scratch_max_allocation(error_callback, scratch, n_tasks + 1);
+    if (max_alloc < n_tasks * sizeof(*tasks)) {
+        return 0;
+    }
+    max_alloc = (max_alloc - n_tasks * sizeof(*tasks)) / n_tasks;
+    if (task_size > max_alloc) {
+        task_size = max_alloc;
+    }
+    if (task_size < rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(rustsecp256k1zkp_v0_8_1_ecmult_multi_scratch_size(ECMULT_PIPPENGER_THRESHOLD))) {
+        return 0;
+    }
+
+    tasks = (rustsecp256k1zkp_v0_8_1_ecmult_multi_task *) rustsecp256k1zkp_v0_8_1_scratch_alloc(error_callback, scratch, n_tasks * sizeof(*tasks));
+    if (tasks == NULL) {
+        return 0;
+    }
+    for (i = 0; i < n_tasks; i++) {
+        void *prealloc = rustsecp256k1zkp_v0_8_1_scratch_alloc(error_callback, scratch, task_size);
+        if (prealloc == NULL) {
+            rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+            return 0;
+        }
+        tasks[i].error_callback = error_callback;
+        tasks[i].scratch = rustsecp256k1zkp_v0_8_1_scratch_init(prealloc, task_size - rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(0), 0, NULL, NULL);
+        tasks[i].inp_g_sc = i == 0 ? inp_g_sc : NULL;
+        tasks[i].cb = cb;
+        tasks[i].cbdata = cbdata;
+        tasks[i].offset = i * n_task_points;
+        tasks[i].n = i + 1 < n_tasks ? n_task_points : n - i * n_task_points;
+        rustsecp256k1zkp_v0_8_1_gej_set_infinity(&tasks[i].r);
+        tasks[i].ret = 0;
+    }
+
+    scratch->run(rustsecp256k1zkp_v0_8_1_ecmult_multi_task_run, (void *) tasks, n_tasks, scratch->run_data);
+
+    *ret = 1;
+    rustsecp256k1zkp_v0_8_1_gej_set_infinity(r);
+    for (i = 0; i < n_tasks; i++) {
+        *ret &= tasks[i].ret;
+        rustsecp256k1zkp_v0_8_1_gej_add_var(r, r, &tasks[i].r, NULL);
+    }
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+    return 1;
+}
+
 typedef int (*rustsecp256k1zkp_v0_8_1_ecmult_multi_func)(const rustsecp256k1zkp_v0_8_1_callback* error_callback, rustsecp256k1zkp_v0_8_1_scratch*, rustsecp256k1zkp_v0_8_1_gej*, const rustsecp256k1zkp_v0_8_1_scalar*, rustsecp256k1zkp_v0_8_1_ecmult_multi_callback cb, void*, size_t);
 static int rustsecp256k1zkp_v0_8_1_ecmult_multi_var(const rustsecp256k1zkp_v0_8_1_callback* error_callback, rustsecp256k1zkp_v0_8_1_scratch *scratch, rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_scalar *inp_g_sc, rustsecp256k1zkp_v0_8_1_ecmult_multi_callback cb, void *cbdata, size_t n) {
     size_t i;
@@ -820,6 +961,7 @@ static int rustsecp256k1zkp_v0_8_1_ecmult_multi_var(const rustsecp256k1zkp_v0_8_
     int (*f)(const rustsecp256k1zkp_v0_8_1_callback* error_callback, rustsecp256k1zkp_v0_8_1_scratch*, rustsecp256k1zkp_v0_8_1_gej*, const rustsecp256k1zkp_v0_8_1_scalar*, rustsecp256k1zkp_v0_8_1_ecmult_multi_callback cb, void*, size_t, size_t);
     size_t n_batches;
     size_t n_batch_points;
+    int ret;
 
     rustsecp256k1zkp_v0_8_1_gej_set_infinity(r);
     if (inp_g_sc == NULL && n == 0) {
@@ -831,6 +973,9 @@ static int rustsecp256k1zkp_v0_8_1_ecmult_multi_var(const rustsecp256k1zkp_v0_8_
     if (scratch == NULL) {
         return rustsecp256k1zkp_v0_8_1_ecmult_multi_simple_var(r, inp_g_sc, cb, cbdata, n);
     }
+    if (rustsecp256k1zkp_v0_8_1_ecmult_multi_parallel_var(&ret, error_callback, scratch, r, inp_g_sc, cb, cbdata, n)) {
+        return ret;
+    }
 
     /* Compute the batch sizes for Pippenger's algorithm given a scratch space. If it's greater than
      * a threshold use Pippenger's algorithm. Otherwise use Strauss' algorithm.
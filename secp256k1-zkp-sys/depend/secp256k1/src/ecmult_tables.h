@@ -0,0 +1,44 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_ECMULT_TABLES_H
+#define SECP256K1_ECMULT_TABLES_H
+
+#include "group.h"
+#include "ecmult.h"
+#include "ecmult_gen.h"
+
+/* Layout of a file with precomputed tables, as written by precompute_ecmult
+ * and loaded with rustsecp256k1zkp_v0_8_1_ecmult_tables_load:
+ *
+ *   offset  size  contents
+ *        0     8  magic "SECPTBL\0"
+ *        8     4  format version, ECMULT_TABLES_VERSION
+ *       12     4  window size of the ecmult tables
+ *       16     4  precision in bits of the ecmult_gen table
+ *       20    12  zero
+ *       32    32  SHA256 of everything after the header
+ *       64        pre_g with ECMULT_TABLE_SIZE(window) entries
+ *                 pre_g_128 with ECMULT_TABLE_SIZE(window) entries
+ *                 the ecmult_gen table with ECMULT_GEN_PREC_N(bits) rows of
+ *                 ECMULT_GEN_PREC_G(bits) entries
+ *
+ * The integers are in the byte order of the machine and the tables are
+ * arrays of rustsecp256k1zkp_v0_8_1_ge_storage as laid out in memory, so that the tables can
+ * be used directly from a mapping of the file. A file can therefore only be
+ * loaded on machines with the same byte order and field implementation as the
+ * one that wrote it. */
+
+#define ECMULT_TABLES_VERSION 1
+#define ECMULT_TABLES_HEADER_SIZE 64
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_ecmult_tables_magic[8] = "SECPTBL";
+
+/** The number of bytes following the header in a file with the given window
+ *  size and ecmult_gen precision. */
+#define ECMULT_TABLES_SIZE(window, bits) \
+    ((2 * (size_t)ECMULT_TABLE_SIZE(window) + (size_t)ECMULT_GEN_PREC_N(bits) * ECMULT_GEN_PREC_G(bits)) * sizeof(rustsecp256k1zkp_v0_8_1_ge_storage))
+
+#endif /* SECP256K1_ECMULT_TABLES_H */
@@ -0,0 +1,168 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_FIELD_5X52_IFMA_IMPL_H
+#define SECP256K1_FIELD_5X52_IFMA_IMPL_H
+
+/* Multiplication of eight independent field elements at once, one per 64-bit
+ * lane of an AVX-512 vector, using the 52-bit multiply-add instructions of
+ * AVX-512 IFMA. These match the 5x52 representation, so elements are only
+ * transposed, not converted. The backend defines SECP256K1_FE_X8 and provides
+ *
+ *   static int rustsecp256k1zkp_v0_8_1_fe_x8_detect(void);
+ *   static void rustsecp256k1zkp_v0_8_1_fe_x8_set(rustsecp256k1zkp_v0_8_1_fe_x8 *r, int lane, const rustsecp256k1zkp_v0_8_1_fe *a);
+ *   static void rustsecp256k1zkp_v0_8_1_fe_x8_get(rustsecp256k1zkp_v0_8_1_fe *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a, int lane);
+ *   static void rustsecp256k1zkp_v0_8_1_fe_x8_mul(rustsecp256k1zkp_v0_8_1_fe_x8 *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a, const rustsecp256k1zkp_v0_8_1_fe_x8 *b);
+ *   static void rustsecp256k1zkp_v0_8_1_fe_x8_sqr(rustsecp256k1zkp_v0_8_1_fe_x8 *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a);
+ *
+ * where mul and sqr must only be called if detect returned 1. Inputs may have
+ * a magnitude of up to 8, and all outputs have magnitude 1. The kernel is
+ * compiled through a function target attribute, so the rest of the library
+ * does not need to be built for a CPU with these instructions. */
+
+#if defined(USE_FIELD_IFMA) && defined(__x86_64__) && \
+    (SECP256K1_GNUC_PREREQ(8, 0) || (defined(__clang__) && __clang_major__ >= 8))
+#define SECP256K1_FE_X8
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+/* Limb k of lane l is n[k][l]. */
+typedef struct {
+    uint64_t n[5][8];
+} rustsecp256k1zkp_v0_8_1_fe_x8;
+
+static int rustsecp256k1zkp_v0_8_1_fe_x8_detect(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+    __cpuid(1, eax, ebx, ecx, edx);
+    /* OSXSAVE */
+    if (!((ecx >> 27) & 1)) {
+        return 0;
+    }
+    /* The OS must save the XMM, YMM, opmask and ZMM registers. */
+    __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    if ((eax & 0xE6) != 0xE6) {
+        return 0;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    /* AVX512F and AVX512IFMA */
+    return ((ebx >> 16) & 1) && ((ebx >> 21) & 1);
+}
+
+static void rustsecp256k1zkp_v0_8_1_fe_x8_set(rustsecp256k1zkp_v0_8_1_fe_x8 *r, int lane, const rustsecp256k1zkp_v0_8_1_fe *a) {
+    int k;
+#ifdef VERIFY
+    rustsecp256k1zkp_v0_8_1_fe_verify(a);
+    VERIFY_CHECK(a->magnitude <= 8);
+#endif
+    for (k = 0; k < 5; k++) {
+        r->n[k][lane] = a->n[k];
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_fe_x8_get(rustsecp256k1zkp_v0_8_1_fe *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a, int lane) {
+    int k;
+    for (k = 0; k < 5; k++) {
+        r->n[k] = a->n[k][lane];
+    }
+#ifdef VERIFY
+    r->magnitude = 1;
+    r->normalized = 0;
+    rustsecp256k1zkp_v0_8_1_fe_verify(r);
+#endif
+}
+
+/* Loads a and propagates the carries, so that every limb fits in the 52 bits
+ * the multiplier reads. A magnitude of up to 8 leaves limbs below 2^57, and a
+ * carry out of the top limb is folded back using 2^256 = 0x1000003D1 (mod p). */
+__attribute__((target("avx512f,avx512ifma")))
+SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_fe_x8_load(__m512i *t, const rustsecp256k1zkp_v0_8_1_fe_x8 *a) {
+    const __m512i m52 = _mm512_set1_epi64(0xFFFFFFFFFFFFFULL);
+    const __m512i m48 = _mm512_set1_epi64(0x0FFFFFFFFFFFFULL);
+    const __m512i r256 = _mm512_set1_epi64(0x1000003D1ULL);
+    int k, pass;
+
+    for (k = 0; k < 5; k++) {
+        t[k] = _mm512_loadu_si512((const void *)a->n[k]);
+    }
+    for (pass = 0; pass < 2; pass++) {
+        for (k = 0; k < 4; k++) {
+            t[k + 1] = _mm512_add_epi64(t[k + 1], _mm512_srli_epi64(t[k], 52));
+            t[k] = _mm512_and_si512(t[k], m52);
+        }
+        t[0] = _mm512_madd52lo_epu64(t[0], _mm512_srli_epi64(t[4], 48), r256);
+        t[4] = _mm512_and_si512(t[4], m48);
+    }
+    /* The fold of the second pass can push t[0] just past 2^52. */
+    for (k = 0; k < 4; k++) {
+        t[k + 1] = _mm512_add_epi64(t[k + 1], _mm512_srli_epi64(t[k], 52));
+        t[k] = _mm512_and_si512(t[k], m52);
+    }
+}
+
+__attribute__((target("avx512f,avx512ifma")))
+static void rustsecp256k1zkp_v0_8_1_fe_x8_mul(rustsecp256k1zkp_v0_8_1_fe_x8 *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a, const rustsecp256k1zkp_v0_8_1_fe_x8 *b) {
+    const __m512i m52 = _mm512_set1_epi64(0xFFFFFFFFFFFFFULL);
+    const __m512i m48 = _mm512_set1_epi64(0x0FFFFFFFFFFFFULL);
+    const __m512i r256 = _mm512_set1_epi64(0x1000003D1ULL);
+    /* 2^260 = 0x1000003D10 (mod p) */
+    const __m512i r260 = _mm512_set1_epi64(0x1000003D10ULL);
+    __m512i x[5], y[5], c[10];
+    int i, j, k;
+
+    rustsecp256k1zkp_v0_8_1_fe_x8_load(x, a);
+    rustsecp256k1zkp_v0_8_1_fe_x8_load(y, b);
+
+    /* Schoolbook product. The low 52 bits of x[i]*y[j] go to column i+j and
+     * the high bits to column i+j+1; every column stays below 10 * 2^52. */
+    for (k = 0; k < 10; k++) {
+        c[k] = _mm512_setzero_si512();
+    }
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < 5; j++) {
+            c[i + j] = _mm512_madd52lo_epu64(c[i + j], x[i], y[j]);
+            c[i + j + 1] = _mm512_madd52hi_epu64(c[i + j + 1], x[i], y[j]);
+        }
+    }
+    for (k = 0; k < 9; k++) {
+        c[k + 1] = _mm512_add_epi64(c[k + 1], _mm512_srli_epi64(c[k], 52));
+        c[k] = _mm512_and_si512(c[k], m52);
+    }
+
+    /* Reduce the columns at 2^260 and above. The product of c[9] < 2^45 and
+     * r260 leaves less than 2^30 at 2^260, which is folded once more. */
+    for (k = 0; k < 5; k++) {
+        c[k] = _mm512_madd52lo_epu64(c[k], c[k + 5], r260);
+        c[k + 1] = _mm512_madd52hi_epu64(k < 4 ? c[k + 1] : _mm512_setzero_si512(), c[k + 5], r260);
+    }
+    c[0] = _mm512_madd52lo_epu64(c[0], c[5], r260);
+    c[1] = _mm512_madd52hi_epu64(c[1], c[5], r260);
+
+    /* Back to 52-bit limbs with a 48-bit top limb, for magnitude 1. */
+    for (k = 0; k < 4; k++) {
+        c[k + 1] = _mm512_add_epi64(c[k + 1], _mm512_srli_epi64(c[k], 52));
+        c[k] = _mm512_and_si512(c[k], m52);
+    }
+    c[0] = _mm512_madd52lo_epu64(c[0], _mm512_srli_epi64(c[4], 48), r256);
+    c[4] = _mm512_and_si512(c[4], m48);
+    c[1] = _mm512_add_epi64(c[1], _mm512_srli_epi64(c[0], 52));
+    c[0] = _mm512_and_si512(c[0], m52);
+
+    for (k = 0; k < 5; k++) {
+        _mm512_storeu_si512((void *)r->n[k], c[k]);
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_fe_x8_sqr(rustsecp256k1zkp_v0_8_1_fe_x8 *r, const rustsecp256k1zkp_v0_8_1_fe_x8 *a) {
+    rustsecp256k1zkp_v0_8_1_fe_x8_mul(r, a, a);
+}
+
+#endif
+
+#endif /* SECP256K1_FIELD_5X52_IFMA_IMPL_H */
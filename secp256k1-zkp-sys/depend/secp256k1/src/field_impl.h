@@ -427,4 +427,8 @@ SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_fe_half(rustsecp256k1zkp_v0
 
 #endif /* defined(VERIFY) */
 
+#if defined(SECP256K1_WIDEMUL_INT128)
+#include "field_5x52_ifma_impl.h"
+#endif
+
 #endif /* SECP256K1_FIELD_IMPL_H */
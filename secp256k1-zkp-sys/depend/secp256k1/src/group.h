@@ -78,6 +78,11 @@ static void rustsecp256k1zkp_v0_8_1_ge_set_gej(rustsecp256k1zkp_v0_8_1_ge *r, ru
 /** Set a group element equal to another which is given in jacobian coordinates. */
 static void rustsecp256k1zkp_v0_8_1_ge_set_gej_var(rustsecp256k1zkp_v0_8_1_ge *r, rustsecp256k1zkp_v0_8_1_gej *a);
 
+/** Set a batch of group elements equal to the inputs given in jacobian coordinates, using a
+ *  single field inversion. Constant time in the values of the inputs (but not in len); infinity
+ *  inputs result in infinity outputs. */
+static void rustsecp256k1zkp_v0_8_1_ge_set_all_gej(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_gej *a, size_t len);
+
 /** Set a batch of group elements equal to the inputs given in jacobian coordinates */
 static void rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_gej *a, size_t len);
 
@@ -177,6 +177,78 @@ static void rustsecp256k1zkp_v0_8_1_ge_set_gej_var(rustsecp256k1zkp_v0_8_1_ge *r
     rustsecp256k1zkp_v0_8_1_ge_verify(r);
 }
 
+static void rustsecp256k1zkp_v0_8_1_ge_set_all_gej(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_gej *a, size_t len) {
+    rustsecp256k1zkp_v0_8_1_fe u, z, zi2, zi3;
+    size_t i;
+
+    if (len == 0) {
+        return;
+    }
+
+    /* Use destination's x coordinates as scratch space for the running
+     * products of z. Infinities contribute a factor of one so that they do
+     * not zero out the product. */
+    for (i = 0; i < len; i++) {
+        rustsecp256k1zkp_v0_8_1_gej_verify(&a[i]);
+        z = a[i].z;
+        rustsecp256k1zkp_v0_8_1_fe_cmov(&z, &rustsecp256k1zkp_v0_8_1_fe_one, a[i].infinity);
+        if (i == 0) {
+            r[i].x = z;
+        } else {
+            rustsecp256k1zkp_v0_8_1_fe_mul(&r[i].x, &r[i - 1].x, &z);
+        }
+    }
+    rustsecp256k1zkp_v0_8_1_fe_inv(&u, &r[len - 1].x);
+
+    for (i = len - 1; i > 0; i--) {
+        z = a[i].z;
+        rustsecp256k1zkp_v0_8_1_fe_cmov(&z, &rustsecp256k1zkp_v0_8_1_fe_one, a[i].infinity);
+        rustsecp256k1zkp_v0_8_1_fe_mul(&r[i].x, &r[i - 1].x, &u);
+        rustsecp256k1zkp_v0_8_1_fe_mul(&u, &u, &z);
+    }
+    r[0].x = u;
+
+    for (i = 0; i < len; i++) {
+        rustsecp256k1zkp_v0_8_1_fe_sqr(&zi2, &r[i].x);
+        rustsecp256k1zkp_v0_8_1_fe_mul(&zi3, &zi2, &r[i].x);
+        rustsecp256k1zkp_v0_8_1_fe_mul(&r[i].x, &a[i].x, &zi2);
+        rustsecp256k1zkp_v0_8_1_fe_mul(&r[i].y, &a[i].y, &zi3);
+        r[i].infinity = a[i].infinity;
+        rustsecp256k1zkp_v0_8_1_ge_verify(&r[i]);
+    }
+}
+
+#ifdef SECP256K1_FE_X8
+/* Whether the eight-lane field multiplication is used, or -1 if not detected
+ * yet. Only accessed through rustsecp256k1zkp_v0_8_1_once_int, so the detection runs once
+ * even if the first batches are converted by several threads. */
+static int rustsecp256k1zkp_v0_8_1_fe_x8_enabled = -1;
+
+/* Like rustsecp256k1zkp_v0_8_1_ge_set_gej_zinv for the eight points a[idx[l]], with the
+ * inverses of their z coordinates in r[idx[l]].x. */
+static void rustsecp256k1zkp_v0_8_1_ge_set_gej_zinv_x8(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_gej *a, const size_t *idx) {
+    rustsecp256k1zkp_v0_8_1_fe_x8 zi, zi2, zi3, x, y;
+    int l;
+
+    for (l = 0; l < 8; l++) {
+        rustsecp256k1zkp_v0_8_1_gej_verify(&a[idx[l]]);
+        VERIFY_CHECK(!a[idx[l]].infinity);
+        rustsecp256k1zkp_v0_8_1_fe_x8_set(&zi, l, &r[idx[l]].x);
+        rustsecp256k1zkp_v0_8_1_fe_x8_set(&x, l, &a[idx[l]].x);
+        rustsecp256k1zkp_v0_8_1_fe_x8_set(&y, l, &a[idx[l]].y);
+    }
+    rustsecp256k1zkp_v0_8_1_fe_x8_sqr(&zi2, &zi);
+    rustsecp256k1zkp_v0_8_1_fe_x8_mul(&zi3, &zi2, &zi);
+    rustsecp256k1zkp_v0_8_1_fe_x8_mul(&x, &x, &zi2);
+    rustsecp256k1zkp_v0_8_1_fe_x8_mul(&y, &y, &zi3);
+    for (l = 0; l < 8; l++) {
+        rustsecp256k1zkp_v0_8_1_fe_x8_get(&r[idx[l]].x, &x, l);
+        rustsecp256k1zkp_v0_8_1_fe_x8_get(&r[idx[l]].y, &y, l);
+        r[idx[l]].infinity = 0;
+    }
+}
+#endif
+
 static void rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_gej *a, size_t len) {
     rustsecp256k1zkp_v0_8_1_fe u;
     size_t i;
@@ -213,7 +285,27 @@ static void rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(rustsecp256k1zkp_v0_8_1_g
     VERIFY_CHECK(!a[last_i].infinity);
     r[last_i].x = u;
 
-    for (i = 0; i < len; i++) {
+    i = 0;
+#ifdef SECP256K1_FE_X8
+    if (rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_fe_x8_enabled, rustsecp256k1zkp_v0_8_1_fe_x8_detect)) {
+        /* Convert the points in groups of eight and leave the rest to the loop below. */
+        size_t idx[8];
+        size_t j, n = 0;
+        for (j = 0; j < len; j++) {
+            if (!a[j].infinity) {
+                idx[n++] = j;
+                if (n == 8) {
+                    rustsecp256k1zkp_v0_8_1_ge_set_gej_zinv_x8(r, a, idx);
+                    n = 0;
+                    for (; i <= j; i++) {
+                        rustsecp256k1zkp_v0_8_1_ge_verify(&r[i]);
+                    }
+                }
+            }
+        }
+    }
+#endif
+    for (; i < len; i++) {
         if (!a[i].infinity) {
             rustsecp256k1zkp_v0_8_1_ge_set_gej_zinv(&r[i], &a[i], &r[i].x);
         }
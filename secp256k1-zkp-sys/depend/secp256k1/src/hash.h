@@ -20,6 +20,34 @@ static void rustsecp256k1zkp_v0_8_1_sha256_initialize(rustsecp256k1zkp_v0_8_1_sh
 static void rustsecp256k1zkp_v0_8_1_sha256_write(rustsecp256k1zkp_v0_8_1_sha256 *hash, const unsigned char *data, size_t size);
 static void rustsecp256k1zkp_v0_8_1_sha256_finalize(rustsecp256k1zkp_v0_8_1_sha256 *hash, unsigned char *out32);
 
+/* The _multi functions process n hashes in lockstep, which must all have been
+ * written the same number of bytes. They use a transform that hashes several
+ * blocks at once if the CPU supports it. The data of hash i starts at
+ * data + i*stride, so a stride of 0 writes the same data to all hashes, and
+ * the outputs are stored consecutively in out32. If the CPU has the SHA
+ * extensions used by rustsecp256k1zkp_v0_8_1_sha256_write, the hashes are processed one at a
+ * time with them instead, as they are faster per block than the vector code
+ * even with all lanes in use. */
+static void rustsecp256k1zkp_v0_8_1_sha256_write_multi(rustsecp256k1zkp_v0_8_1_sha256 *hashes, size_t n, const unsigned char *data, size_t stride, size_t len);
+static void rustsecp256k1zkp_v0_8_1_sha256_finalize_multi(rustsecp256k1zkp_v0_8_1_sha256 *hashes, size_t n, unsigned char *out32);
+
+/* The state of SHA256 after processing SHA256(tag)||SHA256(tag), for the tags
+ * listed in precomputed_tagged_hash.h. */
+typedef struct {
+    const char *tag;
+    size_t taglen;
+    uint32_t s[8];
+} rustsecp256k1zkp_v0_8_1_sha256_tag_midstate;
+
+/* Initializes a sha256 struct as a tagged hash for the tag with index tag,
+ * one of the SECP256K1_TAG_ constants. */
+static void rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(rustsecp256k1zkp_v0_8_1_sha256 *hash, size_t tag);
+
+/* Initializes a sha256 struct as a tagged hash for an arbitrary tag, using
+ * the precomputed midstate if the tag is one of the library's own. Runs in
+ * time variable in the tag. */
+static void rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(rustsecp256k1zkp_v0_8_1_sha256 *hash, const unsigned char *tag, size_t taglen);
+
 typedef struct {
     rustsecp256k1zkp_v0_8_1_sha256 inner, outer;
 } rustsecp256k1zkp_v0_8_1_hmac_sha256;
@@ -0,0 +1,218 @@
+/**********************************************************************
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_HASH_HW_IMPL_H
+#define SECP256K1_HASH_HW_IMPL_H
+
+/* Hardware accelerated SHA-256 transforms, using the x86 SHA extensions or
+ * the ARMv8 cryptography extensions. Each backend defines SECP256K1_SHA256_HW
+ * and provides
+ *
+ *   static int rustsecp256k1zkp_v0_8_1_sha256_hw_detect(void);
+ *   static void rustsecp256k1zkp_v0_8_1_sha256_transform_hw(uint32_t *s, const unsigned char *buf);
+ *
+ * where the transform must only be called if detect returned 1. The backends
+ * are compiled through function target attributes, so the rest of the library
+ * does not need to be built for a CPU with these instructions. */
+
+#include <stdint.h>
+
+#if defined(USE_SHA256_HW) && (defined(__x86_64__) || defined(__i386__)) && \
+    (SECP256K1_GNUC_PREREQ(5, 0) || (defined(__clang__) && __clang_major__ >= 8))
+#  define SECP256K1_SHA256_HW_X86
+#elif defined(USE_SHA256_HW) && defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+/* The compiler targets a CPU with the extensions, no detection needed. */
+#  define SECP256K1_SHA256_HW_ARM
+#elif defined(USE_SHA256_HW) && defined(__aarch64__) && defined(__linux__) && \
+    !defined(__clang__) && SECP256K1_GNUC_PREREQ(6, 0)
+#  define SECP256K1_SHA256_HW_ARM
+#  define SECP256K1_SHA256_HW_ARM_HWCAP
+#endif
+
+#if defined(SECP256K1_SHA256_HW_X86) || defined(SECP256K1_SHA256_HW_ARM)
+#define SECP256K1_SHA256_HW
+
+static const uint32_t rustsecp256k1zkp_v0_8_1_sha256_hw_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#if defined(SECP256K1_SHA256_HW_X86)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+static int rustsecp256k1zkp_v0_8_1_sha256_hw_detect(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+    __cpuid(1, eax, ebx, ecx, edx);
+    /* SSSE3 and SSE4.1 */
+    if (!((ecx >> 9) & 1) || !((ecx >> 19) & 1)) {
+        return 0;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    /* SHA */
+    return (ebx >> 29) & 1;
+}
+
+/* Four rounds with message words m. The state is kept as s0 = ABEF and
+ * s1 = CDGH, the layout expected by sha256rnds2. */
+#define SHA256_X86_QUAD_ROUND(s0, s1, m, i) do { \
+    __m128i msg_ = _mm_add_epi32((m), _mm_loadu_si128((const __m128i *)(const void *)&rustsecp256k1zkp_v0_8_1_sha256_hw_k[4 * (i)])); \
+    (s1) = _mm_sha256rnds2_epu32((s1), (s0), msg_); \
+    (s0) = _mm_sha256rnds2_epu32((s0), (s1), _mm_shuffle_epi32(msg_, 0x0e)); \
+} while(0)
+
+/* Message schedule: m0 = msg1(m0, m1) starts the computation of the words
+ * four rounds after m0, and msg2 finishes it, yielding m2 from m0, m1 and the
+ * words before. */
+#define SHA256_X86_MSG1(m0, m1) ((m0) = _mm_sha256msg1_epu32((m0), (m1)))
+#define SHA256_X86_MSG2(m0, m1, m2) ((m2) = _mm_sha256msg2_epu32(_mm_add_epi32((m2), _mm_alignr_epi8((m1), (m0), 4)), (m1)))
+
+__attribute__((target("sha,sse4.1")))
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_hw(uint32_t *s, const unsigned char *buf) {
+    const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m128i s0, s1, t0, t1, so0, so1;
+    __m128i m0, m1, m2, m3;
+
+    /* Convert ABCD/EFGH to ABEF/CDGH. */
+    t0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(const void *)&s[0]), 0xb1);
+    t1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(const void *)&s[4]), 0x1b);
+    s0 = _mm_alignr_epi8(t0, t1, 8);
+    s1 = _mm_blend_epi16(t1, t0, 0xf0);
+    so0 = s0;
+    so1 = s1;
+
+    m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[0]), mask);
+    SHA256_X86_QUAD_ROUND(s0, s1, m0, 0);
+    m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[16]), mask);
+    SHA256_X86_QUAD_ROUND(s0, s1, m1, 1);
+    SHA256_X86_MSG1(m0, m1);
+    m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[32]), mask);
+    SHA256_X86_QUAD_ROUND(s0, s1, m2, 2);
+    SHA256_X86_MSG1(m1, m2);
+    m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[48]), mask);
+    SHA256_X86_QUAD_ROUND(s0, s1, m3, 3);
+    SHA256_X86_MSG2(m2, m3, m0); SHA256_X86_MSG1(m2, m3);
+    SHA256_X86_QUAD_ROUND(s0, s1, m0, 4);
+    SHA256_X86_MSG2(m3, m0, m1); SHA256_X86_MSG1(m3, m0);
+    SHA256_X86_QUAD_ROUND(s0, s1, m1, 5);
+    SHA256_X86_MSG2(m0, m1, m2); SHA256_X86_MSG1(m0, m1);
+    SHA256_X86_QUAD_ROUND(s0, s1, m2, 6);
+    SHA256_X86_MSG2(m1, m2, m3); SHA256_X86_MSG1(m1, m2);
+    SHA256_X86_QUAD_ROUND(s0, s1, m3, 7);
+    SHA256_X86_MSG2(m2, m3, m0); SHA256_X86_MSG1(m2, m3);
+    SHA256_X86_QUAD_ROUND(s0, s1, m0, 8);
+    SHA256_X86_MSG2(m3, m0, m1); SHA256_X86_MSG1(m3, m0);
+    SHA256_X86_QUAD_ROUND(s0, s1, m1, 9);
+    SHA256_X86_MSG2(m0, m1, m2); SHA256_X86_MSG1(m0, m1);
+    SHA256_X86_QUAD_ROUND(s0, s1, m2, 10);
+    SHA256_X86_MSG2(m1, m2, m3); SHA256_X86_MSG1(m1, m2);
+    SHA256_X86_QUAD_ROUND(s0, s1, m3, 11);
+    SHA256_X86_MSG2(m2, m3, m0); SHA256_X86_MSG1(m2, m3);
+    SHA256_X86_QUAD_ROUND(s0, s1, m0, 12);
+    SHA256_X86_MSG2(m3, m0, m1); SHA256_X86_MSG1(m3, m0);
+    SHA256_X86_QUAD_ROUND(s0, s1, m1, 13);
+    SHA256_X86_MSG2(m0, m1, m2);
+    SHA256_X86_QUAD_ROUND(s0, s1, m2, 14);
+    SHA256_X86_MSG2(m1, m2, m3);
+    SHA256_X86_QUAD_ROUND(s0, s1, m3, 15);
+
+    s0 = _mm_add_epi32(s0, so0);
+    s1 = _mm_add_epi32(s1, so1);
+
+    /* Convert ABEF/CDGH back to ABCD/EFGH. */
+    t0 = _mm_shuffle_epi32(s0, 0x1b);
+    t1 = _mm_shuffle_epi32(s1, 0xb1);
+    _mm_storeu_si128((__m128i *)(void *)&s[0], _mm_blend_epi16(t0, t1, 0xf0));
+    _mm_storeu_si128((__m128i *)(void *)&s[4], _mm_alignr_epi8(t1, t0, 8));
+}
+
+#undef SHA256_X86_MSG2
+#undef SHA256_X86_MSG1
+#undef SHA256_X86_QUAD_ROUND
+
+#elif defined(SECP256K1_SHA256_HW_ARM)
+
+#include <arm_neon.h>
+#ifdef SECP256K1_SHA256_HW_ARM_HWCAP
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#define SECP256K1_SHA256_HW_TARGET __attribute__((target("+crypto")))
+#else
+#define SECP256K1_SHA256_HW_TARGET
+#endif
+
+static int rustsecp256k1zkp_v0_8_1_sha256_hw_detect(void) {
+#ifdef SECP256K1_SHA256_HW_ARM_HWCAP
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return 1;
+#endif
+}
+
+/* Four rounds with message words m. */
+#define SHA256_ARM_QUAD_ROUND(s0, s1, m, i) do { \
+    uint32x4_t msg_ = vaddq_u32((m), vld1q_u32(&rustsecp256k1zkp_v0_8_1_sha256_hw_k[4 * (i)])); \
+    uint32x4_t abcd_ = (s0); \
+    (s0) = vsha256hq_u32((s0), (s1), msg_); \
+    (s1) = vsha256h2q_u32((s1), abcd_, msg_); \
+} while(0)
+
+/* Replaces m0 by the message words sixteen rounds later. */
+#define SHA256_ARM_SCHEDULE(m0, m1, m2, m3) ((m0) = vsha256su1q_u32(vsha256su0q_u32((m0), (m1)), (m2), (m3)))
+
+SECP256K1_SHA256_HW_TARGET
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_hw(uint32_t *s, const unsigned char *buf) {
+    uint32x4_t s0 = vld1q_u32(&s[0]);
+    uint32x4_t s1 = vld1q_u32(&s[4]);
+    uint32x4_t so0 = s0;
+    uint32x4_t so1 = s1;
+    uint32x4_t m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&buf[0])));
+    uint32x4_t m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&buf[16])));
+    uint32x4_t m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&buf[32])));
+    uint32x4_t m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&buf[48])));
+
+    SHA256_ARM_QUAD_ROUND(s0, s1, m0, 0); SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m1, 1); SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m2, 2); SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m3, 3); SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m0, 4); SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m1, 5); SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m2, 6); SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m3, 7); SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m0, 8); SHA256_ARM_SCHEDULE(m0, m1, m2, m3);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m1, 9); SHA256_ARM_SCHEDULE(m1, m2, m3, m0);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m2, 10); SHA256_ARM_SCHEDULE(m2, m3, m0, m1);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m3, 11); SHA256_ARM_SCHEDULE(m3, m0, m1, m2);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m0, 12);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m1, 13);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m2, 14);
+    SHA256_ARM_QUAD_ROUND(s0, s1, m3, 15);
+
+    vst1q_u32(&s[0], vaddq_u32(s0, so0));
+    vst1q_u32(&s[4], vaddq_u32(s1, so1));
+}
+
+#undef SHA256_ARM_SCHEDULE
+#undef SHA256_ARM_QUAD_ROUND
+#undef SECP256K1_SHA256_HW_TARGET
+
+#endif
+
+#endif /* SECP256K1_HASH_HW_IMPL_H */
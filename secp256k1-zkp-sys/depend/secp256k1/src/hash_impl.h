@@ -9,6 +9,7 @@
 
 #include "hash.h"
 #include "util.h"
+#include "hash_hw_impl.h"
 
 #include <stdlib.h>
 #include <stdint.h>
@@ -41,7 +42,7 @@ static void rustsecp256k1zkp_v0_8_1_sha256_initialize(rustsecp256k1zkp_v0_8_1_sh
 }
 
 /** Perform one SHA-256 transformation, processing 16 big endian 32-bit words. */
-static void rustsecp256k1zkp_v0_8_1_sha256_transform(uint32_t* s, const unsigned char* buf) {
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_portable(uint32_t* s, const unsigned char* buf) {
     uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
     uint32_t w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
 
@@ -123,6 +124,127 @@ static void rustsecp256k1zkp_v0_8_1_sha256_transform(uint32_t* s, const unsigned
     s[7] += h;
 }
 
+#ifdef SECP256K1_SHA256_HW
+/* Whether the hardware transform is used, or -1 if not detected yet. Only
+ * accessed through rustsecp256k1zkp_v0_8_1_once_int, so the detection runs once even if
+ * the first hashes are computed by several threads. Single-threaded tests may
+ * set it to 0 to force the portable code. */
+static int rustsecp256k1zkp_v0_8_1_sha256_hw_enabled = -1;
+#endif
+
+static void rustsecp256k1zkp_v0_8_1_sha256_transform(uint32_t* s, const unsigned char* buf) {
+#ifdef SECP256K1_SHA256_HW
+    if (rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_hw_enabled, rustsecp256k1zkp_v0_8_1_sha256_hw_detect)) {
+        rustsecp256k1zkp_v0_8_1_sha256_transform_hw(s, buf);
+        return;
+    }
+#endif
+    rustsecp256k1zkp_v0_8_1_sha256_transform_portable(s, buf);
+}
+
+/* A transform that processes SECP256K1_SHA256_LANES independent hashes at once,
+ * one per lane of a vector of 32-bit words. It is written with the GCC vector
+ * extension, so it compiles to SSE2 or NEON instructions by default, and to
+ * AVX2 in a copy built with the corresponding target attribute. */
+#if defined(USE_SHA256_HW) && (defined(__x86_64__) || defined(__aarch64__)) && \
+    (SECP256K1_GNUC_PREREQ(5, 0) || (defined(__clang__) && __clang_major__ >= 8))
+#define SECP256K1_SHA256_LANES 8
+
+typedef uint32_t rustsecp256k1zkp_v0_8_1_sha256_vec __attribute__((vector_size(4 * SECP256K1_SHA256_LANES)));
+
+#define SPLAT(k) {k, k, k, k, k, k, k, k}
+static const rustsecp256k1zkp_v0_8_1_sha256_vec rustsecp256k1zkp_v0_8_1_sha256_lanes_k[64] = {
+    SPLAT(0x428a2f98), SPLAT(0x71374491), SPLAT(0xb5c0fbcf), SPLAT(0xe9b5dba5),
+    SPLAT(0x3956c25b), SPLAT(0x59f111f1), SPLAT(0x923f82a4), SPLAT(0xab1c5ed5),
+    SPLAT(0xd807aa98), SPLAT(0x12835b01), SPLAT(0x243185be), SPLAT(0x550c7dc3),
+    SPLAT(0x72be5d74), SPLAT(0x80deb1fe), SPLAT(0x9bdc06a7), SPLAT(0xc19bf174),
+    SPLAT(0xe49b69c1), SPLAT(0xefbe4786), SPLAT(0x0fc19dc6), SPLAT(0x240ca1cc),
+    SPLAT(0x2de92c6f), SPLAT(0x4a7484aa), SPLAT(0x5cb0a9dc), SPLAT(0x76f988da),
+    SPLAT(0x983e5152), SPLAT(0xa831c66d), SPLAT(0xb00327c8), SPLAT(0xbf597fc7),
+    SPLAT(0xc6e00bf3), SPLAT(0xd5a79147), SPLAT(0x06ca6351), SPLAT(0x14292967),
+    SPLAT(0x27b70a85), SPLAT(0x2e1b2138), SPLAT(0x4d2c6dfc), SPLAT(0x53380d13),
+    SPLAT(0x650a7354), SPLAT(0x766a0abb), SPLAT(0x81c2c92e), SPLAT(0x92722c85),
+    SPLAT(0xa2bfe8a1), SPLAT(0xa81a664b), SPLAT(0xc24b8b70), SPLAT(0xc76c51a3),
+    SPLAT(0xd192e819), SPLAT(0xd6990624), SPLAT(0xf40e3585), SPLAT(0x106aa070),
+    SPLAT(0x19a4c116), SPLAT(0x1e376c08), SPLAT(0x2748774c), SPLAT(0x34b0bcb5),
+    SPLAT(0x391c0cb3), SPLAT(0x4ed8aa4a), SPLAT(0x5b9cca4f), SPLAT(0x682e6ff3),
+    SPLAT(0x748f82ee), SPLAT(0x78a5636f), SPLAT(0x84c87814), SPLAT(0x8cc70208),
+    SPLAT(0x90befffa), SPLAT(0xa4506ceb), SPLAT(0xbef9a3f7), SPLAT(0xc67178f2)
+};
+#undef SPLAT
+
+/* Transforms the buffers of the SECP256K1_SHA256_LANES hashes. Always inlined,
+ * so that the instruction set of the caller is used. */
+SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_body(rustsecp256k1zkp_v0_8_1_sha256 * const *hashes) __attribute__((always_inline));
+SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_body(rustsecp256k1zkp_v0_8_1_sha256 * const *hashes) {
+    rustsecp256k1zkp_v0_8_1_sha256_vec s[8], w[16];
+    rustsecp256k1zkp_v0_8_1_sha256_vec a, b, c, d, e, f, g, h, t1, t2;
+    int i, l;
+
+    for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+        for (i = 0; i < 8; i++) {
+            s[i][l] = hashes[l]->s[i];
+        }
+        for (i = 0; i < 16; i++) {
+            w[i][l] = rustsecp256k1zkp_v0_8_1_read_be32(&hashes[l]->buf[4*i]);
+        }
+    }
+    a = s[0]; b = s[1]; c = s[2]; d = s[3]; e = s[4]; f = s[5]; g = s[6]; h = s[7];
+    for (i = 0; i < 64; i++) {
+        if (i >= 16) {
+            w[i & 15] += sigma1(w[(i + 14) & 15]) + w[(i + 9) & 15] + sigma0(w[(i + 1) & 15]);
+        }
+        t1 = h + Sigma1(e) + Ch(e, f, g) + rustsecp256k1zkp_v0_8_1_sha256_lanes_k[i] + w[i & 15];
+        t2 = Sigma0(a) + Maj(a, b, c);
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    s[0] += a; s[1] += b; s[2] += c; s[3] += d; s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+    for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+        for (i = 0; i < 8; i++) {
+            hashes[l]->s[i] = s[i][l];
+        }
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_lanes(rustsecp256k1zkp_v0_8_1_sha256 * const *hashes) {
+    rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_body(hashes);
+}
+
+#if defined(__x86_64__)
+#define SECP256K1_SHA256_LANES_AVX2
+
+#include <cpuid.h>
+
+__attribute__((target("avx2")))
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_avx2(rustsecp256k1zkp_v0_8_1_sha256 * const *hashes) {
+    rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_body(hashes);
+}
+
+static int rustsecp256k1zkp_v0_8_1_sha256_lanes_avx2_detect(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+    __cpuid(1, eax, ebx, ecx, edx);
+    /* OSXSAVE and AVX */
+    if (!((ecx >> 27) & 1) || !((ecx >> 28) & 1)) {
+        return 0;
+    }
+    /* The OS must save the XMM and YMM registers. */
+    __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    if ((eax & 6) != 6) {
+        return 0;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    /* AVX2 */
+    return (ebx >> 5) & 1;
+}
+#endif
+
+#endif
+
 static void rustsecp256k1zkp_v0_8_1_sha256_write(rustsecp256k1zkp_v0_8_1_sha256 *hash, const unsigned char *data, size_t len) {
     size_t bufsize = hash->bytes & 0x3F;
     hash->bytes += len;
@@ -158,6 +280,124 @@ static void rustsecp256k1zkp_v0_8_1_sha256_finalize(rustsecp256k1zkp_v0_8_1_sha2
     }
 }
 
+#ifdef SECP256K1_SHA256_LANES
+/* Which transform rustsecp256k1zkp_v0_8_1_sha256_transform_multi uses for groups of hashes:
+ * 0 for hashing one at a time, 1 for the default vector code, 2 for AVX2, or
+ * -1 if not selected yet. Only accessed through rustsecp256k1zkp_v0_8_1_once_int, like
+ * rustsecp256k1zkp_v0_8_1_sha256_hw_enabled. Single-threaded tests may set it to force a
+ * transform. */
+static int rustsecp256k1zkp_v0_8_1_sha256_lanes_impl = -1;
+
+static int rustsecp256k1zkp_v0_8_1_sha256_lanes_select(void) {
+#ifdef SECP256K1_SHA256_HW
+    /* The SHA instructions beat the vector code, even with all lanes in use. */
+    if (rustsecp256k1zkp_v0_8_1_sha256_hw_detect()) {
+        return 0;
+    }
+#endif
+#ifdef SECP256K1_SHA256_LANES_AVX2
+    if (rustsecp256k1zkp_v0_8_1_sha256_lanes_avx2_detect()) {
+        return 2;
+    }
+#endif
+    return 1;
+}
+#endif
+
+/* Transforms the buffers of the n hashes. */
+static void rustsecp256k1zkp_v0_8_1_sha256_transform_multi(rustsecp256k1zkp_v0_8_1_sha256 *hashes, size_t n) {
+    size_t i = 0;
+#ifdef SECP256K1_SHA256_LANES
+    rustsecp256k1zkp_v0_8_1_sha256 *lanes[SECP256K1_SHA256_LANES];
+    rustsecp256k1zkp_v0_8_1_sha256 unused;
+    size_t l, min_lanes;
+    int impl = rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_lanes_impl, rustsecp256k1zkp_v0_8_1_sha256_lanes_select);
+
+    if (impl) {
+        /* A group beats hashing one at a time once half of the lanes are used
+         * with AVX2, and three quarters with the default code. Lanes without a
+         * hash transform a copy whose result is thrown away. */
+        min_lanes = impl == 2 ? SECP256K1_SHA256_LANES / 2 : SECP256K1_SHA256_LANES * 3 / 4;
+        for (; n - i >= min_lanes; i += l) {
+            for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+                lanes[l] = i + l < n ? &hashes[i + l] : &unused;
+            }
+            unused = hashes[i];
+#ifdef SECP256K1_SHA256_LANES_AVX2
+            if (impl == 2) {
+                rustsecp256k1zkp_v0_8_1_sha256_transform_lanes_avx2(lanes);
+            } else
+#endif
+            {
+                rustsecp256k1zkp_v0_8_1_sha256_transform_lanes(lanes);
+            }
+            l = n - i < SECP256K1_SHA256_LANES ? n - i : SECP256K1_SHA256_LANES;
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_sha256_transform(hashes[i].s, hashes[i].buf);
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_sha256_write_multi(rustsecp256k1zkp_v0_8_1_sha256 *hashes, size_t n, const unsigned char *data, size_t stride, size_t len) {
+    size_t bufsize, offset = 0;
+    size_t i;
+
+    if (n == 0) {
+        return;
+    }
+    bufsize = hashes[0].bytes & 0x3F;
+#ifdef VERIFY
+    for (i = 1; i < n; i++) {
+        VERIFY_CHECK(hashes[i].bytes == hashes[0].bytes);
+    }
+#endif
+    for (i = 0; i < n; i++) {
+        hashes[i].bytes += len;
+        VERIFY_CHECK(hashes[i].bytes >= len);
+    }
+    while (len - offset >= 64 - bufsize) {
+        /* Fill the buffers, and process them. */
+        size_t chunk_len = 64 - bufsize;
+        for (i = 0; i < n; i++) {
+            memcpy(hashes[i].buf + bufsize, data + i * stride + offset, chunk_len);
+        }
+        offset += chunk_len;
+        rustsecp256k1zkp_v0_8_1_sha256_transform_multi(hashes, n);
+        bufsize = 0;
+    }
+    if (len - offset) {
+        /* Fill the buffers with what remains. */
+        for (i = 0; i < n; i++) {
+            memcpy(hashes[i].buf + bufsize, data + i * stride + offset, len - offset);
+        }
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_sha256_finalize_multi(rustsecp256k1zkp_v0_8_1_sha256 *hashes, size_t n, unsigned char *out32) {
+    static const unsigned char pad[64] = {0x80};
+    unsigned char sizedesc[8];
+    size_t i;
+    int j;
+
+    if (n == 0) {
+        return;
+    }
+    /* The maximum message size of SHA256 is 2^64-1 bits. */
+    VERIFY_CHECK(hashes[0].bytes < ((uint64_t)1 << 61));
+    rustsecp256k1zkp_v0_8_1_write_be32(&sizedesc[0], hashes[0].bytes >> 29);
+    rustsecp256k1zkp_v0_8_1_write_be32(&sizedesc[4], hashes[0].bytes << 3);
+    rustsecp256k1zkp_v0_8_1_sha256_write_multi(hashes, n, pad, 0, 1 + ((119 - (hashes[0].bytes % 64)) % 64));
+    rustsecp256k1zkp_v0_8_1_sha256_write_multi(hashes, n, sizedesc, 0, 8);
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < 8; j++) {
+            rustsecp256k1zkp_v0_8_1_write_be32(&out32[32*i + 4*j], hashes[i].s[j]);
+            hashes[i].s[j] = 0;
+        }
+    }
+}
+
 /* Initializes a sha256 struct and writes the 64 byte string
  * SHA256(tag)||SHA256(tag) into it. */
 static void rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(rustsecp256k1zkp_v0_8_1_sha256 *hash, const unsigned char *tag, size_t taglen) {
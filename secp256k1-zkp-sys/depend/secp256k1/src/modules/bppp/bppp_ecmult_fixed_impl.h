@@ -0,0 +1,100 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_MODULE_BPPP_ECMULT_FIXED_IMPL_H
+#define SECP256K1_MODULE_BPPP_ECMULT_FIXED_IMPL_H
+
+#include "../../group.h"
+#include "../../scalar.h"
+#include "../../ecmult.h"
+#include "../../ecmult_fixed_impl.h"
+#include "../../scratch.h"
+#include "../bppp/main.h"
+
+/* Multi-exponentiation with the generators of a bppp_generators object. The
+ * generators do not change, so the rows of ecmult_fixed are stored for every
+ * generator when the object is created. */
+
+/* Fills gens->table with window size w. Like the other allocations of the
+ * generators, running out of memory calls the error callback, which aborts by
+ * default. If the callback returns, the table stays NULL and the generators
+ * are used without it. A table is also not built if its size would overflow. */
+static void rustsecp256k1zkp_v0_8_1_bppp_generators_precompute(const rustsecp256k1zkp_v0_8_1_callback *error_callback, rustsecp256k1zkp_v0_8_1_bppp_generators *gens, int w) {
+    const size_t n_windows = ECMULT_FIXED_N_WINDOWS(w);
+    rustsecp256k1zkp_v0_8_1_gej *tmpj;
+    rustsecp256k1zkp_v0_8_1_ge *tmpa;
+    size_t i;
+
+    VERIFY_CHECK(w >= 2 && w <= ECMULT_FIXED_MAX_WINDOW);
+    gens->table = NULL;
+    gens->window = 0;
+    if (gens->n == 0 || gens->n > SIZE_MAX / sizeof(*tmpj) / n_windows) {
+        return;
+    }
+
+    tmpj = (rustsecp256k1zkp_v0_8_1_gej *)checked_malloc(error_callback, gens->n * n_windows * sizeof(*tmpj));
+    tmpa = (rustsecp256k1zkp_v0_8_1_ge *)checked_malloc(error_callback, gens->n * n_windows * sizeof(*tmpa));
+    gens->table = (rustsecp256k1zkp_v0_8_1_ge_storage *)checked_malloc(error_callback, gens->n * n_windows * sizeof(*gens->table));
+    if (tmpj == NULL || tmpa == NULL || gens->table == NULL) {
+        free(tmpj);
+        free(tmpa);
+        free(gens->table);
+        gens->table = NULL;
+        return;
+    }
+
+    for (i = 0; i < gens->n; i++) {
+        rustsecp256k1zkp_v0_8_1_ecmult_fixed_row(&tmpj[i * n_windows], &gens->gens[i], w);
+    }
+    rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(tmpa, tmpj, gens->n * n_windows);
+    for (i = 0; i < gens->n * n_windows; i++) {
+        rustsecp256k1zkp_v0_8_1_ge_to_storage(&gens->table[i], &tmpa[i]);
+    }
+    gens->window = w;
+
+    free(tmpj);
+    free(tmpa);
+}
+
+/* Computes r = inp_g_sc*G + sum_i s_i P_i over the generators P_i of gens,
+ * where s_i is a[i] for i < a_len and b[i - a_len] otherwise. inp_g_sc may be
+ * NULL. Returns 0 without setting r if gens has no table or the scratch space
+ * cannot hold the buckets, in which case ecmult_multi_var has to be used. */
+static int rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(const rustsecp256k1zkp_v0_8_1_callback *error_callback, rustsecp256k1zkp_v0_8_1_scratch *scratch, rustsecp256k1zkp_v0_8_1_gej *r, const rustsecp256k1zkp_v0_8_1_scalar *inp_g_sc, const rustsecp256k1zkp_v0_8_1_bppp_generators *gens, const rustsecp256k1zkp_v0_8_1_scalar *a, size_t a_len, const rustsecp256k1zkp_v0_8_1_scalar *b) {
+    size_t scratch_checkpoint, n_windows, n_buckets;
+    rustsecp256k1zkp_v0_8_1_gej *buckets;
+    size_t i, j;
+    int w;
+
+    if (gens->table == NULL || scratch == NULL) {
+        return 0;
+    }
+    w = gens->window;
+    n_windows = ECMULT_FIXED_N_WINDOWS(w);
+    n_buckets = ECMULT_FIXED_N_BUCKETS(w);
+    scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(error_callback, scratch);
+    buckets = (rustsecp256k1zkp_v0_8_1_gej *)rustsecp256k1zkp_v0_8_1_scratch_alloc(error_callback, scratch, n_buckets * sizeof(*buckets));
+    if (buckets == NULL) {
+        return 0;
+    }
+    for (j = 0; j < n_buckets; j++) {
+        rustsecp256k1zkp_v0_8_1_gej_set_infinity(&buckets[j]);
+    }
+
+    for (i = 0; i < gens->n; i++) {
+        rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_add(buckets, &gens->table[i * n_windows], i < a_len ? &a[i] : &b[i - a_len], w);
+    }
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_bucket_sum(r, buckets, w);
+    if (inp_g_sc != NULL) {
+        rustsecp256k1zkp_v0_8_1_gej gj;
+        rustsecp256k1zkp_v0_8_1_gej_set_infinity(&gj);
+        rustsecp256k1zkp_v0_8_1_ecmult(&gj, &gj, &rustsecp256k1zkp_v0_8_1_scalar_zero, inp_g_sc);
+        rustsecp256k1zkp_v0_8_1_gej_add_var(r, r, &gj, NULL);
+    }
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+    return 1;
+}
+
+#endif
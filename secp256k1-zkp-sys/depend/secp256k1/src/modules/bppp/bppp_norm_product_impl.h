@@ -14,6 +14,7 @@
 #include "../../hash.h"
 
 #include "../bppp/main.h"
+#include "../bppp/bppp_ecmult_fixed_impl.h"
 #include "../bppp/bppp_util.h"
 #include "../bppp/bppp_transcript_impl.h"
 
@@ -138,7 +139,8 @@ static int rustsecp256k1zkp_v0_8_1_bppp_commit(
         data.l = l_vec;
         data.g_len = n_vec_len;
 
-        if (!rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &commitj, &v, ecmult_bp_commit_cb, (void*) &data, n_vec_len + l_vec_len)) {
+        if (!rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&ctx->error_callback, scratch, &commitj, &v, g_vec, n_vec, n_vec_len, l_vec)
+            && !rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &commitj, &v, ecmult_bp_commit_cb, (void*) &data, n_vec_len + l_vec_len)) {
             return 0;
         }
         rustsecp256k1zkp_v0_8_1_ge_set_gej_var(commit, &commitj);
@@ -528,7 +530,8 @@ static int rustsecp256k1zkp_v0_8_1_bppp_rangeproof_norm_product_verify(
         data.s_g = s_g;
         data.s_h = s_h;
 
-        if (!rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &res2, &v, ec_mult_verify_cb2, &data, g_len + h_len)) {
+        if (!rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&ctx->error_callback, scratch, &res2, &v, g_vec, s_g, g_len, s_h)
+            && !rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &res2, &v, ec_mult_verify_cb2, &data, g_len + h_len)) {
             rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
             return 0;
         }
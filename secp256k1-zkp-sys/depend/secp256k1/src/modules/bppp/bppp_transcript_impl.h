@@ -10,21 +10,9 @@
 #include "../../scalar.h"
 #include "bppp_util.h"
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("Bulletproofs_pp/v0/commitment")||SHA256("Bulletproofs_pp/v0/commitment").
- */
+/* Initializes SHA256 as a tagged hash with tag "Bulletproofs_pp/v0/commitment". */
 static void rustsecp256k1zkp_v0_8_1_bppp_sha256_tagged_commitment_init(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x52fc8185ul;
-    sha->s[1] = 0x0e7debf0ul;
-    sha->s[2] = 0xb0967270ul;
-    sha->s[3] = 0x6f5abfe1ul;
-    sha->s[4] = 0x822bdec0ul;
-    sha->s[5] = 0x36db8beful;
-    sha->s[6] = 0x03d9e1f1ul;
-    sha->s[7] = 0x8a5cef6ful;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_BPPP_COMMITMENT);
 }
 
 /* Obtain a challenge scalar from the current transcript.*/
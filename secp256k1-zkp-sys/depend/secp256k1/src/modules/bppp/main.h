@@ -8,6 +8,10 @@ struct rustsecp256k1zkp_v0_8_1_bppp_generators {
     /* For BP++, the generators are G_i from [0..(n - 8)] and the last 8 values
     are generators are for H_i */
     rustsecp256k1zkp_v0_8_1_ge* gens;
+    /* For every generator, its multiples 2^(j*window) gens[i] for
+     * j < ECMULT_FIXED_N_WINDOWS(window), or NULL. See ecmult_fixed.h. */
+    rustsecp256k1zkp_v0_8_1_ge_storage* table;
+    int window;
 };
 
 #endif
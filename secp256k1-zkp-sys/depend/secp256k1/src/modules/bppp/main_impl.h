@@ -13,6 +13,7 @@
 #include "../../hash.h"
 #include "../../util.h"
 #include "../bppp/main.h"
+#include "../bppp/bppp_ecmult_fixed_impl.h"
 #include "../bppp/bppp_norm_product_impl.h"
 
 rustsecp256k1zkp_v0_8_1_bppp_generators *rustsecp256k1zkp_v0_8_1_bppp_generators_create(const rustsecp256k1zkp_v0_8_1_context *ctx, size_t n) {
@@ -45,6 +46,7 @@ rustsecp256k1zkp_v0_8_1_bppp_generators *rustsecp256k1zkp_v0_8_1_bppp_generators
         CHECK(rustsecp256k1zkp_v0_8_1_generator_generate(ctx, &gen, tmp));
         rustsecp256k1zkp_v0_8_1_generator_load(&ret->gens[i], &gen);
     }
+    rustsecp256k1zkp_v0_8_1_bppp_generators_precompute(&ctx->error_callback, ret, rustsecp256k1zkp_v0_8_1_ecmult_fixed_window(n));
 
     return ret;
 }
@@ -80,6 +82,7 @@ rustsecp256k1zkp_v0_8_1_bppp_generators* rustsecp256k1zkp_v0_8_1_bppp_generators
         }
         rustsecp256k1zkp_v0_8_1_generator_load(&ret->gens[n], &gen);
     }
+    rustsecp256k1zkp_v0_8_1_bppp_generators_precompute(&ctx->error_callback, ret, rustsecp256k1zkp_v0_8_1_ecmult_fixed_window(ret->n));
     return ret;
 }
 
@@ -107,6 +110,7 @@ void rustsecp256k1zkp_v0_8_1_bppp_generators_destroy(const rustsecp256k1zkp_v0_8
     VERIFY_CHECK(ctx != NULL);
     (void) ctx;
     if (gens != NULL) {
+        free(gens->table);
         free(gens->gens);
         free(gens);
     }
@@ -454,6 +454,72 @@ static int rustsecp256k1zkp_v0_8_1_norm_arg_verify(
     return res;
 }
 
+/* The multi-exponentiation with a table agrees with ecmult_multi_var for every
+ * window size. */
+static void test_bppp_ecmult_fixed(void) {
+    rustsecp256k1zkp_v0_8_1_scalar a[64], b[64], g_sc;
+    rustsecp256k1zkp_v0_8_1_scratch *scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 1000*1000);
+    rustsecp256k1zkp_v0_8_1_scratch *small_scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 100);
+    static const size_t ns[4] = {1, 3, 64, 128};
+    size_t i, k;
+    int w;
+
+    for (k = 0; k < sizeof(ns) / sizeof(ns[0]); k++) {
+        const size_t n = ns[k];
+        const size_t a_len = n / 2;
+        rustsecp256k1zkp_v0_8_1_bppp_generators *gs = rustsecp256k1zkp_v0_8_1_bppp_generators_create(CTX, n);
+        ecmult_bp_commit_cb_data data;
+        rustsecp256k1zkp_v0_8_1_gej expected, r;
+
+        CHECK(gs->table != NULL);
+        CHECK(gs->window == rustsecp256k1zkp_v0_8_1_ecmult_fixed_window(n));
+        for (i = 0; i < a_len; i++) {
+            random_scalar_order(&a[i]);
+        }
+        for (i = 0; i < n - a_len; i++) {
+            random_scalar_order(&b[i]);
+        }
+        /* A scalar with only zero digits and one that carries through most of them */
+        if (n > 1) {
+            rustsecp256k1zkp_v0_8_1_scalar_set_int(&b[0], 0);
+            rustsecp256k1zkp_v0_8_1_scalar_set_int(&b[n - a_len - 1], 1);
+            rustsecp256k1zkp_v0_8_1_scalar_negate(&b[n - a_len - 1], &b[n - a_len - 1]);
+        }
+        random_scalar_order(&g_sc);
+        data.g = gs->gens;
+        data.n = a;
+        data.l = b;
+        data.g_len = a_len;
+        CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &expected, &g_sc, ecmult_bp_commit_cb, &data, n));
+
+        for (w = 2; w <= ECMULT_FIXED_MAX_WINDOW; w++) {
+            if (n > 3 && w != gs->window && w != 2 && w != ECMULT_FIXED_MAX_WINDOW) {
+                continue;
+            }
+            free(gs->table);
+            rustsecp256k1zkp_v0_8_1_bppp_generators_precompute(&CTX->error_callback, gs, w);
+            CHECK(gs->window == w);
+            CHECK(rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&CTX->error_callback, scratch, &r, &g_sc, gs, a, a_len, b));
+            CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+            CHECK(scratch->alloc_size == 0);
+        }
+        CHECK(rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&CTX->error_callback, scratch, &r, NULL, gs, a, a_len, b));
+        CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &expected, NULL, ecmult_bp_commit_cb, &data, n));
+        CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+
+        /* The caller falls back to ecmult_multi_var without buckets or a table. */
+        CHECK(!rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&CTX->error_callback, small_scratch, &r, NULL, gs, a, a_len, b));
+        CHECK(!rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&CTX->error_callback, NULL, &r, NULL, gs, a, a_len, b));
+        free(gs->table);
+        gs->table = NULL;
+        CHECK(!rustsecp256k1zkp_v0_8_1_bppp_ecmult_fixed(&CTX->error_callback, scratch, &r, NULL, gs, a, a_len, b));
+        rustsecp256k1zkp_v0_8_1_bppp_generators_destroy(CTX, gs);
+    }
+
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, small_scratch);
+}
+
 /* Verify |c| = 0 */
 static void norm_arg_verify_zero_len(void) {
     rustsecp256k1zkp_v0_8_1_scalar n_vec[64], l_vec[64], c_vec[64];
@@ -538,6 +604,9 @@ rustsecp256k1zkp_v0_8_1_bppp_generators* bppp_generators_parse_regular(const uns
         return NULL;
     }
     ret->n = n;
+    /* Without a table, the generators go through ecmult_multi_var. */
+    ret->table = NULL;
+    ret->window = 0;
     ret->gens = (rustsecp256k1zkp_v0_8_1_ge*)checked_malloc(&CTX->error_callback, n * sizeof(*ret->gens));
     if (ret->gens == NULL) {
         free(ret);
@@ -675,6 +744,7 @@ static void run_bppp_tests(void) {
     test_serialize_two_points();
     test_bppp_generators_api();
     test_bppp_generators_fixed();
+    test_bppp_ecmult_fixed();
     test_bppp_tagged_hash();
 
     norm_arg_verify_zero_len();
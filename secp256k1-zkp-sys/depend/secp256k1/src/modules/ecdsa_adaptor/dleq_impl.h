@@ -1,20 +1,11 @@
 #ifndef SECP256K1_DLEQ_IMPL_H
 #define SECP256K1_DLEQ_IMPL_H
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("DLEQ")||SHA256("DLEQ"). */
+#include "enckey_impl.h"
+
+/* Initializes SHA256 as a tagged hash with tag "DLEQ". */
 static void rustsecp256k1zkp_v0_8_1_nonce_function_dleq_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x8cc4beacul;
-    sha->s[1] = 0x2e011f3ful;
-    sha->s[2] = 0x355c75fbul;
-    sha->s[3] = 0x3ba6a2c5ul;
-    sha->s[4] = 0xe96f3aeful;
-    sha->s[5] = 0x180530fdul;
-    sha->s[6] = 0x94582499ul;
-    sha->s[7] = 0x577fd564ul;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_DLEQ);
 }
 
 /* algo argument for nonce_function_ecdsa_adaptor to derive the nonce using a tagged hash function. */
@@ -75,19 +66,24 @@ static void rustsecp256k1zkp_v0_8_1_dleq_challenge(rustsecp256k1zkp_v0_8_1_scala
     rustsecp256k1zkp_v0_8_1_scalar_set_b32(e, buf, NULL);
 }
 
-/* P1 = x*G, P2 = x*Y */
-static void rustsecp256k1zkp_v0_8_1_dleq_pair(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ecmult_gen_ctx, rustsecp256k1zkp_v0_8_1_ge *p1, rustsecp256k1zkp_v0_8_1_ge *p2, const rustsecp256k1zkp_v0_8_1_scalar *sk, const rustsecp256k1zkp_v0_8_1_ge *gen2) {
+/* P1 = x*G, P2 = x*Y. If gen2_table is not NULL, it must be a table for Y
+ * built with rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare. */
+static void rustsecp256k1zkp_v0_8_1_dleq_pair(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ecmult_gen_ctx, rustsecp256k1zkp_v0_8_1_ge *p1, rustsecp256k1zkp_v0_8_1_ge *p2, const rustsecp256k1zkp_v0_8_1_scalar *sk, const rustsecp256k1zkp_v0_8_1_ge *gen2, const unsigned char *gen2_table) {
     rustsecp256k1zkp_v0_8_1_gej p1j, p2j;
 
     rustsecp256k1zkp_v0_8_1_ecmult_gen(ecmult_gen_ctx, &p1j, sk);
     rustsecp256k1zkp_v0_8_1_ge_set_gej(p1, &p1j);
-    rustsecp256k1zkp_v0_8_1_ecmult_const(&p2j, gen2, sk);
+    if (gen2_table != NULL) {
+        rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(&p2j, gen2_table, SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS, sk);
+    } else {
+        rustsecp256k1zkp_v0_8_1_ecmult_const(&p2j, gen2, sk);
+    }
     rustsecp256k1zkp_v0_8_1_ge_set_gej(p2, &p2j);
 }
 
 /* Generates a proof that the discrete logarithm of P1 to the secp256k1 base G is the
  * same as the discrete logarithm of P2 to the base Y */
-static int rustsecp256k1zkp_v0_8_1_dleq_prove(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scalar *s, rustsecp256k1zkp_v0_8_1_scalar *e, const rustsecp256k1zkp_v0_8_1_scalar *sk, rustsecp256k1zkp_v0_8_1_ge *gen2, rustsecp256k1zkp_v0_8_1_ge *p1, rustsecp256k1zkp_v0_8_1_ge *p2, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata) {
+static int rustsecp256k1zkp_v0_8_1_dleq_prove(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scalar *s, rustsecp256k1zkp_v0_8_1_scalar *e, const rustsecp256k1zkp_v0_8_1_scalar *sk, rustsecp256k1zkp_v0_8_1_ge *gen2, rustsecp256k1zkp_v0_8_1_ge *p1, rustsecp256k1zkp_v0_8_1_ge *p2, const unsigned char *gen2_table, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata) {
     rustsecp256k1zkp_v0_8_1_ge r1, r2;
     rustsecp256k1zkp_v0_8_1_scalar k = { 0 };
     unsigned char sk32[32];
@@ -110,7 +106,7 @@ static int rustsecp256k1zkp_v0_8_1_dleq_prove(const rustsecp256k1zkp_v0_8_1_cont
 
     ret &= rustsecp256k1zkp_v0_8_1_dleq_nonce(&k, sk32, gen2_33, p1_33, p2_33, noncefp, ndata);
     /* R1 = k*G, R2 = k*Y */
-    rustsecp256k1zkp_v0_8_1_dleq_pair(&ctx->ecmult_gen_ctx, &r1, &r2, &k, gen2);
+    rustsecp256k1zkp_v0_8_1_dleq_pair(&ctx->ecmult_gen_ctx, &r1, &r2, &k, gen2, gen2_table);
     /* We declassify the non-secret values r1 and r2 to allow using them as
      * branch points. */
     rustsecp256k1zkp_v0_8_1_declassify(ctx, &r1, sizeof(r1));
@@ -0,0 +1,16 @@
+/**********************************************************************
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_ECDSA_ADAPTOR_ENCKEY_IMPL_H
+#define SECP256K1_ECDSA_ADAPTOR_ENCKEY_IMPL_H
+
+#include "../../ecmult_fixed_const_impl.h"
+
+/* The table of a prepared encryption key Y is an ecmult_fixed_const table
+ * for Y that covers all 256-bit scalars. */
+#define SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS 64
+#define SECP256K1_ECDSA_ADAPTOR_ENCKEY_TABLE_SIZE ECMULT_FIXED_CONST_TABLE_SIZE(SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS)
+
+#endif
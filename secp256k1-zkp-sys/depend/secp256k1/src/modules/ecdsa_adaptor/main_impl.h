@@ -7,6 +7,15 @@
 #ifndef SECP256K1_MODULE_ECDSA_ADAPTOR_MAIN_H
 #define SECP256K1_MODULE_ECDSA_ADAPTOR_MAIN_H
 
+/* The attestation points use the BIP-340 challenge of the schnorrsig module
+ * and the x-only keys of the extrakeys module. */
+#ifndef ENABLE_MODULE_SCHNORRSIG
+#error "The ecdsa_adaptor module requires the schnorrsig module (ENABLE_MODULE_SCHNORRSIG)."
+#endif
+#ifndef ENABLE_MODULE_EXTRAKEYS
+#error "The ecdsa_adaptor module requires the extrakeys module (ENABLE_MODULE_EXTRAKEYS)."
+#endif
+
 #include "../../../include/secp256k1_ecdsa_adaptor.h"
 #include "dleq_impl.h"
 
@@ -65,36 +74,9 @@ static int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_sig_deserialize(rustsecp256k1zk
     return 1;
 }
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("ECDSAadaptor/non")||SHA256("ECDSAadaptor/non"). */
-static void rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x791dae43ul;
-    sha->s[1] = 0xe52d3b44ul;
-    sha->s[2] = 0x37f9edeaul;
-    sha->s[3] = 0x9bfd2ab1ul;
-    sha->s[4] = 0xcfb0f44dul;
-    sha->s[5] = 0xccf1d880ul;
-    sha->s[6] = 0xd18f2c13ul;
-    sha->s[7] = 0xa37b9024ul;
-
-    sha->bytes = 64;
-}
-
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("ECDSAadaptor/aux")||SHA256("ECDSAadaptor/aux"). */
+/* Initializes SHA256 as a tagged hash with tag "ECDSAadaptor/aux". */
 static void rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor_sha256_tagged_aux(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0xd14c7bd9ul;
-    sha->s[1] = 0x095d35e6ul;
-    sha->s[2] = 0xb8490a88ul;
-    sha->s[3] = 0xfb00ef74ul;
-    sha->s[4] = 0x0baa488ful;
-    sha->s[5] = 0x69366693ul;
-    sha->s[6] = 0x1c81c5baul;
-    sha->s[7] = 0xc33b296aul;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_ECDSA_ADAPTOR_AUX);
 }
 
 /* algo argument for nonce_function_ecdsa_adaptor to derive the nonce using a tagged hash function. */
@@ -120,17 +102,9 @@ static int nonce_function_ecdsa_adaptor(unsigned char *nonce32, const unsigned c
     }
 
     /* Tag the hash with algo which is important to avoid nonce reuse across
-     * algorithims. An optimized tagging implementation is used if the default
-     * tag is provided. */
-    if (algolen == sizeof(ecdsa_adaptor_algo)
-            && rustsecp256k1zkp_v0_8_1_memcmp_var(algo, ecdsa_adaptor_algo, algolen) == 0) {
-        rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor_sha256_tagged(&sha);
-    } else if (algolen == sizeof(dleq_algo)
-            && rustsecp256k1zkp_v0_8_1_memcmp_var(algo, dleq_algo, algolen) == 0) {
-        rustsecp256k1zkp_v0_8_1_nonce_function_dleq_sha256_tagged(&sha);
-    } else {
-        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, algo, algolen);
-    }
+     * algorithims. The precomputed midstate is used if the default or the
+     * DLEQ tag is provided. */
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha, algo, algolen);
 
     /* Hash (masked-)key||pk||msg using the tagged hash as per BIP-340 */
     if (data != NULL) {
@@ -146,11 +120,15 @@ static int nonce_function_ecdsa_adaptor(unsigned char *nonce32, const unsigned c
 
 const rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor = nonce_function_ecdsa_adaptor;
 
-int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *adaptor_sig162, unsigned char *seckey32, const rustsecp256k1zkp_v0_8_1_pubkey *enckey, const unsigned char *msg32, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata) {
+/* Creates an adaptor signature for the encryption key enckey_ge. If enckey_table
+ * is not NULL, it must be the table of a prepared encryption key for
+ * enckey_ge (see enckey_impl.h) and is used for the
+ * multiplications by the encryption key. ret is 0 if loading the encryption
+ * key failed, in which case the signature is zeroed. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_internal(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *adaptor_sig162, unsigned char *seckey32, rustsecp256k1zkp_v0_8_1_ge *enckey_ge, const unsigned char *enckey_table, const unsigned char *msg32, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata, int ret) {
     rustsecp256k1zkp_v0_8_1_scalar k;
     rustsecp256k1zkp_v0_8_1_gej rj, rpj;
     rustsecp256k1zkp_v0_8_1_ge r, rp;
-    rustsecp256k1zkp_v0_8_1_ge enckey_ge;
     rustsecp256k1zkp_v0_8_1_scalar dleq_proof_s;
     rustsecp256k1zkp_v0_8_1_scalar dleq_proof_e;
     rustsecp256k1zkp_v0_8_1_scalar sk;
@@ -161,14 +139,6 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_
     unsigned char nonce32[32] = { 0 };
     unsigned char buf33[33];
     size_t size = 33;
-    int ret = 1;
-
-    VERIFY_CHECK(ctx != NULL);
-    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
-    ARG_CHECK(adaptor_sig162 != NULL);
-    ARG_CHECK(seckey32 != NULL);
-    ARG_CHECK(enckey != NULL);
-    ARG_CHECK(msg32 != NULL);
 
     rustsecp256k1zkp_v0_8_1_scalar_clear(&dleq_proof_e);
     rustsecp256k1zkp_v0_8_1_scalar_clear(&dleq_proof_s);
@@ -177,8 +147,7 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_
         noncefp = rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor;
     }
 
-    ret &= rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &enckey_ge, enckey);
-    ret &= rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&enckey_ge, buf33, &size, 1);
+    ret &= rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(enckey_ge, buf33, &size, 1);
     ret &= !!noncefp(nonce32, msg32, seckey32, buf33, ecdsa_adaptor_algo, sizeof(ecdsa_adaptor_algo), ndata);
     rustsecp256k1zkp_v0_8_1_scalar_set_b32(&k, nonce32, NULL);
     ret &= !rustsecp256k1zkp_v0_8_1_scalar_is_zero(&k);
@@ -188,7 +157,11 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_
     rustsecp256k1zkp_v0_8_1_ecmult_gen(&ctx->ecmult_gen_ctx, &rpj, &k);
     rustsecp256k1zkp_v0_8_1_ge_set_gej(&rp, &rpj);
     /* R = k*Y; */
-    rustsecp256k1zkp_v0_8_1_ecmult_const(&rj, &enckey_ge, &k);
+    if (enckey_table != NULL) {
+        rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(&rj, enckey_table, SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS, &k);
+    } else {
+        rustsecp256k1zkp_v0_8_1_ecmult_const(&rj, enckey_ge, &k);
+    }
     rustsecp256k1zkp_v0_8_1_ge_set_gej(&r, &rj);
     /* We declassify the non-secret values rp and r to allow using them
      * as branch points. */
@@ -196,7 +169,7 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_
     rustsecp256k1zkp_v0_8_1_declassify(ctx, &r, sizeof(r));
 
     /* dleq_proof = DLEQ_prove(k, (R', Y, R)) */
-    ret &= rustsecp256k1zkp_v0_8_1_dleq_prove(ctx, &dleq_proof_s, &dleq_proof_e, &k, &enckey_ge, &rp, &r, noncefp, ndata);
+    ret &= rustsecp256k1zkp_v0_8_1_dleq_prove(ctx, &dleq_proof_s, &dleq_proof_e, &k, enckey_ge, &rp, &r, enckey_table, noncefp, ndata);
 
     ret &= rustsecp256k1zkp_v0_8_1_scalar_set_b32_seckey(&sk, seckey32);
     rustsecp256k1zkp_v0_8_1_scalar_cmov(&sk, &rustsecp256k1zkp_v0_8_1_scalar_one, !ret);
@@ -223,6 +196,66 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_
     return ret;
 }
 
+int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *adaptor_sig162, unsigned char *seckey32, const rustsecp256k1zkp_v0_8_1_pubkey *enckey, const unsigned char *msg32, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata) {
+    rustsecp256k1zkp_v0_8_1_ge enckey_ge;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(adaptor_sig162 != NULL);
+    ARG_CHECK(seckey32 != NULL);
+    ARG_CHECK(enckey != NULL);
+    ARG_CHECK(msg32 != NULL);
+
+    ret = rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &enckey_ge, enckey);
+    return rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_internal(ctx, adaptor_sig162, seckey32, &enckey_ge, NULL, msg32, noncefp, ndata, ret);
+}
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey_magic[4] = { 0x3c, 0x91, 0xe5, 0x07 };
+
+/* A prepared encryption key consists of
+ * - 4 byte magic set during preparation to allow detecting an uninitialized
+ *   object.
+ * - 64 byte encryption key Y as ge_storage
+ * - the multiplication table for Y as described in enckey_impl.h
+ */
+int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey *prepared, const rustsecp256k1zkp_v0_8_1_pubkey *enckey) {
+    rustsecp256k1zkp_v0_8_1_ge enckey_ge;
+    rustsecp256k1zkp_v0_8_1_ge_storage s;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(prepared != NULL);
+    memset(prepared, 0, sizeof(*prepared));
+    ARG_CHECK(enckey != NULL);
+    VERIFY_CHECK(sizeof(prepared->data) == 4 + sizeof(s) + SECP256K1_ECDSA_ADAPTOR_ENCKEY_TABLE_SIZE);
+
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &enckey_ge, enckey)) {
+        return 0;
+    }
+    memcpy(&prepared->data[0], rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey_magic, 4);
+    rustsecp256k1zkp_v0_8_1_ge_to_storage(&s, &enckey_ge);
+    memcpy(&prepared->data[4], &s, sizeof(s));
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_const_table_build(&prepared->data[4 + sizeof(s)], &enckey_ge, SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *adaptor_sig162, unsigned char *seckey32, const rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey *enckey, const unsigned char *msg32, rustsecp256k1zkp_v0_8_1_nonce_function_hardened_ecdsa_adaptor noncefp, void *ndata) {
+    rustsecp256k1zkp_v0_8_1_ge enckey_ge;
+    rustsecp256k1zkp_v0_8_1_ge_storage s;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(adaptor_sig162 != NULL);
+    ARG_CHECK(seckey32 != NULL);
+    ARG_CHECK(enckey != NULL);
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&enckey->data[0], rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey_magic, 4) == 0);
+
+    memcpy(&s, &enckey->data[4], sizeof(s));
+    rustsecp256k1zkp_v0_8_1_ge_from_storage(&enckey_ge, &s);
+    return rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_internal(ctx, adaptor_sig162, seckey32, &enckey_ge, &enckey->data[4 + sizeof(s)], msg32, noncefp, ndata, 1);
+}
+
 int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(const rustsecp256k1zkp_v0_8_1_context* ctx, const unsigned char *adaptor_sig162, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const unsigned char *msg32, const rustsecp256k1zkp_v0_8_1_pubkey *enckey) {
     rustsecp256k1zkp_v0_8_1_scalar dleq_proof_s, dleq_proof_e;
     rustsecp256k1zkp_v0_8_1_scalar msg;
@@ -270,6 +303,132 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(const rustsecp256k1zkp_v0_8_1_c
     return rustsecp256k1zkp_v0_8_1_gej_is_infinity(&derived_rp);
 }
 
+/* Initializes SHA256 as a tagged hash with tag "ECDSAadaptor/batch". */
+static void rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_batch_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_ECDSA_ADAPTOR_BATCH);
+}
+
+/* The first signature gets weight 1, signature i > 0 gets weight
+ * SHA256(seed || i) where seed commits to all inputs of the batch. */
+static void rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_batch_weight(rustsecp256k1zkp_v0_8_1_scalar *weight, const unsigned char *seed32, size_t i) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char buf[32];
+    int j;
+
+    if (i == 0) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_int(weight, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        buf[j] = ((uint64_t) i >> (8 * j)) & 0xff;
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, seed32, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, buf, 8);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(weight, buf, NULL);
+}
+
+typedef struct {
+    const rustsecp256k1zkp_v0_8_1_context *ctx;
+    const unsigned char * const *adaptor_sigs162;
+    const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys;
+    const unsigned char *seed32;
+} rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_data;
+
+/* Point 2*i is R'_i with scalar a_i*s'_i and point 2*i + 1 is X_i with scalar
+ * -a_i*R_i.x, so that sum_i a_i*(s'_i*R'_i - R_i.x*X_i) - (sum_i a_i*m_i)*G is
+ * infinity if all signatures are valid. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_callback(rustsecp256k1zkp_v0_8_1_scalar *sc, rustsecp256k1zkp_v0_8_1_ge *pt, size_t idx, void *data) {
+    rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_data *ecmult_data = (rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_data *) data;
+    const unsigned char *adaptor_sig162 = ecmult_data->adaptor_sigs162[idx / 2];
+    rustsecp256k1zkp_v0_8_1_scalar weight;
+
+    rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_batch_weight(&weight, ecmult_data->seed32, idx / 2);
+    if (idx % 2 == 0) {
+        if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_sig_deserialize(NULL, NULL, pt, sc, NULL, NULL, adaptor_sig162)) {
+            return 0;
+        }
+    } else {
+        if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_sig_deserialize(NULL, sc, NULL, NULL, NULL, NULL, adaptor_sig162)) {
+            return 0;
+        }
+        if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ecmult_data->ctx, pt, ecmult_data->pubkeys[idx / 2])) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_scalar_negate(sc, sc);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_mul(sc, sc, &weight);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, const unsigned char * const *adaptor_sigs162, const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys, const unsigned char * const *msgs32, const rustsecp256k1zkp_v0_8_1_pubkey * const *enckeys, size_t n_sigs) {
+    rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_data ecmult_data;
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char seed[32];
+    rustsecp256k1zkp_v0_8_1_scalar g_sc;
+    rustsecp256k1zkp_v0_8_1_gej resj;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_sigs == 0 || adaptor_sigs162 != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkeys != NULL);
+    ARG_CHECK(n_sigs == 0 || msgs32 != NULL);
+    ARG_CHECK(n_sigs == 0 || enckeys != NULL);
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+
+    /* Derive the weights from all inputs so that they can't be predicted by
+     * whoever produced the signatures. */
+    rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_batch_sha256_tagged(&sha);
+    for (i = 0; i < n_sigs; i++) {
+        ARG_CHECK(adaptor_sigs162[i] != NULL);
+        ARG_CHECK(pubkeys[i] != NULL);
+        ARG_CHECK(msgs32[i] != NULL);
+        ARG_CHECK(enckeys[i] != NULL);
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, adaptor_sigs162[i], 162);
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pubkeys[i]->data, sizeof(pubkeys[i]->data));
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, msgs32[i], 32);
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, enckeys[i]->data, sizeof(enckeys[i]->data));
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, seed);
+
+    /* The DLEQ challenge is a hash of the proof's commitments, so the proofs
+     * have to be verified one at a time. */
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&g_sc, 0);
+    for (i = 0; i < n_sigs; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar dleq_proof_s, dleq_proof_e;
+        rustsecp256k1zkp_v0_8_1_scalar msg, weight;
+        rustsecp256k1zkp_v0_8_1_ge r, rp, enckey_ge;
+        rustsecp256k1zkp_v0_8_1_scalar sp, sigr;
+
+        if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_sig_deserialize(&r, &sigr, &rp, &sp, &dleq_proof_e, &dleq_proof_s, adaptor_sigs162[i])) {
+            return 0;
+        }
+        if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &enckey_ge, enckeys[i])) {
+            return 0;
+        }
+        /* DLEQ_verify((R', Y, R), dleq_proof) */
+        if (!rustsecp256k1zkp_v0_8_1_dleq_verify(&dleq_proof_s, &dleq_proof_e, &rp, &enckey_ge, &r)) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_batch_weight(&weight, seed, i);
+        rustsecp256k1zkp_v0_8_1_scalar_set_b32(&msg, msgs32[i], NULL);
+        rustsecp256k1zkp_v0_8_1_scalar_mul(&msg, &msg, &weight);
+        rustsecp256k1zkp_v0_8_1_scalar_add(&g_sc, &g_sc, &msg);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_negate(&g_sc, &g_sc);
+
+    /* sum_i a_i*(s'_i*R'_i - R_i.x*X_i - m_i*G) == infinity */
+    ecmult_data.ctx = ctx;
+    ecmult_data.adaptor_sigs162 = adaptor_sigs162;
+    ecmult_data.pubkeys = pubkeys;
+    ecmult_data.seed32 = seed;
+    if (!rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &resj, &g_sc, rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch_ecmult_callback, (void *) &ecmult_data, 2 * n_sigs)) {
+        return 0;
+    }
+    return rustsecp256k1zkp_v0_8_1_gej_is_infinity(&resj);
+}
+
 int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_decrypt(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_ecdsa_signature *sig, const unsigned char *deckey32, const unsigned char *adaptor_sig162) {
     rustsecp256k1zkp_v0_8_1_scalar deckey;
     rustsecp256k1zkp_v0_8_1_scalar sp;
@@ -372,4 +531,130 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_recover(const rustsecp256k1zkp_v0_8_1_
     return ret;
 }
 
+/* Number of points converted to affine coordinates at once by
+ * rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points. */
+#define SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH 64
+
+/* Converts the n points in gej to affine coordinates and stores them at the
+ * indices idx of out. Returns 0 if any of the points is infinity. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_flush(rustsecp256k1zkp_v0_8_1_pubkey *out, rustsecp256k1zkp_v0_8_1_ge *ge, rustsecp256k1zkp_v0_8_1_gej *gej, size_t *idx, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (rustsecp256k1zkp_v0_8_1_gej_is_infinity(&gej[i])) {
+            return 0;
+        }
+    }
+    rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(ge, gej, n);
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_pubkey_save(&out[idx[i]], &ge[i]);
+    }
+    return 1;
+}
+
+/* Computes the attestation points after the arguments have been checked. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_points_internal(const rustsecp256k1zkp_v0_8_1_context *ctx, rustsecp256k1zkp_v0_8_1_pubkey *digit_points, rustsecp256k1zkp_v0_8_1_pubkey *points, const rustsecp256k1zkp_v0_8_1_xonly_pubkey *oracle_pubkey, const rustsecp256k1zkp_v0_8_1_xonly_pubkey *nonces, size_t n_digits, const unsigned char * const *outcome_msgs32, size_t base) {
+    rustsecp256k1zkp_v0_8_1_gej gej[SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge ge[SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH];
+    size_t idx[SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge pk, r, s;
+    rustsecp256k1zkp_v0_8_1_gej pkj, prefixj;
+    rustsecp256k1zkp_v0_8_1_scalar e;
+    unsigned char pk32[32];
+    unsigned char r32[32];
+    size_t width, j, d, p;
+    size_t n = 0;
+
+    if (!rustsecp256k1zkp_v0_8_1_xonly_pubkey_load(ctx, &pk, oracle_pubkey)) {
+        return 0;
+    }
+    rustsecp256k1zkp_v0_8_1_fe_get_b32(pk32, &pk.x);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&pkj, &pk);
+
+    /* S_{j,d} = R_j + H(R_j, m_d, P)*P */
+    for (j = 0; j < n_digits; j++) {
+        if (!rustsecp256k1zkp_v0_8_1_xonly_pubkey_load(ctx, &r, &nonces[j])) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_fe_get_b32(r32, &r.x);
+        for (d = 0; d < base; d++) {
+            rustsecp256k1zkp_v0_8_1_schnorrsig_challenge(&e, r32, outcome_msgs32[d], 32, pk32);
+            rustsecp256k1zkp_v0_8_1_ecmult(&gej[n], &pkj, &e, &rustsecp256k1zkp_v0_8_1_scalar_zero);
+            rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&gej[n], &gej[n], &r, NULL);
+            idx[n++] = j*base + d;
+            if (n == SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH) {
+                if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_flush(digit_points, ge, gej, idx, n)) {
+                    return 0;
+                }
+                n = 0;
+            }
+        }
+    }
+    if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_flush(digit_points, ge, gej, idx, n)) {
+        return 0;
+    }
+    n = 0;
+
+    memcpy(points, digit_points, base * sizeof(*points));
+    /* Extend every prefix of the previous level by one digit. The prefixes are
+     * processed from last to first, so the destinations p*base + d (which are
+     * greater than p unless p = 0, in which case prefix p has already been
+     * read) never overwrite a prefix that is still needed. */
+    for (width = base, j = 1; j < n_digits; width *= base, j++) {
+        for (p = width; p-- > 0;) {
+            if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &s, &points[p])) {
+                return 0;
+            }
+            rustsecp256k1zkp_v0_8_1_gej_set_ge(&prefixj, &s);
+            for (d = 0; d < base; d++) {
+                if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &s, &digit_points[j*base + d])) {
+                    return 0;
+                }
+                rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&gej[n], &prefixj, &s, NULL);
+                idx[n++] = p*base + d;
+                if (n == SECP256K1_ECDSA_ADAPTOR_ATTESTATION_BATCH) {
+                    if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_flush(points, ge, gej, idx, n)) {
+                        return 0;
+                    }
+                    n = 0;
+                }
+            }
+        }
+        if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_flush(points, ge, gej, idx, n)) {
+            return 0;
+        }
+        n = 0;
+    }
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(const rustsecp256k1zkp_v0_8_1_context *ctx, rustsecp256k1zkp_v0_8_1_pubkey *digit_points, rustsecp256k1zkp_v0_8_1_pubkey *points, const rustsecp256k1zkp_v0_8_1_xonly_pubkey *oracle_pubkey, const rustsecp256k1zkp_v0_8_1_xonly_pubkey *nonces, size_t n_digits, const unsigned char * const *outcome_msgs32, size_t base, size_t n_points) {
+    size_t expected, j, d;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(digit_points != NULL);
+    ARG_CHECK(points != NULL);
+    ARG_CHECK(oracle_pubkey != NULL);
+    ARG_CHECK(nonces != NULL);
+    ARG_CHECK(outcome_msgs32 != NULL);
+    ARG_CHECK(n_digits > 0);
+    ARG_CHECK(base > 1);
+    expected = 1;
+    for (j = 0; j < n_digits; j++) {
+        ARG_CHECK(expected <= SIZE_MAX / base);
+        expected *= base;
+    }
+    ARG_CHECK(n_points == expected);
+    for (d = 0; d < base; d++) {
+        ARG_CHECK(outcome_msgs32[d] != NULL);
+    }
+
+    if (!rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_attestation_points_internal(ctx, digit_points, points, oracle_pubkey, nonces, n_digits, outcome_msgs32, base)) {
+        memset(digit_points, 0, n_digits * base * sizeof(*digit_points));
+        memset(points, 0, n_points * sizeof(*points));
+        return 0;
+    }
+    return 1;
+}
+
 #endif
@@ -41,8 +41,8 @@ static void dleq_tests(void) {
 
     rand_point(&gen2);
     rand_scalar(&sk);
-    rustsecp256k1zkp_v0_8_1_dleq_pair(&CTX->ecmult_gen_ctx, &p1, &p2, &sk, &gen2);
-    CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p1, &p2, NULL, NULL) == 1);
+    rustsecp256k1zkp_v0_8_1_dleq_pair(&CTX->ecmult_gen_ctx, &p1, &p2, &sk, &gen2, NULL);
+    CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p1, &p2, NULL, NULL, NULL) == 1);
     CHECK(rustsecp256k1zkp_v0_8_1_dleq_verify(&s, &e, &p1, &gen2, &p2) == 1);
 
     {
@@ -61,9 +61,9 @@ static void dleq_tests(void) {
     {
         rustsecp256k1zkp_v0_8_1_ge p_inf;
         rustsecp256k1zkp_v0_8_1_ge_set_infinity(&p_inf);
-        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &p_inf, &p1, &p2, NULL, NULL) == 0);
-        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p_inf, &p2, NULL, NULL) == 0);
-        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p1, &p_inf, NULL, NULL) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &p_inf, &p1, &p2, NULL, NULL, NULL) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p_inf, &p2, NULL, NULL, NULL) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_dleq_prove(CTX, &s, &e, &sk, &gen2, &p1, &p_inf, NULL, NULL, NULL) == 0);
     }
 
     /* Nonce tests */
@@ -745,11 +745,10 @@ static void run_nonce_function_ecdsa_adaptor_tests(void) {
     unsigned char *args[5];
     int i;
 
-    /* Check that hash initialized by
-     * rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor_sha256_tagged has the expected
-     * state. */
+    /* Check that the precomputed midstate nonce_function_ecdsa_adaptor looks
+     * up for its tag has the expected state. */
     rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, tag, sizeof(tag));
-    rustsecp256k1zkp_v0_8_1_nonce_function_ecdsa_adaptor_sha256_tagged(&sha_optimized);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha_optimized, tag, sizeof(tag));
     ecdsa_adaptor_test_sha256_eq(&sha, &sha_optimized);
 
    /* Check that hash initialized by
@@ -822,6 +821,11 @@ static void test_ecdsa_adaptor_api(void) {
     unsigned char msg[32];
     unsigned char asig[162];
     unsigned char deckey[32];
+    const unsigned char *asig_ptr = asig;
+    const unsigned char *msg_ptr = msg;
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey_ptr = &pubkey;
+    const rustsecp256k1zkp_v0_8_1_pubkey *enckey_ptr = &enckey;
+    const rustsecp256k1zkp_v0_8_1_pubkey *zero_pk_ptr = &zero_pk;
 
     /** setup **/
     int ecount;
@@ -872,6 +876,23 @@ static void test_ecdsa_adaptor_api(void) {
     CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(CTX, asig, &pubkey, msg, &zero_pk) == 0);
     CHECK(ecount == 6);
 
+    ecount = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, &pubkey_ptr, &msg_ptr, &enckey_ptr, 1) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, NULL, &pubkey_ptr, &msg_ptr, &enckey_ptr, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, NULL, &msg_ptr, &enckey_ptr, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, &pubkey_ptr, NULL, &enckey_ptr, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, &pubkey_ptr, &msg_ptr, NULL, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, &zero_pk_ptr, &msg_ptr, &enckey_ptr, 1) == 0);
+    CHECK(ecount == 5);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, &asig_ptr, &pubkey_ptr, &msg_ptr, &zero_pk_ptr, 1) == 0);
+    CHECK(ecount == 6);
+
     ecount = 0;
     CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_decrypt(CTX, &sig, deckey, asig) == 1);
     CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_decrypt(CTX, &sig, deckey, asig) == 1);
@@ -905,6 +926,257 @@ static void test_ecdsa_adaptor_api(void) {
     rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
 }
 
+static void test_ecdsa_adaptor_enckey_table(void) {
+    static unsigned char table[SECP256K1_ECDSA_ADAPTOR_ENCKEY_TABLE_SIZE];
+    rustsecp256k1zkp_v0_8_1_ge y;
+    rustsecp256k1zkp_v0_8_1_gej r1, r2;
+    rustsecp256k1zkp_v0_8_1_scalar k;
+    int i;
+
+    rand_point(&y);
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_const_table_build(table, &y, SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS);
+    for (i = 0; i < 8; i++) {
+        switch (i) {
+        case 0: rustsecp256k1zkp_v0_8_1_scalar_set_int(&k, 0); break;
+        case 1: rustsecp256k1zkp_v0_8_1_scalar_set_int(&k, 1); break;
+        case 2: rustsecp256k1zkp_v0_8_1_scalar_negate(&k, &rustsecp256k1zkp_v0_8_1_scalar_one); break;
+        default: rand_scalar(&k);
+        }
+        rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(&r1, table, SECP256K1_ECDSA_ADAPTOR_ENCKEY_WINDOWS, &k);
+        rustsecp256k1zkp_v0_8_1_ecmult_const(&r2, &y, &k);
+        rustsecp256k1zkp_v0_8_1_gej_neg(&r2, &r2);
+        rustsecp256k1zkp_v0_8_1_gej_add_var(&r1, &r1, &r2, NULL);
+        CHECK(rustsecp256k1zkp_v0_8_1_gej_is_infinity(&r1));
+    }
+}
+
+static void test_ecdsa_adaptor_encrypt_prepared(void) {
+    static rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_prepared_enckey prepared;
+    unsigned char seckey[32];
+    unsigned char deckey[32];
+    unsigned char msg[32];
+    unsigned char asig1[162], asig2[162];
+    unsigned char aux_rand[32];
+    rustsecp256k1zkp_v0_8_1_pubkey pubkey, enckey, zero_pk;
+    int ecount = 0;
+    int i;
+
+    rustsecp256k1zkp_v0_8_1_testrand256(seckey);
+    rustsecp256k1zkp_v0_8_1_testrand256(deckey);
+    rustsecp256k1zkp_v0_8_1_testrand256(aux_rand);
+    CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &pubkey, seckey) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &enckey, deckey) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(CTX, &prepared, &enckey) == 1);
+
+    for (i = 0; i < 4; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(msg);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(CTX, asig1, seckey, &enckey, msg, NULL, i % 2 ? aux_rand : NULL) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, asig2, seckey, &prepared, msg, NULL, i % 2 ? aux_rand : NULL) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(asig1, asig2, sizeof(asig1)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(CTX, asig2, &pubkey, msg, &enckey) == 1);
+    }
+
+    memset(&zero_pk, 0, sizeof(zero_pk));
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(CTX, NULL, &enckey) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(CTX, &prepared, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(CTX, &prepared, &zero_pk) == 0);
+    CHECK(ecount == 3);
+    /* prepared was zeroed by the failed call */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, asig2, seckey, &prepared, msg, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare(CTX, &prepared, &enckey) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(STATIC_CTX, asig2, seckey, &prepared, msg, NULL, NULL) == 0);
+    CHECK(ecount == 5);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, NULL, seckey, &prepared, msg, NULL, NULL) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, asig2, NULL, &prepared, msg, NULL, NULL) == 0);
+    CHECK(ecount == 7);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, asig2, seckey, NULL, msg, NULL, NULL) == 0);
+    CHECK(ecount == 8);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared(CTX, asig2, seckey, &prepared, NULL, NULL, NULL) == 0);
+    CHECK(ecount == 9);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
+}
+
+static void test_ecdsa_adaptor_verify_batch(void) {
+    unsigned char seckeys[2][32];
+    unsigned char deckeys[32][32];
+    unsigned char msgs[32][32];
+    unsigned char asigs[32][162];
+    rustsecp256k1zkp_v0_8_1_pubkey pubkeys[2];
+    rustsecp256k1zkp_v0_8_1_pubkey enckeys[32];
+    const unsigned char *asig_ptrs[32];
+    const unsigned char *msg_ptrs[32];
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey_ptrs[32];
+    const rustsecp256k1zkp_v0_8_1_pubkey *enckey_ptrs[32];
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch;
+    size_t i;
+
+    for (i = 0; i < 2; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(seckeys[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &pubkeys[i], seckeys[i]) == 1);
+    }
+    /* As in a DLC, most signatures share a signing key but have distinct
+     * encryption keys. */
+    for (i = 0; i < 32; i++) {
+        size_t signer = i % 5 == 0;
+        rustsecp256k1zkp_v0_8_1_testrand256(deckeys[i]);
+        rustsecp256k1zkp_v0_8_1_testrand256(msgs[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &enckeys[i], deckeys[i]) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt(CTX, asigs[i], seckeys[signer], &enckeys[i], msgs[i], NULL, NULL) == 1);
+        asig_ptrs[i] = asigs[i];
+        msg_ptrs[i] = msgs[i];
+        pubkey_ptrs[i] = &pubkeys[signer];
+        enckey_ptrs[i] = &enckeys[i];
+    }
+
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 1024 * 1024);
+    for (i = 0; i <= 32; i += 8) {
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, i) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, i) == 1);
+    }
+
+    /* Wrong message only breaks the ECDSA relation, which is batched. */
+    msg_ptrs[17] = msgs[18];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, NULL, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 17) == 1);
+    msg_ptrs[17] = msgs[17];
+    /* Wrong signing key */
+    pubkey_ptrs[3] = &pubkeys[1];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    pubkey_ptrs[3] = &pubkeys[0];
+    /* Wrong encryption key breaks the DLEQ proof. */
+    enckey_ptrs[30] = &enckeys[31];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    enckey_ptrs[30] = &enckeys[30];
+    /* Swapping two signatures for the same key and message set */
+    asig_ptrs[1] = asigs[2];
+    asig_ptrs[2] = asigs[1];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    asig_ptrs[1] = asigs[1];
+    asig_ptrs[2] = asigs[2];
+    /* Invalid s' */
+    rand_flip_bit(&asigs[9][66], 32);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify(CTX, asigs[9], pubkey_ptrs[9], msgs[9], &enckeys[9]) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch(CTX, scratch, asig_ptrs, pubkey_ptrs, msg_ptrs, enckey_ptrs, 32) == 0);
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+}
+
+/* Returns the 32 bytes pointed to by data as the nonce, so that the tests can
+ * sign with the nonces announced by an oracle. */
+static int ecdsa_adaptor_attestation_nonce_function(unsigned char *nonce32, const unsigned char *msg, size_t msglen, const unsigned char *key32, const unsigned char *xonly_pk32, const unsigned char *algo, size_t algolen, void *data) {
+    (void) msg;
+    (void) msglen;
+    (void) key32;
+    (void) xonly_pk32;
+    (void) algo;
+    (void) algolen;
+    memcpy(nonce32, data, 32);
+    return 1;
+}
+
+static void test_ecdsa_adaptor_compute_attestation_points(void) {
+    enum { N_DIGITS = 3, BASE = 3, N_POINTS = 27 };
+    unsigned char oracle_sk[32];
+    unsigned char nonce_sks[N_DIGITS][32];
+    unsigned char msgs[BASE][32];
+    unsigned char sig[64];
+    const unsigned char *msg_ptrs[BASE];
+    rustsecp256k1zkp_v0_8_1_keypair oracle_keypair;
+    rustsecp256k1zkp_v0_8_1_keypair keypair;
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey oracle_pk;
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey nonces[N_DIGITS];
+    rustsecp256k1zkp_v0_8_1_pubkey digit_points[N_DIGITS * BASE];
+    rustsecp256k1zkp_v0_8_1_pubkey points[N_POINTS];
+    rustsecp256k1zkp_v0_8_1_pubkey expected;
+    rustsecp256k1zkp_v0_8_1_scalar attestations[N_DIGITS * BASE];
+    rustsecp256k1zkp_v0_8_1_scalar sum;
+    rustsecp256k1zkp_v0_8_1_schnorrsig_extraparams extraparams = SECP256K1_SCHNORRSIG_EXTRAPARAMS_INIT;
+    unsigned char sum32[32];
+    size_t i, j, d;
+    int ecount = 0;
+
+    rustsecp256k1zkp_v0_8_1_testrand256(oracle_sk);
+    CHECK(rustsecp256k1zkp_v0_8_1_keypair_create(CTX, &oracle_keypair, oracle_sk) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_keypair_xonly_pub(CTX, &oracle_pk, NULL, &oracle_keypair) == 1);
+    for (j = 0; j < N_DIGITS; j++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(nonce_sks[j]);
+        CHECK(rustsecp256k1zkp_v0_8_1_keypair_create(CTX, &keypair, nonce_sks[j]) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_keypair_xonly_pub(CTX, &nonces[j], NULL, &keypair) == 1);
+    }
+    for (d = 0; d < BASE; d++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(msgs[d]);
+        msg_ptrs[d] = msgs[d];
+    }
+
+    /* The oracle attests to digit j having value d with a BIP-340 signature
+     * under nonce j, whose s value is the discrete log of S_{j,d}. */
+    extraparams.noncefp = ecdsa_adaptor_attestation_nonce_function;
+    for (j = 0; j < N_DIGITS; j++) {
+        extraparams.ndata = nonce_sks[j];
+        for (d = 0; d < BASE; d++) {
+            CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_custom(CTX, sig, msgs[d], 32, &oracle_keypair, &extraparams) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_verify(CTX, sig, msgs[d], 32, &oracle_pk) == 1);
+            rustsecp256k1zkp_v0_8_1_scalar_set_b32(&attestations[j*BASE + d], &sig[32], NULL);
+        }
+    }
+
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 1);
+    for (i = 0; i < N_DIGITS * BASE; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(sum32, &attestations[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &expected, sum32) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_cmp(CTX, &expected, &digit_points[i]) == 0);
+    }
+    for (i = 0; i < N_POINTS; i++) {
+        size_t rem = i;
+        rustsecp256k1zkp_v0_8_1_scalar_clear(&sum);
+        for (j = N_DIGITS; j-- > 0;) {
+            rustsecp256k1zkp_v0_8_1_scalar_add(&sum, &sum, &attestations[j*BASE + rem % BASE]);
+            rem /= BASE;
+        }
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(sum32, &sum);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &expected, sum32) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_cmp(CTX, &expected, &points[i]) == 0);
+    }
+
+    /* A single digit yields the digit points themselves. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, &nonces[1], 1, msg_ptrs, BASE, BASE) == 1);
+    for (d = 0; d < BASE; d++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_cmp(CTX, &digit_points[d], &points[d]) == 0);
+    }
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, NULL, points, &oracle_pk, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, NULL, &oracle_pk, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, NULL, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, NULL, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, N_DIGITS, NULL, BASE, N_POINTS) == 0);
+    CHECK(ecount == 5);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, 0, msg_ptrs, BASE, 1) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, N_DIGITS, msg_ptrs, 1, 1) == 0);
+    CHECK(ecount == 7);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS - 1) == 0);
+    CHECK(ecount == 8);
+    /* base^n_digits overflows */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, 8 * sizeof(size_t), msg_ptrs, 2, 0) == 0);
+    CHECK(ecount == 9);
+    msg_ptrs[1] = NULL;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points(CTX, digit_points, points, &oracle_pk, nonces, N_DIGITS, msg_ptrs, BASE, N_POINTS) == 0);
+    CHECK(ecount == 10);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+}
+
 static void adaptor_tests(void) {
     unsigned char seckey[32];
     rustsecp256k1zkp_v0_8_1_pubkey pubkey;
@@ -1191,6 +1463,10 @@ static void run_ecdsa_adaptor_tests(void) {
     for (i = 0; i < COUNT; i++) {
         adaptor_tests();
     }
+    test_ecdsa_adaptor_verify_batch();
+    test_ecdsa_adaptor_enckey_table();
+    test_ecdsa_adaptor_encrypt_prepared();
+    test_ecdsa_adaptor_compute_attestation_points();
     for (i = 0; i < COUNT; i++) {
         multi_hop_lock_tests();
     }
@@ -33,36 +33,14 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_s2c_opening_serialize(const rustsecp256k1zkp_v
     return rustsecp256k1zkp_v0_8_1_ec_pubkey_serialize(ctx, output33, &out_len, (const rustsecp256k1zkp_v0_8_1_pubkey*) opening, SECP256K1_EC_COMPRESSED);
 }
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("s2c/ecdsa/point")||SHA256("s2c/ecdsa/point"). */
+/* Initializes SHA256 as a tagged hash with tag "s2c/ecdsa/point". */
 static void rustsecp256k1zkp_v0_8_1_s2c_ecdsa_point_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0xa9b21c7bul;
-    sha->s[1] = 0x358c3e3eul;
-    sha->s[2] = 0x0b6863d1ul;
-    sha->s[3] = 0xc62b2035ul;
-    sha->s[4] = 0xb44b40ceul;
-    sha->s[5] = 0x254a8912ul;
-    sha->s[6] = 0x0f85d0d4ul;
-    sha->s[7] = 0x8a5bf91cul;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_S2C_ECDSA_POINT);
 }
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("s2c/ecdsa/data")||SHA256("s2c/ecdsa/data"). */
+/* Initializes SHA256 as a tagged hash with tag "s2c/ecdsa/data". */
 static void rustsecp256k1zkp_v0_8_1_s2c_ecdsa_data_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0xfeefd675ul;
-    sha->s[1] = 0x73166c99ul;
-    sha->s[2] = 0xe2309cb8ul;
-    sha->s[3] = 0x6d458113ul;
-    sha->s[4] = 0x01d3a512ul;
-    sha->s[5] = 0x00e18112ul;
-    sha->s[6] = 0x37ee0874ul;
-    sha->s[7] = 0x421fc55ful;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_S2C_ECDSA_DATA);
 }
 
 int rustsecp256k1zkp_v0_8_1_ecdsa_s2c_sign(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_ecdsa_signature* signature, rustsecp256k1zkp_v0_8_1_ecdsa_s2c_opening* s2c_opening, const unsigned char
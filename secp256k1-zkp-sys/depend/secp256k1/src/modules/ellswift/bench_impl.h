@@ -12,6 +12,11 @@ typedef struct {
     rustsecp256k1zkp_v0_8_1_context *ctx;
     rustsecp256k1zkp_v0_8_1_pubkey point[256];
     unsigned char rnd64[64];
+    unsigned char seckeys32[256][32];
+    unsigned char ell64s[256][64];
+    const unsigned char *seckey_ptrs[256];
+    const unsigned char *ell64_ptrs[256];
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret secret;
 } bench_ellswift_data;
 
 static void bench_ellswift_setup(void *arg) {
@@ -36,6 +41,14 @@ static void bench_ellswift_setup(void *arg) {
         }
     }
     CHECK(rustsecp256k1zkp_v0_8_1_ellswift_encode(data->ctx, data->rnd64, &data->point[255], init + 16));
+    for (i = 0; i < 256; ++i) {
+        memcpy(data->seckeys32[i], init, 32);
+        data->seckeys32[i][31] = i;
+        data->seckey_ptrs[i] = data->seckeys32[i];
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_encode(data->ctx, data->ell64s[i], &data->point[i], init + 32));
+        data->ell64_ptrs[i] = data->ell64s[i];
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(data->ctx, &data->secret, data->seckeys32[0]));
 }
 
 static void bench_ellswift_encode(void *arg, int iters) {
@@ -71,6 +84,27 @@ static void bench_ellswift_decode(void *arg, int iters) {
     }
 }
 
+static void bench_ellswift_create_batch(void *arg, int iters) {
+    int i;
+    bench_ellswift_data *data = (bench_ellswift_data*)arg;
+
+    for (i = 0; i < iters; i += 256) {
+        size_t n = iters - i < 256 ? iters - i : 256;
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(data->ctx, data->ell64s[0], data->seckey_ptrs, NULL, n));
+    }
+}
+
+static void bench_ellswift_decode_batch(void *arg, int iters) {
+    int i;
+    rustsecp256k1zkp_v0_8_1_pubkey out[256];
+    bench_ellswift_data *data = (bench_ellswift_data*)arg;
+
+    for (i = 0; i < iters; i += 256) {
+        size_t n = iters - i < 256 ? iters - i : 256;
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(data->ctx, out, data->ell64_ptrs, n) == 1);
+    }
+}
+
 static void bench_ellswift_xdh(void *arg, int iters) {
     int i;
     bench_ellswift_data *data = (bench_ellswift_data*)arg;
@@ -88,6 +122,22 @@ static void bench_ellswift_xdh(void *arg, int iters) {
     }
 }
 
+static void bench_ellswift_xdh_with_secret(void *arg, int iters) {
+    int i;
+    bench_ellswift_data *data = (bench_ellswift_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(data->ctx,
+                                     data->rnd64 + (i % 33),
+                                     data->rnd64,
+                                     data->rnd64,
+                                     &data->secret,
+                                     i & 1,
+                                     rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324,
+                                     NULL) == 1);
+    }
+}
+
 void run_ellswift_bench(int iters, int argc, char **argv) {
     bench_ellswift_data data;
     int d = argc == 1;
@@ -98,7 +148,10 @@ void run_ellswift_bench(int iters, int argc, char **argv) {
     if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "encode") || have_flag(argc, argv, "ellswift_encode")) run_benchmark("ellswift_encode", bench_ellswift_encode, bench_ellswift_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "decode") || have_flag(argc, argv, "ellswift_decode")) run_benchmark("ellswift_decode", bench_ellswift_decode, bench_ellswift_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "keygen") || have_flag(argc, argv, "ellswift_keygen")) run_benchmark("ellswift_keygen", bench_ellswift_create, bench_ellswift_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "ellswift_decode_batch")) run_benchmark("ellswift_decode_batch", bench_ellswift_decode_batch, bench_ellswift_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "ellswift_keygen_batch")) run_benchmark("ellswift_keygen_batch", bench_ellswift_create_batch, bench_ellswift_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "ecdh") || have_flag(argc, argv, "ellswift_ecdh")) run_benchmark("ellswift_ecdh", bench_ellswift_xdh, bench_ellswift_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ellswift") || have_flag(argc, argv, "ellswift_ecdh_secret")) run_benchmark("ellswift_ecdh_secret", bench_ellswift_xdh_with_secret, bench_ellswift_setup, NULL, &data, 10, iters);
 
     rustsecp256k1zkp_v0_8_1_context_destroy(data.ctx);
 }
@@ -147,26 +147,42 @@ static void rustsecp256k1zkp_v0_8_1_ellswift_swiftec_var(rustsecp256k1zkp_v0_8_1
     rustsecp256k1zkp_v0_8_1_ge_set_xo_var(p, &x, rustsecp256k1zkp_v0_8_1_fe_is_odd(t));
 }
 
-/* Try to complete an ElligatorSwift encoding (u, t) for X coordinate x, given u and x.
- *
- * There may be up to 8 distinct t values such that (u, t) decodes back to x, but also
- * fewer, or none at all. Each such partial inverse can be accessed individually using a
- * distinct input argument c (in range 0-7), and some or all of these may return failure.
- * The following guarantees exist:
- * - Given (x, u), no two distinct c values give the same successful result t.
- * - Every successful result maps back to x through rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_var.
- * - Given (x, u), all t values that map back to x can be reached by combining the
- *   successful results from this function over all c values, with the exception of:
- *   - this function cannot be called with u=0
- *   - no result with t=0 will be returned
- *   - no result for which u^3 + t^2 + 7 = 0 will be returned.
- *
- * The rather unusual encoding of bits in c (a large "if" based on the middle bit, and then
- * using the low and high bits to pick signs of square roots) is to match the paper's
- * encoding more closely: c=0 through c=3 match branches 1..4 in the paper, while c=4 through
- * c=7 are copies of those with an additional negation of sqrt(w).
- */
-static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0_8_1_fe *t, const rustsecp256k1zkp_v0_8_1_fe *x_in, const rustsecp256k1zkp_v0_8_1_fe *u_in, int c) {
+/* Number of encodings whose field inversions are combined into one in
+ * ellswift_decode_batch and ellswift_create_batch. */
+#define SECP256K1_ELLSWIFT_BATCH 32
+
+/** Set r[i] = 1/a[i] for the len nonzero field elements a[i] with a single inversion. r and a
+ *  must not overlap. */
+static void rustsecp256k1zkp_v0_8_1_ellswift_fe_inv_all_var(rustsecp256k1zkp_v0_8_1_fe *r, const rustsecp256k1zkp_v0_8_1_fe *a, size_t len) {
+    rustsecp256k1zkp_v0_8_1_fe u;
+    size_t i;
+
+    if (len == 0) {
+        return;
+    }
+    r[0] = a[0];
+    for (i = 1; i < len; i++) {
+        rustsecp256k1zkp_v0_8_1_fe_mul(&r[i], &r[i - 1], &a[i]);      /* r[i] = a[0]*...*a[i] */
+    }
+    rustsecp256k1zkp_v0_8_1_fe_inv_var(&u, &r[len - 1]);             /* u = 1/(a[0]*...*a[len-1]) */
+    for (i = len - 1; i > 0; i--) {
+        rustsecp256k1zkp_v0_8_1_fe_mul(&r[i], &r[i - 1], &u);         /* r[i] = 1/a[i] */
+        rustsecp256k1zkp_v0_8_1_fe_mul(&u, &u, &a[i]);                /* u = 1/(a[0]*...*a[i-1]) */
+    }
+    r[0] = u;
+}
+
+/* The state of rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var after all checks that can
+ * fail, before s is inverted. n is the numerator (u^3+7) of s if (c & 2) = 0,
+ * and r otherwise. */
+typedef struct {
+    rustsecp256k1zkp_v0_8_1_fe x, u, s, n;
+    int c;
+} rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_state;
+
+/* The part of rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var up to the inversion of s, so
+ * that the inversions of many calls can be combined. */
+static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_prepare_var(rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_state *st, const rustsecp256k1zkp_v0_8_1_fe *x_in, const rustsecp256k1zkp_v0_8_1_fe *u_in, int c) {
     /* The implemented algorithm is this (all arithmetic, except involving c, is mod p):
      *
      * - If (c & 2) = 0:
@@ -187,7 +203,7 @@ static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0
      * - If (c & 5) = 4: return  w*(c3*u + v).
      * - If (c & 5) = 5: return -w*(c4*u + v).
      */
-    rustsecp256k1zkp_v0_8_1_fe x = *x_in, u = *u_in, g, v, s, m, r, q;
+    rustsecp256k1zkp_v0_8_1_fe x = *x_in, u = *u_in, g, s, m, r, q;
     int ret;
 
     rustsecp256k1zkp_v0_8_1_fe_normalize_weak(&x);
@@ -243,12 +259,8 @@ static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0
         rustsecp256k1zkp_v0_8_1_fe_mul(&m, &s, &g);                   /* m = -(u^3 + 7)*(u^2 + u*x + x^2) */
         if (!rustsecp256k1zkp_v0_8_1_fe_is_square_var(&m)) return 0;
 
-        /* Let s = -(u^3 + 7)/(u^2 + u*x + x^2) [second part] */
-        rustsecp256k1zkp_v0_8_1_fe_inv_var(&s, &s);                   /* s = -1/(u^2 + u*x + x^2) [no div by 0] */
-        rustsecp256k1zkp_v0_8_1_fe_mul(&s, &s, &g);                   /* s = -(u^3 + 7)/(u^2 + u*x + x^2) */
-
-        /* Let v = x. */
-        v = x;
+        /* The division of s is done in finish. */
+        st->n = g;
     } else {
         /* c is in {2, 3, 6, 7}. In this case we look for an inverse under the x3 formula. */
 
@@ -280,9 +292,33 @@ static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0
         /* If s = 0, fail. */
         if (EXPECT(rustsecp256k1zkp_v0_8_1_fe_normalizes_to_zero_var(&s), 0)) return 0;
 
+        /* v = (r/s-u)/2 is computed in finish. */
+        st->n = r;
+    }
+
+    st->x = x;
+    st->u = u;
+    st->s = s;
+    st->c = c;
+    return 1;
+}
+
+/* The rest of rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var, given sinv = 1/s. */
+static void rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_finish_var(rustsecp256k1zkp_v0_8_1_fe *t, const rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_state *st, const rustsecp256k1zkp_v0_8_1_fe *sinv) {
+    rustsecp256k1zkp_v0_8_1_fe u = st->u, s = st->s, v, m;
+    int c = st->c;
+    int ret;
+
+    if (!(c & 2)) {
+        /* Let s = -(u^3 + 7)/(u^2 + u*x + x^2) [second part] */
+        rustsecp256k1zkp_v0_8_1_fe_mul(&s, sinv, &st->n);             /* s = -(u^3 + 7)/(u^2 + u*x + x^2) */
+
+        /* Let v = x. */
+        v = st->x;
+    } else {
         /* Let v = (r/s-u)/2. */
-        rustsecp256k1zkp_v0_8_1_fe_inv_var(&v, &s);                   /* v = 1/s [no div by 0] */
-        rustsecp256k1zkp_v0_8_1_fe_mul(&v, &v, &r);                   /* v = r/s */
+        rustsecp256k1zkp_v0_8_1_fe_negate(&m, &u, 1);                 /* m = -u */
+        rustsecp256k1zkp_v0_8_1_fe_mul(&v, sinv, &st->n);             /* v = r/s */
         rustsecp256k1zkp_v0_8_1_fe_add(&v, &m);                       /* v = r/s-u */
         rustsecp256k1zkp_v0_8_1_fe_half(&v);                          /* v = (r/s-u)/2 */
     }
@@ -300,6 +336,34 @@ static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0
     /* u = {c4 if c&1=1; c3 otherwise}*u */
     rustsecp256k1zkp_v0_8_1_fe_add(&u, &v);                           /* u = {c4 if c&1=1; c3 otherwise}*u + v */
     rustsecp256k1zkp_v0_8_1_fe_mul(t, &m, &u);
+}
+
+/* Try to complete an ElligatorSwift encoding (u, t) for X coordinate x, given u and x.
+ *
+ * There may be up to 8 distinct t values such that (u, t) decodes back to x, but also
+ * fewer, or none at all. Each such partial inverse can be accessed individually using a
+ * distinct input argument c (in range 0-7), and some or all of these may return failure.
+ * The following guarantees exist:
+ * - Given (x, u), no two distinct c values give the same successful result t.
+ * - Every successful result maps back to x through rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_var.
+ * - Given (x, u), all t values that map back to x can be reached by combining the
+ *   successful results from this function over all c values, with the exception of:
+ *   - this function cannot be called with u=0
+ *   - no result with t=0 will be returned
+ *   - no result for which u^3 + t^2 + 7 = 0 will be returned.
+ *
+ * The rather unusual encoding of bits in c (a large "if" based on the middle bit, and then
+ * using the low and high bits to pick signs of square roots) is to match the paper's
+ * encoding more closely: c=0 through c=3 match branches 1..4 in the paper, while c=4 through
+ * c=7 are copies of those with an additional negation of sqrt(w).
+ */
+static int rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_var(rustsecp256k1zkp_v0_8_1_fe *t, const rustsecp256k1zkp_v0_8_1_fe *x_in, const rustsecp256k1zkp_v0_8_1_fe *u_in, int c) {
+    rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_state st;
+    rustsecp256k1zkp_v0_8_1_fe sinv;
+
+    if (!rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_prepare_var(&st, x_in, u_in, c)) return 0;
+    rustsecp256k1zkp_v0_8_1_fe_inv_var(&sinv, &st.s);                 /* [no div by 0] */
+    rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_finish_var(t, &st, &sinv);
     return 1;
 }
 
@@ -384,19 +448,75 @@ static void rustsecp256k1zkp_v0_8_1_ellswift_elligatorswift_var(unsigned char *u
     }
 }
 
+/** Find ElligatorSwift encodings for the n <= SECP256K1_ELLSWIFT_BATCH points p[i].
+ *
+ * The result for p[i] is the same as rustsecp256k1zkp_v0_8_1_ellswift_elligatorswift_var with
+ * hashers[i] gives, stored as u || t in ell64s[64*i..64*i+64]. All points try their next
+ * candidate u at the same time, so the inversions of the candidates that get to that point
+ * are combined. */
+static void rustsecp256k1zkp_v0_8_1_ellswift_elligatorswift_batch_var(unsigned char *ell64s, const rustsecp256k1zkp_v0_8_1_ge *p, const rustsecp256k1zkp_v0_8_1_sha256 *hashers, size_t n) {
+    unsigned char branch_hash[SECP256K1_ELLSWIFT_BATCH][32];
+    int branches_left[SECP256K1_ELLSWIFT_BATCH];
+    uint32_t cnt[SECP256K1_ELLSWIFT_BATCH];
+    int done[SECP256K1_ELLSWIFT_BATCH];
+    rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_state st[SECP256K1_ELLSWIFT_BATCH];
+    rustsecp256k1zkp_v0_8_1_fe s[SECP256K1_ELLSWIFT_BATCH], sinv[SECP256K1_ELLSWIFT_BATCH];
+    size_t idx[SECP256K1_ELLSWIFT_BATCH];
+    size_t n_left = n;
+    size_t i, j, k;
+
+    VERIFY_CHECK(n <= SECP256K1_ELLSWIFT_BATCH);
+    for (i = 0; i < n; i++) {
+        branches_left[i] = 0;
+        cnt[i] = 0;
+        done[i] = 0;
+    }
+    while (n_left > 0) {
+        /* One iteration of the loop in rustsecp256k1zkp_v0_8_1_ellswift_xelligatorswift_var for
+         * every point that has no encoding yet. */
+        k = 0;
+        for (i = 0; i < n; i++) {
+            int branch;
+            rustsecp256k1zkp_v0_8_1_fe u;
+            if (done[i]) continue;
+            if (branches_left[i] == 0) {
+                rustsecp256k1zkp_v0_8_1_ellswift_prng(branch_hash[i], &hashers[i], cnt[i]++);
+                branches_left[i] = 64;
+            }
+            --branches_left[i];
+            branch = (branch_hash[i][branches_left[i] >> 1] >> ((branches_left[i] & 1) << 2)) & 7;
+            rustsecp256k1zkp_v0_8_1_ellswift_prng(&ell64s[64 * i], &hashers[i], cnt[i]++);
+            rustsecp256k1zkp_v0_8_1_fe_set_b32_mod(&u, &ell64s[64 * i]);
+#ifdef VERIFY
+            VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_fe_normalizes_to_zero_var(&u));
+#endif
+            if (EXPECT(rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_prepare_var(&st[k], &p[i].x, &u, branch), 0)) {
+                s[k] = st[k].s;
+                idx[k] = i;
+                k++;
+            }
+        }
+
+        rustsecp256k1zkp_v0_8_1_ellswift_fe_inv_all_var(sinv, s, k);
+        for (j = 0; j < k; j++) {
+            rustsecp256k1zkp_v0_8_1_fe t;
+            i = idx[j];
+            rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_inv_finish_var(&t, &st[j], &sinv[j]);
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&t);
+            if (rustsecp256k1zkp_v0_8_1_fe_is_odd(&t) != rustsecp256k1zkp_v0_8_1_fe_is_odd(&p[i].y)) {
+                rustsecp256k1zkp_v0_8_1_fe_negate(&t, &t, 1);
+                rustsecp256k1zkp_v0_8_1_fe_normalize_var(&t);
+            }
+            rustsecp256k1zkp_v0_8_1_fe_get_b32(&ell64s[64 * i + 32], &t);
+            done[i] = 1;
+            n_left--;
+        }
+    }
+}
+
 /** Set hash state to the BIP340 tagged hash midstate for "rustsecp256k1zkp_v0_8_1_ellswift_encode". */
 static void rustsecp256k1zkp_v0_8_1_ellswift_sha256_init_encode(rustsecp256k1zkp_v0_8_1_sha256* hash) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(hash);
-    hash->s[0] = 0xd1a6524bul;
-    hash->s[1] = 0x028594b3ul;
-    hash->s[2] = 0x96e42f4eul;
-    hash->s[3] = 0x1037a177ul;
-    hash->s[4] = 0x1b8fcb8bul;
-    hash->s[5] = 0x56023885ul;
-    hash->s[6] = 0x2560ede1ul;
-    hash->s[7] = 0xd626b715ul;
-
-    hash->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(hash, SECP256K1_TAG_ELLSWIFT_ENCODE);
 }
 
 int rustsecp256k1zkp_v0_8_1_ellswift_encode(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *ell64, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const unsigned char *rnd32) {
@@ -433,17 +553,7 @@ int rustsecp256k1zkp_v0_8_1_ellswift_encode(const rustsecp256k1zkp_v0_8_1_contex
 
 /** Set hash state to the BIP340 tagged hash midstate for "rustsecp256k1zkp_v0_8_1_ellswift_create". */
 static void rustsecp256k1zkp_v0_8_1_ellswift_sha256_init_create(rustsecp256k1zkp_v0_8_1_sha256* hash) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(hash);
-    hash->s[0] = 0xd29e1bf5ul;
-    hash->s[1] = 0xf7025f42ul;
-    hash->s[2] = 0x9b024773ul;
-    hash->s[3] = 0x094cb7d5ul;
-    hash->s[4] = 0xe59ed789ul;
-    hash->s[5] = 0x03bc9786ul;
-    hash->s[6] = 0x68335b35ul;
-    hash->s[7] = 0x4e363b53ul;
-
-    hash->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(hash, SECP256K1_TAG_ELLSWIFT_CREATE);
 }
 
 int rustsecp256k1zkp_v0_8_1_ellswift_create(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *ell64, const unsigned char *seckey32, const unsigned char *auxrnd32) {
@@ -500,6 +610,100 @@ int rustsecp256k1zkp_v0_8_1_ellswift_decode(const rustsecp256k1zkp_v0_8_1_contex
     return 1;
 }
 
+int rustsecp256k1zkp_v0_8_1_ellswift_create_batch(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *ell64s, const unsigned char * const *seckeys32, const unsigned char * const *auxrnds32, size_t n) {
+    rustsecp256k1zkp_v0_8_1_gej pj[SECP256K1_ELLSWIFT_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge p[SECP256K1_ELLSWIFT_BATCH];
+    rustsecp256k1zkp_v0_8_1_sha256 hash[SECP256K1_ELLSWIFT_BATCH];
+    int ret_key[SECP256K1_ELLSWIFT_BATCH];
+    rustsecp256k1zkp_v0_8_1_scalar seckey_scalar;
+    static const unsigned char zero32[32] = {0};
+    int ret = 1;
+    size_t i, j;
+
+    /* Sanity check inputs. */
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || ell64s != NULL);
+    if (n > 0) {
+        memset(ell64s, 0, 64 * n);
+    }
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || seckeys32 != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(seckeys32[i] != NULL);
+    }
+
+    for (i = 0; i < n; i += SECP256K1_ELLSWIFT_BATCH) {
+        size_t len = n - i < SECP256K1_ELLSWIFT_BATCH ? n - i : SECP256K1_ELLSWIFT_BATCH;
+        for (j = 0; j < len; j++) {
+            ret_key[j] = rustsecp256k1zkp_v0_8_1_scalar_set_b32_seckey(&seckey_scalar, seckeys32[i + j]);
+            rustsecp256k1zkp_v0_8_1_scalar_cmov(&seckey_scalar, &rustsecp256k1zkp_v0_8_1_scalar_one, !ret_key[j]);
+            rustsecp256k1zkp_v0_8_1_ecmult_gen(&ctx->ecmult_gen_ctx, &pj[j], &seckey_scalar);
+
+            /* Set up hasher state like rustsecp256k1zkp_v0_8_1_ellswift_create. */
+            rustsecp256k1zkp_v0_8_1_ellswift_sha256_init_create(&hash[j]);
+            rustsecp256k1zkp_v0_8_1_sha256_write(&hash[j], seckeys32[i + j], 32);
+            rustsecp256k1zkp_v0_8_1_sha256_write(&hash[j], zero32, sizeof(zero32));
+            rustsecp256k1zkp_v0_8_1_declassify(ctx, &hash[j], sizeof(hash[j])); /* private key is hashed now */
+            if (auxrnds32 != NULL && auxrnds32[i + j] != NULL) {
+                rustsecp256k1zkp_v0_8_1_sha256_write(&hash[j], auxrnds32[i + j], 32);
+            }
+        }
+
+        /* Compute the (affine) public keys with a single inversion. */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej(p, pj, len);
+        rustsecp256k1zkp_v0_8_1_declassify(ctx, p, len * sizeof(*p)); /* not constant time in produced pubkey */
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&p[j].x);
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&p[j].y);
+        }
+
+        rustsecp256k1zkp_v0_8_1_ellswift_elligatorswift_batch_var(&ell64s[64 * i], p, hash, len);
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_memczero(&ell64s[64 * (i + j)], 64, !ret_key[j]);
+            ret &= ret_key[j];
+            rustsecp256k1zkp_v0_8_1_gej_clear(&pj[j]);
+        }
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&seckey_scalar);
+
+    return ret;
+}
+
+int rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(const rustsecp256k1zkp_v0_8_1_context *ctx, rustsecp256k1zkp_v0_8_1_pubkey *pubkeys, const unsigned char * const *ell64s, size_t n) {
+    rustsecp256k1zkp_v0_8_1_fe xn[SECP256K1_ELLSWIFT_BATCH], xd[SECP256K1_ELLSWIFT_BATCH], xdinv[SECP256K1_ELLSWIFT_BATCH];
+    int t_odd[SECP256K1_ELLSWIFT_BATCH];
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    ARG_CHECK(n == 0 || ell64s != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(ell64s[i] != NULL);
+    }
+
+    for (i = 0; i < n; i += SECP256K1_ELLSWIFT_BATCH) {
+        size_t len = n - i < SECP256K1_ELLSWIFT_BATCH ? n - i : SECP256K1_ELLSWIFT_BATCH;
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_fe u, t;
+            rustsecp256k1zkp_v0_8_1_fe_set_b32_mod(&u, ell64s[i + j]);
+            rustsecp256k1zkp_v0_8_1_fe_set_b32_mod(&t, ell64s[i + j] + 32);
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&t);
+            rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_frac_var(&xn[j], &xd[j], &u, &t);
+            t_odd[j] = rustsecp256k1zkp_v0_8_1_fe_is_odd(&t);
+        }
+
+        /* The X coordinates of the whole batch need a single inversion. */
+        rustsecp256k1zkp_v0_8_1_ellswift_fe_inv_all_var(xdinv, xd, len);
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_fe x;
+            rustsecp256k1zkp_v0_8_1_ge p;
+            rustsecp256k1zkp_v0_8_1_fe_mul(&x, &xn[j], &xdinv[j]);
+            rustsecp256k1zkp_v0_8_1_ge_set_xo_var(&p, &x, t_odd[j]);
+            rustsecp256k1zkp_v0_8_1_pubkey_save(&pubkeys[i + j], &p);
+        }
+    }
+    return 1;
+}
+
 static int ellswift_xdh_hash_function_prefix(unsigned char *output, const unsigned char *x32, const unsigned char *ell_a64, const unsigned char *ell_b64, void *data) {
     rustsecp256k1zkp_v0_8_1_sha256 sha;
 
@@ -515,17 +719,7 @@ static int ellswift_xdh_hash_function_prefix(unsigned char *output, const unsign
 
 /** Set hash state to the BIP340 tagged hash midstate for "bip324_ellswift_xonly_ecdh". */
 static void rustsecp256k1zkp_v0_8_1_ellswift_sha256_init_bip324(rustsecp256k1zkp_v0_8_1_sha256* hash) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(hash);
-    hash->s[0] = 0x8c12d730ul;
-    hash->s[1] = 0x827bd392ul;
-    hash->s[2] = 0x9e4fb2eeul;
-    hash->s[3] = 0x207b373eul;
-    hash->s[4] = 0x2292bd7aul;
-    hash->s[5] = 0xaa5441bcul;
-    hash->s[6] = 0x15c3779ful;
-    hash->s[7] = 0xcfb52549ul;
-
-    hash->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(hash, SECP256K1_TAG_BIP324_ELLSWIFT_XONLY_ECDH);
 }
 
 static int ellswift_xdh_hash_function_bip324(unsigned char* output, const unsigned char *x32, const unsigned char *ell_a64, const unsigned char *ell_b64, void *data) {
@@ -545,34 +739,87 @@ static int ellswift_xdh_hash_function_bip324(unsigned char* output, const unsign
 const rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_prefix = ellswift_xdh_hash_function_prefix;
 const rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324 = ellswift_xdh_hash_function_bip324;
 
-int rustsecp256k1zkp_v0_8_1_ellswift_xdh(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *output, const unsigned char *ell_a64, const unsigned char *ell_b64, const unsigned char *seckey32, int party, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function hashfp, void *data) {
-    int ret = 0;
+/* An ellswift_xdh_secret stores the digits of ecmult_const_recoding. Each
+ * digit is odd with an absolute value below 2^(WINDOW_A - 1), so it is stored
+ * in WINDOW_A - 1 bits. The last byte holds the skews and a bit that is only
+ * set in valid secrets. */
+#define ELLSWIFT_XDH_DIGITS (1 + WNAF_SIZE(WINDOW_A - 1))
+#define ELLSWIFT_XDH_DIGITS_BYTES ((ELLSWIFT_XDH_DIGITS * (WINDOW_A - 1) + 7) / 8)
+
+static void rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_save(unsigned char *out, const int *wnaf) {
+    int j, k;
+
+    memset(out, 0, ELLSWIFT_XDH_DIGITS_BYTES);
+    for (j = 0; j < ELLSWIFT_XDH_DIGITS; j++) {
+        unsigned int v = (unsigned int)(wnaf[j] + (1 << (WINDOW_A - 1)) - 1) >> 1;
+        for (k = 0; k < WINDOW_A - 1; k++) {
+            int pos = j * (WINDOW_A - 1) + k;
+            out[pos >> 3] |= ((v >> k) & 1) << (pos & 7);
+        }
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_load(int *wnaf, const unsigned char *in) {
+    int j;
+
+    for (j = 0; j < ELLSWIFT_XDH_DIGITS; j++) {
+        int pos = j * (WINDOW_A - 1);
+        /* A digit spans at most two bytes. */
+        int v = in[pos >> 3];
+        if ((pos >> 3) + 1 < ELLSWIFT_XDH_DIGITS_BYTES) {
+            v |= in[(pos >> 3) + 1] << 8;
+        }
+        v = (v >> (pos & 7)) & ((1 << (WINDOW_A - 1)) - 1);
+        wnaf[j] = 2 * v - (1 << (WINDOW_A - 1)) + 1;
+    }
+}
+
+static void rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_save(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret, const rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec) {
+    STATIC_ASSERT(2 * ELLSWIFT_XDH_DIGITS_BYTES + 1 <= sizeof(secret->data));
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_save(secret->data, rec->wnaf_1);
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_save(secret->data + ELLSWIFT_XDH_DIGITS_BYTES, rec->wnaf_lam);
+    secret->data[sizeof(secret->data) - 1] = rec->skew_1 | (rec->skew_lam << 1) | 4;
+}
+
+/* Returns 0 if the secret was zeroed because it was created from an invalid
+ * secret key. */
+static int rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_load(rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec, const rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret) {
+    unsigned char flags = secret->data[sizeof(secret->data) - 1];
+
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_load(rec->wnaf_1, secret->data);
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_digits_load(rec->wnaf_lam, secret->data + ELLSWIFT_XDH_DIGITS_BYTES);
+    rec->skew_1 = flags & 1;
+    rec->skew_lam = (flags >> 1) & 1;
+    return (flags >> 2) & 1;
+}
+
+/* Loads our secret key as a scalar, using one if it is invalid, and returns
+ * whether it was valid. */
+static int rustsecp256k1zkp_v0_8_1_ellswift_xdh_load_seckey(rustsecp256k1zkp_v0_8_1_scalar *s, const unsigned char *seckey32) {
     int overflow;
-    rustsecp256k1zkp_v0_8_1_scalar s;
+
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(s, seckey32, &overflow);
+    overflow = rustsecp256k1zkp_v0_8_1_scalar_is_zero(s);
+    rustsecp256k1zkp_v0_8_1_scalar_cmov(s, &rustsecp256k1zkp_v0_8_1_scalar_one, overflow);
+    return !overflow;
+}
+
+/* Computes the shared X coordinate with the digits of our secret key and
+ * returns what hashfp returns. */
+static int rustsecp256k1zkp_v0_8_1_ellswift_xdh_recoded(unsigned char *output, const unsigned char *ell_a64, const unsigned char *ell_b64, const rustsecp256k1zkp_v0_8_1_ecmult_const_recoding *rec, int party, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function hashfp, void *data) {
+    int ret;
     rustsecp256k1zkp_v0_8_1_fe xn, xd, px, u, t;
     unsigned char sx[32];
     const unsigned char* theirs64;
 
-    VERIFY_CHECK(ctx != NULL);
-    ARG_CHECK(output != NULL);
-    ARG_CHECK(ell_a64 != NULL);
-    ARG_CHECK(ell_b64 != NULL);
-    ARG_CHECK(seckey32 != NULL);
-    ARG_CHECK(hashfp != NULL);
-
     /* Load remote public key (as fraction). */
     theirs64 = party ? ell_a64 : ell_b64;
     rustsecp256k1zkp_v0_8_1_fe_set_b32_mod(&u, theirs64);
     rustsecp256k1zkp_v0_8_1_fe_set_b32_mod(&t, theirs64 + 32);
     rustsecp256k1zkp_v0_8_1_ellswift_xswiftec_frac_var(&xn, &xd, &u, &t);
 
-    /* Load private key (using one if invalid). */
-    rustsecp256k1zkp_v0_8_1_scalar_set_b32(&s, seckey32, &overflow);
-    overflow = rustsecp256k1zkp_v0_8_1_scalar_is_zero(&s);
-    rustsecp256k1zkp_v0_8_1_scalar_cmov(&s, &rustsecp256k1zkp_v0_8_1_scalar_one, overflow);
-
     /* Compute shared X coordinate. */
-    rustsecp256k1zkp_v0_8_1_ecmult_const_xonly(&px, &xn, &xd, &s, 1);
+    rustsecp256k1zkp_v0_8_1_ecmult_const_xonly_recoded(&px, &xn, &xd, rec, 1);
     rustsecp256k1zkp_v0_8_1_fe_normalize(&px);
     rustsecp256k1zkp_v0_8_1_fe_get_b32(sx, &px);
 
@@ -581,9 +828,77 @@ int rustsecp256k1zkp_v0_8_1_ellswift_xdh(const rustsecp256k1zkp_v0_8_1_context *
 
     memset(sx, 0, 32);
     rustsecp256k1zkp_v0_8_1_fe_clear(&px);
+
+    return ret;
+}
+
+int rustsecp256k1zkp_v0_8_1_ellswift_xdh(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *output, const unsigned char *ell_a64, const unsigned char *ell_b64, const unsigned char *seckey32, int party, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function hashfp, void *data) {
+    int ret = 0;
+    int valid;
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoding rec;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(ell_a64 != NULL);
+    ARG_CHECK(ell_b64 != NULL);
+    ARG_CHECK(seckey32 != NULL);
+    ARG_CHECK(hashfp != NULL);
+
+    valid = rustsecp256k1zkp_v0_8_1_ellswift_xdh_load_seckey(&s, seckey32);
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recode(&rec, &s);
+    ret = rustsecp256k1zkp_v0_8_1_ellswift_xdh_recoded(output, ell_a64, ell_b64, &rec, party, hashfp, data);
+
     rustsecp256k1zkp_v0_8_1_scalar_clear(&s);
+    memset(&rec, 0, sizeof(rec));
+
+    return !!ret & !!valid;
+}
+
+int rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(const rustsecp256k1zkp_v0_8_1_context *ctx, rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret, const unsigned char *seckey32) {
+    int ret;
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoding rec;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secret != NULL);
+    memset(secret, 0, sizeof(*secret));
+    ARG_CHECK(seckey32 != NULL);
+
+    ret = rustsecp256k1zkp_v0_8_1_ellswift_xdh_load_seckey(&s, seckey32);
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recode(&rec, &s);
+    rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_save(secret, &rec);
+    rustsecp256k1zkp_v0_8_1_memczero(secret, sizeof(*secret), !ret);
+
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&s);
+    memset(&rec, 0, sizeof(rec));
+    return ret;
+}
+
+int rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(const rustsecp256k1zkp_v0_8_1_context *ctx, unsigned char *output, const unsigned char *ell_a64, const unsigned char *ell_b64, const rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret *secret, int party, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function hashfp, void *data) {
+    int ret, valid;
+    rustsecp256k1zkp_v0_8_1_ecmult_const_recoding rec;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(ell_a64 != NULL);
+    ARG_CHECK(ell_b64 != NULL);
+    ARG_CHECK(secret != NULL);
+    ARG_CHECK(hashfp != NULL);
+
+    valid = rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_load(&rec, secret);
+    /* We can declassify valid here because the secret is only invalid if
+     * ellswift_xdh_secret_create failed (which zeroes it) and its return value
+     * wasn't checked. */
+    rustsecp256k1zkp_v0_8_1_declassify(ctx, &valid, sizeof(valid));
+    if (!valid) {
+        memset(&rec, 0, sizeof(rec));
+        return 0;
+    }
+    ret = rustsecp256k1zkp_v0_8_1_ellswift_xdh_recoded(output, ell_a64, ell_b64, &rec, party, hashfp, data);
 
-    return !!ret & !overflow;
+    memset(&rec, 0, sizeof(rec));
+    return !!ret;
 }
 
 #endif
@@ -403,6 +403,127 @@ void run_ellswift_tests(void) {
         }
     }
 
+    /* Verify that the batch functions give the same results as the functions for a single key. */
+    for (i = 0; i < COUNT; i++) {
+        enum { N_KEYS = 70 };
+        unsigned char sec32[N_KEYS][32], auxrnd32[N_KEYS][32], ell64[N_KEYS][64], single64[64];
+        const unsigned char *sec_ptr[N_KEYS], *auxrnd_ptr[N_KEYS], *ell_ptr[N_KEYS];
+        rustsecp256k1zkp_v0_8_1_pubkey pub[N_KEYS], single;
+        rustsecp256k1zkp_v0_8_1_scalar sec;
+        int32_t ecount = 0;
+        size_t j;
+
+        for (j = 0; j < N_KEYS; j++) {
+            random_scalar_order_test(&sec);
+            rustsecp256k1zkp_v0_8_1_scalar_get_b32(sec32[j], &sec);
+            rustsecp256k1zkp_v0_8_1_testrand256_test(auxrnd32[j]);
+            sec_ptr[j] = sec32[j];
+            auxrnd_ptr[j] = (j % 3) ? auxrnd32[j] : NULL;
+            ell_ptr[j] = ell64[j];
+        }
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, ell64[0], sec_ptr, auxrnd_ptr, N_KEYS) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(CTX, pub, ell_ptr, N_KEYS) == 1);
+        for (j = 0; j < N_KEYS; j++) {
+            CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create(CTX, single64, sec32[j], auxrnd_ptr[j]) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(single64, ell64[j], 64) == 0);
+            CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode(CTX, &single, ell64[j]) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&single, &pub[j], sizeof(single)) == 0);
+        }
+        /* Without any auxiliary randomness. */
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, ell64[0], sec_ptr, NULL, N_KEYS) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create(CTX, single64, sec32[N_KEYS - 1], NULL) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(single64, ell64[N_KEYS - 1], 64) == 0);
+
+        /* An invalid secret key only zeroes its own public key. */
+        memset(sec32[1], 0, 32);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, ell64[0], sec_ptr, auxrnd_ptr, N_KEYS) == 0);
+        memset(single64, 0, 64);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(single64, ell64[1], 64) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create(CTX, single64, sec32[2], auxrnd_ptr[2]) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(single64, ell64[2], 64) == 0);
+
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, counting_illegal_callback_fn, &ecount);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, NULL, NULL, NULL, 0) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(CTX, NULL, NULL, 0) == 1);
+        CHECK(ecount == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, NULL, sec_ptr, auxrnd_ptr, N_KEYS) == 0);
+        CHECK(ecount == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(CTX, ell64[0], NULL, auxrnd_ptr, N_KEYS) == 0);
+        CHECK(ecount == 2);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_create_batch(STATIC_CTX, ell64[0], sec_ptr, auxrnd_ptr, N_KEYS) == 0);
+        CHECK(ecount == 3);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(CTX, NULL, ell_ptr, N_KEYS) == 0);
+        CHECK(ecount == 4);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(CTX, pub, NULL, N_KEYS) == 0);
+        CHECK(ecount == 5);
+        ell_ptr[N_KEYS - 1] = NULL;
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_decode_batch(CTX, pub, ell_ptr, N_KEYS) == 0);
+        CHECK(ecount == 6);
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
+    }
+
+    /* Verify that rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret gives the same shared secrets as rustsecp256k1zkp_v0_8_1_ellswift_xdh. */
+    for (i = 0; (unsigned)i < sizeof(ellswift_xdh_tests_bip324) / sizeof(ellswift_xdh_tests_bip324[0]); ++i) {
+        const struct ellswift_xdh_test *test = &ellswift_xdh_tests_bip324[i];
+        rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret secret;
+        unsigned char shared_secret[32];
+        int party = !test->initiating;
+        const unsigned char* ell_a64 = party ? test->ellswift_theirs : test->ellswift_ours;
+        const unsigned char* ell_b64 = party ? test->ellswift_ours   : test->ellswift_theirs;
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, &secret, test->priv_ours) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, shared_secret, ell_a64, ell_b64, &secret, party, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(shared_secret, test->shared_secret, 32) == 0);
+    }
+    for (i = 0; i < 20 * COUNT; i++) {
+        rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret secret, zero_secret;
+        unsigned char sec32[32], ell64a[64], ell64b[64], share32[32], expected32[32];
+        rustsecp256k1zkp_v0_8_1_scalar sec;
+        int32_t ecount = 0;
+        int j;
+
+        random_scalar_order_test(&sec);
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(sec32, &sec);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, &secret, sec32) == 1);
+        for (j = 0; j < 4; j++) {
+            rustsecp256k1zkp_v0_8_1_testrand256_test(ell64a);
+            rustsecp256k1zkp_v0_8_1_testrand256_test(ell64a + 32);
+            rustsecp256k1zkp_v0_8_1_testrand256_test(ell64b);
+            rustsecp256k1zkp_v0_8_1_testrand256_test(ell64b + 32);
+            CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh(CTX, expected32, ell64a, ell64b, sec32, j & 1, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, ell64a, ell64b, &secret, j & 1, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(share32, expected32, 32) == 0);
+        }
+
+        /* An invalid secret key gives a zeroed secret, which cannot be used. */
+        memset(&zero_secret, 0, sizeof(zero_secret));
+        memset(sec32, 0, 32);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, &secret, sec32) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&secret, &zero_secret, sizeof(secret)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, ell64a, ell64b, &secret, 0, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 0);
+
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(sec32, &sec);
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, NULL, sec32) == 0);
+        CHECK(ecount == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, &secret, NULL) == 0);
+        CHECK(ecount == 2);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&secret, &zero_secret, sizeof(secret)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_secret_create(CTX, &secret, sec32) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, NULL, ell64a, ell64b, &secret, 0, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 0);
+        CHECK(ecount == 3);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, NULL, ell64b, &secret, 0, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 0);
+        CHECK(ecount == 4);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, ell64a, NULL, &secret, 0, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 0);
+        CHECK(ecount == 5);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, ell64a, ell64b, NULL, 0, rustsecp256k1zkp_v0_8_1_ellswift_xdh_hash_function_bip324, NULL) == 0);
+        CHECK(ecount == 6);
+        CHECK(rustsecp256k1zkp_v0_8_1_ellswift_xdh_with_secret(CTX, share32, ell64a, ell64b, &secret, 0, NULL, NULL) == 0);
+        CHECK(ecount == 7);
+        rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+    }
+
     /* Test hash initializers. */
     {
         rustsecp256k1zkp_v0_8_1_sha256 sha, sha_optimized;
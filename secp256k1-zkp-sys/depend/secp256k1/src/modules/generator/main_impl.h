@@ -322,6 +322,102 @@ int rustsecp256k1zkp_v0_8_1_pedersen_commit(const rustsecp256k1zkp_v0_8_1_contex
     return ret;
 }
 
+/* Number of commitments converted per field inversion when no (or too small a) scratch space is given. */
+#define SECP256K1_PEDERSEN_COMMIT_BATCH_STACK 32
+/* Minimum number of consecutive commitments to the same generator for which a value table is built. */
+#define SECP256K1_PEDERSEN_COMMIT_BATCH_TABLE_MIN 8
+
+int rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_pedersen_commitment *commits, const unsigned char * const *blinds, const uint64_t *values, const rustsecp256k1zkp_v0_8_1_generator * const *gens, size_t n) {
+    rustsecp256k1zkp_v0_8_1_pedersen_value_table table;
+    rustsecp256k1zkp_v0_8_1_gej rj_stack[SECP256K1_PEDERSEN_COMMIT_BATCH_STACK];
+    rustsecp256k1zkp_v0_8_1_ge r_stack[SECP256K1_PEDERSEN_COMMIT_BATCH_STACK];
+    rustsecp256k1zkp_v0_8_1_gej *rj = rj_stack;
+    rustsecp256k1zkp_v0_8_1_ge *r = r_stack;
+    size_t batch_size = SECP256K1_PEDERSEN_COMMIT_BATCH_STACK;
+    size_t scratch_checkpoint = 0;
+    size_t table_end = 0;
+    size_t i, j, k;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || commits != NULL);
+    ARG_CHECK(n == 0 || blinds != NULL);
+    ARG_CHECK(n == 0 || values != NULL);
+    ARG_CHECK(n == 0 || gens != NULL);
+
+    if (scratch != NULL && n > batch_size) {
+        scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&ctx->error_callback, scratch);
+        rj = (rustsecp256k1zkp_v0_8_1_gej *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, n * sizeof(rustsecp256k1zkp_v0_8_1_gej));
+        r = (rustsecp256k1zkp_v0_8_1_ge *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, n * sizeof(rustsecp256k1zkp_v0_8_1_ge));
+        if (rj == NULL || r == NULL) {
+            rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+            scratch = NULL;
+            rj = rj_stack;
+            r = r_stack;
+        } else {
+            batch_size = n;
+        }
+    }
+
+    for (i = 0; i < n; i += batch_size) {
+        size_t len = n - i < batch_size ? n - i : batch_size;
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_ge genp;
+            rustsecp256k1zkp_v0_8_1_gej vj;
+            rustsecp256k1zkp_v0_8_1_scalar sec;
+            int overflow;
+
+            rustsecp256k1zkp_v0_8_1_generator_load(&genp, gens[i + j]);
+            if (i + j >= table_end) {
+                /* Precompute value multiples if enough consecutive commitments use this generator. */
+                for (k = i + j + 1; k < n; k++) {
+                    if (rustsecp256k1zkp_v0_8_1_memcmp_var(gens[k], gens[i + j], sizeof(*gens[k])) != 0) {
+                        break;
+                    }
+                }
+                if (k - (i + j) >= SECP256K1_PEDERSEN_COMMIT_BATCH_TABLE_MIN) {
+                    rustsecp256k1zkp_v0_8_1_pedersen_value_table_build(&table, &genp);
+                    table_end = k;
+                }
+            }
+
+            rustsecp256k1zkp_v0_8_1_scalar_set_b32(&sec, blinds[i + j], &overflow);
+            rustsecp256k1zkp_v0_8_1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj[j], &sec);
+            if (i + j < table_end) {
+                rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small_table(&vj, values[i + j], &table);
+            } else {
+                rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small(&vj, values[i + j], &genp);
+            }
+            /* FIXME: constant time. */
+            rustsecp256k1zkp_v0_8_1_gej_add_var(&rj[j], &rj[j], &vj, NULL);
+            /* A commitment to an overflowing blinding factor is zeroed like one at infinity. */
+            rustsecp256k1zkp_v0_8_1_gej_set_infinity(&vj);
+            rustsecp256k1zkp_v0_8_1_gej_cmov(&rj[j], &vj, overflow);
+            ret &= !rustsecp256k1zkp_v0_8_1_gej_is_infinity(&rj[j]);
+            rustsecp256k1zkp_v0_8_1_gej_clear(&vj);
+            rustsecp256k1zkp_v0_8_1_scalar_clear(&sec);
+        }
+
+        /* A single inversion brings the whole batch to affine coordinates. */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej(r, rj, len);
+        for (j = 0; j < len; j++) {
+            if (rustsecp256k1zkp_v0_8_1_ge_is_infinity(&r[j])) {
+                memset(&commits[i + j], 0, sizeof(commits[i + j]));
+            } else {
+                rustsecp256k1zkp_v0_8_1_pedersen_commitment_save(&commits[i + j], &r[j]);
+            }
+            rustsecp256k1zkp_v0_8_1_gej_clear(&rj[j]);
+            rustsecp256k1zkp_v0_8_1_ge_clear(&r[j]);
+        }
+    }
+
+    if (scratch != NULL && n > SECP256K1_PEDERSEN_COMMIT_BATCH_STACK) {
+        rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    }
+    return ret;
+}
+
 /** Takes a list of n pointers to 32 byte blinding values, the first negs of which are treated with positive sign and the rest
  *  negative, then calculates an additional blinding value that adds to zero.
  */
@@ -439,4 +535,113 @@ int rustsecp256k1zkp_v0_8_1_pedersen_blind_generator_blind_sum(const rustsecp256
     return 1;
 }
 
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_magic[4] = { 0x6d, 0x1c, 0x3a, 0x9e };
+
+/* A blind accumulator consists of
+ * - 4 byte magic set during initialization to allow detecting an uninitialized
+ *   object.
+ * - 32 byte running sum of (vr + r') over all entries, inputs negated.
+ */
+static void rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_save(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc, const rustsecp256k1zkp_v0_8_1_scalar *sum) {
+    memcpy(&acc->data[0], rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_magic, 4);
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(&acc->data[4], sum);
+}
+
+static int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_load(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scalar *sum, const rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc) {
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&acc->data[0], rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_magic, 4) == 0);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(sum, &acc->data[4], NULL);
+    return 1;
+}
+
+/* Computes term = vr + r'. Returns 0 if r or r' overflow. */
+static int rustsecp256k1zkp_v0_8_1_pedersen_blind_term(rustsecp256k1zkp_v0_8_1_scalar *term, uint64_t value, const unsigned char *generator_blind, const unsigned char *blinding_factor) {
+    rustsecp256k1zkp_v0_8_1_scalar tmp;
+    int overflow;
+
+    rustsecp256k1zkp_v0_8_1_scalar_set_u64(term, value);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(&tmp, generator_blind, &overflow);
+    rustsecp256k1zkp_v0_8_1_scalar_mul(term, term, &tmp);
+    if (blinding_factor != NULL && !overflow) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_b32(&tmp, blinding_factor, &overflow);
+        rustsecp256k1zkp_v0_8_1_scalar_add(term, term, &tmp);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&tmp);
+    if (overflow) {
+        rustsecp256k1zkp_v0_8_1_scalar_clear(term);
+        return 0;
+    }
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_init(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc) {
+    rustsecp256k1zkp_v0_8_1_scalar zero;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(acc != NULL);
+
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&zero, 0);
+    rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_save(acc, &zero);
+    return 1;
+}
+
+static int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_update(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc, uint64_t value, const unsigned char *generator_blind, const unsigned char *blinding_factor, int negate) {
+    rustsecp256k1zkp_v0_8_1_scalar sum;
+    rustsecp256k1zkp_v0_8_1_scalar term;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(acc != NULL);
+    ARG_CHECK(generator_blind != NULL);
+    ARG_CHECK(blinding_factor != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_load(ctx, &sum, acc)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_pedersen_blind_term(&term, value, generator_blind, blinding_factor)) {
+        rustsecp256k1zkp_v0_8_1_scalar_clear(&sum);
+        return 0;
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_cond_negate(&term, negate);
+    rustsecp256k1zkp_v0_8_1_scalar_add(&sum, &sum, &term);
+    rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_save(acc, &sum);
+
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&term);
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&sum);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc, uint64_t value, const unsigned char *generator_blind, const unsigned char *blinding_factor, int is_input) {
+    return rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_update(ctx, acc, value, generator_blind, blinding_factor, !!is_input);
+}
+
+int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc, uint64_t value, const unsigned char *generator_blind, const unsigned char *blinding_factor, int is_input) {
+    return rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_update(ctx, acc, value, generator_blind, blinding_factor, !is_input);
+}
+
+int rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *blinding_factor_out, const rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator *acc, uint64_t value, const unsigned char *generator_blind) {
+    rustsecp256k1zkp_v0_8_1_scalar sum;
+    rustsecp256k1zkp_v0_8_1_scalar term;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(blinding_factor_out != NULL);
+    ARG_CHECK(acc != NULL);
+    ARG_CHECK(generator_blind != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_load(ctx, &sum, acc)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_pedersen_blind_term(&term, value, generator_blind, NULL)) {
+        rustsecp256k1zkp_v0_8_1_scalar_clear(&sum);
+        return 0;
+    }
+    /* The last output needs r' = -(sum + vr) for the total to be zero. */
+    rustsecp256k1zkp_v0_8_1_scalar_add(&sum, &sum, &term);
+    rustsecp256k1zkp_v0_8_1_scalar_negate(&sum, &sum);
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(blinding_factor_out, &sum);
+
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&term);
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&sum);
+    return 1;
+}
+
 #endif
@@ -7,6 +7,7 @@
 #ifndef SECP256K1_PEDERSEN_H
 #define SECP256K1_PEDERSEN_H
 
+#include "../../ecmult_fixed_const.h"
 #include "../../ecmult_gen.h"
 #include "../../group.h"
 #include "../../scalar.h"
@@ -16,6 +17,19 @@
 /** Multiply a small number with the generator: r = gn*G2 */
 static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small(rustsecp256k1zkp_v0_8_1_gej *r, uint64_t gn, const rustsecp256k1zkp_v0_8_1_ge* genp);
 
+/** Multiples of a generator G2 for computing gn*G2 with many 64-bit gn, as an
+ *  ecmult_fixed_const table with one window per 4 bits of gn. */
+#define SECP256K1_PEDERSEN_VALUE_WINDOWS 16
+typedef struct {
+    unsigned char data[ECMULT_FIXED_CONST_TABLE_SIZE(SECP256K1_PEDERSEN_VALUE_WINDOWS)];
+} rustsecp256k1zkp_v0_8_1_pedersen_value_table;
+
+/** Fill a table of multiples of genp. Variable time in genp only. */
+static void rustsecp256k1zkp_v0_8_1_pedersen_value_table_build(rustsecp256k1zkp_v0_8_1_pedersen_value_table *table, const rustsecp256k1zkp_v0_8_1_ge* genp);
+
+/** Multiply a small number with a precomputed generator: r = gn*G2. Constant time in gn. */
+static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small_table(rustsecp256k1zkp_v0_8_1_gej *r, uint64_t gn, const rustsecp256k1zkp_v0_8_1_pedersen_value_table *table);
+
 /* sec * G + value * G2. */
 static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ecmult_gen_ctx, rustsecp256k1zkp_v0_8_1_gej *rj, const rustsecp256k1zkp_v0_8_1_scalar *sec, uint64_t value, const rustsecp256k1zkp_v0_8_1_ge* genp);
 
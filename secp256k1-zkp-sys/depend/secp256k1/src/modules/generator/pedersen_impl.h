@@ -11,11 +11,13 @@
 
 #include "../../eckey.h"
 #include "../../ecmult_const.h"
+#include "../../ecmult_fixed_const_impl.h"
 #include "../../ecmult_gen.h"
 #include "../../group.h"
 #include "../../field.h"
 #include "../../scalar.h"
 #include "../../util.h"
+#include "pedersen.h"
 
 static void rustsecp256k1zkp_v0_8_1_pedersen_scalar_set_u64(rustsecp256k1zkp_v0_8_1_scalar *sec, uint64_t value) {
     unsigned char data[32];
@@ -38,6 +40,17 @@ static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small(rustsecp256k1zkp_v0_8_
     rustsecp256k1zkp_v0_8_1_scalar_clear(&s);
 }
 
+static void rustsecp256k1zkp_v0_8_1_pedersen_value_table_build(rustsecp256k1zkp_v0_8_1_pedersen_value_table *table, const rustsecp256k1zkp_v0_8_1_ge* genp) {
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_const_table_build(table->data, genp, SECP256K1_PEDERSEN_VALUE_WINDOWS);
+}
+
+static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult_small_table(rustsecp256k1zkp_v0_8_1_gej *r, uint64_t gn, const rustsecp256k1zkp_v0_8_1_pedersen_value_table *table) {
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    rustsecp256k1zkp_v0_8_1_pedersen_scalar_set_u64(&s, gn);
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_const(r, table->data, SECP256K1_PEDERSEN_VALUE_WINDOWS, &s);
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&s);
+}
+
 /* sec * G + value * G2. */
 SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_pedersen_ecmult(const rustsecp256k1zkp_v0_8_1_ecmult_gen_context *ecmult_gen_ctx, rustsecp256k1zkp_v0_8_1_gej *rj, const rustsecp256k1zkp_v0_8_1_scalar *sec, uint64_t value, const rustsecp256k1zkp_v0_8_1_ge* genp) {
     rustsecp256k1zkp_v0_8_1_gej vj;
@@ -337,6 +337,181 @@ static void test_pedersen(void) {
     CHECK(rustsecp256k1zkp_v0_8_1_pedersen_verify_tally(CTX, &cptr[1], 1, &cptr[1], 1));
 }
 
+static void test_pedersen_batch(void) {
+    rustsecp256k1zkp_v0_8_1_pedersen_commitment commits[80];
+    rustsecp256k1zkp_v0_8_1_pedersen_commitment single;
+    rustsecp256k1zkp_v0_8_1_generator gen[3];
+    const rustsecp256k1zkp_v0_8_1_generator *gptr[80];
+    unsigned char blinds[32*80];
+    const unsigned char *bptr[80];
+    uint64_t values[80];
+    unsigned char ser1[33], ser2[33];
+    unsigned char key[32];
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch;
+    int32_t ecount = 0;
+    size_t i, n;
+
+    for (i = 0; i < 3; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(key);
+        CHECK(rustsecp256k1zkp_v0_8_1_generator_generate(CTX, &gen[i], key));
+    }
+    /* Long runs (which use a value table) and short runs of the same generator. */
+    for (i = 0; i < 80; i++) {
+        if (i < 20) {
+            gptr[i] = &gen[0];
+        } else if (i < 30) {
+            gptr[i] = &gen[i % 3];
+        } else if (i < 70) {
+            gptr[i] = &gen[1];
+        } else {
+            gptr[i] = i % 2 ? rustsecp256k1zkp_v0_8_1_generator_h : &gen[2];
+        }
+        random_scalar_order(&s);
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(&blinds[i * 32], &s);
+        bptr[i] = &blinds[i * 32];
+        values[i] = rustsecp256k1zkp_v0_8_1_testrand64();
+    }
+    values[0] = 0;
+    values[1] = UINT64_MAX;
+    values[2] = 1;
+    values[40] = 0;
+    values[41] = UINT64_MAX;
+
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 1024 * 1024);
+    for (n = 0; n <= 80; n += 40) {
+        CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, commits, bptr, values, gptr, n));
+        for (i = 0; i < n; i++) {
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit(CTX, &single, bptr[i], values[i], gptr[i]));
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser1, &single));
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser2, &commits[i]));
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(ser1, ser2, 33) == 0);
+        }
+        memset(commits, 0, sizeof(commits));
+        CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, scratch, commits, bptr, values, gptr, n));
+        for (i = 0; i < n; i++) {
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit(CTX, &single, bptr[i], values[i], gptr[i]));
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser1, &single));
+            CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser2, &commits[i]));
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(ser1, ser2, 33) == 0);
+        }
+    }
+
+    /* Overflowing blinding factor fails without affecting the other commitments. */
+    memset(&blinds[5 * 32], 0xFF, 32);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, scratch, commits, bptr, values, gptr, 10) == 0);
+    memset(&single, 0, sizeof(single));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&commits[5], &single, sizeof(single)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, commits, bptr, values, gptr, 10) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&commits[5], &single, sizeof(single)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit(CTX, &single, bptr[6], values[6], gptr[6]));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser1, &single));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commitment_serialize(CTX, ser2, &commits[6]));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(ser1, ser2, 33) == 0);
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, NULL, NULL, NULL, NULL, 0));
+    CHECK(ecount == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(STATIC_CTX, NULL, commits, bptr, values, gptr, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, NULL, bptr, values, gptr, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, commits, NULL, values, gptr, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, commits, bptr, NULL, gptr, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_commit_batch(CTX, NULL, commits, bptr, values, NULL, 1) == 0);
+    CHECK(ecount == 5);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
+}
+
+static void test_pedersen_blind_accumulator(void) {
+    rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator acc;
+    rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator acc2;
+    unsigned char vblinds[32*8];
+    unsigned char blinds[32*8];
+    const unsigned char *vbptr[8];
+    unsigned char *bptr[8];
+    unsigned char extra_vblind[32], extra_blind[32];
+    unsigned char expected[32], out[32];
+    unsigned char overflow[32];
+    uint64_t values[8];
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    int32_t ecount = 0;
+    size_t i, n_inputs;
+
+    for (i = 0; i < 8; i++) {
+        random_scalar_order(&s);
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(&vblinds[i * 32], &s);
+        random_scalar_order(&s);
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(&blinds[i * 32], &s);
+        vbptr[i] = &vblinds[i * 32];
+        bptr[i] = &blinds[i * 32];
+        values[i] = rustsecp256k1zkp_v0_8_1_testrand64();
+    }
+    random_scalar_order(&s);
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(extra_vblind, &s);
+    random_scalar_order(&s);
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(extra_blind, &s);
+    memset(overflow, 0xFF, 32);
+    n_inputs = rustsecp256k1zkp_v0_8_1_testrand_int(8);
+
+    /* Matches the last blinding factor computed by blind_generator_blind_sum. */
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_init(CTX, &acc));
+    for (i = 0; i < 7; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[i], vbptr[i], bptr[i], i < n_inputs));
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc, values[7], vbptr[7]));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_generator_blind_sum(CTX, values, vbptr, bptr, 8, n_inputs));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(out, bptr[7], 32) == 0);
+    memcpy(expected, out, 32);
+
+    /* Adding and removing an entry is a no-op. */
+    acc2 = acc;
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[0], extra_vblind, extra_blind, 1));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[1], extra_vblind, extra_blind, 0));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc, values[7], vbptr[7]));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(out, expected, 32) != 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(CTX, &acc, values[0], extra_vblind, extra_blind, 1));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(CTX, &acc, values[1], extra_vblind, extra_blind, 0));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&acc, &acc2, sizeof(acc)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc, values[7], vbptr[7]));
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(out, expected, 32) == 0);
+
+    /* Overflowing blinding factors leave the accumulator unchanged. */
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[0], overflow, extra_blind, 0) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[0], extra_vblind, overflow, 0) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(CTX, &acc, values[0], extra_vblind, overflow, 1) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&acc, &acc2, sizeof(acc)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc, values[7], overflow) == 0);
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_init(CTX, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, NULL, values[0], extra_vblind, extra_blind, 0) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc, values[0], NULL, extra_blind, 0) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove(CTX, &acc, values[0], extra_vblind, NULL, 0) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, NULL, &acc, values[0], extra_vblind) == 0);
+    CHECK(ecount == 5);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, NULL, values[0], extra_vblind) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc, values[0], NULL) == 0);
+    CHECK(ecount == 7);
+    /* Uninitialized accumulator */
+    memset(&acc2, 0, sizeof(acc2));
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add(CTX, &acc2, values[0], extra_vblind, extra_blind, 0) == 0);
+    CHECK(ecount == 8);
+    CHECK(rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize(CTX, out, &acc2, values[0], extra_vblind) == 0);
+    CHECK(ecount == 9);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+}
+
 static void test_pedersen_commitment_fixed_vector(void) {
     const unsigned char two_g[33] = {
         0x09,
@@ -369,6 +544,8 @@ static void run_generator_tests(void) {
     for (i = 0; i < COUNT / 2 + 1; i++) {
         test_pedersen();
     }
+    test_pedersen_batch();
+    test_pedersen_blind_accumulator();
 }
 
 #endif
@@ -109,20 +109,9 @@ static int rustsecp256k1zkp_v0_8_1_keyagg_cache_load(const rustsecp256k1zkp_v0_8
     return 1;
 }
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("KeyAgg list")||SHA256("KeyAgg list"). */
+/* Initializes SHA256 as a tagged hash with tag "KeyAgg list". */
 static void rustsecp256k1zkp_v0_8_1_musig_keyagglist_sha256(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-
-    sha->s[0] = 0xb399d5e0ul;
-    sha->s[1] = 0xc8fff302ul;
-    sha->s[2] = 0x6badac71ul;
-    sha->s[3] = 0x07c5b7f1ul;
-    sha->s[4] = 0x9701e2eful;
-    sha->s[5] = 0x2a72ecf8ul;
-    sha->s[6] = 0x201a4c7bul;
-    sha->s[7] = 0xab148a38ul;
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_KEYAGG_LIST);
 }
 
 /* Computes pk_hash = tagged_hash(pk[0], ..., pk[np-1]) */
@@ -144,20 +133,22 @@ static int rustsecp256k1zkp_v0_8_1_musig_compute_pk_hash(const rustsecp256k1zkp_
     return 1;
 }
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("KeyAgg coefficient")||SHA256("KeyAgg coefficient"). */
+/* Initializes SHA256 as a tagged hash with tag "KeyAgg coefficient". */
 static void rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_sha256(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-
-    sha->s[0] = 0x6ef02c5aul;
-    sha->s[1] = 0x06a480deul;
-    sha->s[2] = 0x1f298665ul;
-    sha->s[3] = 0x1d1134f2ul;
-    sha->s[4] = 0x56a0b063ul;
-    sha->s[5] = 0x52da4147ul;
-    sha->s[6] = 0xf280d9d4ul;
-    sha->s[7] = 0x4484be15ul;
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_KEYAGG_COEFFICIENT);
+}
+
+/* Computes tagged_hash(pk_hash, ser33), the KeyAgg coefficient of the public
+ * key with compressed serialization ser33 if it is not the second pubkey. */
+static void rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_hash(rustsecp256k1zkp_v0_8_1_scalar *r, const unsigned char *pk_hash, const unsigned char *ser33) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char buf[32];
+
+    rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_sha256(&sha);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pk_hash, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, ser33, 33);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(r, buf, NULL);
 }
 
 /* Compute KeyAgg coefficient which is constant 1 for the second pubkey and
@@ -166,8 +157,6 @@ static void rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_sha256(rustsecp256k1zkp_v0_
  * that pk is not the point at infinity and that the coordinates of pk and
  * second_pk are normalized. */
 static void rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_internal(rustsecp256k1zkp_v0_8_1_scalar *r, const unsigned char *pk_hash, rustsecp256k1zkp_v0_8_1_ge *pk, const rustsecp256k1zkp_v0_8_1_ge *second_pk) {
-    rustsecp256k1zkp_v0_8_1_sha256 sha;
-
     VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_ge_is_infinity(pk));
 #ifdef VERIFY
     VERIFY_CHECK(pk->x.normalized && pk->y.normalized);
@@ -182,15 +171,11 @@ static void rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_internal(rustsecp256k1zkp_v
         unsigned char buf[33];
         size_t buflen = sizeof(buf);
         int ret;
-        rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_sha256(&sha);
-        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pk_hash, 32);
         ret = rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(pk, buf, &buflen, 1);
         /* Serialization does not fail since the pk is not the point at infinity
          * (according to this function's precondition). */
         VERIFY_CHECK(ret && buflen == sizeof(buf));
-        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, buf, sizeof(buf));
-        rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
-        rustsecp256k1zkp_v0_8_1_scalar_set_b32(r, buf, NULL);
+        rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_hash(r, pk_hash, buf);
     }
 }
 
@@ -219,6 +204,29 @@ static int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_callback(rustsecp256k1zkp_v0
     return 1;
 }
 
+/* Stores the aggregate key pkj of the public keys with hash pk_hash and second
+ * pubkey second_pk in agg_pk and keyagg_cache, each of which may be NULL. */
+static void rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_save(rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pk, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, rustsecp256k1zkp_v0_8_1_gej *pkj, const unsigned char *pk_hash, const rustsecp256k1zkp_v0_8_1_ge *second_pk) {
+    rustsecp256k1zkp_v0_8_1_ge pkp;
+
+    rustsecp256k1zkp_v0_8_1_ge_set_gej(&pkp, pkj);
+    rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pkp.y);
+    /* The resulting public key is infinity with negligible probability */
+    VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_ge_is_infinity(&pkp));
+    if (keyagg_cache != NULL) {
+        rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i = { 0 };
+        cache_i.pk = pkp;
+        cache_i.second_pk = *second_pk;
+        memcpy(cache_i.pk_hash, pk_hash, sizeof(cache_i.pk_hash));
+        rustsecp256k1zkp_v0_8_1_keyagg_cache_save(keyagg_cache, &cache_i);
+    }
+
+    rustsecp256k1zkp_v0_8_1_extrakeys_ge_even_y(&pkp);
+    if (agg_pk != NULL) {
+        rustsecp256k1zkp_v0_8_1_xonly_pubkey_save(agg_pk, &pkp);
+    }
+}
+
 static void print_hex(unsigned char* data, size_t size) {
     size_t i;
     printf("0x");
@@ -231,7 +239,6 @@ static void print_hex(unsigned char* data, size_t size) {
 int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pk, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_pubkey * const* pubkeys, size_t n_pubkeys) {
     rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_ecmult_data ecmult_data;
     rustsecp256k1zkp_v0_8_1_gej pkj;
-    rustsecp256k1zkp_v0_8_1_ge pkp;
     size_t i;
     (void) scratch;
 
@@ -268,25 +275,208 @@ int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(const rustsecp256k1zkp_v0_8_1_conte
          * fail. */
         return 0;
     }
-    rustsecp256k1zkp_v0_8_1_ge_set_gej(&pkp, &pkj);
-    rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pkp.y);
-    /* The resulting public key is infinity with negligible probability */
-    VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_ge_is_infinity(&pkp));
-    if (keyagg_cache != NULL) {
-        rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i = { 0 };
-        cache_i.pk = pkp;
-        cache_i.second_pk = ecmult_data.second_pk;
-        memcpy(cache_i.pk_hash, ecmult_data.pk_hash, sizeof(cache_i.pk_hash));
-        rustsecp256k1zkp_v0_8_1_keyagg_cache_save(keyagg_cache, &cache_i);
+    rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_save(agg_pk, keyagg_cache, &pkj, ecmult_data.pk_hash, &ecmult_data.second_pk);
+    return 1;
+}
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey_magic[4] = { 0x6d, 0x1f, 0x42, 0xc8 };
+
+/* A prepared pubkey consists of
+ * - 4 byte magic set during initialization to allow detecting an uninitialized
+ *   object.
+ * - 64 byte public key
+ * - 33 byte compressed serialization of the public key
+ */
+int rustsecp256k1zkp_v0_8_1_musig_pubkey_prepare(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *prepared, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey) {
+    rustsecp256k1zkp_v0_8_1_ge pk;
+    size_t ser_len = 33;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(prepared != NULL);
+    memset(prepared, 0, sizeof(*prepared));
+    ARG_CHECK(pubkey != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pk, pubkey)) {
+        return 0;
     }
+    memcpy(prepared->data, rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey_magic, 4);
+    rustsecp256k1zkp_v0_8_1_point_save(&prepared->data[4], &pk);
+    ret = rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&pk, &prepared->data[68], &ser_len, 1);
+    VERIFY_CHECK(ret && ser_len == 33);
+    (void) ret;
+    return 1;
+}
 
-    rustsecp256k1zkp_v0_8_1_extrakeys_ge_even_y(&pkp);
-    if (agg_pk != NULL) {
-        rustsecp256k1zkp_v0_8_1_xonly_pubkey_save(agg_pk, &pkp);
+typedef struct {
+    /* pk_hash is the hash of the public keys */
+    unsigned char pk_hash[32];
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey * const* keys;
+    /* indices of the aggregated keys, or NULL to aggregate all keys in order */
+    const size_t *indices;
+    /* serialization of the second pubkey, or NULL if there is none */
+    const unsigned char *second_ser;
+} rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data;
+
+static const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *rustsecp256k1zkp_v0_8_1_musig_prepared_key(const rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data *data, size_t idx) {
+    return data->keys[data->indices != NULL ? data->indices[idx] : idx];
+}
+
+/* Like musig_pubkey_agg_callback, but takes the points and their serializations
+ * from prepared pubkeys. */
+static int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_callback(rustsecp256k1zkp_v0_8_1_scalar *sc, rustsecp256k1zkp_v0_8_1_ge *pt, size_t idx, void *data) {
+    rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data *ecmult_data = (rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data *) data;
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *key = rustsecp256k1zkp_v0_8_1_musig_prepared_key(ecmult_data, idx);
+
+    rustsecp256k1zkp_v0_8_1_point_load(pt, &key->data[4]);
+    if (ecmult_data->second_ser != NULL && rustsecp256k1zkp_v0_8_1_memcmp_var(&key->data[68], ecmult_data->second_ser, 33) == 0) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_int(sc, 1);
+    } else {
+        rustsecp256k1zkp_v0_8_1_musig_keyaggcoef_hash(sc, ecmult_data->pk_hash, &key->data[68]);
+    }
+    return 1;
+}
+
+/* Aggregates the n keys selected by ecmult_data, whose pk_hash must be set. */
+static int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_internal(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pk, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data *ecmult_data, size_t n) {
+    const unsigned char *first_ser = &rustsecp256k1zkp_v0_8_1_musig_prepared_key(ecmult_data, 0)->data[68];
+    rustsecp256k1zkp_v0_8_1_ge second_pk;
+    rustsecp256k1zkp_v0_8_1_gej pkj;
+    size_t i;
+
+    rustsecp256k1zkp_v0_8_1_ge_set_infinity(&second_pk);
+    ecmult_data->second_ser = NULL;
+    for (i = 1; i < n; i++) {
+        const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *key = rustsecp256k1zkp_v0_8_1_musig_prepared_key(ecmult_data, i);
+        if (rustsecp256k1zkp_v0_8_1_memcmp_var(&key->data[68], first_ser, 33) != 0) {
+            rustsecp256k1zkp_v0_8_1_point_load(&second_pk, &key->data[4]);
+            ecmult_data->second_ser = &key->data[68];
+            break;
+        }
+    }
+    if (!rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &pkj, NULL, rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_callback, (void *) ecmult_data, n)) {
+        return 0;
     }
+    rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_save(agg_pk, keyagg_cache, &pkj, ecmult_data->pk_hash, &second_pk);
     return 1;
 }
 
+int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pk, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey * const* prepared, size_t n_pubkeys) {
+    rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data ecmult_data;
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    if (agg_pk != NULL) {
+        memset(agg_pk, 0, sizeof(*agg_pk));
+    }
+    ARG_CHECK(prepared != NULL);
+    ARG_CHECK(n_pubkeys > 0);
+    for (i = 0; i < n_pubkeys; i++) {
+        ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(prepared[i]->data, rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey_magic, 4) == 0);
+    }
+
+    rustsecp256k1zkp_v0_8_1_musig_keyagglist_sha256(&sha);
+    for (i = 0; i < n_pubkeys; i++) {
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, &prepared[i]->data[68], 33);
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, ecmult_data.pk_hash);
+    ecmult_data.keys = prepared;
+    ecmult_data.indices = NULL;
+    return rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_internal(ctx, scratch, agg_pk, keyagg_cache, &ecmult_data, n_pubkeys);
+}
+
+/* Sets subset to the k-subset of {0, ..., n - 1} that follows it in
+ * lexicographic order and returns the first position that changed, or returns
+ * k if subset is the last one. */
+static size_t rustsecp256k1zkp_v0_8_1_musig_subset_next(size_t *subset, size_t k, size_t n) {
+    size_t i = k, pos;
+    while (i > 0 && subset[i - 1] == n - k + i - 1) {
+        i--;
+    }
+    if (i == 0) {
+        return k;
+    }
+    pos = i - 1;
+    subset[pos]++;
+    for (i = pos + 1; i < k; i++) {
+        subset[i] = subset[i - 1] + 1;
+    }
+    return pos;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_xonly_pubkey *agg_pks, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_caches, size_t *n_subsets, size_t *subset, size_t k, const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey * const* prepared, size_t n_pubkeys) {
+    rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_ecmult_data ecmult_data;
+    /* states[j] is the list hash after the first j + 1 keys of subset */
+    rustsecp256k1zkp_v0_8_1_sha256 *states = NULL;
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    size_t scratch_checkpoint = 0;
+    size_t n_max, n_done, changed, i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_subsets != NULL);
+    n_max = *n_subsets;
+    *n_subsets = 0;
+    ARG_CHECK(subset != NULL);
+    ARG_CHECK(prepared != NULL);
+    ARG_CHECK(k > 0 && k <= n_pubkeys);
+    for (i = 0; i < n_pubkeys; i++) {
+        ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(prepared[i]->data, rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey_magic, 4) == 0);
+    }
+    if (subset[0] == n_pubkeys) {
+        /* All subsets have been aggregated. */
+        return 1;
+    }
+    for (i = 0; i < k; i++) {
+        ARG_CHECK(subset[i] < n_pubkeys && (i == 0 || subset[i] > subset[i - 1]));
+    }
+
+    if (scratch != NULL) {
+        scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&ctx->error_callback, scratch);
+        states = (rustsecp256k1zkp_v0_8_1_sha256 *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, k * sizeof(*states));
+    }
+    ecmult_data.keys = prepared;
+    ecmult_data.indices = subset;
+    changed = 0;
+    for (n_done = 0; n_done < n_max && subset[0] != n_pubkeys; n_done++) {
+        if (states != NULL) {
+            /* Consecutive subsets often share their first keys, whose part of
+             * the list hash is kept. */
+            for (i = changed; i < k; i++) {
+                if (i == 0) {
+                    rustsecp256k1zkp_v0_8_1_musig_keyagglist_sha256(&states[0]);
+                } else {
+                    states[i] = states[i - 1];
+                }
+                rustsecp256k1zkp_v0_8_1_sha256_write(&states[i], &prepared[subset[i]]->data[68], 33);
+            }
+            sha = states[k - 1];
+        } else {
+            rustsecp256k1zkp_v0_8_1_musig_keyagglist_sha256(&sha);
+            for (i = 0; i < k; i++) {
+                rustsecp256k1zkp_v0_8_1_sha256_write(&sha, &prepared[subset[i]]->data[68], 33);
+            }
+        }
+        rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, ecmult_data.pk_hash);
+        if (!rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared_internal(ctx, scratch, agg_pks != NULL ? &agg_pks[n_done] : NULL, keyagg_caches != NULL ? &keyagg_caches[n_done] : NULL, &ecmult_data, k)) {
+            ret = 0;
+            break;
+        }
+        changed = rustsecp256k1zkp_v0_8_1_musig_subset_next(subset, k, n_pubkeys);
+        if (changed == k) {
+            for (i = 0; i < k; i++) {
+                subset[i] = n_pubkeys;
+            }
+        }
+    }
+    *n_subsets = n_done;
+    if (scratch != NULL) {
+        rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    }
+    return ret;
+}
+
 int rustsecp256k1zkp_v0_8_1_musig_pubkey_get(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pubkey *agg_pk, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache) {
     rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
     VERIFY_CHECK(ctx != NULL);
@@ -11,6 +11,7 @@
 #include "../../../include/secp256k1_musig.h"
 
 #include "../../scalar.h"
+#include "keyagg.h"
 
 typedef struct {
     int fin_nonce_parity;
@@ -20,6 +21,23 @@ typedef struct {
     rustsecp256k1zkp_v0_8_1_scalar s_part;
 } rustsecp256k1zkp_v0_8_1_musig_session_internal;
 
+/* The contents of a musig_expanded_session after its magic, copied in and out
+ * with memcpy. */
+typedef struct {
+    rustsecp256k1zkp_v0_8_1_musig_session_internal session;
+    rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache;
+    /* Whether the secret keys of the signers are negated, i.e., whether the
+     * aggregate public key has an odd Y coordinate XOR cache.parity_acc. */
+    int negate_seckey;
+    /* Whether signer_mu and signer_pk are set, and if so the KeyAgg
+     * coefficient and compressed public key of the signer the session was
+     * expanded for. The key is kept serialized so that the struct fits into a
+     * musig_expanded_session also in VERIFY builds. */
+    int has_signer;
+    rustsecp256k1zkp_v0_8_1_scalar signer_mu;
+    unsigned char signer_pk[33];
+} rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal;
+
 static int rustsecp256k1zkp_v0_8_1_musig_session_load(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_session_internal *session_i, const rustsecp256k1zkp_v0_8_1_musig_session *session);
 
 #endif
@@ -16,6 +16,7 @@
 #include "keyagg.h"
 #include "session.h"
 #include "../../eckey.h"
+#include "../../ecmult_fixed_impl.h"
 #include "../../hash.h"
 #include "../../scalar.h"
 #include "../../util.h"
@@ -293,7 +294,7 @@ static void rustsecp256k1zkp_v0_8_1_nonce_function_musig(rustsecp256k1zkp_v0_8_1
     unsigned char msg_present;
 
     if (seckey32 != NULL) {
-        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, (unsigned char*)"MuSig/aux", sizeof("MuSig/aux") - 1);
+        rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(&sha, SECP256K1_TAG_MUSIG_AUX);
         rustsecp256k1zkp_v0_8_1_sha256_write(&sha, session_id, 32);
         rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, rand);
         for (i = 0; i < 32; i++) {
@@ -304,7 +305,7 @@ static void rustsecp256k1zkp_v0_8_1_nonce_function_musig(rustsecp256k1zkp_v0_8_1
     }
 
     /* Subtract one from `sizeof` to avoid hashing the implicit null byte */
-    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, (unsigned char*)"MuSig/nonce", sizeof("MuSig/nonce") - 1);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(&sha, SECP256K1_TAG_MUSIG_NONCE);
     rustsecp256k1zkp_v0_8_1_sha256_write(&sha, rand, sizeof(rand));
     rustsecp256k1zkp_v0_8_1_nonce_function_musig_helper(&sha, 1, pk33, 33);
     rustsecp256k1zkp_v0_8_1_nonce_function_musig_helper(&sha, 1, agg_pk32, 32);
@@ -400,6 +401,91 @@ int rustsecp256k1zkp_v0_8_1_musig_nonce_gen(const rustsecp256k1zkp_v0_8_1_contex
     return ret;
 }
 
+/* Number of nonce pairs whose points, 2 * SECP256K1_MUSIG_NONCE_GEN_BATCH of
+ * them, are brought to affine coordinates with one field inversion in
+ * musig_nonce_gen_batch. */
+#define SECP256K1_MUSIG_NONCE_GEN_BATCH 16
+
+int rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonces, rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonces, const unsigned char * const *session_ids32, const unsigned char *seckey, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const unsigned char *extra_input32, size_t n) {
+    rustsecp256k1zkp_v0_8_1_gej nonce_ptj[2 * SECP256K1_MUSIG_NONCE_GEN_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge nonce_pt[2 * SECP256K1_MUSIG_NONCE_GEN_BATCH];
+    unsigned char pk_ser[33];
+    size_t pk_ser_len = sizeof(pk_ser);
+    rustsecp256k1zkp_v0_8_1_ge pk;
+    int pk_serialize_success;
+    int valid_seckey = 1;
+    int ret;
+    size_t i, j;
+    int k;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || secnonces != NULL);
+    if (n > 0) {
+        memset(secnonces, 0, n * sizeof(*secnonces));
+    }
+    ARG_CHECK(n == 0 || pubnonces != NULL);
+    if (n > 0) {
+        memset(pubnonces, 0, n * sizeof(*pubnonces));
+    }
+    ARG_CHECK(n == 0 || session_ids32 != NULL);
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+
+    if (seckey != NULL) {
+        rustsecp256k1zkp_v0_8_1_scalar sk;
+        valid_seckey = rustsecp256k1zkp_v0_8_1_scalar_set_b32_seckey(&sk, seckey);
+        rustsecp256k1zkp_v0_8_1_scalar_clear(&sk);
+    }
+    ret = valid_seckey;
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pk, pubkey)) {
+        return 0;
+    }
+    pk_serialize_success = rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&pk, pk_ser, &pk_ser_len, SECP256K1_EC_COMPRESSED);
+    /* A pubkey cannot be the point at infinity */
+    VERIFY_CHECK(pk_serialize_success);
+    VERIFY_CHECK(pk_ser_len == sizeof(pk_ser));
+
+    for (i = 0; i < n; i += SECP256K1_MUSIG_NONCE_GEN_BATCH) {
+        size_t len = n - i < SECP256K1_MUSIG_NONCE_GEN_BATCH ? n - i : SECP256K1_MUSIG_NONCE_GEN_BATCH;
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_scalar nonce_k[2];
+            int ret_j = valid_seckey;
+
+            if (seckey == NULL) {
+                /* Same defense-in-depth check as in musig_nonce_gen. */
+                unsigned char acc = 0;
+                for (k = 0; k < 32; k++) {
+                    acc |= session_ids32[i + j][k];
+                }
+                ret_j &= !!acc;
+                memset(&acc, 0, sizeof(acc));
+            }
+            rustsecp256k1zkp_v0_8_1_nonce_function_musig(nonce_k, session_ids32[i + j], NULL, seckey, pk_ser, NULL, extra_input32);
+            VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_scalar_is_zero(&nonce_k[0]));
+            VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_scalar_is_zero(&nonce_k[1]));
+            VERIFY_CHECK(!rustsecp256k1zkp_v0_8_1_scalar_eq(&nonce_k[0], &nonce_k[1]));
+            rustsecp256k1zkp_v0_8_1_musig_secnonce_save(&secnonces[i + j], nonce_k, &pk);
+            rustsecp256k1zkp_v0_8_1_musig_secnonce_invalidate(ctx, &secnonces[i + j], !ret_j);
+            ret &= ret_j;
+            for (k = 0; k < 2; k++) {
+                rustsecp256k1zkp_v0_8_1_ecmult_gen(&ctx->ecmult_gen_ctx, &nonce_ptj[2 * j + k], &nonce_k[k]);
+                rustsecp256k1zkp_v0_8_1_scalar_clear(&nonce_k[k]);
+            }
+        }
+
+        /* A single inversion brings the points of the whole batch to affine
+         * coordinates. */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej(nonce_pt, nonce_ptj, 2 * len);
+        rustsecp256k1zkp_v0_8_1_declassify(ctx, nonce_pt, 2 * len * sizeof(*nonce_pt));
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_musig_pubnonce_save(&pubnonces[i + j], &nonce_pt[2 * j]);
+            rustsecp256k1zkp_v0_8_1_gej_clear(&nonce_ptj[2 * j]);
+            rustsecp256k1zkp_v0_8_1_gej_clear(&nonce_ptj[2 * j + 1]);
+        }
+    }
+    return ret;
+}
+
 static int rustsecp256k1zkp_v0_8_1_musig_sum_nonces(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_gej *summed_nonces, const rustsecp256k1zkp_v0_8_1_musig_pubnonce * const* pubnonces, size_t n_pubnonces) {
     size_t i;
     int j;
@@ -438,13 +524,81 @@ int rustsecp256k1zkp_v0_8_1_musig_nonce_agg(const rustsecp256k1zkp_v0_8_1_contex
     return 1;
 }
 
+/* Number of sessions whose aggregate nonces are converted per field inversion
+ * when no (or too small a) scratch space is given to musig_nonce_agg_batch. */
+#define SECP256K1_MUSIG_NONCE_AGG_BATCH_STACK 32
+
+int rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_musig_aggnonce *aggnonces, const rustsecp256k1zkp_v0_8_1_musig_pubnonce * const* pubnonces, const size_t *n_pubnonces, size_t n_sessions) {
+    rustsecp256k1zkp_v0_8_1_gej aggnonce_ptj_stack[2 * SECP256K1_MUSIG_NONCE_AGG_BATCH_STACK];
+    rustsecp256k1zkp_v0_8_1_ge aggnonce_pt_stack[2 * SECP256K1_MUSIG_NONCE_AGG_BATCH_STACK];
+    rustsecp256k1zkp_v0_8_1_gej *aggnonce_ptj = aggnonce_ptj_stack;
+    rustsecp256k1zkp_v0_8_1_ge *aggnonce_pt = aggnonce_pt_stack;
+    size_t batch_size = SECP256K1_MUSIG_NONCE_AGG_BATCH_STACK;
+    size_t scratch_checkpoint = 0;
+    size_t i, j;
+    size_t offset = 0;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_sessions == 0 || aggnonces != NULL);
+    if (n_sessions > 0) {
+        memset(aggnonces, 0, n_sessions * sizeof(*aggnonces));
+    }
+    ARG_CHECK(n_sessions == 0 || pubnonces != NULL);
+    ARG_CHECK(n_sessions == 0 || n_pubnonces != NULL);
+    for (i = 0; i < n_sessions; i++) {
+        ARG_CHECK(n_pubnonces[i] > 0);
+    }
+
+    if (scratch != NULL && n_sessions > batch_size) {
+        scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&ctx->error_callback, scratch);
+        aggnonce_ptj = (rustsecp256k1zkp_v0_8_1_gej *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, 2 * n_sessions * sizeof(rustsecp256k1zkp_v0_8_1_gej));
+        aggnonce_pt = (rustsecp256k1zkp_v0_8_1_ge *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, 2 * n_sessions * sizeof(rustsecp256k1zkp_v0_8_1_ge));
+        if (aggnonce_ptj == NULL || aggnonce_pt == NULL) {
+            rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+            scratch = NULL;
+            aggnonce_ptj = aggnonce_ptj_stack;
+            aggnonce_pt = aggnonce_pt_stack;
+        } else {
+            batch_size = n_sessions;
+        }
+    }
+
+    for (i = 0; ret && i < n_sessions; i += batch_size) {
+        size_t len = n_sessions - i < batch_size ? n_sessions - i : batch_size;
+        for (j = 0; ret && j < len; j++) {
+            ret = rustsecp256k1zkp_v0_8_1_musig_sum_nonces(ctx, &aggnonce_ptj[2 * j], &pubnonces[offset], n_pubnonces[i + j]);
+            offset += n_pubnonces[i + j];
+        }
+        if (!ret) {
+            break;
+        }
+
+        /* The nonces are public, so the whole batch is brought to affine
+         * coordinates with a single variable-time inversion. Sums that are
+         * infinity stay infinity, as in musig_nonce_agg. */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(aggnonce_pt, aggnonce_ptj, 2 * len);
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_musig_aggnonce_save(&aggnonces[i + j], &aggnonce_pt[2 * j]);
+        }
+    }
+    if (!ret) {
+        memset(aggnonces, 0, n_sessions * sizeof(*aggnonces));
+    }
+
+    if (scratch != NULL && n_sessions > SECP256K1_MUSIG_NONCE_AGG_BATCH_STACK) {
+        rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    }
+    return ret;
+}
+
 /* tagged_hash(aggnonce[0], aggnonce[1], agg_pk, msg) */
 static int rustsecp256k1zkp_v0_8_1_musig_compute_noncehash(unsigned char *noncehash, rustsecp256k1zkp_v0_8_1_ge *aggnonce, const unsigned char *agg_pk32, const unsigned char *msg) {
     unsigned char buf[33];
     rustsecp256k1zkp_v0_8_1_sha256 sha;
     int i;
 
-    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, (unsigned char*)"MuSig/noncecoef", sizeof("MuSig/noncecoef") - 1);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(&sha, SECP256K1_TAG_MUSIG_NONCECOEF);
     for (i = 0; i < 2; i++) {
         rustsecp256k1zkp_v0_8_1_ge_serialize_ext(buf, &aggnonce[i]);
         rustsecp256k1zkp_v0_8_1_sha256_write(&sha, buf, sizeof(buf));
@@ -874,11 +1028,50 @@ int rustsecp256k1zkp_v0_8_1_blinded_musig_pubkey_xonly_tweak_add(
     return 1;
 }
 
+/* Whether sk must be negated for signing, i.e., whether the aggregate public
+ * key has an odd Y coordinate XOR cache_i->parity_acc. This corresponds to the
+ * line "Let d = g⋅gacc⋅d' mod n" in the specification. */
+static int rustsecp256k1zkp_v0_8_1_musig_negate_seckey_internal(const rustsecp256k1zkp_v0_8_1_keyagg_cache_internal *cache_i) {
+    return rustsecp256k1zkp_v0_8_1_fe_is_odd(&cache_i->pk.y) != cache_i->parity_acc;
+}
+
+/* Computes the partial signature from the loaded secret nonce k, the secret
+ * key sk and its public key pk, and clears k and sk. If mu is not NULL, it is
+ * the KeyAgg coefficient of pk and is not computed again. */
+static void rustsecp256k1zkp_v0_8_1_musig_partial_sign_internal(rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, rustsecp256k1zkp_v0_8_1_scalar *sk, rustsecp256k1zkp_v0_8_1_scalar *k, rustsecp256k1zkp_v0_8_1_ge *pk, const rustsecp256k1zkp_v0_8_1_scalar *mu, const rustsecp256k1zkp_v0_8_1_keyagg_cache_internal *cache_i, const rustsecp256k1zkp_v0_8_1_musig_session_internal *session_i, int negate_seckey) {
+    rustsecp256k1zkp_v0_8_1_scalar mu_pk, s;
+
+    rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk->y);
+    if (negate_seckey) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(sk, sk);
+    }
+
+    /* Multiply KeyAgg coefficient */
+    if (mu == NULL) {
+        rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk->x);
+        rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&mu_pk, cache_i, pk);
+        mu = &mu_pk;
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_mul(sk, sk, mu);
+
+    if (session_i->fin_nonce_parity) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&k[0], &k[0]);
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&k[1], &k[1]);
+    }
+
+    /* Sign */
+    rustsecp256k1zkp_v0_8_1_scalar_mul(&s, &session_i->challenge, sk);
+    rustsecp256k1zkp_v0_8_1_scalar_mul(&k[1], &session_i->noncecoef, &k[1]);
+    rustsecp256k1zkp_v0_8_1_scalar_add(&k[0], &k[0], &k[1]);
+    rustsecp256k1zkp_v0_8_1_scalar_add(&s, &s, &k[0]);
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig_save(partial_sig, &s);
+    rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(sk, k);
+}
+
 int rustsecp256k1zkp_v0_8_1_musig_partial_sign(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonce, const rustsecp256k1zkp_v0_8_1_keypair *keypair, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_session *session) {
     rustsecp256k1zkp_v0_8_1_scalar sk;
     rustsecp256k1zkp_v0_8_1_ge pk, keypair_pk;
     rustsecp256k1zkp_v0_8_1_scalar k[2];
-    rustsecp256k1zkp_v0_8_1_scalar mu, s;
     rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
     rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
     int ret;
@@ -911,39 +1104,11 @@ int rustsecp256k1zkp_v0_8_1_musig_partial_sign(const rustsecp256k1zkp_v0_8_1_con
         rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
         return 0;
     }
-    rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk.y);
-
-    /* Negate sk if rustsecp256k1zkp_v0_8_1_fe_is_odd(&cache_i.pk.y)) XOR cache_i.parity_acc.
-     * This corresponds to the line "Let d = g⋅gacc⋅d' mod n" in the
-     * specification. */
-    if ((rustsecp256k1zkp_v0_8_1_fe_is_odd(&cache_i.pk.y)
-         != cache_i.parity_acc)) {
-        rustsecp256k1zkp_v0_8_1_scalar_negate(&sk, &sk);
-    }
-
-    /* Multiply KeyAgg coefficient */
-    rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk.x);
-    /* TODO Cache mu */
-    rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&mu, &cache_i, &pk);
-    rustsecp256k1zkp_v0_8_1_scalar_mul(&sk, &sk, &mu);
-
     if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, session)) {
         rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
         return 0;
     }
-
-    if (session_i.fin_nonce_parity) {
-        rustsecp256k1zkp_v0_8_1_scalar_negate(&k[0], &k[0]);
-        rustsecp256k1zkp_v0_8_1_scalar_negate(&k[1], &k[1]);
-    }
-
-    /* Sign */
-    rustsecp256k1zkp_v0_8_1_scalar_mul(&s, &session_i.challenge, &sk);
-    rustsecp256k1zkp_v0_8_1_scalar_mul(&k[1], &session_i.noncecoef, &k[1]);
-    rustsecp256k1zkp_v0_8_1_scalar_add(&k[0], &k[0], &k[1]);
-    rustsecp256k1zkp_v0_8_1_scalar_add(&s, &s, &k[0]);
-    rustsecp256k1zkp_v0_8_1_musig_partial_sig_save(partial_sig, &s);
-    rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
+    rustsecp256k1zkp_v0_8_1_musig_partial_sign_internal(partial_sig, &sk, k, &pk, NULL, &cache_i, &session_i, rustsecp256k1zkp_v0_8_1_musig_negate_seckey_internal(&cache_i));
     return 1;
 }
 
@@ -1129,26 +1294,13 @@ SECP256K1_API int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_without_key
     return 1;
 }
 
-int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(const rustsecp256k1zkp_v0_8_1_context* ctx, const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_session *session) {
-    rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
-    rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+/* Verifies the partial signature with the loaded public key pkp of the signer. */
+static int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_internal(const rustsecp256k1zkp_v0_8_1_context* ctx, const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce, rustsecp256k1zkp_v0_8_1_ge *pkp, const rustsecp256k1zkp_v0_8_1_keyagg_cache_internal *cache_i, const rustsecp256k1zkp_v0_8_1_musig_session_internal *session_i, int negate_seckey) {
     rustsecp256k1zkp_v0_8_1_scalar mu, e, s;
     rustsecp256k1zkp_v0_8_1_gej pkj;
     rustsecp256k1zkp_v0_8_1_ge nonce_pt[2];
     rustsecp256k1zkp_v0_8_1_gej rj;
     rustsecp256k1zkp_v0_8_1_gej tmp;
-    rustsecp256k1zkp_v0_8_1_ge pkp;
-
-    VERIFY_CHECK(ctx != NULL);
-    ARG_CHECK(partial_sig != NULL);
-    ARG_CHECK(pubnonce != NULL);
-    ARG_CHECK(pubkey != NULL);
-    ARG_CHECK(keyagg_cache != NULL);
-    ARG_CHECK(session != NULL);
-
-    if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, session)) {
-        return 0;
-    }
 
     /* Compute "effective" nonce rj = aggnonce[0] + b*aggnonce[1] */
     /* TODO: use multiexp to compute -s*G + e*mu*pubkey + aggnonce[0] + b*aggnonce[1] */
@@ -1156,26 +1308,19 @@ int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(const rustsecp256k1zkp_v0_8
         return 0;
     }
     rustsecp256k1zkp_v0_8_1_gej_set_ge(&rj, &nonce_pt[1]);
-    rustsecp256k1zkp_v0_8_1_ecmult(&rj, &rj, &session_i.noncecoef, NULL);
+    rustsecp256k1zkp_v0_8_1_ecmult(&rj, &rj, &session_i->noncecoef, NULL);
     rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&rj, &rj, &nonce_pt[0], NULL);
 
-    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pkp, pubkey)) {
-        return 0;
-    }
-    if (!rustsecp256k1zkp_v0_8_1_keyagg_cache_load(ctx, &cache_i, keyagg_cache)) {
-        return 0;
-    }
     /* Multiplying the challenge by the KeyAgg coefficient is equivalent
      * to multiplying the signer's public key by the coefficient, except
      * much easier to do. */
-    rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&mu, &cache_i, &pkp);
-    rustsecp256k1zkp_v0_8_1_scalar_mul(&e, &session_i.challenge, &mu);
+    rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&mu, cache_i, pkp);
+    rustsecp256k1zkp_v0_8_1_scalar_mul(&e, &session_i->challenge, &mu);
 
     /* Negate e if rustsecp256k1zkp_v0_8_1_fe_is_odd(&cache_i.pk.y)) XOR cache_i.parity_acc.
      * This corresponds to the line "Let g' = g⋅gacc mod n" and the multiplication "g'⋅e"
      * in the specification. */
-    if (rustsecp256k1zkp_v0_8_1_fe_is_odd(&cache_i.pk.y)
-            != cache_i.parity_acc) {
+    if (negate_seckey) {
         rustsecp256k1zkp_v0_8_1_scalar_negate(&e, &e);
     }
 
@@ -1184,9 +1329,9 @@ int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(const rustsecp256k1zkp_v0_8
     }
     /* Compute -s*G + e*pkj + rj (e already includes the keyagg coefficient mu) */
     rustsecp256k1zkp_v0_8_1_scalar_negate(&s, &s);
-    rustsecp256k1zkp_v0_8_1_gej_set_ge(&pkj, &pkp);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&pkj, pkp);
     rustsecp256k1zkp_v0_8_1_ecmult(&tmp, &pkj, &e, &s);
-    if (session_i.fin_nonce_parity) {
+    if (session_i->fin_nonce_parity) {
         rustsecp256k1zkp_v0_8_1_gej_neg(&rj, &rj);
     }
     rustsecp256k1zkp_v0_8_1_gej_add_var(&tmp, &tmp, &rj, NULL);
@@ -1194,6 +1339,30 @@ int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(const rustsecp256k1zkp_v0_8
     return rustsecp256k1zkp_v0_8_1_gej_is_infinity(&tmp);
 }
 
+int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(const rustsecp256k1zkp_v0_8_1_context* ctx, const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_session *session) {
+    rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
+    rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+    rustsecp256k1zkp_v0_8_1_ge pkp;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(partial_sig != NULL);
+    ARG_CHECK(pubnonce != NULL);
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(keyagg_cache != NULL);
+    ARG_CHECK(session != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, session)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pkp, pubkey)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_keyagg_cache_load(ctx, &cache_i, keyagg_cache)) {
+        return 0;
+    }
+    return rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_internal(ctx, partial_sig, pubnonce, &pkp, &cache_i, &session_i, rustsecp256k1zkp_v0_8_1_musig_negate_seckey_internal(&cache_i));
+}
+
 int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sig_verify(
     const rustsecp256k1zkp_v0_8_1_context* ctx, 
     const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, 
@@ -1271,8 +1440,248 @@ int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sig_verify(
     return rustsecp256k1zkp_v0_8_1_gej_is_infinity(&tmp);
 }
 
-int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *sig64, const rustsecp256k1zkp_v0_8_1_musig_session *session, const rustsecp256k1zkp_v0_8_1_musig_partial_sig * const* partial_sigs, size_t n_sigs) {
+/* Initializes SHA256 as a tagged hash with tag "MuSig/partial_sign_batch". */
+static void rustsecp256k1zkp_v0_8_1_musig_sign_batch_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_MUSIG_SIGN_BATCH);
+}
+
+/* The first partial signature gets weight 1, partial signature i > 0 gets
+ * weight SHA256(seed || i) where seed commits to all outputs of the batch. */
+static void rustsecp256k1zkp_v0_8_1_musig_sign_batch_weight(rustsecp256k1zkp_v0_8_1_scalar *weight, const unsigned char *seed32, size_t i) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char buf[32];
+    int j;
+
+    if (i == 0) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_int(weight, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        buf[j] = ((uint64_t) i >> (8 * j)) & 0xff;
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, seed32, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, buf, 8);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(weight, buf, NULL);
+}
+
+typedef struct {
+    const rustsecp256k1zkp_v0_8_1_context *ctx;
+    const rustsecp256k1zkp_v0_8_1_musig_session *sessions;
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonces;
+    const rustsecp256k1zkp_v0_8_1_ge *pk;
+    const rustsecp256k1zkp_v0_8_1_scalar *pk_sc;
+    const unsigned char *seed32;
+    /* The scalars of the 2*n nonce points if they fit into the scratch space,
+     * or NULL. */
+    const rustsecp256k1zkp_v0_8_1_scalar *nonce_sc;
+    size_t n;
+} rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_data;
+
+/* Points 2*i and 2*i + 1 are the nonces R_i1 and R_i2 of session i with
+ * scalars -a_i and -a_i*b_i, negated if the final nonce of the session was
+ * negated, and point 2*n is the public key P with scalar pk_sc. The callback
+ * may be called from several threads, so the scalars are taken from nonce_sc
+ * and only derived again from the session without a scratch space. */
+static int rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_callback(rustsecp256k1zkp_v0_8_1_scalar *sc, rustsecp256k1zkp_v0_8_1_ge *pt, size_t idx, void *data) {
+    rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_data *ecmult_data = (rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_data *) data;
+    rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+    rustsecp256k1zkp_v0_8_1_ge nonce_pt[2];
+    rustsecp256k1zkp_v0_8_1_scalar weight;
+
+    if (idx == 2 * ecmult_data->n) {
+        *pt = *ecmult_data->pk;
+        *sc = *ecmult_data->pk_sc;
+        return 1;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_musig_pubnonce_load(ecmult_data->ctx, nonce_pt, &ecmult_data->pubnonces[idx / 2])) {
+        return 0;
+    }
+    *pt = nonce_pt[idx % 2];
+    if (ecmult_data->nonce_sc != NULL) {
+        *sc = ecmult_data->nonce_sc[idx];
+        return 1;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ecmult_data->ctx, &session_i, &ecmult_data->sessions[idx / 2])) {
+        return 0;
+    }
+    rustsecp256k1zkp_v0_8_1_musig_sign_batch_weight(&weight, ecmult_data->seed32, idx / 2);
+    if (!session_i.fin_nonce_parity) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&weight, &weight);
+    }
+    if (idx % 2 == 0) {
+        *sc = weight;
+    } else {
+        rustsecp256k1zkp_v0_8_1_scalar_mul(sc, &weight, &session_i.noncecoef);
+    }
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sigs, rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonces, const rustsecp256k1zkp_v0_8_1_keypair *keypair, const rustsecp256k1zkp_v0_8_1_musig_session *sessions, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonces, const unsigned char *keyaggcoef, int negate_seckey, size_t n) {
+    rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_data ecmult_data;
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char seed[32];
+    unsigned char pk_ser[33];
+    size_t pk_len = sizeof(pk_ser);
+    rustsecp256k1zkp_v0_8_1_scalar sk, mu, g_sc, pk_sc;
+    rustsecp256k1zkp_v0_8_1_scalar *nonce_sc = NULL;
+    rustsecp256k1zkp_v0_8_1_ge keypair_pk;
+    rustsecp256k1zkp_v0_8_1_gej resj;
+    size_t scratch_checkpoint = 0;
     size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || secnonces != NULL);
+    ARG_CHECK(n == 0 || partial_sigs != NULL);
+    ARG_CHECK(keypair != NULL);
+    ARG_CHECK(n == 0 || sessions != NULL);
+    ARG_CHECK(n == 0 || pubnonces != NULL);
+    ARG_CHECK(n < SIZE_MAX / 2);
+
+    /* The secret key, its negation and the KeyAgg coefficient are the same
+     * for every session, so sk*mu is computed only once. */
+    ret &= rustsecp256k1zkp_v0_8_1_keypair_load(ctx, &sk, &keypair_pk, keypair);
+    if (negate_seckey) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&sk, &sk);
+    }
+    if (keyaggcoef != NULL) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_b32(&mu, keyaggcoef, NULL);
+    } else {
+        rustsecp256k1zkp_v0_8_1_scalar_set_int(&mu, 1);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_mul(&sk, &sk, &mu);
+
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar k[2], s;
+        rustsecp256k1zkp_v0_8_1_ge pk;
+        rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+        int ret_i;
+
+        /* Every secnonce is used up, even if signing fails. */
+        ret_i = rustsecp256k1zkp_v0_8_1_musig_secnonce_load(ctx, k, &pk, &secnonces[i]);
+        memset(&secnonces[i], 0, sizeof(secnonces[i]));
+        if (ret && ret_i) {
+            if (!rustsecp256k1zkp_v0_8_1_fe_equal_var(&pk.x, &keypair_pk.x)
+                || !rustsecp256k1zkp_v0_8_1_fe_equal_var(&pk.y, &keypair_pk.y)) {
+                rustsecp256k1zkp_v0_8_1_callback_call(&ctx->illegal_callback, "secnonce does not match keypair");
+                ret_i = 0;
+            }
+        }
+        if (ret && ret_i) {
+            ret_i = rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, &sessions[i]);
+        }
+        ret &= ret_i;
+        if (ret) {
+            if (session_i.fin_nonce_parity) {
+                rustsecp256k1zkp_v0_8_1_scalar_negate(&k[0], &k[0]);
+                rustsecp256k1zkp_v0_8_1_scalar_negate(&k[1], &k[1]);
+            }
+            rustsecp256k1zkp_v0_8_1_scalar_mul(&s, &session_i.challenge, &sk);
+            rustsecp256k1zkp_v0_8_1_scalar_mul(&k[1], &session_i.noncecoef, &k[1]);
+            rustsecp256k1zkp_v0_8_1_scalar_add(&k[0], &k[0], &k[1]);
+            rustsecp256k1zkp_v0_8_1_scalar_add(&s, &s, &k[0]);
+            rustsecp256k1zkp_v0_8_1_musig_partial_sig_save(&partial_sigs[i], &s);
+        }
+        rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&s, k);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&sk);
+    if (!ret) {
+        if (n > 0) {
+            memset(partial_sigs, 0, n * sizeof(*partial_sigs));
+        }
+        return 0;
+    }
+    /* The partial signatures are outputs that the caller publishes, and they
+     * are verified with variable-time operations below. */
+    rustsecp256k1zkp_v0_8_1_declassify(ctx, partial_sigs, n * sizeof(*partial_sigs));
+
+    /* Verify all partial signatures at once, which the per-session signing
+     * functions leave to the caller: with s_i*G = R_i + e_i*mu*P for
+     * R_i = R_i1 + b_i*R_i2 (or its negation), the weighted sum
+     * (sum_i a_i*s_i)*G - sum_i a_i*R_i - (sum_i a_i*e_i)*mu*P is infinity. */
+    rustsecp256k1zkp_v0_8_1_musig_sign_batch_sha256_tagged(&sha);
+    /* keypair_pk was loaded successfully above, so it is not infinity. */
+    rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&keypair_pk, pk_ser, &pk_len, 1);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pk_ser, sizeof(pk_ser));
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, partial_sigs[i].data, sizeof(partial_sigs[i].data));
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, sessions[i].data, sizeof(sessions[i].data));
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pubnonces[i].data, sizeof(pubnonces[i].data));
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, seed);
+
+    /* Keep the nonce scalars for the callback, so that each weight is hashed
+     * and each session is loaded once. */
+    if (scratch != NULL && n <= SIZE_MAX / (2 * sizeof(*nonce_sc))) {
+        scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&ctx->error_callback, scratch);
+        nonce_sc = (rustsecp256k1zkp_v0_8_1_scalar *) rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, 2 * n * sizeof(*nonce_sc));
+    }
+
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&g_sc, 0);
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&pk_sc, 0);
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+        rustsecp256k1zkp_v0_8_1_scalar weight, s, term;
+
+        rustsecp256k1zkp_v0_8_1_musig_sign_batch_weight(&weight, seed, i);
+        /* Both were loaded successfully above. */
+        rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, &sessions[i]);
+        rustsecp256k1zkp_v0_8_1_musig_partial_sig_load(ctx, &s, &partial_sigs[i]);
+        rustsecp256k1zkp_v0_8_1_scalar_mul(&term, &weight, &s);
+        rustsecp256k1zkp_v0_8_1_scalar_add(&g_sc, &g_sc, &term);
+        rustsecp256k1zkp_v0_8_1_scalar_mul(&term, &weight, &session_i.challenge);
+        rustsecp256k1zkp_v0_8_1_scalar_add(&pk_sc, &pk_sc, &term);
+        if (nonce_sc != NULL) {
+            if (!session_i.fin_nonce_parity) {
+                rustsecp256k1zkp_v0_8_1_scalar_negate(&weight, &weight);
+            }
+            nonce_sc[2 * i] = weight;
+            rustsecp256k1zkp_v0_8_1_scalar_mul(&nonce_sc[2 * i + 1], &weight, &session_i.noncecoef);
+        }
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_mul(&pk_sc, &pk_sc, &mu);
+    if (!negate_seckey) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&pk_sc, &pk_sc);
+    }
+
+    ecmult_data.ctx = ctx;
+    ecmult_data.sessions = sessions;
+    ecmult_data.pubnonces = pubnonces;
+    ecmult_data.pk = &keypair_pk;
+    ecmult_data.pk_sc = &pk_sc;
+    ecmult_data.seed32 = seed;
+    ecmult_data.nonce_sc = nonce_sc;
+    ecmult_data.n = n;
+    ret = rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &resj, &g_sc, rustsecp256k1zkp_v0_8_1_musig_sign_batch_ecmult_callback, (void *) &ecmult_data, 2 * n + 1)
+          && rustsecp256k1zkp_v0_8_1_gej_is_infinity(&resj);
+    if (nonce_sc != NULL) {
+        rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    }
+    if (!ret && n > 0) {
+        memset(partial_sigs, 0, n * sizeof(*partial_sigs));
+    }
+    return ret;
+}
+
+static int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_internal(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *sig64, const rustsecp256k1zkp_v0_8_1_musig_session_internal *session_i, const rustsecp256k1zkp_v0_8_1_musig_partial_sig * const* partial_sigs, size_t n_sigs) {
+    rustsecp256k1zkp_v0_8_1_scalar s = session_i->s_part;
+    size_t i;
+
+    for (i = 0; i < n_sigs; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar term;
+        if (!rustsecp256k1zkp_v0_8_1_musig_partial_sig_load(ctx, &term, partial_sigs[i])) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_scalar_add(&s, &s, &term);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(&sig64[32], &s);
+    memcpy(&sig64[0], session_i->fin_nonce, 32);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *sig64, const rustsecp256k1zkp_v0_8_1_musig_session *session, const rustsecp256k1zkp_v0_8_1_musig_partial_sig * const* partial_sigs, size_t n_sigs) {
     rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
 
     VERIFY_CHECK(ctx != NULL);
@@ -1284,16 +1693,297 @@ int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(const rustsecp256k1zkp_v0_8_1_
     if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, session)) {
         return 0;
     }
-    for (i = 0; i < n_sigs; i++) {
-        rustsecp256k1zkp_v0_8_1_scalar term;
-        if (!rustsecp256k1zkp_v0_8_1_musig_partial_sig_load(ctx, &term, partial_sigs[i])) {
+    return rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_internal(ctx, sig64, &session_i, partial_sigs, n_sigs);
+}
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_musig_expanded_session_magic[4] = { 0x4e, 0x6b, 0x31, 0xa9 };
+
+static void rustsecp256k1zkp_v0_8_1_musig_expanded_session_save(rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded, const rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal *expanded_i) {
+    STATIC_ASSERT(4 + sizeof(*expanded_i) <= sizeof(expanded->data));
+    memcpy(&expanded->data[0], rustsecp256k1zkp_v0_8_1_musig_expanded_session_magic, 4);
+    memcpy(&expanded->data[4], expanded_i, sizeof(*expanded_i));
+}
+
+static int rustsecp256k1zkp_v0_8_1_musig_expanded_session_load(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal *expanded_i, const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded) {
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&expanded->data[0], rustsecp256k1zkp_v0_8_1_musig_expanded_session_magic, 4) == 0);
+    memcpy(expanded_i, &expanded->data[4], sizeof(*expanded_i));
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_session_expand(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_session *session, const rustsecp256k1zkp_v0_8_1_pubkey *signer) {
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal expanded_i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(expanded != NULL);
+    memset(expanded, 0, sizeof(*expanded));
+    ARG_CHECK(keyagg_cache != NULL);
+    ARG_CHECK(session != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_keyagg_cache_load(ctx, &expanded_i.cache, keyagg_cache)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &expanded_i.session, session)) {
+        return 0;
+    }
+    expanded_i.negate_seckey = rustsecp256k1zkp_v0_8_1_musig_negate_seckey_internal(&expanded_i.cache);
+    expanded_i.has_signer = signer != NULL;
+    memset(expanded_i.signer_pk, 0, sizeof(expanded_i.signer_pk));
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&expanded_i.signer_mu);
+    if (signer != NULL) {
+        rustsecp256k1zkp_v0_8_1_ge pk;
+        size_t pk_len = sizeof(expanded_i.signer_pk);
+        int ret;
+
+        if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pk, signer)) {
             return 0;
         }
-        rustsecp256k1zkp_v0_8_1_scalar_add(&session_i.s_part, &session_i.s_part, &term);
+        ret = rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&pk, expanded_i.signer_pk, &pk_len, 1);
+        /* Serialization does not fail since pubkey_load does not return the
+         * point at infinity. */
+        VERIFY_CHECK(ret && pk_len == sizeof(expanded_i.signer_pk));
+        (void) ret;
+        rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&expanded_i.signer_mu, &expanded_i.cache, &pk);
+    }
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_save(expanded, &expanded_i);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, rustsecp256k1zkp_v0_8_1_musig_session *session, const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded) {
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal expanded_i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(expanded != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_musig_expanded_session_load(ctx, &expanded_i, expanded)) {
+        return 0;
+    }
+    if (keyagg_cache != NULL) {
+        rustsecp256k1zkp_v0_8_1_keyagg_cache_save(keyagg_cache, &expanded_i.cache);
+    }
+    if (session != NULL) {
+        rustsecp256k1zkp_v0_8_1_musig_session_save(session, &expanded_i.session);
+    }
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_partial_sign_expanded(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, rustsecp256k1zkp_v0_8_1_musig_secnonce *secnonce, const rustsecp256k1zkp_v0_8_1_keypair *keypair, const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded) {
+    rustsecp256k1zkp_v0_8_1_scalar sk;
+    rustsecp256k1zkp_v0_8_1_ge pk, keypair_pk;
+    rustsecp256k1zkp_v0_8_1_scalar k[2];
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal expanded_i;
+    const rustsecp256k1zkp_v0_8_1_scalar *signer_mu = NULL;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+
+    ARG_CHECK(secnonce != NULL);
+    /* Fails if the magic doesn't match */
+    ret = rustsecp256k1zkp_v0_8_1_musig_secnonce_load(ctx, k, &pk, secnonce);
+    /* Set nonce to zero to avoid nonce reuse. This will cause subsequent calls
+     * of this function to fail */
+    memset(secnonce, 0, sizeof(*secnonce));
+    if (!ret) {
+        rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
+        return 0;
+    }
+
+    ARG_CHECK(partial_sig != NULL);
+    ARG_CHECK(keypair != NULL);
+    ARG_CHECK(expanded != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_keypair_load(ctx, &sk, &keypair_pk, keypair)) {
+        rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
+        return 0;
+    }
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_fe_equal_var(&pk.x, &keypair_pk.x)
+              && rustsecp256k1zkp_v0_8_1_fe_equal_var(&pk.y, &keypair_pk.y));
+    if (!rustsecp256k1zkp_v0_8_1_musig_expanded_session_load(ctx, &expanded_i, expanded)) {
+        rustsecp256k1zkp_v0_8_1_musig_partial_sign_clear(&sk, k);
+        return 0;
+    }
+    if (expanded_i.has_signer) {
+        unsigned char pk_ser[33];
+        size_t pk_len = sizeof(pk_ser);
+
+        rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk.x);
+        rustsecp256k1zkp_v0_8_1_fe_normalize_var(&pk.y);
+        if (rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&pk, pk_ser, &pk_len, 1)
+            && rustsecp256k1zkp_v0_8_1_memcmp_var(pk_ser, expanded_i.signer_pk, sizeof(pk_ser)) == 0) {
+            signer_mu = &expanded_i.signer_mu;
+        }
     }
-    rustsecp256k1zkp_v0_8_1_scalar_get_b32(&sig64[32], &session_i.s_part);
-    memcpy(&sig64[0], session_i.fin_nonce, 32);
+    rustsecp256k1zkp_v0_8_1_musig_partial_sign_internal(partial_sig, &sk, k, &pk, signer_mu, &expanded_i.cache, &expanded_i.session, expanded_i.negate_seckey);
     return 1;
 }
 
+int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded(const rustsecp256k1zkp_v0_8_1_context* ctx, const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded) {
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal expanded_i;
+    rustsecp256k1zkp_v0_8_1_ge pkp;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(partial_sig != NULL);
+    ARG_CHECK(pubnonce != NULL);
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(expanded != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_musig_expanded_session_load(ctx, &expanded_i, expanded)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pkp, pubkey)) {
+        return 0;
+    }
+    return rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_internal(ctx, partial_sig, pubnonce, &pkp, &expanded_i.cache, &expanded_i.session, expanded_i.negate_seckey);
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *sig64, const rustsecp256k1zkp_v0_8_1_musig_expanded_session *expanded, const rustsecp256k1zkp_v0_8_1_musig_partial_sig * const* partial_sigs, size_t n_sigs) {
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session_internal expanded_i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(expanded != NULL);
+    ARG_CHECK(partial_sigs != NULL);
+    ARG_CHECK(n_sigs > 0);
+
+    if (!rustsecp256k1zkp_v0_8_1_musig_expanded_session_load(ctx, &expanded_i, expanded)) {
+        return 0;
+    }
+    return rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_internal(ctx, sig64, &expanded_i.session, partial_sigs, n_sigs);
+}
+
+/* The signer table holds the multiples of mu*P needed to compute e*mu*P with
+ * the signed digits of ecmult_fixed_recode, one addition per digit. A window
+ * of 4 bits keeps the table at about 32 kB per signer. */
+#define MUSIG_SIGNER_TABLE_WINDOW 4
+#define MUSIG_SIGNER_TABLE_N_WINDOWS ECMULT_FIXED_N_WINDOWS(MUSIG_SIGNER_TABLE_WINDOW)
+#define MUSIG_SIGNER_TABLE_N_ENTRIES ((int)ECMULT_FIXED_N_BUCKETS(MUSIG_SIGNER_TABLE_WINDOW))
+
+static const unsigned char rustsecp256k1zkp_v0_8_1_musig_signer_table_magic[4] = { 0x5b, 0xc2, 0x07, 0x9e };
+
+/* A signer table consists of
+ * - 4 byte magic set during initialization to allow detecting an uninitialized
+ *   object.
+ * - 32 byte hash of the public keys of the keyagg_cache it was created with
+ * - 64 byte points d*2^(4*j)*mu*P for j from 0 to 64 and d from 1 to 8, where
+ *   P is the signer's public key and mu its KeyAgg coefficient
+ */
+int rustsecp256k1zkp_v0_8_1_musig_signer_table_create(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_musig_signer_table *table, const rustsecp256k1zkp_v0_8_1_pubkey *pubkey, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache) {
+    rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
+    rustsecp256k1zkp_v0_8_1_ge pkp;
+    rustsecp256k1zkp_v0_8_1_scalar mu;
+    rustsecp256k1zkp_v0_8_1_gej base;
+    rustsecp256k1zkp_v0_8_1_gej row[MUSIG_SIGNER_TABLE_N_ENTRIES];
+    rustsecp256k1zkp_v0_8_1_ge row_ge[MUSIG_SIGNER_TABLE_N_ENTRIES];
+    unsigned char *ptr;
+    int i, j;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(table != NULL);
+    memset(table, 0, sizeof(*table));
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(keyagg_cache != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_keyagg_cache_load(ctx, &cache_i, keyagg_cache)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &pkp, pubkey)) {
+        return 0;
+    }
+    rustsecp256k1zkp_v0_8_1_musig_keyaggcoef(&mu, &cache_i, &pkp);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&base, &pkp);
+    rustsecp256k1zkp_v0_8_1_ecmult(&base, &base, &mu, NULL);
+    /* mu*P is infinity with negligible probability */
+    if (rustsecp256k1zkp_v0_8_1_gej_is_infinity(&base)) {
+        return 0;
+    }
+
+    ptr = table->data;
+    memcpy(ptr, rustsecp256k1zkp_v0_8_1_musig_signer_table_magic, 4);
+    ptr += 4;
+    memcpy(ptr, cache_i.pk_hash, 32);
+    ptr += 32;
+    for (j = 0; j < MUSIG_SIGNER_TABLE_N_WINDOWS; j++) {
+        row[0] = base;
+        for (i = 1; i < MUSIG_SIGNER_TABLE_N_ENTRIES; i++) {
+            rustsecp256k1zkp_v0_8_1_gej_add_var(&row[i], &row[i - 1], &base, NULL);
+        }
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(row_ge, row, MUSIG_SIGNER_TABLE_N_ENTRIES);
+        for (i = 0; i < MUSIG_SIGNER_TABLE_N_ENTRIES; i++) {
+            rustsecp256k1zkp_v0_8_1_point_save(ptr, &row_ge[i]);
+            ptr += 64;
+        }
+        for (i = 0; i < MUSIG_SIGNER_TABLE_WINDOW; i++) {
+            rustsecp256k1zkp_v0_8_1_gej_double_var(&base, &base, NULL);
+        }
+    }
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(const rustsecp256k1zkp_v0_8_1_context* ctx, const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig, const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce, const rustsecp256k1zkp_v0_8_1_musig_signer_table *table, const rustsecp256k1zkp_v0_8_1_musig_keyagg_cache *keyagg_cache, const rustsecp256k1zkp_v0_8_1_musig_session *session) {
+    rustsecp256k1zkp_v0_8_1_keyagg_cache_internal cache_i;
+    rustsecp256k1zkp_v0_8_1_musig_session_internal session_i;
+    rustsecp256k1zkp_v0_8_1_scalar e, s;
+    rustsecp256k1zkp_v0_8_1_ge nonce_pt[2];
+    rustsecp256k1zkp_v0_8_1_gej tmp;
+    int digits[MUSIG_SIGNER_TABLE_N_WINDOWS];
+    int j;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(partial_sig != NULL);
+    ARG_CHECK(pubnonce != NULL);
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(table->data, rustsecp256k1zkp_v0_8_1_musig_signer_table_magic, 4) == 0);
+    ARG_CHECK(keyagg_cache != NULL);
+    ARG_CHECK(session != NULL);
+
+    if (!rustsecp256k1zkp_v0_8_1_musig_session_load(ctx, &session_i, session)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_keyagg_cache_load(ctx, &cache_i, keyagg_cache)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_musig_pubnonce_load(ctx, nonce_pt, pubnonce)) {
+        return 0;
+    }
+    if (!rustsecp256k1zkp_v0_8_1_musig_partial_sig_load(ctx, &s, partial_sig)) {
+        return 0;
+    }
+    /* The table holds the multiples of mu*P for a different list of keys. */
+    if (rustsecp256k1zkp_v0_8_1_memcmp_var(&table->data[4], cache_i.pk_hash, 32) != 0) {
+        return 0;
+    }
+
+    e = session_i.challenge;
+    if (rustsecp256k1zkp_v0_8_1_musig_negate_seckey_internal(&cache_i)) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&e, &e);
+    }
+    if (session_i.fin_nonce_parity) {
+        rustsecp256k1zkp_v0_8_1_ge_neg(&nonce_pt[0], &nonce_pt[0]);
+        rustsecp256k1zkp_v0_8_1_ge_neg(&nonce_pt[1], &nonce_pt[1]);
+    }
+
+    /* Compute -s*G + b*aggnonce[1] + aggnonce[0] + e*mu*pubkey, where the
+     * first two terms share one ecmult and the last one comes from the
+     * table. */
+    rustsecp256k1zkp_v0_8_1_scalar_negate(&s, &s);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&tmp, &nonce_pt[1]);
+    rustsecp256k1zkp_v0_8_1_ecmult(&tmp, &tmp, &session_i.noncecoef, &s);
+    rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&tmp, &tmp, &nonce_pt[0], NULL);
+    rustsecp256k1zkp_v0_8_1_ecmult_fixed_recode(digits, &e, MUSIG_SIGNER_TABLE_WINDOW);
+    for (j = 0; j < MUSIG_SIGNER_TABLE_N_WINDOWS; j++) {
+        int digit = digits[j];
+        rustsecp256k1zkp_v0_8_1_ge p;
+
+        if (digit == 0) {
+            continue;
+        }
+        rustsecp256k1zkp_v0_8_1_point_load(&p, &table->data[36 + (j * MUSIG_SIGNER_TABLE_N_ENTRIES + (digit < 0 ? -digit : digit) - 1) * 64]);
+        if (digit < 0) {
+            rustsecp256k1zkp_v0_8_1_ge_neg(&p, &p);
+        }
+        rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&tmp, &tmp, &p, NULL);
+    }
+
+    return rustsecp256k1zkp_v0_8_1_gej_is_infinity(&tmp);
+}
+
 #endif
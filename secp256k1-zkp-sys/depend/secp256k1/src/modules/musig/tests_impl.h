@@ -598,6 +598,117 @@ static void musig_api_tests(rustsecp256k1zkp_v0_8_1_scratch_space *scratch) {
     rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
 }
 
+static void musig_pubkey_agg_prepared_test(rustsecp256k1zkp_v0_8_1_scratch_space *scratch) {
+    enum { N_KEYS = 6, K = 3, N_SUBSETS = 20, N_PER_CALL = 7 };
+    rustsecp256k1zkp_v0_8_1_pubkey pk[N_KEYS];
+    rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey prepared[N_KEYS];
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *prepared_ptr[N_KEYS];
+    rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey invalid_prepared;
+    const rustsecp256k1zkp_v0_8_1_musig_prepared_pubkey *invalid_prepared_ptr[2];
+    rustsecp256k1zkp_v0_8_1_pubkey invalid_pk;
+    const rustsecp256k1zkp_v0_8_1_pubkey *pk_ptr[N_KEYS];
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey agg_pk, agg_pk_prepared;
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache keyagg_cache, keyagg_cache_prepared;
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey agg_pks[N_SUBSETS];
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache keyagg_caches[N_SUBSETS];
+    size_t subset[K];
+    size_t n_subsets, n_total, a, b, c;
+    int use_scratch, ecount = 0;
+    int i;
+
+    for (i = 0; i < N_KEYS; i++) {
+        unsigned char sk[32];
+        rustsecp256k1zkp_v0_8_1_testrand256(sk);
+        CHECK(create_keypair_and_pk(NULL, &pk[i], sk) == 1);
+    }
+    /* Repeated keys affect which key is the second one. */
+    pk[1] = pk[0];
+    pk[4] = pk[2];
+    for (i = 0; i < N_KEYS; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_prepare(CTX, &prepared[i], &pk[i]) == 1);
+        prepared_ptr[i] = &prepared[i];
+        pk_ptr[i] = &pk[i];
+    }
+
+    for (i = 1; i <= N_KEYS; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(CTX, scratch, &agg_pk, &keyagg_cache, pk_ptr, i) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(CTX, scratch, &agg_pk_prepared, &keyagg_cache_prepared, prepared_ptr, i) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&agg_pk, &agg_pk_prepared, sizeof(agg_pk)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&keyagg_cache, &keyagg_cache_prepared, sizeof(keyagg_cache)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(CTX, NULL, &agg_pk_prepared, NULL, prepared_ptr, i) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&agg_pk, &agg_pk_prepared, sizeof(agg_pk)) == 0);
+    }
+
+    /* All subsets of K keys, a few at a time, in lexicographic order */
+    for (use_scratch = 0; use_scratch < 2; use_scratch++) {
+        for (i = 0; i < K; i++) {
+            subset[i] = i;
+        }
+        n_total = 0;
+        do {
+            n_subsets = N_PER_CALL;
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, use_scratch ? scratch : NULL, &agg_pks[n_total], &keyagg_caches[n_total], &n_subsets, subset, K, prepared_ptr, N_KEYS) == 1);
+            n_total += n_subsets;
+        } while (n_subsets == N_PER_CALL);
+        CHECK(n_total == N_SUBSETS);
+        for (i = 0; i < K; i++) {
+            CHECK(subset[i] == N_KEYS);
+        }
+        n_subsets = N_PER_CALL;
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, K, prepared_ptr, N_KEYS) == 1);
+        CHECK(n_subsets == 0);
+
+        n_total = 0;
+        for (a = 0; a < N_KEYS; a++) {
+            for (b = a + 1; b < N_KEYS; b++) {
+                for (c = b + 1; c < N_KEYS; c++) {
+                    const rustsecp256k1zkp_v0_8_1_pubkey *subset_ptr[K];
+                    subset_ptr[0] = &pk[a];
+                    subset_ptr[1] = &pk[b];
+                    subset_ptr[2] = &pk[c];
+                    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(CTX, scratch, &agg_pk, &keyagg_cache, subset_ptr, K) == 1);
+                    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&agg_pk, &agg_pks[n_total], sizeof(agg_pk)) == 0);
+                    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&keyagg_cache, &keyagg_caches[n_total], sizeof(keyagg_cache)) == 0);
+                    n_total++;
+                }
+            }
+        }
+    }
+
+    /* Illegal arguments */
+    memset(&invalid_pk, 0, sizeof(invalid_pk));
+    memset(&invalid_prepared, 0, sizeof(invalid_prepared));
+    invalid_prepared_ptr[0] = &prepared[0];
+    invalid_prepared_ptr[1] = &invalid_prepared;
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_prepare(CTX, &invalid_prepared, &invalid_pk) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(CTX, scratch, &agg_pk, NULL, invalid_prepared_ptr, 2) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared(CTX, scratch, &agg_pk, NULL, prepared_ptr, 0) == 0);
+    CHECK(ecount == 3);
+    subset[0] = 0;
+    subset[1] = 2;
+    subset[2] = 2;
+    n_subsets = 1;
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, K, prepared_ptr, N_KEYS) == 0);
+    CHECK(ecount == 4);
+    CHECK(n_subsets == 0);
+    subset[2] = N_KEYS;
+    n_subsets = 1;
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, K, prepared_ptr, N_KEYS) == 0);
+    CHECK(ecount == 5);
+    subset[2] = 3;
+    n_subsets = 1;
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, N_KEYS + 1, prepared_ptr, N_KEYS) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, 0, prepared_ptr, N_KEYS) == 0);
+    CHECK(ecount == 7);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets(CTX, scratch, agg_pks, NULL, &n_subsets, subset, 2, invalid_prepared_ptr, 2) == 0);
+    CHECK(ecount == 8);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+}
+
 static void musig_nonce_bitflip(unsigned char **args, size_t n_flip, size_t n_bytes) {
     rustsecp256k1zkp_v0_8_1_scalar k1[2], k2[2];
 
@@ -663,6 +774,249 @@ static void musig_nonce_test(void) {
     }
 }
 
+/* Checks that musig_nonce_gen_batch matches musig_nonce_gen across several
+ * inversion batches and invalidates exactly the nonces it fails for. */
+static void musig_nonce_gen_batch_test(void) {
+    enum { N_NONCES = 37 };
+    unsigned char session_id[N_NONCES][32];
+    const unsigned char *session_id_ptr[N_NONCES];
+    unsigned char sk[32];
+    unsigned char extra_input[32];
+    unsigned char zeros[132] = { 0 };
+    unsigned char max64[64];
+    rustsecp256k1zkp_v0_8_1_pubkey pk;
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce[N_NONCES];
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce[N_NONCES];
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce_single;
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce_single;
+    int ecount = 0;
+    int i;
+
+    memset(max64, 0xff, sizeof(max64));
+    rustsecp256k1zkp_v0_8_1_testrand256(sk);
+    rustsecp256k1zkp_v0_8_1_testrand256(extra_input);
+    CHECK(create_keypair_and_pk(NULL, &pk, sk));
+    for (i = 0; i < N_NONCES; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(session_id[i]);
+        session_id_ptr[i] = session_id[i];
+    }
+
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce, session_id_ptr, sk, &pk, extra_input, N_NONCES) == 1);
+    for (i = 0; i < N_NONCES; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen(CTX, &secnonce_single, &pubnonce_single, session_id[i], sk, &pk, NULL, NULL, extra_input) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&secnonce[i], &secnonce_single, sizeof(secnonce_single)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&pubnonce[i], &pubnonce_single, sizeof(pubnonce_single)) == 0);
+    }
+
+    /* Without a seckey, only the nonce of the zero session id is invalid. */
+    memset(session_id[20], 0, sizeof(session_id[20]));
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce, session_id_ptr, NULL, &pk, NULL, N_NONCES) == 0);
+    for (i = 0; i < N_NONCES; i++) {
+        int ret = rustsecp256k1zkp_v0_8_1_musig_nonce_gen(CTX, &secnonce_single, &pubnonce_single, session_id[i], NULL, &pk, NULL, NULL, NULL);
+        CHECK(ret == (i != 20));
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&secnonce[i], &secnonce_single, sizeof(secnonce_single)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&pubnonce[i], &pubnonce_single, sizeof(pubnonce_single)) == 0);
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce[20].data, zeros, sizeof(secnonce[20].data)) == 0);
+
+    /* An invalid seckey invalidates all nonces. */
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce, session_id_ptr, max64, &pk, NULL, N_NONCES) == 0);
+    for (i = 0; i < N_NONCES; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce[i].data, zeros, sizeof(secnonce[i].data)) == 0);
+    }
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, NULL, NULL, NULL, sk, &pk, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(STATIC_CTX, secnonce, pubnonce, session_id_ptr, sk, &pk, NULL, N_NONCES) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, NULL, pubnonce, session_id_ptr, sk, &pk, NULL, N_NONCES) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, NULL, session_id_ptr, sk, &pk, NULL, N_NONCES) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce, NULL, sk, &pk, NULL, N_NONCES) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce[0].data, zeros, sizeof(secnonce[0].data)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce, session_id_ptr, sk, NULL, NULL, N_NONCES) == 0);
+    CHECK(ecount == 5);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
+}
+
+/* Checks that musig_nonce_agg_batch matches musig_nonce_agg with and without
+ * scratch space, including sessions whose nonces sum to infinity. */
+static void musig_nonce_agg_batch_test(rustsecp256k1zkp_v0_8_1_scratch_space *scratch) {
+    enum { N_SESSIONS = 70, MAX_SIGNERS = 4 };
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce[N_SESSIONS * MAX_SIGNERS];
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce_ptr[N_SESSIONS * MAX_SIGNERS];
+    size_t n_pubnonces[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_aggnonce aggnonce[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_aggnonce aggnonce_single;
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce invalid_pubnonce;
+    unsigned char zeros[sizeof(aggnonce)] = { 0 };
+    size_t n = 0;
+    size_t i, j;
+    int ecount = 0;
+    int use_scratch;
+
+    for (i = 0; i < N_SESSIONS; i++) {
+        if (i % 9 == 4) {
+            pubnonce_summing_to_inf(&pubnonce[n]);
+            n_pubnonces[i] = 2;
+        } else {
+            n_pubnonces[i] = 1 + rustsecp256k1zkp_v0_8_1_testrand_int(MAX_SIGNERS);
+            for (j = 0; j < n_pubnonces[i]; j++) {
+                rustsecp256k1zkp_v0_8_1_ge ge[2];
+                random_group_element_test(&ge[0]);
+                random_group_element_test(&ge[1]);
+                rustsecp256k1zkp_v0_8_1_musig_pubnonce_save(&pubnonce[n + j], ge);
+            }
+        }
+        for (j = 0; j < n_pubnonces[i]; j++) {
+            pubnonce_ptr[n + j] = &pubnonce[n + j];
+        }
+        n += n_pubnonces[i];
+    }
+
+    for (use_scratch = 0; use_scratch < 2; use_scratch++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, use_scratch ? scratch : NULL, aggnonce, pubnonce_ptr, n_pubnonces, N_SESSIONS) == 1);
+        n = 0;
+        for (i = 0; i < N_SESSIONS; i++) {
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg(CTX, &aggnonce_single, &pubnonce_ptr[n], n_pubnonces[i]) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&aggnonce[i], &aggnonce_single, sizeof(aggnonce_single)) == 0);
+            n += n_pubnonces[i];
+        }
+    }
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, NULL, NULL, pubnonce_ptr, n_pubnonces, N_SESSIONS) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, NULL, aggnonce, NULL, n_pubnonces, N_SESSIONS) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, NULL, aggnonce, pubnonce_ptr, NULL, N_SESSIONS) == 0);
+    CHECK(ecount == 3);
+    j = n_pubnonces[N_SESSIONS - 1];
+    n_pubnonces[N_SESSIONS - 1] = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, NULL, aggnonce, pubnonce_ptr, n_pubnonces, N_SESSIONS) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(aggnonce, zeros, sizeof(aggnonce)) == 0);
+    n_pubnonces[N_SESSIONS - 1] = j;
+    /* An invalid nonce in a later session zeroes all aggregate nonces. */
+    memset(&invalid_pubnonce, 0, sizeof(invalid_pubnonce));
+    pubnonce_ptr[n - 1] = &invalid_pubnonce;
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch(CTX, scratch, aggnonce, pubnonce_ptr, n_pubnonces, N_SESSIONS) == 0);
+    CHECK(ecount == 5);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(aggnonce, zeros, sizeof(aggnonce)) == 0);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+}
+
+/* Checks that blinded_musig_partial_sign_batch matches the single-session
+ * signing functions and fails for a pubnonce that doesn't match. */
+static void musig_blinded_partial_sign_batch_test(rustsecp256k1zkp_v0_8_1_scratch_space *scratch) {
+    enum { N_SESSIONS = 20 };
+    unsigned char sk[2][32];
+    unsigned char session_id[N_SESSIONS][32];
+    const unsigned char *session_id_ptr[N_SESSIONS];
+    unsigned char msg[32];
+    unsigned char keyaggcoef[32];
+    unsigned char zeros[sizeof(rustsecp256k1zkp_v0_8_1_musig_secnonce) * N_SESSIONS] = { 0 };
+    rustsecp256k1zkp_v0_8_1_keypair keypair[2];
+    rustsecp256k1zkp_v0_8_1_pubkey pk[2];
+    const rustsecp256k1zkp_v0_8_1_pubkey *pk_ptr[2];
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache keyagg_cache;
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce_tmp[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce_other;
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce[N_SESSIONS][2];
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce0[N_SESSIONS];
+    const rustsecp256k1zkp_v0_8_1_musig_pubnonce *pubnonce_ptr[2];
+    rustsecp256k1zkp_v0_8_1_musig_aggnonce aggnonce;
+    rustsecp256k1zkp_v0_8_1_musig_session session[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sig[N_SESSIONS];
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sig_single;
+    int negate_seckey;
+    int ecount = 0;
+    int use_coef;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand256(sk[i]);
+        CHECK(create_keypair_and_pk(&keypair[i], &pk[i], sk[i]) == 1);
+        pk_ptr[i] = &pk[i];
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(CTX, NULL, NULL, &keyagg_cache, pk_ptr, 2) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_get_keyaggcoef_and_negation_seckey(CTX, keyaggcoef, &negate_seckey, &keyagg_cache, &pk[0]) == 1);
+
+    for (use_coef = 0; use_coef < 2; use_coef++) {
+        for (i = 0; i < N_SESSIONS; i++) {
+            rustsecp256k1zkp_v0_8_1_testrand256(session_id[i]);
+            session_id_ptr[i] = session_id[i];
+        }
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch(CTX, secnonce, pubnonce0, session_id_ptr, sk[0], &pk[0], NULL, N_SESSIONS) == 1);
+        for (i = 0; i < N_SESSIONS; i++) {
+            pubnonce[i][0] = pubnonce0[i];
+            rustsecp256k1zkp_v0_8_1_testrand256(session_id[i]);
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_gen(CTX, &secnonce_other, &pubnonce[i][1], session_id[i], sk[1], &pk[1], NULL, NULL, NULL) == 1);
+            pubnonce_ptr[0] = &pubnonce[i][0];
+            pubnonce_ptr[1] = &pubnonce[i][1];
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg(CTX, &aggnonce, pubnonce_ptr, 2) == 1);
+            rustsecp256k1zkp_v0_8_1_testrand256(msg);
+            CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_process(CTX, &session[i], &aggnonce, msg, &keyagg_cache, NULL) == 1);
+        }
+
+        memcpy(secnonce_tmp, secnonce, sizeof(secnonce));
+        CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, use_coef ? scratch : NULL, partial_sig, secnonce_tmp, &keypair[0], session, pubnonce0, use_coef ? keyaggcoef : NULL, negate_seckey, N_SESSIONS) == 1);
+        /* The nonce scalars kept in the scratch space are freed again. */
+        CHECK(scratch->alloc_size == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce_tmp, zeros, sizeof(secnonce_tmp)) == 0);
+        for (i = 0; i < N_SESSIONS; i++) {
+            secnonce_tmp[i] = secnonce[i];
+            if (use_coef) {
+                CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sign(CTX, &partial_sig_single, &secnonce_tmp[i], &keypair[0], &keyagg_cache, &session[i]) == 1);
+                CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify(CTX, &partial_sig[i], &pubnonce0[i], &pk[0], &keyagg_cache, &session[i]) == 1);
+            } else {
+                CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_without_keyaggcoeff(CTX, &partial_sig_single, &secnonce_tmp[i], &keypair[0], &session[i], negate_seckey) == 1);
+            }
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&partial_sig[i], &partial_sig_single, sizeof(partial_sig_single)) == 0);
+        }
+    }
+
+    /* A pubnonce of another session makes the verification fail. */
+    memcpy(secnonce_tmp, secnonce, sizeof(secnonce));
+    pubnonce0[7] = pubnonce0[8];
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, &keypair[0], session, pubnonce0, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(scratch->alloc_size == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(partial_sig, zeros, sizeof(partial_sig)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce_tmp, zeros, sizeof(secnonce_tmp)) == 0);
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, NULL, NULL, &keypair[0], NULL, NULL, keyaggcoef, negate_seckey, 0) == 1);
+    CHECK(ecount == 0);
+    memcpy(secnonce_tmp, secnonce, sizeof(secnonce));
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, NULL, secnonce_tmp, &keypair[0], session, pubnonce0, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, NULL, &keypair[0], session, pubnonce0, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, NULL, session, pubnonce0, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, &keypair[0], NULL, pubnonce0, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, &keypair[0], session, NULL, keyaggcoef, negate_seckey, N_SESSIONS) == 0);
+    CHECK(ecount == 5);
+    /* The secnonces of another keypair are used up without signing. */
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, &keypair[1], session, pubnonce0, keyaggcoef, negate_seckey, 2) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(partial_sig, zeros, 2 * sizeof(partial_sig[0])) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(secnonce_tmp, zeros, 2 * sizeof(secnonce_tmp[0])) == 0);
+    /* Used secnonces can't sign again. */
+    CHECK(rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch(CTX, scratch, partial_sig, secnonce_tmp, &keypair[0], session, pubnonce0, keyaggcoef, negate_seckey, 1) == 0);
+    CHECK(ecount == 7);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+}
+
 static void scriptless_atomic_swap(rustsecp256k1zkp_v0_8_1_scratch_space *scratch) {
     /* Throughout this test "a" and "b" refer to two hypothetical blockchains,
      * while the indices 0 and 1 refer to the two signers. Here signer 0 is
@@ -827,6 +1181,16 @@ static void musig_tweak_test_helper(const rustsecp256k1zkp_v0_8_1_xonly_pubkey*
     rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sig[2];
     const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig_ptr[2];
     unsigned char final_sig[64];
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce_copy[2];
+    rustsecp256k1zkp_v0_8_1_musig_secnonce secnonce_copy_signer[2];
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session expanded;
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache keyagg_cache_get;
+    rustsecp256k1zkp_v0_8_1_musig_session session_get;
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sig_expanded;
+    unsigned char final_sig_expanded[64];
+    rustsecp256k1zkp_v0_8_1_musig_signer_table table;
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache keyagg_cache_swapped;
+    const rustsecp256k1zkp_v0_8_1_pubkey *pk_swapped_ptr[2];
     int i;
 
     for (i = 0; i < 2; i++) {
@@ -845,6 +1209,8 @@ static void musig_tweak_test_helper(const rustsecp256k1zkp_v0_8_1_xonly_pubkey*
     CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_agg(CTX, &aggnonce, pubnonce_ptr, 2) == 1);
     CHECK(rustsecp256k1zkp_v0_8_1_musig_nonce_process(CTX, &session, &aggnonce, msg, keyagg_cache, NULL) == 1);
 
+    memcpy(secnonce_copy, secnonce, sizeof(secnonce));
+    memcpy(secnonce_copy_signer, secnonce, sizeof(secnonce));
     CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sign(CTX, &partial_sig[0], &secnonce[0], &keypair[0], keyagg_cache, &session) == 1);
     CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sign(CTX, &partial_sig[1], &secnonce[1], &keypair[1], keyagg_cache, &session) == 1);
 
@@ -853,6 +1219,87 @@ static void musig_tweak_test_helper(const rustsecp256k1zkp_v0_8_1_xonly_pubkey*
 
     CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg(CTX, final_sig, &session, partial_sig_ptr, 2) == 1);
     CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_verify(CTX, final_sig, msg, sizeof(msg), agg_pk) == 1);
+
+    /* The expanded session gives the same results and converts back to the
+     * same keyagg_cache and session. */
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_session_expand(CTX, &expanded, keyagg_cache, &session, NULL) == 1);
+    for (i = 0; i < 2; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sign_expanded(CTX, &partial_sig_expanded, &secnonce_copy[i], &keypair[i], &expanded) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&partial_sig_expanded, &partial_sig[i], sizeof(partial_sig_expanded)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded(CTX, &partial_sig[i], &pubnonce[i], &pk[i], &expanded) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded(CTX, &partial_sig[i], &pubnonce[1 - i], &pk[i], &expanded) == 0);
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded(CTX, final_sig_expanded, &expanded, partial_sig_ptr, 2) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(final_sig_expanded, final_sig, sizeof(final_sig)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(CTX, &keyagg_cache_get, &session_get, &expanded) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&keyagg_cache_get, keyagg_cache, sizeof(keyagg_cache_get)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&session_get, &session, sizeof(session_get)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(CTX, NULL, NULL, &expanded) == 1);
+
+    /* Expanding for signer 0 caches its KeyAgg coefficient, which gives the
+     * same partial signature. Signer 1 still signs correctly with it. */
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_session_expand(CTX, &expanded, keyagg_cache, &session, &pk[0]) == 1);
+    for (i = 0; i < 2; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sign_expanded(CTX, &partial_sig_expanded, &secnonce_copy_signer[i], &keypair[i], &expanded) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&partial_sig_expanded, &partial_sig[i], sizeof(partial_sig_expanded)) == 0);
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(CTX, &keyagg_cache_get, &session_get, &expanded) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&session_get, &session, sizeof(session_get)) == 0);
+
+    /* Verifying with signer tables gives the same results. A table for a
+     * different list of keys does not verify. */
+    for (i = 0; i < 2; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_signer_table_create(CTX, &table, &pk[i], keyagg_cache) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(CTX, &partial_sig[i], &pubnonce[i], &table, keyagg_cache, &session) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(CTX, &partial_sig[1 - i], &pubnonce[1 - i], &table, keyagg_cache, &session) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(CTX, &partial_sig[i], &pubnonce[1 - i], &table, keyagg_cache, &session) == 0);
+        pk_swapped_ptr[i] = &pk[1 - i];
+    }
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_pubkey_agg(CTX, NULL, NULL, &keyagg_cache_swapped, pk_swapped_ptr, 2) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_signer_table_create(CTX, &table, &pk[0], &keyagg_cache_swapped) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(CTX, &partial_sig[0], &pubnonce[0], &table, keyagg_cache, &session) == 0);
+}
+
+static void musig_expanded_session_api_test(void) {
+    rustsecp256k1zkp_v0_8_1_musig_expanded_session expanded;
+    rustsecp256k1zkp_v0_8_1_musig_keyagg_cache invalid_keyagg_cache;
+    rustsecp256k1zkp_v0_8_1_musig_session session;
+    rustsecp256k1zkp_v0_8_1_musig_partial_sig partial_sig;
+    const rustsecp256k1zkp_v0_8_1_musig_partial_sig *partial_sig_ptr = &partial_sig;
+    rustsecp256k1zkp_v0_8_1_musig_pubnonce pubnonce;
+    rustsecp256k1zkp_v0_8_1_pubkey pk;
+    unsigned char sig64[64];
+    unsigned char zeros[sizeof(expanded)] = { 0 };
+    rustsecp256k1zkp_v0_8_1_musig_signer_table table;
+    int ecount = 0;
+
+    memset(&invalid_keyagg_cache, 0, sizeof(invalid_keyagg_cache));
+    memset(&table, 0, sizeof(table));
+    memset(&session, 0, sizeof(session));
+    memset(&expanded, 0, sizeof(expanded));
+    memset(&partial_sig, 0, sizeof(partial_sig));
+    memset(&pubnonce, 0, sizeof(pubnonce));
+    memset(&pk, 0, sizeof(pk));
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    /* Uninitialized inputs */
+    memset(&expanded, 0xff, sizeof(expanded));
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_session_expand(CTX, &expanded, &invalid_keyagg_cache, &session, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&expanded, zeros, sizeof(expanded)) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_expanded_session_get(CTX, NULL, &session, &expanded) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded(CTX, &partial_sig, &pubnonce, &pk, &expanded) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded(CTX, sig64, &expanded, &partial_sig_ptr, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded(CTX, sig64, &expanded, &partial_sig_ptr, 0) == 0);
+    CHECK(ecount == 5);
+    /* An uninitialized signer table */
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table(CTX, &partial_sig, &pubnonce, &table, &invalid_keyagg_cache, &session) == 0);
+    CHECK(ecount == 6);
+    CHECK(rustsecp256k1zkp_v0_8_1_musig_signer_table_create(CTX, &table, &pk, &invalid_keyagg_cache) == 0);
+    CHECK(ecount == 7);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
 }
 
 /* Create aggregate public key P[0], tweak multiple times (using xonly and
@@ -1305,7 +1752,12 @@ static void run_musig_tests(void) {
         musig_simple_test(scratch);
     }
     musig_api_tests(scratch);
+    musig_pubkey_agg_prepared_test(scratch);
     musig_nonce_test();
+    musig_nonce_gen_batch_test();
+    musig_nonce_agg_batch_test(scratch);
+    musig_expanded_session_api_test();
+    musig_blinded_partial_sign_batch_test(scratch);
     for (i = 0; i < COUNT; i++) {
         /* Run multiple times to ensure that pk and nonce have different y
          * parities */
@@ -35,6 +35,26 @@ SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_borromean_hash(unsigned cha
     rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha256_en, hash);
 }
 
+/* Number of rings whose chains borromean_verify advances in lockstep, so that
+ * their hashes can be computed together. */
+#define SECP256K1_BORROMEAN_VERIFY_RINGS 8
+
+/* Computes hash i = H(e_i||m||pos_i) for i < n, where e_i = e + i*estride and
+ * pos_i is the 8 bytes ring||epos at pos + 8*i. */
+static void rustsecp256k1zkp_v0_8_1_borromean_hash_multi(unsigned char *hashes, size_t n, const unsigned char *e, size_t estride, size_t elen,
+ const unsigned char *m, size_t mlen, const unsigned char *pos) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha256_en[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    size_t i;
+    VERIFY_CHECK(n <= SECP256K1_BORROMEAN_VERIFY_RINGS);
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha256_en[i]);
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_write_multi(sha256_en, n, e, estride, elen);
+    rustsecp256k1zkp_v0_8_1_sha256_write_multi(sha256_en, n, m, 0, mlen);
+    rustsecp256k1zkp_v0_8_1_sha256_write_multi(sha256_en, n, pos, 8, 8);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize_multi(sha256_en, n, hashes);
+}
+
 /**  "Borromean" ring signature.
  *   Verifies nrings concurrent ring signatures all sharing a challenge value.
  *   Signature is one s value per pubkey and a hash.
@@ -48,19 +68,32 @@ SECP256K1_INLINE static void rustsecp256k1zkp_v0_8_1_borromean_hash(unsigned cha
  *   | | | en = to_scalar(e)
  *   | | r_i = r
  *   | return e_0 ==== H(r_{0..i}||m)
+ *   The rings are independent until the final hash, so groups of up to
+ *   SECP256K1_BORROMEAN_VERIFY_RINGS rings are walked in lockstep, with one
+ *   batched affine conversion and one multi-lane hash per step.
  */
 int rustsecp256k1zkp_v0_8_1_borromean_verify(rustsecp256k1zkp_v0_8_1_scalar *evalues, const unsigned char *e0,
  const rustsecp256k1zkp_v0_8_1_scalar *s, const rustsecp256k1zkp_v0_8_1_gej *pubs, const size_t *rsizes, size_t nrings, const unsigned char *m, size_t mlen) {
-    rustsecp256k1zkp_v0_8_1_gej rgej;
-    rustsecp256k1zkp_v0_8_1_ge rge;
-    rustsecp256k1zkp_v0_8_1_scalar ens;
+    rustsecp256k1zkp_v0_8_1_gej rgej[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    rustsecp256k1zkp_v0_8_1_ge rge[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    rustsecp256k1zkp_v0_8_1_scalar ens[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    int overflow[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    size_t first[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    size_t lanes[SECP256K1_BORROMEAN_VERIFY_RINGS];
+    unsigned char r[SECP256K1_BORROMEAN_VERIFY_RINGS][33];
+    unsigned char e[SECP256K1_BORROMEAN_VERIFY_RINGS][33];
+    unsigned char pos[SECP256K1_BORROMEAN_VERIFY_RINGS][8];
+    unsigned char hashes[SECP256K1_BORROMEAN_VERIFY_RINGS * 32];
     rustsecp256k1zkp_v0_8_1_sha256 sha256_e0;
-    unsigned char tmp[33];
+    unsigned char tmp[32];
     size_t i;
     size_t j;
+    size_t k;
+    size_t n;
+    size_t ngroup;
+    size_t nr;
+    size_t maxsize;
     size_t count;
-    size_t size;
-    int overflow;
     VERIFY_CHECK(e0 != NULL);
     VERIFY_CHECK(s != NULL);
     VERIFY_CHECK(pubs != NULL);
@@ -69,32 +102,66 @@ int rustsecp256k1zkp_v0_8_1_borromean_verify(rustsecp256k1zkp_v0_8_1_scalar *eva
     VERIFY_CHECK(m != NULL);
     count = 0;
     rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha256_e0);
-    for (i = 0; i < nrings; i++) {
-        VERIFY_CHECK(INT_MAX - count > rsizes[i]);
-        rustsecp256k1zkp_v0_8_1_borromean_hash(tmp, m, mlen, e0, 32, i, 0);
-        rustsecp256k1zkp_v0_8_1_scalar_set_b32(&ens, tmp, &overflow);
-        for (j = 0; j < rsizes[i]; j++) {
-            if (overflow || rustsecp256k1zkp_v0_8_1_scalar_is_zero(&s[count]) || rustsecp256k1zkp_v0_8_1_scalar_is_zero(&ens) || rustsecp256k1zkp_v0_8_1_gej_is_infinity(&pubs[count])) {
-                return 0;
+    for (i = 0; i < nrings; i += ngroup) {
+        ngroup = nrings - i < SECP256K1_BORROMEAN_VERIFY_RINGS ? nrings - i : SECP256K1_BORROMEAN_VERIFY_RINGS;
+        maxsize = 0;
+        for (k = 0; k < ngroup; k++) {
+            VERIFY_CHECK(INT_MAX - count > rsizes[i + k]);
+            first[k] = count;
+            count += rsizes[i + k];
+            maxsize = rsizes[i + k] > maxsize ? rsizes[i + k] : maxsize;
+            rustsecp256k1zkp_v0_8_1_write_be32(&pos[k][0], (uint32_t)(i + k));
+            rustsecp256k1zkp_v0_8_1_write_be32(&pos[k][4], 0);
+        }
+        rustsecp256k1zkp_v0_8_1_borromean_hash_multi(hashes, ngroup, e0, 0, 32, m, mlen, &pos[0][0]);
+        for (k = 0; k < ngroup; k++) {
+            rustsecp256k1zkp_v0_8_1_scalar_set_b32(&ens[k], &hashes[32 * k], &overflow[k]);
+        }
+        for (j = 0; j < maxsize; j++) {
+            /* Compute r for every ring that has a j-th pubkey. */
+            n = 0;
+            for (k = 0; k < ngroup; k++) {
+                size_t idx = first[k] + j;
+                if (j >= rsizes[i + k]) {
+                    continue;
+                }
+                if (overflow[k] || rustsecp256k1zkp_v0_8_1_scalar_is_zero(&s[idx]) || rustsecp256k1zkp_v0_8_1_scalar_is_zero(&ens[k]) || rustsecp256k1zkp_v0_8_1_gej_is_infinity(&pubs[idx])) {
+                    return 0;
+                }
+                if (evalues) {
+                    /*If requested, save the challenges for proof rewind.*/
+                    evalues[idx] = ens[k];
+                }
+                rustsecp256k1zkp_v0_8_1_ecmult(&rgej[n], &pubs[idx], &ens[k], &s[idx]);
+                if (rustsecp256k1zkp_v0_8_1_gej_is_infinity(&rgej[n])) {
+                    return 0;
+                }
+                lanes[n++] = k;
             }
-            if (evalues) {
-                /*If requested, save the challenges for proof rewind.*/
-                evalues[count] = ens;
+            rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(rge, rgej, n);
+            /* Hash the r of the rings that continue, the others are kept for e0. */
+            nr = n;
+            n = 0;
+            for (k = 0; k < nr; k++) {
+                size_t ring = lanes[k];
+                size_t len = 33;
+                rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&rge[k], r[ring], &len, 1);
+                if (j != rsizes[i + ring] - 1) {
+                    memcpy(e[n], r[ring], 33);
+                    rustsecp256k1zkp_v0_8_1_write_be32(&pos[n][0], (uint32_t)(i + ring));
+                    rustsecp256k1zkp_v0_8_1_write_be32(&pos[n][4], (uint32_t)(j + 1));
+                    lanes[n++] = ring;
+                }
             }
-            rustsecp256k1zkp_v0_8_1_ecmult(&rgej, &pubs[count], &ens, &s[count]);
-            if (rustsecp256k1zkp_v0_8_1_gej_is_infinity(&rgej)) {
-                return 0;
+            rustsecp256k1zkp_v0_8_1_borromean_hash_multi(hashes, n, &e[0][0], 33, 33, m, mlen, &pos[0][0]);
+            for (k = 0; k < n; k++) {
+                rustsecp256k1zkp_v0_8_1_scalar_set_b32(&ens[lanes[k]], &hashes[32 * k], &overflow[lanes[k]]);
             }
-            /* OPT: loop can be hoisted and split to use batch inversion across all the rings; this would make it much faster. */
-            rustsecp256k1zkp_v0_8_1_ge_set_gej_var(&rge, &rgej);
-            rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&rge, tmp, &size, 1);
-            if (j != rsizes[i] - 1) {
-                rustsecp256k1zkp_v0_8_1_borromean_hash(tmp, m, mlen, tmp, 33, i, j + 1);
-                rustsecp256k1zkp_v0_8_1_scalar_set_b32(&ens, tmp, &overflow);
-            } else {
-                rustsecp256k1zkp_v0_8_1_sha256_write(&sha256_e0, tmp, size);
+        }
+        for (k = 0; k < ngroup; k++) {
+            if (rsizes[i + k] > 0) {
+                rustsecp256k1zkp_v0_8_1_sha256_write(&sha256_e0, r[k], 33);
             }
-            count++;
         }
     }
     rustsecp256k1zkp_v0_8_1_sha256_write(&sha256_e0, m, mlen);
@@ -84,30 +84,38 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_convert(const rustsecp25
     return 1;
 }
 
-static int rustsecp256k1zkp_v0_8_1_ecdsa_sig_recover(const rustsecp256k1zkp_v0_8_1_scalar *sigr, const rustsecp256k1zkp_v0_8_1_scalar* sigs, rustsecp256k1zkp_v0_8_1_ge *pubkey, const rustsecp256k1zkp_v0_8_1_scalar *message, int recid) {
+/* Sets r to the nonce point R of a signature, whose x coordinate is sigr
+ * (plus the group order if recid & 2) and whose y coordinate is odd if
+ * recid & 1. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_sig_recover_nonce(rustsecp256k1zkp_v0_8_1_ge *r, const rustsecp256k1zkp_v0_8_1_scalar *sigr, int recid) {
     unsigned char brx[32];
     rustsecp256k1zkp_v0_8_1_fe fx;
+    int ret;
+
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(brx, sigr);
+    ret = rustsecp256k1zkp_v0_8_1_fe_set_b32_limit(&fx, brx);
+    (void)ret;
+    VERIFY_CHECK(ret); /* brx comes from a scalar, so is less than the order; certainly less than p */
+    if (recid & 2) {
+        if (rustsecp256k1zkp_v0_8_1_fe_cmp_var(&fx, &rustsecp256k1zkp_v0_8_1_ecdsa_const_p_minus_order) >= 0) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_fe_add(&fx, &rustsecp256k1zkp_v0_8_1_ecdsa_const_order_as_fe);
+    }
+    return rustsecp256k1zkp_v0_8_1_ge_set_xo_var(r, &fx, recid & 1);
+}
+
+static int rustsecp256k1zkp_v0_8_1_ecdsa_sig_recover(const rustsecp256k1zkp_v0_8_1_scalar *sigr, const rustsecp256k1zkp_v0_8_1_scalar* sigs, rustsecp256k1zkp_v0_8_1_ge *pubkey, const rustsecp256k1zkp_v0_8_1_scalar *message, int recid) {
     rustsecp256k1zkp_v0_8_1_ge x;
     rustsecp256k1zkp_v0_8_1_gej xj;
     rustsecp256k1zkp_v0_8_1_scalar rn, u1, u2;
     rustsecp256k1zkp_v0_8_1_gej qj;
-    int r;
 
     if (rustsecp256k1zkp_v0_8_1_scalar_is_zero(sigr) || rustsecp256k1zkp_v0_8_1_scalar_is_zero(sigs)) {
         return 0;
     }
 
-    rustsecp256k1zkp_v0_8_1_scalar_get_b32(brx, sigr);
-    r = rustsecp256k1zkp_v0_8_1_fe_set_b32_limit(&fx, brx);
-    (void)r;
-    VERIFY_CHECK(r); /* brx comes from a scalar, so is less than the order; certainly less than p */
-    if (recid & 2) {
-        if (rustsecp256k1zkp_v0_8_1_fe_cmp_var(&fx, &rustsecp256k1zkp_v0_8_1_ecdsa_const_p_minus_order) >= 0) {
-            return 0;
-        }
-        rustsecp256k1zkp_v0_8_1_fe_add(&fx, &rustsecp256k1zkp_v0_8_1_ecdsa_const_order_as_fe);
-    }
-    if (!rustsecp256k1zkp_v0_8_1_ge_set_xo_var(&x, &fx, recid & 1)) {
+    if (!rustsecp256k1zkp_v0_8_1_ecdsa_sig_recover_nonce(&x, sigr, recid)) {
         return 0;
     }
     rustsecp256k1zkp_v0_8_1_gej_set_ge(&xj, &x);
@@ -156,4 +164,144 @@ int rustsecp256k1zkp_v0_8_1_ecdsa_recover(const rustsecp256k1zkp_v0_8_1_context*
     }
 }
 
+/* Initializes SHA256 as a tagged hash with tag "ECDSArecovery/batch". */
+static void rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_batch_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_ECDSA_RECOVERY_BATCH);
+}
+
+/* The first signature gets weight 1, signature i > 0 gets weight
+ * SHA256(seed || i) where seed commits to all inputs of the batch. */
+static void rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_batch_weight(rustsecp256k1zkp_v0_8_1_scalar *weight, const unsigned char *seed32, size_t i) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char buf[32];
+    int j;
+
+    if (i == 0) {
+        rustsecp256k1zkp_v0_8_1_scalar_set_int(weight, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        buf[j] = ((uint64_t) i >> (8 * j)) & 0xff;
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, seed32, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, buf, 8);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(weight, buf, NULL);
+}
+
+typedef struct {
+    const rustsecp256k1zkp_v0_8_1_context *ctx;
+    const rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature * const *sigs;
+    const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys;
+    const unsigned char *seed32;
+    /* The weights a_i if they fit into the scratch space, or NULL. */
+    const rustsecp256k1zkp_v0_8_1_scalar *weights;
+} rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_data;
+
+/* Point 2*i is R_i with scalar a_i*s_i and point 2*i + 1 is P_i with scalar
+ * -a_i*r_i, so that sum_i a_i*(s_i*R_i - r_i*P_i) - (sum_i a_i*m_i)*G is
+ * infinity if all signatures are valid. The callback may be called from
+ * several threads, so a_i is not passed from point 2*i to point 2*i + 1 but
+ * taken from weights, and only hashed again without a scratch space. */
+static int rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_callback(rustsecp256k1zkp_v0_8_1_scalar *sc, rustsecp256k1zkp_v0_8_1_ge *pt, size_t idx, void *data) {
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_data *ecmult_data = (rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_data *) data;
+    rustsecp256k1zkp_v0_8_1_scalar sigr, sigs, weight;
+    int recid;
+
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_load(ecmult_data->ctx, &sigr, &sigs, &recid, ecmult_data->sigs[idx / 2]);
+    if (ecmult_data->weights != NULL) {
+        weight = ecmult_data->weights[idx / 2];
+    } else {
+        rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_batch_weight(&weight, ecmult_data->seed32, idx / 2);
+    }
+    if (idx % 2 == 0) {
+        if (!rustsecp256k1zkp_v0_8_1_ecdsa_sig_recover_nonce(pt, &sigr, recid)) {
+            return 0;
+        }
+        *sc = sigs;
+    } else {
+        if (!rustsecp256k1zkp_v0_8_1_pubkey_load(ecmult_data->ctx, pt, ecmult_data->pubkeys[idx / 2])) {
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_scalar_negate(sc, &sigr);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_mul(sc, sc, &weight);
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space *scratch, const rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature * const *sigs, const unsigned char * const *msghashes32, const rustsecp256k1zkp_v0_8_1_pubkey * const *pubkeys, size_t n_sigs) {
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_data ecmult_data;
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char seed[32];
+    rustsecp256k1zkp_v0_8_1_scalar g_sc;
+    rustsecp256k1zkp_v0_8_1_scalar *weights = NULL;
+    rustsecp256k1zkp_v0_8_1_gej resj;
+    size_t scratch_checkpoint = 0;
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_sigs == 0 || sigs != NULL);
+    ARG_CHECK(n_sigs == 0 || msghashes32 != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkeys != NULL);
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+
+    /* Derive the weights from all inputs so that they can't be predicted by
+     * whoever produced the signatures. */
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_batch_sha256_tagged(&sha);
+    for (i = 0; i < n_sigs; i++) {
+        ARG_CHECK(sigs[i] != NULL);
+        ARG_CHECK(msghashes32[i] != NULL);
+        ARG_CHECK(pubkeys[i] != NULL);
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, sigs[i]->data, sizeof(sigs[i]->data));
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, msghashes32[i], 32);
+        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, pubkeys[i]->data, sizeof(pubkeys[i]->data));
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, seed);
+
+    /* Keep the weights for the callback, so that each one is hashed once. */
+    if (scratch != NULL && n_sigs <= SIZE_MAX / sizeof(*weights)) {
+        scratch_checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&ctx->error_callback, scratch);
+        weights = (rustsecp256k1zkp_v0_8_1_scalar *) rustsecp256k1zkp_v0_8_1_scratch_alloc(&ctx->error_callback, scratch, n_sigs * sizeof(*weights));
+    }
+
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&g_sc, 0);
+    for (i = 0; i < n_sigs; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar sigr, sigs_i, msg, weight;
+        int recid;
+
+        rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_load(ctx, &sigr, &sigs_i, &recid, sigs[i]);
+        VERIFY_CHECK(recid >= 0 && recid < 4);  /* should have been caught in parse_compact */
+        /* Like ecdsa_verify, reject zero and high s values. */
+        if (rustsecp256k1zkp_v0_8_1_scalar_is_zero(&sigr) || rustsecp256k1zkp_v0_8_1_scalar_is_zero(&sigs_i) || rustsecp256k1zkp_v0_8_1_scalar_is_high(&sigs_i)) {
+            if (weights != NULL) {
+                rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+            }
+            return 0;
+        }
+        rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_batch_weight(&weight, seed, i);
+        if (weights != NULL) {
+            weights[i] = weight;
+        }
+        rustsecp256k1zkp_v0_8_1_scalar_set_b32(&msg, msghashes32[i], NULL);
+        rustsecp256k1zkp_v0_8_1_scalar_mul(&msg, &msg, &weight);
+        rustsecp256k1zkp_v0_8_1_scalar_add(&g_sc, &g_sc, &msg);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_negate(&g_sc, &g_sc);
+
+    /* sum_i a_i*(s_i*R_i - r_i*P_i - m_i*G) == infinity */
+    ecmult_data.ctx = ctx;
+    ecmult_data.sigs = sigs;
+    ecmult_data.pubkeys = pubkeys;
+    ecmult_data.seed32 = seed;
+    ecmult_data.weights = weights;
+    ret = rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&ctx->error_callback, scratch, &resj, &g_sc, rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch_ecmult_callback, (void *) &ecmult_data, 2 * n_sigs)
+          && rustsecp256k1zkp_v0_8_1_gej_is_infinity(&resj);
+    if (weights != NULL) {
+        rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    }
+    return ret;
+}
+
 #endif /* SECP256K1_MODULE_RECOVERY_MAIN_H */
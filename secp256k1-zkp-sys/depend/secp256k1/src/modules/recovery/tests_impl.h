@@ -359,6 +359,85 @@ static void test_ecdsa_recovery_edge_cases(void) {
     }
 }
 
+static void test_ecdsa_recoverable_verify_batch(void) {
+    enum { N_SIGS = 20 };
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature rsig[N_SIGS];
+    const rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature *rsig_ptr[N_SIGS];
+    unsigned char msg[N_SIGS][32];
+    const unsigned char *msg_ptr[N_SIGS];
+    rustsecp256k1zkp_v0_8_1_pubkey pubkey[N_SIGS];
+    const rustsecp256k1zkp_v0_8_1_pubkey *pubkey_ptr[N_SIGS];
+    rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature tmp;
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch;
+    rustsecp256k1zkp_v0_8_1_scalar s;
+    unsigned char sig64[64];
+    unsigned char privkey[32];
+    int32_t ecount = 0;
+    int recid;
+    size_t i;
+
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 1024 * 1024);
+    for (i = 0; i < N_SIGS; i++) {
+        rustsecp256k1zkp_v0_8_1_scalar key;
+        random_scalar_order_test(&key);
+        rustsecp256k1zkp_v0_8_1_scalar_get_b32(privkey, &key);
+        rustsecp256k1zkp_v0_8_1_testrand256(msg[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &pubkey[i], privkey) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_sign_recoverable(CTX, &rsig[i], msg[i], privkey, NULL, NULL) == 1);
+        rsig_ptr[i] = &rsig[i];
+        msg_ptr[i] = msg[i];
+        pubkey_ptr[i] = &pubkey[i];
+    }
+
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 1);
+    /* The weights kept in the scratch space are freed again. */
+    CHECK(scratch->alloc_size == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, NULL, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, 1) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, NULL, NULL, NULL, 0) == 1);
+
+    /* A wrong message or public key fails the batch. */
+    i = rustsecp256k1zkp_v0_8_1_testrand_int(N_SIGS);
+    msg_ptr[i] = msg[(i + 1) % N_SIGS];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+    msg_ptr[i] = msg[i];
+    pubkey_ptr[i] = &pubkey[(i + 1) % N_SIGS];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+    pubkey_ptr[i] = &pubkey[i];
+
+    /* So does a wrong recovery id, even though ecdsa_verify accepts the
+     * signature. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_serialize_compact(CTX, sig64, &recid, &rsig[i]) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_parse_compact(CTX, &tmp, sig64, recid ^ 1) == 1);
+    rsig_ptr[i] = &tmp;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+
+    /* Negating s and flipping the parity of R gives a valid signature with a
+     * high s value, which ecdsa_verify rejects. */
+    rustsecp256k1zkp_v0_8_1_scalar_set_b32(&s, &sig64[32], NULL);
+    rustsecp256k1zkp_v0_8_1_scalar_negate(&s, &s);
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(&sig64[32], &s);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_signature_parse_compact(CTX, &tmp, sig64, recid ^ 1) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+    CHECK(scratch->alloc_size == 0);
+    rsig_ptr[i] = &rsig[i];
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 1);
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, NULL, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, NULL, pubkey_ptr, N_SIGS) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, NULL, N_SIGS) == 0);
+    CHECK(ecount == 3);
+    rsig_ptr[i] = NULL;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecdsa_recoverable_verify_batch(CTX, scratch, rsig_ptr, msg_ptr, pubkey_ptr, N_SIGS) == 0);
+    CHECK(ecount == 4);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+}
+
 static void run_recovery_tests(void) {
     int i;
     for (i = 0; i < COUNT; i++) {
@@ -368,6 +447,9 @@ static void run_recovery_tests(void) {
         test_ecdsa_recovery_end_to_end();
     }
     test_ecdsa_recovery_edge_cases();
+    for (i = 0; i < COUNT; i++) {
+        test_ecdsa_recoverable_verify_batch();
+    }
 }
 
 #endif /* SECP256K1_MODULE_RECOVERY_TESTS_H */
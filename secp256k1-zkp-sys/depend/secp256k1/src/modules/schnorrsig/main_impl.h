@@ -11,36 +11,9 @@
 #include "../../../include/secp256k1_schnorrsig.h"
 #include "../../hash.h"
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("BIP0340/nonce")||SHA256("BIP0340/nonce"). */
-static void rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x46615b35ul;
-    sha->s[1] = 0xf4bfbff7ul;
-    sha->s[2] = 0x9f8dc671ul;
-    sha->s[3] = 0x83627ab3ul;
-    sha->s[4] = 0x60217180ul;
-    sha->s[5] = 0x57358661ul;
-    sha->s[6] = 0x21a29e54ul;
-    sha->s[7] = 0x68b07b4cul;
-
-    sha->bytes = 64;
-}
-
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("BIP0340/aux")||SHA256("BIP0340/aux"). */
+/* Initializes SHA256 as a tagged hash with tag "BIP0340/aux". */
 static void rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged_aux(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x24dd3219ul;
-    sha->s[1] = 0x4eba7e70ul;
-    sha->s[2] = 0xca0fabb9ul;
-    sha->s[3] = 0x0fa3166dul;
-    sha->s[4] = 0x3afbe4b1ul;
-    sha->s[5] = 0x4c44df97ul;
-    sha->s[6] = 0x4aac2739ul;
-    sha->s[7] = 0x249e850aul;
-
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_BIP0340_AUX);
 }
 
 /* algo argument for nonce_function_bip340 to derive the nonce exactly as stated in BIP-340
@@ -49,19 +22,16 @@ static const unsigned char bip340_algo[13] = "BIP0340/nonce";
 
 static const unsigned char schnorrsig_extraparams_magic[4] = SECP256K1_SCHNORRSIG_EXTRAPARAMS_MAGIC;
 
-static int nonce_function_bip340(unsigned char *nonce32, const unsigned char *msg, size_t msglen, const unsigned char *key32, const unsigned char *xonly_pk32, const unsigned char *algo, size_t algolen, void *data) {
-    rustsecp256k1zkp_v0_8_1_sha256 sha;
+/* Initializes sha as the nonce hash of nonce_function_bip340 and writes
+ * masked-key||pk to it, which only depends on the key and data. */
+static void rustsecp256k1zkp_v0_8_1_nonce_function_bip340_prefix(rustsecp256k1zkp_v0_8_1_sha256 *sha, const unsigned char *key32, const unsigned char *xonly_pk32, const unsigned char *algo, size_t algolen, void *data) {
     unsigned char masked_key[32];
     int i;
 
-    if (algo == NULL) {
-        return 0;
-    }
-
     if (data != NULL) {
-        rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged_aux(&sha);
-        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, data, 32);
-        rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, masked_key);
+        rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged_aux(sha);
+        rustsecp256k1zkp_v0_8_1_sha256_write(sha, data, 32);
+        rustsecp256k1zkp_v0_8_1_sha256_finalize(sha, masked_key);
         for (i = 0; i < 32; i++) {
             masked_key[i] ^= key32[i];
         }
@@ -80,17 +50,23 @@ static int nonce_function_bip340(unsigned char *nonce32, const unsigned char *ms
 
     /* Tag the hash with algo which is important to avoid nonce reuse across
      * algorithms. If this nonce function is used in BIP-340 signing as defined
-     * in the spec, an optimized tagging implementation is used. */
-    if (algolen == sizeof(bip340_algo)
-            && rustsecp256k1zkp_v0_8_1_memcmp_var(algo, bip340_algo, algolen) == 0) {
-        rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged(&sha);
-    } else {
-        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, algo, algolen);
-    }
+     * in the spec, the precomputed midstate for the tag is used. */
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(sha, algo, algolen);
 
     /* Hash masked-key||pk||msg using the tagged hash as per the spec */
-    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, masked_key, 32);
-    rustsecp256k1zkp_v0_8_1_sha256_write(&sha, xonly_pk32, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(sha, masked_key, 32);
+    rustsecp256k1zkp_v0_8_1_sha256_write(sha, xonly_pk32, 32);
+    memset(masked_key, 0, sizeof(masked_key));
+}
+
+static int nonce_function_bip340(unsigned char *nonce32, const unsigned char *msg, size_t msglen, const unsigned char *key32, const unsigned char *xonly_pk32, const unsigned char *algo, size_t algolen, void *data) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+
+    if (algo == NULL) {
+        return 0;
+    }
+
+    rustsecp256k1zkp_v0_8_1_nonce_function_bip340_prefix(&sha, key32, xonly_pk32, algo, algolen, data);
     rustsecp256k1zkp_v0_8_1_sha256_write(&sha, msg, msglen);
     rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, nonce32);
     return 1;
@@ -98,19 +74,9 @@ static int nonce_function_bip340(unsigned char *nonce32, const unsigned char *ms
 
 const rustsecp256k1zkp_v0_8_1_nonce_function_hardened rustsecp256k1zkp_v0_8_1_nonce_function_bip340 = nonce_function_bip340;
 
-/* Initializes SHA256 with fixed midstate. This midstate was computed by applying
- * SHA256 to SHA256("BIP0340/challenge")||SHA256("BIP0340/challenge"). */
+/* Initializes SHA256 as a tagged hash with tag "BIP0340/challenge". */
 static void rustsecp256k1zkp_v0_8_1_schnorrsig_sha256_tagged(rustsecp256k1zkp_v0_8_1_sha256 *sha) {
-    rustsecp256k1zkp_v0_8_1_sha256_initialize(sha);
-    sha->s[0] = 0x9cecba11ul;
-    sha->s[1] = 0x23925381ul;
-    sha->s[2] = 0x11679112ul;
-    sha->s[3] = 0xd1627e0ful;
-    sha->s[4] = 0x97c87550ul;
-    sha->s[5] = 0x003cc765ul;
-    sha->s[6] = 0x90f61164ul;
-    sha->s[7] = 0x33e9b66aul;
-    sha->bytes = 64;
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(sha, SECP256K1_TAG_BIP0340_CHALLENGE);
 }
 
 static void rustsecp256k1zkp_v0_8_1_schnorrsig_challenge(rustsecp256k1zkp_v0_8_1_scalar* e, const unsigned char *r32, const unsigned char *msg, size_t msglen, const unsigned char *pubkey32)
@@ -216,6 +182,105 @@ int rustsecp256k1zkp_v0_8_1_schnorrsig_sign_custom(const rustsecp256k1zkp_v0_8_1
     return rustsecp256k1zkp_v0_8_1_schnorrsig_sign_internal(ctx, sig64, msg, msglen, keypair, noncefp, ndata);
 }
 
+/* Number of signatures whose nonce points are brought to affine coordinates
+ * with one field inversion in schnorrsig_sign_batch. */
+#define SECP256K1_SCHNORRSIG_SIGN_BATCH 32
+
+int rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *sig64, const unsigned char * const *msgs, const size_t *msglens, const rustsecp256k1zkp_v0_8_1_keypair *keypair, const unsigned char * const *aux_rands32, size_t n) {
+    rustsecp256k1zkp_v0_8_1_scalar sk;
+    rustsecp256k1zkp_v0_8_1_scalar k[SECP256K1_SCHNORRSIG_SIGN_BATCH];
+    rustsecp256k1zkp_v0_8_1_gej rj[SECP256K1_SCHNORRSIG_SIGN_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge r[SECP256K1_SCHNORRSIG_SIGN_BATCH];
+    int ret_k[SECP256K1_SCHNORRSIG_SIGN_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge pk;
+    rustsecp256k1zkp_v0_8_1_sha256 nonce_sha;
+    unsigned char pk_buf[32];
+    unsigned char seckey[32];
+    int ret_key;
+    int ret = 1;
+    size_t i, j;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || sig64 != NULL);
+    ARG_CHECK(n == 0 || msgs != NULL);
+    ARG_CHECK(n == 0 || msglens != NULL);
+    ARG_CHECK(keypair != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+    }
+
+    /* The key is loaded once for all messages. */
+    ret_key = rustsecp256k1zkp_v0_8_1_keypair_load(ctx, &sk, &pk, keypair);
+    if (rustsecp256k1zkp_v0_8_1_fe_is_odd(&pk.y)) {
+        rustsecp256k1zkp_v0_8_1_scalar_negate(&sk, &sk);
+    }
+    rustsecp256k1zkp_v0_8_1_scalar_get_b32(seckey, &sk);
+    rustsecp256k1zkp_v0_8_1_fe_get_b32(pk_buf, &pk.x);
+    /* Without auxiliary randomness, the nonce hashes of all messages start
+     * with the same 64 bytes. */
+    if (aux_rands32 == NULL) {
+        rustsecp256k1zkp_v0_8_1_nonce_function_bip340_prefix(&nonce_sha, seckey, pk_buf, bip340_algo, sizeof(bip340_algo), NULL);
+    }
+
+    for (i = 0; i < n; i += SECP256K1_SCHNORRSIG_SIGN_BATCH) {
+        size_t len = n - i < SECP256K1_SCHNORRSIG_SIGN_BATCH ? n - i : SECP256K1_SCHNORRSIG_SIGN_BATCH;
+        for (j = 0; j < len; j++) {
+            rustsecp256k1zkp_v0_8_1_sha256 sha;
+            unsigned char buf[32];
+
+            if (aux_rands32 == NULL) {
+                sha = nonce_sha;
+            } else {
+                /* Cast away const like schnorrsig_sign32, the nonce function
+                 * does not modify the data. */
+                rustsecp256k1zkp_v0_8_1_nonce_function_bip340_prefix(&sha, seckey, pk_buf, bip340_algo, sizeof(bip340_algo), (unsigned char *)aux_rands32[i + j]);
+            }
+            rustsecp256k1zkp_v0_8_1_sha256_write(&sha, msgs[i + j], msglens[i + j]);
+            rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, buf);
+            memset(&sha, 0, sizeof(sha));
+            rustsecp256k1zkp_v0_8_1_scalar_set_b32(&k[j], buf, NULL);
+            ret_k[j] = ret_key & !rustsecp256k1zkp_v0_8_1_scalar_is_zero(&k[j]);
+            rustsecp256k1zkp_v0_8_1_scalar_cmov(&k[j], &rustsecp256k1zkp_v0_8_1_scalar_one, !ret_k[j]);
+            rustsecp256k1zkp_v0_8_1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj[j], &k[j]);
+            memset(buf, 0, sizeof(buf));
+        }
+
+        /* A single inversion brings the nonce points of the whole batch to
+         * affine coordinates. */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej(r, rj, len);
+        /* We declassify r to allow using it as a branch point. This is fine
+         * because r is not a secret. */
+        rustsecp256k1zkp_v0_8_1_declassify(ctx, r, len * sizeof(*r));
+        for (j = 0; j < len; j++) {
+            unsigned char *sig = &sig64[64 * (i + j)];
+            rustsecp256k1zkp_v0_8_1_scalar e;
+
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&r[j].y);
+            if (rustsecp256k1zkp_v0_8_1_fe_is_odd(&r[j].y)) {
+                rustsecp256k1zkp_v0_8_1_scalar_negate(&k[j], &k[j]);
+            }
+            rustsecp256k1zkp_v0_8_1_fe_normalize_var(&r[j].x);
+            rustsecp256k1zkp_v0_8_1_fe_get_b32(&sig[0], &r[j].x);
+
+            rustsecp256k1zkp_v0_8_1_schnorrsig_challenge(&e, &sig[0], msgs[i + j], msglens[i + j], pk_buf);
+            rustsecp256k1zkp_v0_8_1_scalar_mul(&e, &e, &sk);
+            rustsecp256k1zkp_v0_8_1_scalar_add(&e, &e, &k[j]);
+            rustsecp256k1zkp_v0_8_1_scalar_get_b32(&sig[32], &e);
+
+            rustsecp256k1zkp_v0_8_1_memczero(sig, 64, !ret_k[j]);
+            ret &= ret_k[j];
+            rustsecp256k1zkp_v0_8_1_scalar_clear(&k[j]);
+            rustsecp256k1zkp_v0_8_1_gej_clear(&rj[j]);
+        }
+    }
+
+    rustsecp256k1zkp_v0_8_1_scalar_clear(&sk);
+    memset(seckey, 0, sizeof(seckey));
+    memset(&nonce_sha, 0, sizeof(nonce_sha));
+    return ret & ret_key;
+}
+
 int rustsecp256k1zkp_v0_8_1_schnorrsig_verify(const rustsecp256k1zkp_v0_8_1_context* ctx, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const rustsecp256k1zkp_v0_8_1_xonly_pubkey *pubkey) {
     rustsecp256k1zkp_v0_8_1_scalar s;
     rustsecp256k1zkp_v0_8_1_scalar e;
@@ -36,11 +36,10 @@ static void run_nonce_function_bip340_tests(void) {
     unsigned char *args[5];
     int i;
 
-    /* Check that hash initialized by
-     * rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged has the expected
-     * state. */
+    /* Check that the precomputed midstate nonce_function_bip340 looks up
+     * for its tag has the expected state. */
     rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, tag, sizeof(tag));
-    rustsecp256k1zkp_v0_8_1_nonce_function_bip340_sha256_tagged(&sha_optimized);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha_optimized, tag, sizeof(tag));
     test_sha256_eq(&sha, &sha_optimized);
 
    /* Check that hash initialized by
@@ -964,6 +963,74 @@ static void test_schnorrsig_sign_verify(void) {
 }
 #undef N_SIGS
 
+/* Checks that schnorrsig_sign_batch creates the same signatures as
+ * schnorrsig_sign_custom, over more than one batch of nonce points. */
+static void test_schnorrsig_sign_batch(void) {
+    enum { N_MSGS = 45 };
+    unsigned char sk[32];
+    unsigned char msg[N_MSGS][40];
+    const unsigned char *msg_ptr[N_MSGS];
+    size_t msglen[N_MSGS];
+    unsigned char aux_rand[N_MSGS][32];
+    const unsigned char *aux_rand_ptr[N_MSGS];
+    unsigned char sig[N_MSGS][64];
+    unsigned char sig_single[64];
+    unsigned char zeros[sizeof(sig)] = { 0 };
+    rustsecp256k1zkp_v0_8_1_keypair keypair;
+    rustsecp256k1zkp_v0_8_1_keypair invalid_keypair = {{ 0 }};
+    rustsecp256k1zkp_v0_8_1_xonly_pubkey pk;
+    rustsecp256k1zkp_v0_8_1_schnorrsig_extraparams extraparams = SECP256K1_SCHNORRSIG_EXTRAPARAMS_INIT;
+    int ecount = 0;
+    int use_aux;
+    size_t i;
+
+    rustsecp256k1zkp_v0_8_1_testrand256(sk);
+    CHECK(rustsecp256k1zkp_v0_8_1_keypair_create(CTX, &keypair, sk) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_keypair_xonly_pub(CTX, &pk, NULL, &keypair) == 1);
+    for (i = 0; i < N_MSGS; i++) {
+        rustsecp256k1zkp_v0_8_1_testrand_bytes_test(msg[i], sizeof(msg[i]));
+        rustsecp256k1zkp_v0_8_1_testrand256(aux_rand[i]);
+        msglen[i] = i % 3 == 0 ? 32 : rustsecp256k1zkp_v0_8_1_testrand_int(sizeof(msg[i]) + 1);
+        msg_ptr[i] = msglen[i] == 0 ? NULL : msg[i];
+        aux_rand_ptr[i] = aux_rand[i];
+    }
+
+    for (use_aux = 0; use_aux < 2; use_aux++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], msg_ptr, msglen, &keypair, use_aux ? aux_rand_ptr : NULL, N_MSGS) == 1);
+        for (i = 0; i < N_MSGS; i++) {
+            extraparams.ndata = use_aux ? aux_rand[i] : NULL;
+            CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_custom(CTX, sig_single, msg_ptr[i], msglen[i], &keypair, &extraparams) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(sig[i], sig_single, sizeof(sig_single)) == 0);
+            CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_verify(CTX, sig[i], msg_ptr[i], msglen[i], &pk) == 1);
+        }
+    }
+
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, counting_illegal_callback_fn, &ecount);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, counting_illegal_callback_fn, &ecount);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, NULL, NULL, NULL, &keypair, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, NULL, msg_ptr, msglen, &keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], NULL, msglen, &keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], msg_ptr, NULL, &keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], msg_ptr, msglen, NULL, NULL, N_MSGS) == 0);
+    CHECK(ecount == 4);
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(STATIC_CTX, sig[0], msg_ptr, msglen, &keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 5);
+    msg_ptr[3] = NULL;
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], msg_ptr, msglen, &keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 6);
+    msg_ptr[3] = msg[3];
+    /* An invalid keypair zeroes all signatures. */
+    CHECK(rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch(CTX, sig[0], msg_ptr, msglen, &invalid_keypair, NULL, N_MSGS) == 0);
+    CHECK(ecount == 7);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(sig, zeros, sizeof(sig)) == 0);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(CTX, NULL, NULL);
+    rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(STATIC_CTX, NULL, NULL);
+}
+
 static void test_schnorrsig_taproot(void) {
     unsigned char sk[32];
     rustsecp256k1zkp_v0_8_1_keypair keypair;
@@ -1011,6 +1078,7 @@ static void run_schnorrsig_tests(void) {
         test_schnorrsig_sign();
         test_schnorrsig_sign_verify();
     }
+    test_schnorrsig_sign_batch();
     test_schnorrsig_taproot();
 }
 
@@ -33,20 +33,6 @@ static int rustsecp256k1zkp_v0_8_1_whitelist_hash_pubkey(rustsecp256k1zkp_v0_8_1
     return 1;
 }
 
-static int rustsecp256k1zkp_v0_8_1_whitelist_tweak_pubkey(rustsecp256k1zkp_v0_8_1_gej* pub_tweaked) {
-    rustsecp256k1zkp_v0_8_1_scalar tweak;
-    rustsecp256k1zkp_v0_8_1_scalar zero;
-    int ret;
-
-    rustsecp256k1zkp_v0_8_1_scalar_set_int(&zero, 0);
-
-    ret = rustsecp256k1zkp_v0_8_1_whitelist_hash_pubkey(&tweak, pub_tweaked);
-    if (ret) {
-        rustsecp256k1zkp_v0_8_1_ecmult(pub_tweaked, pub_tweaked, &tweak, &zero);
-    }
-    return ret;
-}
-
 static int rustsecp256k1zkp_v0_8_1_whitelist_compute_tweaked_privkey(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scalar* skey, const unsigned char *online_key, const unsigned char *summed_key) {
     rustsecp256k1zkp_v0_8_1_scalar tweak;
     int ret = 1;
@@ -80,16 +66,28 @@ static int rustsecp256k1zkp_v0_8_1_whitelist_compute_tweaked_privkey(const rusts
     return ret;
 }
 
+/* Number of keys whose tweaks are hashed together in
+ * rustsecp256k1zkp_v0_8_1_whitelist_compute_keys_and_message. */
+#define SECP256K1_WHITELIST_TWEAK_BATCH 32
+
 /* Takes a list of pubkeys and combines them to form the public keys needed
  * for the ring signature; also produce a commitment to every one that will
  * be our "message". */
 static int rustsecp256k1zkp_v0_8_1_whitelist_compute_keys_and_message(const rustsecp256k1zkp_v0_8_1_context* ctx, unsigned char *msg32, rustsecp256k1zkp_v0_8_1_gej *keys, const rustsecp256k1zkp_v0_8_1_pubkey *online_pubkeys, const rustsecp256k1zkp_v0_8_1_pubkey *offline_pubkeys, const int n_keys, const rustsecp256k1zkp_v0_8_1_pubkey *sub_pubkey) {
     unsigned char c[33];
+    unsigned char tweak_c[SECP256K1_WHITELIST_TWEAK_BATCH][33];
+    unsigned char tweak_h[SECP256K1_WHITELIST_TWEAK_BATCH][32];
     size_t size = 33;
     rustsecp256k1zkp_v0_8_1_sha256 sha;
-    int i;
+    rustsecp256k1zkp_v0_8_1_sha256 tweak_sha[SECP256K1_WHITELIST_TWEAK_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge online_ge[SECP256K1_WHITELIST_TWEAK_BATCH];
+    rustsecp256k1zkp_v0_8_1_ge tweaked_ge[SECP256K1_WHITELIST_TWEAK_BATCH];
+    rustsecp256k1zkp_v0_8_1_scalar tweak;
+    rustsecp256k1zkp_v0_8_1_scalar zero;
+    int i, j, n;
     rustsecp256k1zkp_v0_8_1_ge subkey_ge;
 
+    rustsecp256k1zkp_v0_8_1_scalar_set_int(&zero, 0);
     rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha);
     rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &subkey_ge, sub_pubkey);
 
@@ -98,32 +96,55 @@ static int rustsecp256k1zkp_v0_8_1_whitelist_compute_keys_and_message(const rust
         return 0;
     }
     rustsecp256k1zkp_v0_8_1_sha256_write(&sha, c, size);
-    for (i = 0; i < n_keys; i++) {
-        rustsecp256k1zkp_v0_8_1_ge offline_ge;
-        rustsecp256k1zkp_v0_8_1_ge online_ge;
-        rustsecp256k1zkp_v0_8_1_gej tweaked_gej;
-
-        /* commit to fixed keys */
-        rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &offline_ge, &offline_pubkeys[i]);
-        if (!rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&offline_ge, c, &size, SECP256K1_EC_COMPRESSED)) {
-            return 0;
+    for (i = 0; i < n_keys; i += n) {
+        n = n_keys - i < SECP256K1_WHITELIST_TWEAK_BATCH ? n_keys - i : SECP256K1_WHITELIST_TWEAK_BATCH;
+        for (j = 0; j < n; j++) {
+            rustsecp256k1zkp_v0_8_1_ge offline_ge;
+
+            /* commit to fixed keys */
+            rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &offline_ge, &offline_pubkeys[i + j]);
+            if (!rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&offline_ge, c, &size, SECP256K1_EC_COMPRESSED)) {
+                return 0;
+            }
+            rustsecp256k1zkp_v0_8_1_sha256_write(&sha, c, size);
+            rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &online_ge[j], &online_pubkeys[i + j]);
+            if (!rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&online_ge[j], c, &size, SECP256K1_EC_COMPRESSED)) {
+                return 0;
+            }
+            rustsecp256k1zkp_v0_8_1_sha256_write(&sha, c, size);
+
+            rustsecp256k1zkp_v0_8_1_gej_set_ge(&keys[i + j], &offline_ge);
+            rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&keys[i + j], &keys[i + j], &subkey_ge, NULL);
         }
-        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, c, size);
-        rustsecp256k1zkp_v0_8_1_pubkey_load(ctx, &online_ge, &online_pubkeys[i]);
-        if (!rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&online_ge, c, &size, SECP256K1_EC_COMPRESSED)) {
-            return 0;
-        }
-        rustsecp256k1zkp_v0_8_1_sha256_write(&sha, c, size);
 
-        /* compute tweaked keys */
-        rustsecp256k1zkp_v0_8_1_gej_set_ge(&tweaked_gej, &offline_ge);
-        rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&tweaked_gej, &tweaked_gej, &subkey_ge, NULL);
-        rustsecp256k1zkp_v0_8_1_whitelist_tweak_pubkey(&tweaked_gej);
-        rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&keys[i], &tweaked_gej, &online_ge, NULL);
+        /* compute tweaked keys, hashing the serializations of the whole batch
+         * together as in rustsecp256k1zkp_v0_8_1_whitelist_hash_pubkey */
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej_var(tweaked_ge, &keys[i], n);
+        for (j = 0; j < n; j++) {
+            rustsecp256k1zkp_v0_8_1_sha256_initialize(&tweak_sha[j]);
+            if (rustsecp256k1zkp_v0_8_1_ge_is_infinity(&tweaked_ge[j])) {
+                /* Not tweaked below, as the tweak cannot change infinity. */
+                memset(tweak_c[j], 0, sizeof(tweak_c[j]));
+            } else {
+                rustsecp256k1zkp_v0_8_1_eckey_pubkey_serialize(&tweaked_ge[j], tweak_c[j], &size, SECP256K1_EC_COMPRESSED);
+            }
+        }
+        rustsecp256k1zkp_v0_8_1_sha256_write_multi(tweak_sha, n, tweak_c[0], sizeof(tweak_c[0]), sizeof(tweak_c[0]));
+        rustsecp256k1zkp_v0_8_1_sha256_finalize_multi(tweak_sha, n, tweak_h[0]);
+        for (j = 0; j < n; j++) {
+            int overflow = 0;
+
+            rustsecp256k1zkp_v0_8_1_scalar_set_b32(&tweak, tweak_h[j], &overflow);
+            /* The overflow and zero cases are mathematically impossible to hit */
+            if (!rustsecp256k1zkp_v0_8_1_ge_is_infinity(&tweaked_ge[j]) && !overflow && !rustsecp256k1zkp_v0_8_1_scalar_is_zero(&tweak)) {
+                rustsecp256k1zkp_v0_8_1_gej_set_ge(&keys[i + j], &tweaked_ge[j]);
+                rustsecp256k1zkp_v0_8_1_ecmult(&keys[i + j], &keys[i + j], &tweak, &zero);
+            }
+            rustsecp256k1zkp_v0_8_1_gej_add_ge_var(&keys[i + j], &keys[i + j], &online_ge[j], NULL);
+        }
     }
     rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, msg32);
     return 1;
 }
 
-
 #endif
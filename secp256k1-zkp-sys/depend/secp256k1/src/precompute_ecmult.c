@@ -6,6 +6,8 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "../include/secp256k1.h"
 
@@ -17,6 +19,9 @@
 #include "int128_impl.h"
 #include "ecmult.h"
 #include "ecmult_compute_table_impl.h"
+#include "ecmult_gen_compute_table_impl.h"
+#include "ecmult_tables.h"
+#include "hash_impl.h"
 
 static void print_table(FILE *fp, const char *name, int window_g, const rustsecp256k1zkp_v0_8_1_ge_storage* table) {
     int j;
@@ -53,12 +58,67 @@ static void print_two_tables(FILE *fp, int window_g) {
     free(table_128);
 }
 
-int main(void) {
+/* Writes a table file as described in ecmult_tables.h. */
+static int write_tables_file(const char *outfile, int window_g) {
+    const size_t n = ECMULT_TABLE_SIZE(window_g);
+    const size_t size = ECMULT_TABLES_SIZE(window_g, ECMULT_GEN_PREC_BITS);
+    unsigned char header[ECMULT_TABLES_HEADER_SIZE] = {0};
+    rustsecp256k1zkp_v0_8_1_ge_storage* tables = malloc(size);
+    rustsecp256k1zkp_v0_8_1_sha256 hash;
+    uint32_t field;
+    FILE* fp;
+    int ret;
+
+    if (tables == NULL) {
+        fprintf(stderr, "Could not allocate %lu bytes!\n", (unsigned long)size);
+        return -1;
+    }
+    rustsecp256k1zkp_v0_8_1_ecmult_compute_two_tables(tables, &tables[n], window_g, &rustsecp256k1zkp_v0_8_1_ge_const_g);
+    rustsecp256k1zkp_v0_8_1_ecmult_gen_compute_table(&tables[2 * n], &rustsecp256k1zkp_v0_8_1_ge_const_g, ECMULT_GEN_PREC_BITS);
+
+    memcpy(header, rustsecp256k1zkp_v0_8_1_ecmult_tables_magic, sizeof(rustsecp256k1zkp_v0_8_1_ecmult_tables_magic));
+    field = ECMULT_TABLES_VERSION;
+    memcpy(&header[8], &field, sizeof(field));
+    field = window_g;
+    memcpy(&header[12], &field, sizeof(field));
+    field = ECMULT_GEN_PREC_BITS;
+    memcpy(&header[16], &field, sizeof(field));
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&hash);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, (const unsigned char *)tables, size);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&hash, &header[32]);
+
+    fp = fopen(outfile, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "Could not open %s for writing!\n", outfile);
+        free(tables);
+        return -1;
+    }
+    ret = fwrite(header, sizeof(header), 1, fp) == 1 && fwrite(tables, size, 1, fp) == 1;
+    ret &= fclose(fp) == 0;
+    free(tables);
+    if (!ret) {
+        fprintf(stderr, "Could not write %s!\n", outfile);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
     /* Always compute all tables for window sizes up to 15. */
     int window_g = (ECMULT_WINDOW_SIZE < 15) ? 15 : ECMULT_WINDOW_SIZE;
     const char outfile[] = "src/precomputed_ecmult.c";
     FILE* fp;
 
+    /* With arguments, write a table file to be loaded at runtime instead. */
+    if (argc > 1) {
+        window_g = argc == 3 ? atoi(argv[1]) : 0;
+        if (window_g < 2 || window_g > 24) {
+            fprintf(stderr, "Usage: %s [<window size 2..24> <output file>]\n", argv[0]);
+            return -1;
+        }
+        return write_tables_file(argv[2], window_g);
+    }
+
     fp = fopen(outfile, "w");
     if (fp == NULL) {
         fprintf(stderr, "Could not open %s for writing!\n", outfile);
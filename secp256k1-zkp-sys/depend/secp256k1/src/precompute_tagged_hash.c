@@ -0,0 +1,85 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/secp256k1.h"
+
+#include "assumptions.h"
+#include "util.h"
+
+#include "hash_impl.h"
+
+/* Every tag the library hashes with. The first entry of each pair is the
+ * suffix of the SECP256K1_TAG_ index constant in the generated file. */
+static const char * const tags[][2] = {
+    {"BIP0340_CHALLENGE", "BIP0340/challenge"},
+    {"BIP0340_AUX", "BIP0340/aux"},
+    {"BIP0340_NONCE", "BIP0340/nonce"},
+    {"KEYAGG_LIST", "KeyAgg list"},
+    {"KEYAGG_COEFFICIENT", "KeyAgg coefficient"},
+    {"MUSIG_AUX", "MuSig/aux"},
+    {"MUSIG_NONCE", "MuSig/nonce"},
+    {"MUSIG_NONCECOEF", "MuSig/noncecoef"},
+    {"MUSIG_SIGN_BATCH", "MuSig/partial_sign_batch"},
+    {"ECDSA_ADAPTOR_NONCE", "ECDSAadaptor/non"},
+    {"ECDSA_ADAPTOR_AUX", "ECDSAadaptor/aux"},
+    {"ECDSA_ADAPTOR_BATCH", "ECDSAadaptor/batch"},
+    {"ECDSA_RECOVERY_BATCH", "ECDSArecovery/batch"},
+    {"DLEQ", "DLEQ"},
+    {"S2C_ECDSA_DATA", "s2c/ecdsa/data"},
+    {"S2C_ECDSA_POINT", "s2c/ecdsa/point"},
+    {"ELLSWIFT_ENCODE", "secp256k1_ellswift_encode"},
+    {"ELLSWIFT_CREATE", "secp256k1_ellswift_create"},
+    {"BIP324_ELLSWIFT_XONLY_ECDH", "bip324_ellswift_xonly_ecdh"},
+    {"BPPP_COMMITMENT", "Bulletproofs_pp/v0/commitment"}
+};
+
+int main(int argc, char **argv) {
+    const char outfile[] = "src/precomputed_tagged_hash.h";
+    const size_t n = sizeof(tags) / sizeof(tags[0]);
+    FILE* fp;
+    size_t i;
+    int j;
+
+    (void)argc;
+    (void)argv;
+
+    fp = fopen(outfile, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "Could not open %s for writing!\n", outfile);
+        return -1;
+    }
+
+    fprintf(fp, "/* This file was automatically generated by precompute_tagged_hash. */\n");
+    fprintf(fp, "/* See tagged_hash_impl.h for details about the contents of this file. */\n");
+    fprintf(fp, "#ifndef SECP256K1_PRECOMPUTED_TAGGED_HASH_H\n");
+    fprintf(fp, "#define SECP256K1_PRECOMPUTED_TAGGED_HASH_H\n\n");
+    fprintf(fp, "#include \"hash.h\"\n\n");
+    for (i = 0; i < n; i++) {
+        fprintf(fp, "#define SECP256K1_TAG_%s %lu\n", tags[i][0], (unsigned long)i);
+    }
+    fprintf(fp, "#define SECP256K1_TAG_COUNT %lu\n\n", (unsigned long)n);
+    fprintf(fp, "static const rustsecp256k1zkp_v0_8_1_sha256_tag_midstate rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[SECP256K1_TAG_COUNT] = {\n");
+    for (i = 0; i < n; i++) {
+        rustsecp256k1zkp_v0_8_1_sha256 hash;
+        size_t taglen = strlen(tags[i][1]);
+
+        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&hash, (const unsigned char *)tags[i][1], taglen);
+        VERIFY_CHECK(hash.bytes == 64);
+        fprintf(fp, "    {\"%s\", %lu, {", tags[i][1], (unsigned long)taglen);
+        for (j = 0; j < 8; j++) {
+            fprintf(fp, "0x%08"PRIx32"ul%s", hash.s[j], j != 7 ? ", " : "");
+        }
+        fprintf(fp, "}}%s\n", i != n - 1 ? "," : "");
+    }
+    fprintf(fp, "};\n\n");
+    fprintf(fp, "#endif /* SECP256K1_PRECOMPUTED_TAGGED_HASH_H */\n");
+    fclose(fp);
+
+    return 0;
+}
@@ -16,7 +16,23 @@ extern "C" {
 #ifdef EXHAUSTIVE_TEST_ORDER
 static rustsecp256k1zkp_v0_8_1_ge_storage rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[ECMULT_GEN_PREC_N(ECMULT_GEN_PREC_BITS)][ECMULT_GEN_PREC_G(ECMULT_GEN_PREC_BITS)];
 #else
-extern const rustsecp256k1zkp_v0_8_1_ge_storage rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[ECMULT_GEN_PREC_N(ECMULT_GEN_PREC_BITS)][ECMULT_GEN_PREC_G(ECMULT_GEN_PREC_BITS)];
+#if ECMULT_GEN_PREC_BITS == 2 || defined(ECMULT_GEN_ALL_PREC_TABLES)
+extern const rustsecp256k1zkp_v0_8_1_ge_storage rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_2[ECMULT_GEN_PREC_N(2)][ECMULT_GEN_PREC_G(2)];
+#endif
+#if ECMULT_GEN_PREC_BITS == 4 || defined(ECMULT_GEN_ALL_PREC_TABLES)
+extern const rustsecp256k1zkp_v0_8_1_ge_storage rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_4[ECMULT_GEN_PREC_N(4)][ECMULT_GEN_PREC_G(4)];
+#endif
+#if ECMULT_GEN_PREC_BITS == 8 || defined(ECMULT_GEN_ALL_PREC_TABLES)
+extern const rustsecp256k1zkp_v0_8_1_ge_storage rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_8[ECMULT_GEN_PREC_N(8)][ECMULT_GEN_PREC_G(8)];
+#endif
+/* The table for ECMULT_GEN_PREC_BITS, used by contexts with the default table. */
+#if ECMULT_GEN_PREC_BITS == 2
+#  define rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_2
+#elif ECMULT_GEN_PREC_BITS == 4
+#  define rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_4
+#else
+#  define rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table_8
+#endif
 #endif /* defined(EXHAUSTIVE_TEST_ORDER) */
 
 #ifdef __cplusplus
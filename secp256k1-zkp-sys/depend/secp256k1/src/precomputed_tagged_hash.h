@@ -0,0 +1,53 @@
+/* This file was automatically generated by precompute_tagged_hash. */
+/* See tagged_hash_impl.h for details about the contents of this file. */
+#ifndef SECP256K1_PRECOMPUTED_TAGGED_HASH_H
+#define SECP256K1_PRECOMPUTED_TAGGED_HASH_H
+
+#include "hash.h"
+
+#define SECP256K1_TAG_BIP0340_CHALLENGE 0
+#define SECP256K1_TAG_BIP0340_AUX 1
+#define SECP256K1_TAG_BIP0340_NONCE 2
+#define SECP256K1_TAG_KEYAGG_LIST 3
+#define SECP256K1_TAG_KEYAGG_COEFFICIENT 4
+#define SECP256K1_TAG_MUSIG_AUX 5
+#define SECP256K1_TAG_MUSIG_NONCE 6
+#define SECP256K1_TAG_MUSIG_NONCECOEF 7
+#define SECP256K1_TAG_MUSIG_SIGN_BATCH 8
+#define SECP256K1_TAG_ECDSA_ADAPTOR_NONCE 9
+#define SECP256K1_TAG_ECDSA_ADAPTOR_AUX 10
+#define SECP256K1_TAG_ECDSA_ADAPTOR_BATCH 11
+#define SECP256K1_TAG_ECDSA_RECOVERY_BATCH 12
+#define SECP256K1_TAG_DLEQ 13
+#define SECP256K1_TAG_S2C_ECDSA_DATA 14
+#define SECP256K1_TAG_S2C_ECDSA_POINT 15
+#define SECP256K1_TAG_ELLSWIFT_ENCODE 16
+#define SECP256K1_TAG_ELLSWIFT_CREATE 17
+#define SECP256K1_TAG_BIP324_ELLSWIFT_XONLY_ECDH 18
+#define SECP256K1_TAG_BPPP_COMMITMENT 19
+#define SECP256K1_TAG_COUNT 20
+
+static const rustsecp256k1zkp_v0_8_1_sha256_tag_midstate rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[SECP256K1_TAG_COUNT] = {
+    {"BIP0340/challenge", 17, {0x9cecba11ul, 0x23925381ul, 0x11679112ul, 0xd1627e0ful, 0x97c87550ul, 0x003cc765ul, 0x90f61164ul, 0x33e9b66aul}},
+    {"BIP0340/aux", 11, {0x24dd3219ul, 0x4eba7e70ul, 0xca0fabb9ul, 0x0fa3166dul, 0x3afbe4b1ul, 0x4c44df97ul, 0x4aac2739ul, 0x249e850aul}},
+    {"BIP0340/nonce", 13, {0x46615b35ul, 0xf4bfbff7ul, 0x9f8dc671ul, 0x83627ab3ul, 0x60217180ul, 0x57358661ul, 0x21a29e54ul, 0x68b07b4cul}},
+    {"KeyAgg list", 11, {0xb399d5e0ul, 0xc8fff302ul, 0x6badac71ul, 0x07c5b7f1ul, 0x9701e2eful, 0x2a72ecf8ul, 0x201a4c7bul, 0xab148a38ul}},
+    {"KeyAgg coefficient", 18, {0x6ef02c5aul, 0x06a480deul, 0x1f298665ul, 0x1d1134f2ul, 0x56a0b063ul, 0x52da4147ul, 0xf280d9d4ul, 0x4484be15ul}},
+    {"MuSig/aux", 9, {0xa19e884bul, 0xf463fe7eul, 0x2f18f9a2ul, 0xbeb0f9fful, 0x0f37e8b0ul, 0x06ebd26ful, 0xe3b243d2ul, 0x522fb150ul}},
+    {"MuSig/nonce", 11, {0x07101b64ul, 0x18003414ul, 0x0391bc43ul, 0x0e6258eeul, 0x29d26b72ul, 0x8343937eul, 0xb7a0a4fbul, 0xff568a30ul}},
+    {"MuSig/noncecoef", 15, {0x2c7d5a45ul, 0x06bf7e53ul, 0x89be68a6ul, 0x971254c0ul, 0x60ac12d2ul, 0x72846dcdul, 0x6c81212ful, 0xde7a2500ul}},
+    {"MuSig/partial_sign_batch", 24, {0x7eeacc43ul, 0x6fdca179ul, 0x155d3126ul, 0x8a351323ul, 0xdf9dba18ul, 0x2649ff91ul, 0x63dbb286ul, 0x36ba378dul}},
+    {"ECDSAadaptor/non", 16, {0x791dae43ul, 0xe52d3b44ul, 0x37f9edeaul, 0x9bfd2ab1ul, 0xcfb0f44dul, 0xccf1d880ul, 0xd18f2c13ul, 0xa37b9024ul}},
+    {"ECDSAadaptor/aux", 16, {0xd14c7bd9ul, 0x095d35e6ul, 0xb8490a88ul, 0xfb00ef74ul, 0x0baa488ful, 0x69366693ul, 0x1c81c5baul, 0xc33b296aul}},
+    {"ECDSAadaptor/batch", 18, {0xeb4acfc6ul, 0x5217c5deul, 0x6054fc61ul, 0xb041a20bul, 0xb0fca5e0ul, 0xbe5207e8ul, 0xf8fb9c42ul, 0xda43a475ul}},
+    {"ECDSArecovery/batch", 19, {0x430f37cful, 0x21552db4ul, 0x82969559ul, 0x52561a79ul, 0x9fc950adul, 0xa3bf6a02ul, 0x23822690ul, 0x4b0cc2b9ul}},
+    {"DLEQ", 4, {0x8cc4beacul, 0x2e011f3ful, 0x355c75fbul, 0x3ba6a2c5ul, 0xe96f3aeful, 0x180530fdul, 0x94582499ul, 0x577fd564ul}},
+    {"s2c/ecdsa/data", 14, {0xfeefd675ul, 0x73166c99ul, 0xe2309cb8ul, 0x6d458113ul, 0x01d3a512ul, 0x00e18112ul, 0x37ee0874ul, 0x421fc55ful}},
+    {"s2c/ecdsa/point", 15, {0xa9b21c7bul, 0x358c3e3eul, 0x0b6863d1ul, 0xc62b2035ul, 0xb44b40ceul, 0x254a8912ul, 0x0f85d0d4ul, 0x8a5bf91cul}},
+    {"secp256k1_ellswift_encode", 25, {0xd1a6524bul, 0x028594b3ul, 0x96e42f4eul, 0x1037a177ul, 0x1b8fcb8bul, 0x56023885ul, 0x2560ede1ul, 0xd626b715ul}},
+    {"secp256k1_ellswift_create", 25, {0xd29e1bf5ul, 0xf7025f42ul, 0x9b024773ul, 0x094cb7d5ul, 0xe59ed789ul, 0x03bc9786ul, 0x68335b35ul, 0x4e363b53ul}},
+    {"bip324_ellswift_xonly_ecdh", 26, {0x8c12d730ul, 0x827bd392ul, 0x9e4fb2eeul, 0x207b373eul, 0x2292bd7aul, 0xaa5441bcul, 0x15c3779ful, 0xcfb52549ul}},
+    {"Bulletproofs_pp/v0/commitment", 29, {0x52fc8185ul, 0x0e7debf0ul, 0xb0967270ul, 0x6f5abfe1ul, 0x822bdec0ul, 0x36db8beful, 0x03d9e1f1ul, 0x8a5cef6ful}}
+};
+
+#endif /* SECP256K1_PRECOMPUTED_TAGGED_HASH_H */
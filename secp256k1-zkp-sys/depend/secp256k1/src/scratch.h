@@ -7,6 +7,16 @@
 #ifndef SECP256K1_SCRATCH_H
 #define SECP256K1_SCRATCH_H
 
+/* A block of memory of a growable scratch space. The header is stored at the
+ * start of the block and followed by `size` bytes of data. */
+typedef struct rustsecp256k1zkp_v0_8_1_scratch_chunk_struct {
+    struct rustsecp256k1zkp_v0_8_1_scratch_chunk_struct *prev;
+    struct rustsecp256k1zkp_v0_8_1_scratch_chunk_struct *next;
+    size_t size;
+    /** the value of alloc_size at which this chunk was last taken into use */
+    size_t base;
+} rustsecp256k1zkp_v0_8_1_scratch_chunk;
+
 /* The typedef is used internally; the struct name is used in the public API
  * (where it is exposed as a different typedef) */
 typedef struct rustsecp256k1zkp_v0_8_1_scratch_space_struct {
@@ -19,12 +29,38 @@ typedef struct rustsecp256k1zkp_v0_8_1_scratch_space_struct {
     size_t alloc_size;
     /** maximum size available to allocate */
     size_t max_size;
+    /** For a growable scratch space, the chunk that data points into, or NULL
+     *  if data is a single block of max_size bytes. Allocations are made from
+     *  the current chunk and move on to the next one when it is full, and
+     *  alloc_size counts the bytes allocated from all of them. The chunks
+     *  after the current one are kept for reuse after a checkpoint has been
+     *  applied. */
+    rustsecp256k1zkp_v0_8_1_scratch_chunk *chunk;
+    /** Provides a new chunk of at least *size bytes, or returns NULL. */
+    void *(*grow)(size_t *size, void *data);
+    void *grow_data;
+    /** Runs the parts of a large multi-exponentiation, possibly in parallel,
+     *  or NULL to compute everything in the calling thread. */
+    void (*run)(void (*task)(size_t index, void *task_data), void *task_data, size_t n_tasks, void *run_data);
+    void *run_data;
+    /** the largest number of parts passed to run */
+    size_t n_workers;
 } rustsecp256k1zkp_v0_8_1_scratch;
 
 static rustsecp256k1zkp_v0_8_1_scratch* rustsecp256k1zkp_v0_8_1_scratch_create(const rustsecp256k1zkp_v0_8_1_callback* error_callback, size_t max_size);
 
 static void rustsecp256k1zkp_v0_8_1_scratch_destroy(const rustsecp256k1zkp_v0_8_1_callback* error_callback, rustsecp256k1zkp_v0_8_1_scratch* scratch);
 
+/** Returns the number of bytes needed by rustsecp256k1zkp_v0_8_1_scratch_init for a scratch
+ *  space whose first chunk holds size bytes. */
+static size_t rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(size_t size);
+
+/** Creates a scratch space in prealloc, whose first chunk holds size bytes.
+ *  If grow is not NULL, it is called for more chunks until max_size bytes are
+ *  allocated. Otherwise max_size is ignored and the scratch space has a fixed
+ *  size. */
+static rustsecp256k1zkp_v0_8_1_scratch* rustsecp256k1zkp_v0_8_1_scratch_init(void *prealloc, size_t size, size_t max_size, void *(*grow)(size_t *size, void *data), void *grow_data);
+
 /** Returns an opaque object used to "checkpoint" a scratch space. Used
  *  with `rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint` to undo allocations. */
 static size_t rustsecp256k1zkp_v0_8_1_scratch_checkpoint(const rustsecp256k1zkp_v0_8_1_callback* error_callback, const rustsecp256k1zkp_v0_8_1_scratch* scratch);
@@ -10,6 +10,61 @@
 #include "util.h"
 #include "scratch.h"
 
+/* The data of a chunk starts after its header, at the same alignment. */
+#define SCRATCH_CHUNK_HEADER_SIZE ROUND_TO_ALIGN(sizeof(rustsecp256k1zkp_v0_8_1_scratch_chunk))
+
+static size_t rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(size_t size) {
+    return ROUND_TO_ALIGN(sizeof(rustsecp256k1zkp_v0_8_1_scratch)) + SCRATCH_CHUNK_HEADER_SIZE + size;
+}
+
+static rustsecp256k1zkp_v0_8_1_scratch* rustsecp256k1zkp_v0_8_1_scratch_init(void *prealloc, size_t size, size_t max_size, void *(*grow)(size_t *size, void *data), void *grow_data) {
+    rustsecp256k1zkp_v0_8_1_scratch* ret = (rustsecp256k1zkp_v0_8_1_scratch *)prealloc;
+    rustsecp256k1zkp_v0_8_1_scratch_chunk *chunk = (rustsecp256k1zkp_v0_8_1_scratch_chunk *)(void *)((char *)prealloc + ROUND_TO_ALIGN(sizeof(rustsecp256k1zkp_v0_8_1_scratch)));
+
+    memset(ret, 0, sizeof(*ret));
+    memcpy(ret->magic, "scratch", 8);
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->base = 0;
+    ret->chunk = chunk;
+    ret->data = (void *) ((char *) chunk + SCRATCH_CHUNK_HEADER_SIZE);
+    ret->max_size = grow != NULL && max_size > size ? max_size : size;
+    ret->grow = grow;
+    ret->grow_data = grow_data;
+    return ret;
+}
+
+/* Returns a chunk to continue with after the current one, which has room for
+ * size bytes, or NULL if there is none and the scratch space cannot grow. */
+static rustsecp256k1zkp_v0_8_1_scratch_chunk* rustsecp256k1zkp_v0_8_1_scratch_next_chunk(rustsecp256k1zkp_v0_8_1_scratch* scratch, size_t size) {
+    rustsecp256k1zkp_v0_8_1_scratch_chunk *cur = scratch->chunk;
+    rustsecp256k1zkp_v0_8_1_scratch_chunk *next = cur->next;
+    size_t chunk_size;
+
+    /* A chunk left over from before a checkpoint was applied is reused. */
+    if (next != NULL && next->size >= size) {
+        return next;
+    }
+    if (scratch->grow == NULL || size > SIZE_MAX - SCRATCH_CHUNK_HEADER_SIZE) {
+        return NULL;
+    }
+    chunk_size = SCRATCH_CHUNK_HEADER_SIZE + size;
+    next = (rustsecp256k1zkp_v0_8_1_scratch_chunk *)scratch->grow(&chunk_size, scratch->grow_data);
+    if (next == NULL || chunk_size < SCRATCH_CHUNK_HEADER_SIZE + size) {
+        return NULL;
+    }
+    /* Insert the new chunk in front of the ones that were too small. */
+    next->prev = cur;
+    next->next = cur->next;
+    next->size = chunk_size - SCRATCH_CHUNK_HEADER_SIZE;
+    if (cur->next != NULL) {
+        cur->next->prev = next;
+    }
+    cur->next = next;
+    return next;
+}
+
 
 static size_t rustsecp256k1zkp_v0_8_1_scratch_checkpoint(const rustsecp256k1zkp_v0_8_1_callback* error_callback, const rustsecp256k1zkp_v0_8_1_scratch* scratch) {
     if (rustsecp256k1zkp_v0_8_1_memcmp_var(scratch->magic, "scratch", 8) != 0) {
@@ -28,6 +83,14 @@ static void rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(const rustsecp256k1
         rustsecp256k1zkp_v0_8_1_callback_call(error_callback, "invalid checkpoint");
         return;
     }
+    if (scratch->chunk != NULL) {
+        /* Go back to the chunk the checkpoint points into. The first chunk
+         * has a base of 0, so this stops there at the latest. */
+        while (scratch->chunk->base > checkpoint) {
+            scratch->chunk = scratch->chunk->prev;
+        }
+        scratch->data = (void *) ((char *) scratch->chunk + SCRATCH_CHUNK_HEADER_SIZE);
+    }
     scratch->alloc_size = checkpoint;
 }
 
@@ -65,7 +128,21 @@ static void *rustsecp256k1zkp_v0_8_1_scratch_alloc(const rustsecp256k1zkp_v0_8_1
     if (size > scratch->max_size - scratch->alloc_size) {
         return NULL;
     }
-    ret = (void *) ((char *) scratch->data + scratch->alloc_size);
+    if (scratch->chunk != NULL) {
+        rustsecp256k1zkp_v0_8_1_scratch_chunk *chunk = scratch->chunk;
+        if (size > chunk->base + chunk->size - scratch->alloc_size) {
+            chunk = rustsecp256k1zkp_v0_8_1_scratch_next_chunk(scratch, size);
+            if (chunk == NULL) {
+                return NULL;
+            }
+            chunk->base = scratch->alloc_size;
+            scratch->chunk = chunk;
+            scratch->data = (void *) ((char *) chunk + SCRATCH_CHUNK_HEADER_SIZE);
+        }
+        ret = (void *) ((char *) scratch->data + (scratch->alloc_size - chunk->base));
+    } else {
+        ret = (void *) ((char *) scratch->data + scratch->alloc_size);
+    }
     memset(ret, 0, size);
     scratch->alloc_size += size;
 
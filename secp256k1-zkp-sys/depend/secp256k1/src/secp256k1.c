@@ -31,9 +31,11 @@
 #include "ecmult_impl.h"
 #include "ecmult_const_impl.h"
 #include "ecmult_gen_impl.h"
+#include "ecmult_tables.h"
 #include "ecdsa_impl.h"
 #include "eckey_impl.h"
 #include "hash_impl.h"
+#include "tagged_hash_impl.h"
 #include "int128_impl.h"
 #include "scratch_impl.h"
 #include "selftest.h"
@@ -109,6 +111,18 @@ void rustsecp256k1zkp_v0_8_1_selftest(void) {
     }
 }
 
+/* Returns the precision of the table selected by the sign table flags, or 0 if
+ * both are set. */
+static int rustsecp256k1zkp_v0_8_1_context_sign_table_bits(unsigned int flags) {
+    int small = !!(flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_SMALL);
+    int large = !!(flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN_TABLE_LARGE);
+
+    if (small && large) {
+        return 0;
+    }
+    return small ? 2 : large ? 8 : ECMULT_GEN_PREC_BITS;
+}
+
 size_t rustsecp256k1zkp_v0_8_1_context_preallocated_size(unsigned int flags) {
     size_t ret = sizeof(rustsecp256k1zkp_v0_8_1_context);
     /* A return value of 0 is reserved as an indicator for errors when we call this function internally. */
@@ -126,6 +140,18 @@ size_t rustsecp256k1zkp_v0_8_1_context_preallocated_size(unsigned int flags) {
             return 0;
     }
 
+    if (EXPECT(rustsecp256k1zkp_v0_8_1_context_sign_table_bits(flags) == 0, 0)) {
+            rustsecp256k1zkp_v0_8_1_callback_call(&default_illegal_callback,
+                                    "Invalid flags");
+            return 0;
+    }
+
+    if (EXPECT(!rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(rustsecp256k1zkp_v0_8_1_context_sign_table_bits(flags)), 0)) {
+            rustsecp256k1zkp_v0_8_1_callback_call(&default_illegal_callback,
+                                    "Sign table not available in this build");
+            return 0;
+    }
+
     return ret;
 }
 
@@ -135,11 +161,30 @@ size_t rustsecp256k1zkp_v0_8_1_context_preallocated_clone_size(const rustsecp256
     return sizeof(rustsecp256k1zkp_v0_8_1_context);
 }
 
+/* Selects the implementations that depend on the CPU, so that the detection
+ * runs when a context is created rather than in the middle of the first
+ * operation that uses them. Each selection is also made on first use, which
+ * covers rustsecp256k1zkp_v0_8_1_context_static and contexts created by other
+ * libraries. All of them go through rustsecp256k1zkp_v0_8_1_once_int, so threads that
+ * make the first use at the same time are safe without calling this. */
+static void rustsecp256k1zkp_v0_8_1_select_backends(void) {
+#ifdef SECP256K1_SHA256_HW
+    rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_hw_enabled, rustsecp256k1zkp_v0_8_1_sha256_hw_detect);
+#endif
+#ifdef SECP256K1_SHA256_LANES
+    rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_lanes_impl, rustsecp256k1zkp_v0_8_1_sha256_lanes_select);
+#endif
+#ifdef SECP256K1_FE_X8
+    rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_fe_x8_enabled, rustsecp256k1zkp_v0_8_1_fe_x8_detect);
+#endif
+}
+
 rustsecp256k1zkp_v0_8_1_context* rustsecp256k1zkp_v0_8_1_context_preallocated_create(void* prealloc, unsigned int flags) {
     size_t prealloc_size;
     rustsecp256k1zkp_v0_8_1_context* ret;
 
     rustsecp256k1zkp_v0_8_1_selftest();
+    rustsecp256k1zkp_v0_8_1_select_backends();
 
     prealloc_size = rustsecp256k1zkp_v0_8_1_context_preallocated_size(flags);
     if (prealloc_size == 0) {
@@ -153,6 +198,8 @@ rustsecp256k1zkp_v0_8_1_context* rustsecp256k1zkp_v0_8_1_context_preallocated_cr
     /* Flags have been checked by rustsecp256k1zkp_v0_8_1_context_preallocated_size. */
     VERIFY_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_CONTEXT);
     rustsecp256k1zkp_v0_8_1_ecmult_gen_context_build(&ret->ecmult_gen_ctx);
+    /* The table has been checked to be available by rustsecp256k1zkp_v0_8_1_context_preallocated_size. */
+    rustsecp256k1zkp_v0_8_1_ecmult_gen_context_set_table(&ret->ecmult_gen_ctx, rustsecp256k1zkp_v0_8_1_context_sign_table_bits(flags));
     ret->declassify = !!(flags & SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY);
 
     return ret;
@@ -180,6 +227,50 @@ void rustsecp256k1zkp_v0_8_1_context_preallocated_destroy(rustsecp256k1zkp_v0_8_
     rustsecp256k1zkp_v0_8_1_ecmult_gen_context_clear(&ctx->ecmult_gen_ctx);
 }
 
+size_t rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(size_t size) {
+    if (size > SIZE_MAX - rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(0)) {
+        return 0;
+    }
+    return rustsecp256k1zkp_v0_8_1_scratch_preallocated_size(size);
+}
+
+rustsecp256k1zkp_v0_8_1_scratch_space* rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(const rustsecp256k1zkp_v0_8_1_context* ctx, void *prealloc, size_t size, size_t max_size, rustsecp256k1zkp_v0_8_1_scratch_grow_function grow, void *grow_data) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(prealloc != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(size) != 0);
+
+    return rustsecp256k1zkp_v0_8_1_scratch_init(prealloc, size, max_size, grow, grow_data);
+}
+
+size_t rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(size_t n_points) {
+    return rustsecp256k1zkp_v0_8_1_ecmult_multi_scratch_size(n_points);
+}
+
+int rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space* scratch, rustsecp256k1zkp_v0_8_1_scratch_run_function run, void *data, size_t n_workers) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(scratch->magic, "scratch", 8) == 0);
+    ARG_CHECK(run == NULL || n_workers > 0);
+
+    scratch->run = run;
+    scratch->run_data = data;
+    scratch->n_workers = run != NULL ? n_workers : 0;
+    return 1;
+}
+
+void rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_scratch_space* scratch) {
+    VERIFY_CHECK(ctx != NULL);
+    if (scratch == NULL) {
+        return;
+    }
+    if (rustsecp256k1zkp_v0_8_1_memcmp_var(scratch->magic, "scratch", 8) != 0) {
+        rustsecp256k1zkp_v0_8_1_callback_call(&ctx->error_callback, "invalid scratch space");
+        return;
+    }
+    VERIFY_CHECK(scratch->alloc_size == 0);
+    memset(scratch->magic, 0, sizeof(scratch->magic));
+}
+
 void rustsecp256k1zkp_v0_8_1_context_set_illegal_callback(rustsecp256k1zkp_v0_8_1_context* ctx, void (*fun)(const char* message, void* data), const void* data) {
     /* We compare pointers instead of checking rustsecp256k1zkp_v0_8_1_context_is_proper() here
        because setting callbacks is allowed on *copies* of the static context:
@@ -761,6 +852,147 @@ int rustsecp256k1zkp_v0_8_1_context_randomize(rustsecp256k1zkp_v0_8_1_context* c
     return 1;
 }
 
+int rustsecp256k1zkp_v0_8_1_context_set_sign_table(rustsecp256k1zkp_v0_8_1_context* ctx, unsigned int flags) {
+    int bits;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(rustsecp256k1zkp_v0_8_1_context_is_proper(ctx));
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_CONTEXT);
+    bits = rustsecp256k1zkp_v0_8_1_context_sign_table_bits(flags);
+    ARG_CHECK(bits != 0);
+
+    return rustsecp256k1zkp_v0_8_1_ecmult_gen_context_set_table(&ctx->ecmult_gen_ctx, bits);
+}
+
+/* The loaded set of tables, which is filled in once before it is published. */
+static rustsecp256k1zkp_v0_8_1_ecmult_tables rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded;
+/* Whether a call to rustsecp256k1zkp_v0_8_1_ecmult_tables_load has claimed
+ * rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded. */
+static int rustsecp256k1zkp_v0_8_1_ecmult_tables_claimed = 0;
+
+static uint32_t rustsecp256k1zkp_v0_8_1_ecmult_tables_header_get(const unsigned char *data, size_t pos) {
+    uint32_t ret;
+    memcpy(&ret, &data[pos], sizeof(ret));
+    return ret;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecmult_tables_load(const rustsecp256k1zkp_v0_8_1_context* ctx, const unsigned char *data, size_t datalen) {
+    const rustsecp256k1zkp_v0_8_1_ge_storage *tables;
+    rustsecp256k1zkp_v0_8_1_ge_storage g;
+    rustsecp256k1zkp_v0_8_1_sha256 hash;
+    unsigned char checksum[32];
+    uint32_t window_g;
+    size_t size;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(data != NULL);
+
+    if (datalen < ECMULT_TABLES_HEADER_SIZE
+        || rustsecp256k1zkp_v0_8_1_memcmp_var(data, rustsecp256k1zkp_v0_8_1_ecmult_tables_magic, sizeof(rustsecp256k1zkp_v0_8_1_ecmult_tables_magic)) != 0
+        || rustsecp256k1zkp_v0_8_1_ecmult_tables_header_get(data, 8) != ECMULT_TABLES_VERSION
+        || rustsecp256k1zkp_v0_8_1_ecmult_tables_header_get(data, 16) != ECMULT_GEN_PREC_BITS) {
+        return 0;
+    }
+    window_g = rustsecp256k1zkp_v0_8_1_ecmult_tables_header_get(data, 12);
+    if (window_g < 2 || window_g > 24) {
+        return 0;
+    }
+    size = ECMULT_TABLES_SIZE(window_g, ECMULT_GEN_PREC_BITS);
+    if (datalen != ECMULT_TABLES_HEADER_SIZE + size) {
+        return 0;
+    }
+
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&hash);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, &data[ECMULT_TABLES_HEADER_SIZE], size);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&hash, checksum);
+    if (rustsecp256k1zkp_v0_8_1_memcmp_var(checksum, &data[32], sizeof(checksum)) != 0) {
+        return 0;
+    }
+
+    /* A file written on a machine with a different memory layout of the
+     * tables has a valid checksum but does not start with G. */
+    tables = (const rustsecp256k1zkp_v0_8_1_ge_storage *)(const void *)&data[ECMULT_TABLES_HEADER_SIZE];
+    rustsecp256k1zkp_v0_8_1_ge_to_storage(&g, &rustsecp256k1zkp_v0_8_1_ge_const_g);
+    if (rustsecp256k1zkp_v0_8_1_memcmp_var(&g, &tables[0], sizeof(g)) != 0) {
+        return 0;
+    }
+
+    /* Tables can be loaded once, so that the published set is never written
+     * to again while other threads may use it. */
+#ifdef __GNUC__
+    if (__atomic_exchange_n(&rustsecp256k1zkp_v0_8_1_ecmult_tables_claimed, 1, __ATOMIC_ACQ_REL)) {
+        return 0;
+    }
+#else
+    if (rustsecp256k1zkp_v0_8_1_ecmult_tables_claimed) {
+        return 0;
+    }
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_claimed = 1;
+#endif
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded.pre_g = tables;
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded.pre_g_128 = &tables[ECMULT_TABLE_SIZE(window_g)];
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded.window_g = (int)window_g;
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded.gen = &tables[2 * ECMULT_TABLE_SIZE(window_g)];
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded.checksum = &data[32];
+#ifdef __GNUC__
+    __atomic_store_n(&rustsecp256k1zkp_v0_8_1_ecmult_tables_current, &rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded, __ATOMIC_RELEASE);
+#else
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_current = &rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded;
+#endif
+    return 1;
+}
+
+int rustsecp256k1zkp_v0_8_1_ecmult_tables_info(const rustsecp256k1zkp_v0_8_1_context* ctx, size_t *size, unsigned char *checksum32, unsigned int *window) {
+    const rustsecp256k1zkp_v0_8_1_ecmult_tables *tables = rustsecp256k1zkp_v0_8_1_ecmult_tables_get();
+    const size_t table_size = ECMULT_TABLE_SIZE(tables->window_g) * sizeof(rustsecp256k1zkp_v0_8_1_ge_storage);
+    rustsecp256k1zkp_v0_8_1_sha256 hash;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(size != NULL);
+    ARG_CHECK(checksum32 != NULL);
+    ARG_CHECK(window != NULL);
+
+    *size = ECMULT_TABLES_SIZE(tables->window_g, ECMULT_GEN_PREC_BITS);
+    *window = tables->window_g;
+    if (tables->checksum != NULL) {
+        memcpy(checksum32, tables->checksum, 32);
+        return 1;
+    }
+    /* The compiled-in tables are hashed as if they were written to a file. */
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&hash);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, (const unsigned char *)tables->pre_g, table_size);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, (const unsigned char *)tables->pre_g_128, table_size);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, (const unsigned char *)&rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[0][0], *size - 2 * table_size);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&hash, checksum32);
+    return 1;
+}
+
+unsigned int rustsecp256k1zkp_v0_8_1_context_backends(const rustsecp256k1zkp_v0_8_1_context* ctx) {
+    unsigned int ret = 0;
+
+    VERIFY_CHECK(ctx != NULL);
+    (void)ctx;
+
+#ifdef USE_ASM_X86_64
+    ret |= SECP256K1_BACKEND_ASM_X86_64;
+#endif
+#ifdef SECP256K1_SHA256_HW
+    if (rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_hw_enabled, rustsecp256k1zkp_v0_8_1_sha256_hw_detect)) {
+        ret |= SECP256K1_BACKEND_SHA256_HW;
+    }
+#endif
+#if defined(SECP256K1_SHA256_LANES) && defined(SECP256K1_SHA256_LANES_AVX2)
+    if (rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_sha256_lanes_impl, rustsecp256k1zkp_v0_8_1_sha256_lanes_select) == 2) {
+        ret |= SECP256K1_BACKEND_SHA256_LANES_AVX2;
+    }
+#endif
+#ifdef SECP256K1_FE_X8
+    if (rustsecp256k1zkp_v0_8_1_once_int(&rustsecp256k1zkp_v0_8_1_fe_x8_enabled, rustsecp256k1zkp_v0_8_1_fe_x8_detect)) {
+        ret |= SECP256K1_BACKEND_FIELD_IFMA;
+    }
+#endif
+    return ret;
+}
+
 int rustsecp256k1zkp_v0_8_1_ec_pubkey_combine(const rustsecp256k1zkp_v0_8_1_context* ctx, rustsecp256k1zkp_v0_8_1_pubkey *pubnonce, const rustsecp256k1zkp_v0_8_1_pubkey * const *pubnonces, size_t n) {
     size_t i;
     rustsecp256k1zkp_v0_8_1_gej Qj;
@@ -794,7 +1026,7 @@ int rustsecp256k1zkp_v0_8_1_tagged_sha256(const rustsecp256k1zkp_v0_8_1_context*
     ARG_CHECK(tag != NULL);
     ARG_CHECK(msg != NULL);
 
-    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, tag, taglen);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha, tag, taglen);
     rustsecp256k1zkp_v0_8_1_sha256_write(&sha, msg, msglen);
     rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, hash32);
     return 1;
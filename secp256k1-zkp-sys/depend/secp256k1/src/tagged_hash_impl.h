@@ -0,0 +1,41 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_TAGGED_HASH_IMPL_H
+#define SECP256K1_TAGGED_HASH_IMPL_H
+
+#include "hash.h"
+#include "util.h"
+#include "precomputed_tagged_hash.h"
+
+/* precomputed_tagged_hash.h is generated by precompute_tagged_hash and holds,
+ * for every tag the library uses, the SHA256 midstate after hashing
+ * SHA256(tag)||SHA256(tag). Starting a tagged hash from it saves the two
+ * compressions sha256_initialize_tagged spends on the prefix. */
+
+static void rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(rustsecp256k1zkp_v0_8_1_sha256 *hash, size_t tag) {
+    int i;
+
+    VERIFY_CHECK(tag < SECP256K1_TAG_COUNT);
+    for (i = 0; i < 8; i++) {
+        hash->s[i] = rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[tag].s[i];
+    }
+    hash->bytes = 64;
+}
+
+static void rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(rustsecp256k1zkp_v0_8_1_sha256 *hash, const unsigned char *tag, size_t taglen) {
+    size_t i;
+
+    for (i = 0; i < SECP256K1_TAG_COUNT; i++) {
+        if (rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[i].taglen == taglen
+                && rustsecp256k1zkp_v0_8_1_memcmp_var(rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[i].tag, tag, taglen) == 0) {
+            rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(hash, i);
+            return;
+        }
+    }
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(hash, tag, taglen);
+}
+
+#endif /* SECP256K1_TAGGED_HASH_IMPL_H */
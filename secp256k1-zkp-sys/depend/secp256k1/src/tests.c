@@ -33,6 +33,7 @@
 #include "modinv64_impl.h"
 #include "int128_impl.h"
 #endif
+#include "ecmult_compute_table_impl.h"
 
 #define CONDITIONAL_TEST(cnt, nam) if (COUNT < (cnt)) { printf("Skipping %s (iteration count too low)\n", nam); } else
 
@@ -294,6 +295,100 @@ static void run_deprecated_context_flags_test(void) {
     rustsecp256k1zkp_v0_8_1_context_destroy(none_ctx);
 }
 
+static void run_sign_table_context_tests(void) {
+    unsigned int flags[] = { SECP256K1_CONTEXT_NONE,
+                             SECP256K1_CONTEXT_SIGN_TABLE_SMALL,
+                             SECP256K1_CONTEXT_SIGN_TABLE_LARGE };
+    int bits[] = { ECMULT_GEN_PREC_BITS, 2, 8 };
+    unsigned char seckey[32];
+    unsigned char seed[32];
+    rustsecp256k1zkp_v0_8_1_pubkey pubkey, pubkey_expected;
+    rustsecp256k1zkp_v0_8_1_context *my_ctx;
+    int i, j;
+
+    /* All tables give the same results, with and without randomization. */
+    random_scalar_order_b32(seckey);
+    rustsecp256k1zkp_v0_8_1_testrand256(seed);
+    CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(CTX, &pubkey_expected, seckey) == 1);
+    for (i = 0; i < (int)(sizeof(flags)/sizeof(flags[0])); i++) {
+        if (!rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(bits[i])) {
+            continue;
+        }
+        my_ctx = rustsecp256k1zkp_v0_8_1_context_create(flags[i]);
+        CHECK(my_ctx->ecmult_gen_ctx.built == (bits[i] == ECMULT_GEN_PREC_BITS ? 1 : bits[i]));
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(my_ctx, &pubkey, seckey) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&pubkey, &pubkey_expected, sizeof(pubkey)) == 0);
+        CHECK(rustsecp256k1zkp_v0_8_1_context_randomize(my_ctx, seed) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(my_ctx, &pubkey, seckey) == 1);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&pubkey, &pubkey_expected, sizeof(pubkey)) == 0);
+
+        /* Switching the table keeps the randomization. */
+        for (j = 0; j < (int)(sizeof(flags)/sizeof(flags[0])); j++) {
+            rustsecp256k1zkp_v0_8_1_scalar blind = my_ctx->ecmult_gen_ctx.blind;
+            CHECK(rustsecp256k1zkp_v0_8_1_context_set_sign_table(my_ctx, flags[j]) == rustsecp256k1zkp_v0_8_1_ecmult_gen_has_table(bits[j]));
+            CHECK(rustsecp256k1zkp_v0_8_1_scalar_eq(&blind, &my_ctx->ecmult_gen_ctx.blind));
+            CHECK(rustsecp256k1zkp_v0_8_1_ec_pubkey_create(my_ctx, &pubkey, seckey) == 1);
+            CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&pubkey, &pubkey_expected, sizeof(pubkey)) == 0);
+        }
+        rustsecp256k1zkp_v0_8_1_context_destroy(my_ctx);
+    }
+
+    /* Illegal arguments */
+    CHECK_ILLEGAL(STATIC_CTX, rustsecp256k1zkp_v0_8_1_context_set_sign_table(STATIC_CTX, SECP256K1_CONTEXT_NONE));
+    CHECK_ILLEGAL(CTX, rustsecp256k1zkp_v0_8_1_context_set_sign_table(CTX, SECP256K1_EC_COMPRESSED));
+    CHECK_ILLEGAL(CTX, rustsecp256k1zkp_v0_8_1_context_set_sign_table(CTX, SECP256K1_CONTEXT_SIGN_TABLE_SMALL | SECP256K1_CONTEXT_SIGN_TABLE_LARGE));
+    CHECK(CTX->ecmult_gen_ctx.built == 1);
+}
+
+static void run_context_backends_tests(void) {
+    unsigned int backends = rustsecp256k1zkp_v0_8_1_context_backends(CTX);
+    unsigned int expected = 0;
+
+    CHECK(rustsecp256k1zkp_v0_8_1_context_backends(STATIC_CTX) == backends);
+#ifdef USE_ASM_X86_64
+    expected |= SECP256K1_BACKEND_ASM_X86_64;
+#endif
+#ifdef SECP256K1_SHA256_HW
+    if (rustsecp256k1zkp_v0_8_1_sha256_hw_detect()) {
+        int enabled = rustsecp256k1zkp_v0_8_1_sha256_hw_enabled;
+        expected |= SECP256K1_BACKEND_SHA256_HW;
+        /* Forcing the portable code is reported. */
+        rustsecp256k1zkp_v0_8_1_sha256_hw_enabled = 0;
+        CHECK(rustsecp256k1zkp_v0_8_1_context_backends(CTX) == (backends & ~SECP256K1_BACKEND_SHA256_HW));
+        rustsecp256k1zkp_v0_8_1_sha256_hw_enabled = enabled;
+    }
+#endif
+#if defined(SECP256K1_SHA256_LANES) && defined(SECP256K1_SHA256_LANES_AVX2)
+    if (rustsecp256k1zkp_v0_8_1_sha256_lanes_select() == 2) {
+        expected |= SECP256K1_BACKEND_SHA256_LANES_AVX2;
+    }
+#endif
+#ifdef SECP256K1_FE_X8
+    if (rustsecp256k1zkp_v0_8_1_fe_x8_detect()) {
+        expected |= SECP256K1_BACKEND_FIELD_IFMA;
+    }
+#endif
+    CHECK(backends == expected);
+}
+
+#ifdef __GNUC__
+static int once_int_calls = 0;
+
+static int once_int_detect(void) {
+    once_int_calls++;
+    return 3;
+}
+
+static void run_once_int_tests(void) {
+    int value = -1;
+
+    CHECK(rustsecp256k1zkp_v0_8_1_once_int(&value, once_int_detect) == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_once_int(&value, once_int_detect) == 3);
+    CHECK(value == 3);
+    CHECK(once_int_calls == 1);
+}
+#endif
+
 static void run_ec_illegal_argument_tests(void) {
     int ecount = 0;
     int ecount2 = 10;
@@ -593,6 +688,114 @@ static void run_scratch_tests(void) {
     rustsecp256k1zkp_v0_8_1_context_set_error_callback(CTX, NULL, NULL);
 }
 
+typedef struct {
+    void *blocks[8];
+    size_t n;
+    size_t min_size;
+} scratch_grow_data;
+
+static void *scratch_grow_fn(size_t *size, void *data) {
+    scratch_grow_data *grow = (scratch_grow_data *)data;
+    if (grow->n == sizeof(grow->blocks) / sizeof(grow->blocks[0])) {
+        return NULL;
+    }
+    /* Provide a little more than needed, like an allocator rounding up. */
+    *size += 8;
+    if (*size < grow->min_size) {
+        *size = grow->min_size;
+    }
+    grow->blocks[grow->n] = checked_malloc(&CTX->error_callback, *size);
+    return grow->blocks[grow->n++];
+}
+
+static void scratch_grow_free(scratch_grow_data *grow) {
+    while (grow->n > 0) {
+        free(grow->blocks[--grow->n]);
+    }
+}
+
+static void run_scratch_growable_tests(void) {
+    const size_t adj_alloc = ((500 + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+    const size_t adj_alloc_64 = ((64 + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+    scratch_grow_data grow;
+    rustsecp256k1zkp_v0_8_1_scratch_space *scratch;
+    void *prealloc;
+    unsigned char *p1, *p2, *p3;
+    size_t checkpoint;
+    size_t i;
+
+    grow.n = 0;
+    grow.min_size = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(SIZE_MAX) == 0);
+    prealloc = checked_malloc(&CTX->error_callback, rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(100));
+    CHECK_ILLEGAL(CTX, rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(CTX, prealloc, SIZE_MAX, 2000, scratch_grow_fn, &grow));
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(CTX, prealloc, 100, 2000, scratch_grow_fn, &grow);
+    CHECK(scratch != NULL);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_max_allocation(&CTX->error_callback, scratch, 0) == 2000);
+
+    /* The first allocation fits into the preallocated memory. */
+    p1 = (unsigned char *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 64);
+    CHECK(p1 != NULL);
+    CHECK(grow.n == 0);
+    memset(p1, 1, 64);
+
+    /* The next one needs more memory. */
+    checkpoint = rustsecp256k1zkp_v0_8_1_scratch_checkpoint(&CTX->error_callback, scratch);
+    p2 = (unsigned char *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 500);
+    CHECK(p2 != NULL);
+    CHECK(grow.n == 1);
+    memset(p2, 2, 500);
+    CHECK(scratch->alloc_size == adj_alloc_64 + adj_alloc);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_max_allocation(&CTX->error_callback, scratch, 0) == 2000 - adj_alloc_64 - adj_alloc);
+
+    /* Memory is reused after applying a checkpoint. */
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, checkpoint);
+    CHECK(scratch->alloc_size == adj_alloc_64);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 500) == p2);
+    CHECK(grow.n == 1);
+
+    /* A block that is too small is skipped and kept. */
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 64) == p1);
+    memset(p1, 1, 64);
+    p3 = (unsigned char *)rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 1000);
+    CHECK(p3 != NULL);
+    CHECK(grow.n == 2);
+    memset(p3, 3, 1000);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 500) == p2);
+    CHECK(grow.n == 2);
+    memset(p2, 2, 500);
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, checkpoint);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 500) == p3);
+    /* The allocations do not overlap. */
+    for (i = 0; i < 64; i++) {
+        CHECK(p1[i] == 1);
+    }
+    for (i = 0; i < 500; i++) {
+        CHECK(p2[i] == 2);
+    }
+
+    /* Allocations beyond max_size fail without asking for memory. */
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 2000) == NULL);
+    CHECK(grow.n == 2);
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, 0);
+    CHECK(scratch->alloc_size == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 64) == p1);
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, 0);
+    rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(CTX, scratch);
+    scratch_grow_free(&grow);
+
+    /* Without a grow function the size is fixed. */
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(CTX, prealloc, 100, 2000, NULL, NULL);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_max_allocation(&CTX->error_callback, scratch, 0) == 100);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 200) == NULL);
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_alloc(&CTX->error_callback, scratch, 64) != NULL);
+    rustsecp256k1zkp_v0_8_1_scratch_apply_checkpoint(&CTX->error_callback, scratch, 0);
+    rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(CTX, scratch);
+    rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(CTX, NULL); /* no-op */
+    free(prealloc);
+}
+
 static void run_ctz_tests(void) {
     static const uint32_t b32[] = {1, 0xffffffff, 0x5e56968f, 0xe0d63129};
     static const uint64_t b64[] = {1, 0xffffffffffffffff, 0xbcd02462139b3fc3, 0x98b5f80c769693ef};
@@ -773,6 +976,83 @@ static void run_sha256_counter_tests(void) {
     }
 }
 
+static void run_sha256_hw_tests(void) {
+#ifdef SECP256K1_SHA256_HW
+    int enabled = rustsecp256k1zkp_v0_8_1_sha256_hw_enabled;
+    int i;
+
+    if (!rustsecp256k1zkp_v0_8_1_sha256_hw_detect()) {
+        return;
+    }
+    for (i = 0; i < 100 * COUNT; i++) {
+        uint32_t s1[8], s2[8];
+        unsigned char buf[64];
+        rustsecp256k1zkp_v0_8_1_testrand_bytes_test((unsigned char *)s1, sizeof(s1));
+        rustsecp256k1zkp_v0_8_1_testrand_bytes_test(buf, sizeof(buf));
+        memcpy(s2, s1, sizeof(s1));
+        rustsecp256k1zkp_v0_8_1_sha256_transform_hw(s1, buf);
+        rustsecp256k1zkp_v0_8_1_sha256_transform_portable(s2, buf);
+        CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(s1, s2, sizeof(s1)) == 0);
+    }
+
+    /* Repeat the known answer tests with the portable transform. */
+    rustsecp256k1zkp_v0_8_1_sha256_hw_enabled = 0;
+    run_sha256_known_output_tests();
+    run_sha256_counter_tests();
+    rustsecp256k1zkp_v0_8_1_sha256_hw_enabled = enabled;
+#endif
+}
+
+static void run_sha256_multi_tests(void) {
+    rustsecp256k1zkp_v0_8_1_sha256 hashes[17];
+    rustsecp256k1zkp_v0_8_1_sha256 sha;
+    unsigned char data[17 * 150];
+    unsigned char out[17 * 32];
+    unsigned char out1[32];
+    size_t n, len, i;
+#ifdef SECP256K1_SHA256_LANES
+    int impl = rustsecp256k1zkp_v0_8_1_sha256_lanes_impl;
+    int impls[3] = {0, 1, 2};
+    int k, nimpls = 2;
+#ifdef SECP256K1_SHA256_LANES_AVX2
+    nimpls += rustsecp256k1zkp_v0_8_1_sha256_lanes_avx2_detect();
+#endif
+#else
+    int k, nimpls = 1;
+    int impls[1] = {0};
+#endif
+
+    rustsecp256k1zkp_v0_8_1_testrand_bytes_test(data, sizeof(data));
+    for (k = 0; k < nimpls; k++) {
+#ifdef SECP256K1_SHA256_LANES
+        rustsecp256k1zkp_v0_8_1_sha256_lanes_impl = impls[k];
+#else
+        (void)impls;
+#endif
+        for (n = 0; n <= 17; n++) {
+            len = rustsecp256k1zkp_v0_8_1_testrand_int(144);
+            for (i = 0; i < n; i++) {
+                rustsecp256k1zkp_v0_8_1_sha256_initialize(&hashes[i]);
+            }
+            /* Write a shared prefix, then per hash data in two parts. */
+            rustsecp256k1zkp_v0_8_1_sha256_write_multi(hashes, n, data, 0, 7);
+            rustsecp256k1zkp_v0_8_1_sha256_write_multi(hashes, n, data + 7, 150, len / 2);
+            rustsecp256k1zkp_v0_8_1_sha256_write_multi(hashes, n, data + 7 + len / 2, 150, len - len / 2);
+            rustsecp256k1zkp_v0_8_1_sha256_finalize_multi(hashes, n, out);
+            for (i = 0; i < n; i++) {
+                rustsecp256k1zkp_v0_8_1_sha256_initialize(&sha);
+                rustsecp256k1zkp_v0_8_1_sha256_write(&sha, data, 7);
+                rustsecp256k1zkp_v0_8_1_sha256_write(&sha, data + 7 + 150 * i, len);
+                rustsecp256k1zkp_v0_8_1_sha256_finalize(&sha, out1);
+                CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(out1, &out[32 * i], 32) == 0);
+            }
+        }
+    }
+#ifdef SECP256K1_SHA256_LANES
+    rustsecp256k1zkp_v0_8_1_sha256_lanes_impl = impl;
+#endif
+}
+
 /* Tests for the equality of two sha256 structs. This function only produces a
  * correct result if an integer multiple of 64 many bytes have been written
  * into the hash functions. This function is used by some module tests. */
@@ -899,6 +1179,34 @@ static void run_tagged_sha256_tests(void) {
     CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(hash32, hash_expected, sizeof(hash32)) == 0);
 }
 
+static void run_sha256_tag_midstate_tests(void) {
+    rustsecp256k1zkp_v0_8_1_sha256 sha, sha_precomputed;
+    unsigned char tag[32];
+    size_t i;
+
+    /* Check every entry of the precomputed table against the tagged hash
+     * computed from scratch, both by index and by looking up the tag. */
+    for (i = 0; i < SECP256K1_TAG_COUNT; i++) {
+        const rustsecp256k1zkp_v0_8_1_sha256_tag_midstate *m = &rustsecp256k1zkp_v0_8_1_sha256_tag_midstates[i];
+        CHECK(m->taglen == strlen(m->tag));
+        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, (const unsigned char *)m->tag, m->taglen);
+        rustsecp256k1zkp_v0_8_1_sha256_initialize_tag(&sha_precomputed, i);
+        test_sha256_eq(&sha, &sha_precomputed);
+        rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha_precomputed, (const unsigned char *)m->tag, m->taglen);
+        test_sha256_eq(&sha, &sha_precomputed);
+    }
+
+    /* Tags without a table entry, including prefixes of one, are computed. */
+    memcpy(tag, "BIP0340/challenge", 17);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, tag, 16);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha_precomputed, tag, 16);
+    test_sha256_eq(&sha, &sha_precomputed);
+    rustsecp256k1zkp_v0_8_1_testrand256(tag);
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged(&sha, tag, sizeof(tag));
+    rustsecp256k1zkp_v0_8_1_sha256_initialize_tagged_var(&sha_precomputed, tag, sizeof(tag));
+    test_sha256_eq(&sha, &sha_precomputed);
+}
+
 /***** MODINV TESTS *****/
 
 /* Compute the modular inverse of (odd) x mod 2^64. */
@@ -3355,6 +3663,51 @@ static void run_fe_mul(void) {
     }
 }
 
+#ifdef SECP256K1_FE_X8
+static void run_fe_x8_mul(void) {
+    int i, lane;
+    if (!rustsecp256k1zkp_v0_8_1_fe_x8_detect()) {
+        return;
+    }
+    for (i = 0; i < 10 * COUNT; ++i) {
+        rustsecp256k1zkp_v0_8_1_fe a[8], b[8], t, u;
+        rustsecp256k1zkp_v0_8_1_fe_x8 ax, bx, rx;
+        for (lane = 0; lane < 8; lane++) {
+            random_fe_test(&a[lane]);
+            random_field_element_magnitude(&a[lane]);
+            random_fe_test(&b[lane]);
+            random_field_element_magnitude(&b[lane]);
+        }
+        /* The largest limbs an input of magnitude 8 may have. */
+        rustsecp256k1zkp_v0_8_1_fe_get_bounds(&a[i % 8], 8);
+        for (lane = 0; lane < 8; lane++) {
+            rustsecp256k1zkp_v0_8_1_fe_x8_set(&ax, lane, &a[lane]);
+            rustsecp256k1zkp_v0_8_1_fe_x8_set(&bx, lane, &b[lane]);
+        }
+
+        rustsecp256k1zkp_v0_8_1_fe_x8_mul(&rx, &ax, &bx);
+        for (lane = 0; lane < 8; lane++) {
+            rustsecp256k1zkp_v0_8_1_fe_x8_get(&t, &rx, lane);
+            rustsecp256k1zkp_v0_8_1_fe_mul(&u, &a[lane], &b[lane]);
+            CHECK(rustsecp256k1zkp_v0_8_1_fe_equal(&t, &u));
+        }
+        rustsecp256k1zkp_v0_8_1_fe_x8_sqr(&rx, &ax);
+        for (lane = 0; lane < 8; lane++) {
+            rustsecp256k1zkp_v0_8_1_fe_x8_get(&t, &rx, lane);
+            rustsecp256k1zkp_v0_8_1_fe_sqr(&u, &a[lane]);
+            CHECK(rustsecp256k1zkp_v0_8_1_fe_equal(&t, &u));
+        }
+        /* Aliasing the output with an input. */
+        rustsecp256k1zkp_v0_8_1_fe_x8_mul(&ax, &ax, &bx);
+        for (lane = 0; lane < 8; lane++) {
+            rustsecp256k1zkp_v0_8_1_fe_x8_get(&t, &ax, lane);
+            rustsecp256k1zkp_v0_8_1_fe_mul(&u, &a[lane], &b[lane]);
+            CHECK(rustsecp256k1zkp_v0_8_1_fe_equal(&t, &u));
+        }
+    }
+}
+#endif
+
 static void run_sqr(void) {
     rustsecp256k1zkp_v0_8_1_fe x, s;
 
@@ -3946,6 +4299,10 @@ static void test_ge(void) {
             rustsecp256k1zkp_v0_8_1_gej_rescale(&gej[i], &s);
             ge_equals_gej(&ge_set_all[i], &gej[i]);
         }
+        rustsecp256k1zkp_v0_8_1_ge_set_all_gej(ge_set_all, gej, 4 * runs + 1);
+        for (i = 0; i < 4 * runs + 1; i++) {
+            ge_equals_gej(&ge_set_all[i], &gej[i]);
+        }
         free(ge_set_all);
     }
 
@@ -3990,6 +4347,11 @@ static void test_ge(void) {
     for (i = 0; i < 4 * runs + 1; i++) {
         ge_equals_gej(&ge[i], &gej[i]);
     }
+    /* constant-time batch convert */
+    rustsecp256k1zkp_v0_8_1_ge_set_all_gej(ge, gej, 4 * runs + 1);
+    for (i = 0; i < 4 * runs + 1; i++) {
+        ge_equals_gej(&ge[i], &gej[i]);
+    }
 
     /* Test batch gej -> ge conversion with all infinities. */
     for (i = 0; i < 4 * runs + 1; i++) {
@@ -4001,6 +4363,10 @@ static void test_ge(void) {
     for (i = 0; i < 4 * runs + 1; i++) {
         CHECK(rustsecp256k1zkp_v0_8_1_ge_is_infinity(&ge[i]));
     }
+    rustsecp256k1zkp_v0_8_1_ge_set_all_gej(ge, gej, 4 * runs + 1);
+    for (i = 0; i < 4 * runs + 1; i++) {
+        CHECK(rustsecp256k1zkp_v0_8_1_ge_is_infinity(&ge[i]));
+    }
 
     free(ge);
     free(gej);
@@ -4409,6 +4775,101 @@ static void run_ecmult_pre_g(void) {
     CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(&gs, &rustsecp256k1zkp_v0_8_1_pre_g_128[0], sizeof(gs)) == 0);
 }
 
+/* Writes a table file with the given window size into a new buffer. */
+static unsigned char *ecmult_tables_file(int window_g, size_t *len) {
+    const size_t n = ECMULT_TABLE_SIZE(window_g);
+    const size_t gen_n = ECMULT_GEN_PREC_N(ECMULT_GEN_PREC_BITS) * ECMULT_GEN_PREC_G(ECMULT_GEN_PREC_BITS);
+    unsigned char *data;
+    rustsecp256k1zkp_v0_8_1_ge_storage *tables;
+    rustsecp256k1zkp_v0_8_1_sha256 hash;
+    uint32_t field;
+
+    *len = ECMULT_TABLES_HEADER_SIZE + ECMULT_TABLES_SIZE(window_g, ECMULT_GEN_PREC_BITS);
+    data = (unsigned char *)calloc(*len, 1);
+    CHECK(data != NULL);
+    tables = (rustsecp256k1zkp_v0_8_1_ge_storage *)(void *)&data[ECMULT_TABLES_HEADER_SIZE];
+    rustsecp256k1zkp_v0_8_1_ecmult_compute_two_tables(tables, &tables[n], window_g, &rustsecp256k1zkp_v0_8_1_ge_const_g);
+    memcpy(&tables[2 * n], &rustsecp256k1zkp_v0_8_1_ecmult_gen_prec_table[0][0], gen_n * sizeof(rustsecp256k1zkp_v0_8_1_ge_storage));
+
+    memcpy(data, rustsecp256k1zkp_v0_8_1_ecmult_tables_magic, sizeof(rustsecp256k1zkp_v0_8_1_ecmult_tables_magic));
+    field = ECMULT_TABLES_VERSION;
+    memcpy(&data[8], &field, sizeof(field));
+    field = window_g;
+    memcpy(&data[12], &field, sizeof(field));
+    field = ECMULT_GEN_PREC_BITS;
+    memcpy(&data[16], &field, sizeof(field));
+    rustsecp256k1zkp_v0_8_1_sha256_initialize(&hash);
+    rustsecp256k1zkp_v0_8_1_sha256_write(&hash, &data[ECMULT_TABLES_HEADER_SIZE], *len - ECMULT_TABLES_HEADER_SIZE);
+    rustsecp256k1zkp_v0_8_1_sha256_finalize(&hash, &data[32]);
+    return data;
+}
+
+static void run_ecmult_tables_load_tests(void) {
+    /* A window larger than the compiled-in one, unless that one is already large. */
+    const int window_g = WINDOW_G < 16 ? 16 : 8;
+    unsigned char checksum[32], builtin_checksum[32];
+    unsigned char *data, *same_window;
+    size_t len, same_len, size;
+    unsigned int window;
+    rustsecp256k1zkp_v0_8_1_scalar na[4], ng[4];
+    rustsecp256k1zkp_v0_8_1_ge p;
+    rustsecp256k1zkp_v0_8_1_gej a, expected[4], expected_gen[4], r;
+    int i;
+
+    /* The compiled-in tables have the checksum of the file with their window. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_info(CTX, &size, builtin_checksum, &window) == 1);
+    CHECK(window == WINDOW_G);
+    CHECK(size == ECMULT_TABLES_SIZE(WINDOW_G, ECMULT_GEN_PREC_BITS));
+    same_window = ecmult_tables_file(WINDOW_G, &same_len);
+    CHECK(same_len == ECMULT_TABLES_HEADER_SIZE + size);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(builtin_checksum, &same_window[32], 32) == 0);
+    free(same_window);
+
+    random_group_element_test(&p);
+    rustsecp256k1zkp_v0_8_1_gej_set_ge(&a, &p);
+    for (i = 0; i < 4; i++) {
+        random_scalar_order_test(&na[i]);
+        random_scalar_order_test(&ng[i]);
+        rustsecp256k1zkp_v0_8_1_ecmult(&expected[i], &a, &na[i], &ng[i]);
+        rustsecp256k1zkp_v0_8_1_ecmult_gen(&CTX->ecmult_gen_ctx, &expected_gen[i], &ng[i]);
+    }
+
+    data = ecmult_tables_file(window_g, &len);
+    /* Invalid files are rejected. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, len - 1) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, ECMULT_TABLES_HEADER_SIZE - 1) == 0);
+    data[8] ^= 2;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, len) == 0);
+    data[8] ^= 2;
+    data[len - 1] ^= 1;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, len) == 0);
+    data[len - 1] ^= 1;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_get() == &rustsecp256k1zkp_v0_8_1_ecmult_tables_builtin);
+    CHECK_ILLEGAL(CTX, rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, NULL, len));
+
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, len) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_info(CTX, &size, checksum, &window) == 1);
+    CHECK(window == (unsigned int)window_g);
+    CHECK(size == len - ECMULT_TABLES_HEADER_SIZE);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(checksum, &data[32], 32) == 0);
+    for (i = 0; i < 4; i++) {
+        rustsecp256k1zkp_v0_8_1_ecmult(&r, &a, &na[i], &ng[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected[i]));
+        rustsecp256k1zkp_v0_8_1_ecmult_gen(&CTX->ecmult_gen_ctx, &r, &ng[i]);
+        CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected_gen[i]));
+    }
+    /* Tables can only be loaded once. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_load(CTX, data, len) == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_get() == &rustsecp256k1zkp_v0_8_1_ecmult_tables_loaded);
+
+    /* Go back to the compiled-in tables before freeing the loaded ones. */
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_current = &rustsecp256k1zkp_v0_8_1_ecmult_tables_builtin;
+    rustsecp256k1zkp_v0_8_1_ecmult_tables_claimed = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_tables_info(CTX, &size, checksum, &window) == 1);
+    CHECK(rustsecp256k1zkp_v0_8_1_memcmp_var(checksum, builtin_checksum, 32) == 0);
+    free(data);
+}
+
 static void run_ecmult_chain(void) {
     /* random starting point A (on the curve) */
     rustsecp256k1zkp_v0_8_1_gej a = SECP256K1_GEJ_CONST(
@@ -5356,9 +5817,103 @@ static void test_ecmult_multi_batching(void) {
     free(pt);
 }
 
+/* A scratch space of rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(n) bytes fits n points in
+ * one batch. */
+static void test_ecmult_multi_scratch_size(void) {
+    size_t n;
+    for (n = 1; n <= 2 * ECMULT_PIPPENGER_THRESHOLD; n++) {
+        rustsecp256k1zkp_v0_8_1_scratch *scratch = rustsecp256k1zkp_v0_8_1_scratch_create(&CTX->error_callback, rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(n));
+        size_t n_batches, n_batch_points;
+        CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, rustsecp256k1zkp_v0_8_1_pippenger_max_points(&CTX->error_callback, scratch), n));
+        if (n_batch_points < ECMULT_PIPPENGER_THRESHOLD) {
+            CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, rustsecp256k1zkp_v0_8_1_strauss_max_points(&CTX->error_callback, scratch), n));
+        }
+        CHECK(n_batches == 1);
+        rustsecp256k1zkp_v0_8_1_scratch_destroy(&CTX->error_callback, scratch);
+    }
+}
+
+/* Runs the tasks in reverse order and counts them, in place of a thread pool. */
+static void ecmult_multi_run_reversed(void (*task)(size_t index, void *task_data), void *task_data, size_t n_tasks, void *data) {
+    size_t *count = (size_t *)data;
+    while (n_tasks > 0) {
+        task(--n_tasks, task_data);
+        (*count)++;
+    }
+}
+
+static void test_ecmult_multi_workers(void) {
+    const size_t n = 3 * ECMULT_PARALLEL_MIN_POINTS + 5;
+    rustsecp256k1zkp_v0_8_1_scalar *sc = (rustsecp256k1zkp_v0_8_1_scalar *)checked_malloc(&CTX->error_callback, n * sizeof(*sc));
+    rustsecp256k1zkp_v0_8_1_ge *pt = (rustsecp256k1zkp_v0_8_1_ge *)checked_malloc(&CTX->error_callback, n * sizeof(*pt));
+    rustsecp256k1zkp_v0_8_1_scratch *scratch;
+    rustsecp256k1zkp_v0_8_1_scalar g_sc;
+    rustsecp256k1zkp_v0_8_1_gej expected, r;
+    ecmult_multi_data data;
+    size_t count = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        random_scalar_order(&sc[i]);
+        random_group_element_test(&pt[i]);
+    }
+    random_scalar_order(&g_sc);
+    data.sc = sc;
+    data.pt = pt;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, NULL, &expected, &g_sc, ecmult_multi_callback, &data, n));
+
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, 4 * rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(n / 2));
+    CHECK_ILLEGAL(CTX, rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(CTX, scratch, ecmult_multi_run_reversed, &count, 0));
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(CTX, scratch, ecmult_multi_run_reversed, &count, 8));
+
+    /* The points are split into parts of at least ECMULT_PARALLEL_MIN_POINTS. */
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, &g_sc, ecmult_multi_callback, &data, n));
+    CHECK(count == 3);
+    CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+    CHECK(scratch->alloc_size == 0);
+
+    /* and into at most n_workers parts. */
+    count = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(CTX, scratch, ecmult_multi_run_reversed, &count, 2));
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, &g_sc, ecmult_multi_callback, &data, n));
+    CHECK(count == 2);
+    CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+
+    /* Failing callbacks fail the whole multi-exponentiation. */
+    count = 0;
+    CHECK(!rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, &g_sc, ecmult_multi_false_callback, &data, n));
+    CHECK(count == 2);
+    CHECK(scratch->alloc_size == 0);
+
+    /* Small multi-exponentiations stay in the calling thread. */
+    count = 0;
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, NULL, ecmult_multi_callback, &data, 2 * ECMULT_PARALLEL_MIN_POINTS - 1));
+    CHECK(count == 0);
+
+    /* Without workers, everything is computed in the calling thread. */
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(CTX, scratch, NULL, NULL, 0));
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, &g_sc, ecmult_multi_callback, &data, n));
+    CHECK(count == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+
+    /* So is everything if the scratch space is too small to share. */
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_create(CTX, rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size(ECMULT_PIPPENGER_THRESHOLD));
+    CHECK(rustsecp256k1zkp_v0_8_1_scratch_space_set_workers(CTX, scratch, ecmult_multi_run_reversed, &count, 8));
+    CHECK(rustsecp256k1zkp_v0_8_1_ecmult_multi_var(&CTX->error_callback, scratch, &r, &g_sc, ecmult_multi_callback, &data, n));
+    CHECK(count == 0);
+    CHECK(rustsecp256k1zkp_v0_8_1_gej_eq_var(&r, &expected));
+    rustsecp256k1zkp_v0_8_1_scratch_space_destroy(CTX, scratch);
+
+    free(sc);
+    free(pt);
+}
+
 static void run_ecmult_multi_tests(void) {
     rustsecp256k1zkp_v0_8_1_scratch *scratch;
     int64_t todo = (int64_t)320 * COUNT;
+    scratch_grow_data grow;
+    void *prealloc = checked_malloc(&CTX->error_callback, rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size(0));
 
     test_rustsecp256k1zkp_v0_8_1_pippenger_bucket_window_inv();
     test_ecmult_multi_pippenger_max_points();
@@ -5379,8 +5934,23 @@ static void run_ecmult_multi_tests(void) {
     test_ecmult_multi(scratch, rustsecp256k1zkp_v0_8_1_ecmult_multi_var);
     rustsecp256k1zkp_v0_8_1_scratch_destroy(&CTX->error_callback, scratch);
 
+    /* A growable scratch space runs everything in one batch. */
+    grow.n = 0;
+    grow.min_size = 1 << 20;
+    scratch = rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create(CTX, prealloc, 0, SIZE_MAX, scratch_grow_fn, &grow);
+    test_ecmult_multi(scratch, rustsecp256k1zkp_v0_8_1_ecmult_multi_var);
+    todo = (int64_t)32 * COUNT;
+    while (todo > 0) {
+        todo -= test_ecmult_multi_random(scratch);
+    }
+    rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy(CTX, scratch);
+    scratch_grow_free(&grow);
+    free(prealloc);
+
     test_ecmult_multi_batch_size_helper();
     test_ecmult_multi_batching();
+    test_ecmult_multi_scratch_size();
+    test_ecmult_multi_workers();
 }
 
 static void test_wnaf(const rustsecp256k1zkp_v0_8_1_scalar *number, int w) {
@@ -7926,9 +8496,15 @@ int main(int argc, char **argv) {
     run_proper_context_tests(0); run_proper_context_tests(1);
     run_static_context_tests(0); run_static_context_tests(1);
     run_deprecated_context_flags_test();
+    run_sign_table_context_tests();
+    run_context_backends_tests();
+#ifdef __GNUC__
+    run_once_int_tests();
+#endif
 
     /* scratch tests */
     run_scratch_tests();
+    run_scratch_growable_tests();
 
     /* util tests */
     run_util_tests();
@@ -7944,9 +8520,12 @@ int main(int argc, char **argv) {
     /* hash tests */
     run_sha256_known_output_tests();
     run_sha256_counter_tests();
+    run_sha256_hw_tests();
+    run_sha256_multi_tests();
     run_hmac_sha256_tests();
     run_rfc6979_hmac_sha256_tests();
     run_tagged_sha256_tests();
+    run_sha256_tag_midstate_tests();
 
     /* scalar tests */
     run_scalar_tests();
@@ -7957,6 +8536,9 @@ int main(int argc, char **argv) {
     run_field_convert();
     run_field_be32_overflow();
     run_fe_mul();
+#ifdef SECP256K1_FE_X8
+    run_fe_x8_mul();
+#endif
     run_sqr();
     run_sqrt();
 
@@ -7967,6 +8549,7 @@ int main(int argc, char **argv) {
 
     /* ecmult tests */
     run_ecmult_pre_g();
+    run_ecmult_tables_load_tests();
     run_wnaf();
     run_point_times_order();
     run_ecmult_near_split_bound();
@@ -64,6 +64,19 @@ static void print_buf_plain(const unsigned char *buf, size_t len) {
     stmt; \
 } while(0)
 
+/** Assert statically that expr is true.
+ *
+ * This is a statement-like macro and can only be used inside functions.
+ */
+#define STATIC_ASSERT(expr) do { \
+    switch(0) { \
+        case 0: \
+        /* ERROR: static assertion failed */ \
+        case (expr): \
+        ; \
+    } \
+} while(0)
+
 typedef struct {
     void (*fn)(const char *text, void* data);
     const void* data;
@@ -155,6 +168,32 @@ static const rustsecp256k1zkp_v0_8_1_callback default_error_callback = {
 
 #define ROUND_TO_ALIGN(size) ((((size) + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT)
 
+#ifdef __GNUC__
+/* Returns *value, which is set to detect() on the first call. *value must
+ * start out as -1 and detect() must return a nonnegative int. This may be
+ * called from several threads at once: exactly one of them runs detect(),
+ * and the others wait until it has stored the result. Only used by the
+ * CPU-specific code, which is only built with GCC and clang. */
+static SECP256K1_INLINE int rustsecp256k1zkp_v0_8_1_once_int(int *value, int (*detect)(void)) {
+    int r = __atomic_load_n(value, __ATOMIC_ACQUIRE);
+    int expected = -1;
+
+    if (EXPECT(r >= 0, 1)) {
+        return r;
+    }
+    /* -2 marks the detection as running. */
+    if (__atomic_compare_exchange_n(value, &expected, -2, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        r = detect();
+        __atomic_store_n(value, r, __ATOMIC_RELEASE);
+        return r;
+    }
+    while ((r = __atomic_load_n(value, __ATOMIC_ACQUIRE)) < 0) {
+        /* Wait for the detection, which takes a few CPUID instructions. */
+    }
+    return r;
+}
+#endif
+
 /* Extract the sign of an int64, take the abs and return a uint64, constant time. */
 SECP256K1_INLINE static int rustsecp256k1zkp_v0_8_1_sign_and_abs64(uint64_t *out, int64_t in) {
     uint64_t mask0, mask1;
@@ -12,7 +12,116 @@ pub const ECDSA_ADAPTOR_SIGNATURE_LENGTH: size_t = 162;
 /// The maximum number of whitelist keys.
 pub const WHITELIST_MAX_N_KEYS: size_t = 255;
 
+/// Flag for `secp256k1_context_set_sign_table` selecting the small generator table.
+pub const SECP256K1_CONTEXT_SIGN_TABLE_SMALL: c_uint = 1 | (1 << 11);
+/// Flag for `secp256k1_context_set_sign_table` selecting the large generator table.
+pub const SECP256K1_CONTEXT_SIGN_TABLE_LARGE: c_uint = 1 | (1 << 12);
+
+/// Flag returned by `secp256k1_context_backends` if the x86_64 assembly is used.
+pub const SECP256K1_BACKEND_ASM_X86_64: c_uint = 1 << 0;
+/// Flag returned by `secp256k1_context_backends` if SHA256 uses the CPU's SHA instructions.
+pub const SECP256K1_BACKEND_SHA256_HW: c_uint = 1 << 1;
+/// Flag returned by `secp256k1_context_backends` if batched SHA256 uses AVX2.
+pub const SECP256K1_BACKEND_SHA256_LANES_AVX2: c_uint = 1 << 2;
+/// Flag returned by `secp256k1_context_backends` if batched field multiplication uses AVX-512 IFMA.
+pub const SECP256K1_BACKEND_FIELD_IFMA: c_uint = 1 << 3;
+
 extern "C" {
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_context_set_sign_table"
+    )]
+    // Select the precomputed table used for multiplications with the generator
+    pub fn secp256k1_context_set_sign_table(cx: *mut Context, flags: c_uint) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecmult_tables_load"
+    )]
+    // Use the precomputed tables in a table file instead of the compiled-in ones
+    pub fn secp256k1_ecmult_tables_load(
+        cx: *const Context,
+        data: *const c_uchar,
+        datalen: size_t,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecmult_tables_info"
+    )]
+    // Describe the precomputed tables in use
+    pub fn secp256k1_ecmult_tables_info(
+        cx: *const Context,
+        size: *mut size_t,
+        checksum32: *mut c_uchar,
+        window: *mut c_uint,
+    ) -> c_int;
+
+    #[cfg(unix)]
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecmult_tables_mmap"
+    )]
+    // Map a table file and load the tables from it
+    pub fn secp256k1_ecmult_tables_mmap(cx: *const Context, path: *const c_char) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_context_backends"
+    )]
+    // Report the optional implementations selected for this CPU
+    pub fn secp256k1_context_backends(cx: *const Context) -> c_uint;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_size"
+    )]
+    // Size of the memory for a scratch space with size bytes before it grows
+    pub fn secp256k1_scratch_space_preallocated_size(size: size_t) -> size_t;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_create"
+    )]
+    // Create a scratch space in prealloc that calls grow for more memory
+    pub fn secp256k1_scratch_space_preallocated_create(
+        cx: *const Context,
+        prealloc: *mut c_void,
+        size: size_t,
+        max_size: size_t,
+        grow: ScratchGrowFn,
+        grow_data: *mut c_void,
+    ) -> *mut ScratchSpace;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_scratch_space_ecmult_size"
+    )]
+    // Size of a scratch space that fits a multi-exponentiation of n_points in one batch
+    pub fn secp256k1_scratch_space_ecmult_size(n_points: size_t) -> size_t;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_scratch_space_set_workers"
+    )]
+    // Let large multi-exponentiations be split into n_workers parts that run calls
+    pub fn secp256k1_scratch_space_set_workers(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        run: ScratchRunFn,
+        data: *mut c_void,
+        n_workers: size_t,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_scratch_space_preallocated_destroy"
+    )]
+    pub fn secp256k1_scratch_space_preallocated_destroy(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+    );
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_pedersen_commitment_parse"
@@ -49,6 +158,24 @@ extern "C" {
         value_gen: *const PublicKey,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_pedersen_commit_batch"
+    )]
+    // Generates n pedersen commitments: commits[i] = blinds[i] * G + values[i] * gens[i].
+    // Consecutive commitments with the same generator share precomputation and
+    // all commitments are normalized with a single field inversion if scratch is
+    // large enough.
+    pub fn secp256k1_pedersen_commit_batch(
+        ctx: *const Context,
+        scratch: *mut ScratchSpace,
+        commits: *mut PedersenCommitment,
+        blinds: *const *const c_uchar,
+        values: *const u64,
+        value_gens: *const *const PublicKey,
+        n: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_pedersen_blind_generator_blind_sum"
@@ -91,6 +218,57 @@ extern "C" {
         n_inputs: size_t,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_init"
+    )]
+    pub fn secp256k1_pedersen_blind_accumulator_init(
+        ctx: *const Context,
+        acc: *mut PedersenBlindAccumulator,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_add"
+    )]
+    // Adds (vr + r') of one commitment to the accumulator, negated if is_input is nonzero.
+    pub fn secp256k1_pedersen_blind_accumulator_add(
+        ctx: *const Context,
+        acc: *mut PedersenBlindAccumulator,
+        value: u64,
+        generator_blind: *const c_uchar,
+        blinding_factor: *const c_uchar,
+        is_input: c_int,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_remove"
+    )]
+    // Undoes a previous secp256k1_pedersen_blind_accumulator_add with the same arguments.
+    pub fn secp256k1_pedersen_blind_accumulator_remove(
+        ctx: *const Context,
+        acc: *mut PedersenBlindAccumulator,
+        value: u64,
+        generator_blind: *const c_uchar,
+        blinding_factor: *const c_uchar,
+        is_input: c_int,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_pedersen_blind_accumulator_finalize"
+    )]
+    // Computes the blinding factor of a final output that makes all accumulated
+    // (vr + r') sum to zero, without modifying the accumulator.
+    pub fn secp256k1_pedersen_blind_accumulator_finalize(
+        ctx: *const Context,
+        blinding_factor_out: *mut c_uchar,
+        acc: *const PedersenBlindAccumulator,
+        value: u64,
+        generator_blind: *const c_uchar,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_pedersen_verify_tally"
@@ -307,6 +485,30 @@ extern "C" {
         ndata: *mut c_void,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_enckey_prepare"
+    )]
+    pub fn secp256k1_ecdsa_adaptor_enckey_prepare(
+        cx: *const Context,
+        prepared: *mut EcdsaAdaptorPreparedEncKey,
+        enckey: *const PublicKey,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_encrypt_prepared"
+    )]
+    pub fn secp256k1_ecdsa_adaptor_encrypt_prepared(
+        cx: *const Context,
+        adaptor_sig162: *mut EcdsaAdaptorSignature,
+        seckey32: *const c_uchar,
+        enckey: *const EcdsaAdaptorPreparedEncKey,
+        msg32: *const c_uchar,
+        noncefp: EcdsaAdaptorNonceFn,
+        ndata: *mut c_void,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify"
@@ -319,6 +521,40 @@ extern "C" {
         enckey: *const PublicKey,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_verify_batch"
+    )]
+    // Verifies n_sigs adaptor signatures, combining their ECDSA relations into a
+    // single multi-exponentiation.
+    pub fn secp256k1_ecdsa_adaptor_verify_batch(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        adaptor_sigs162: *const *const EcdsaAdaptorSignature,
+        pubkeys: *const *const PublicKey,
+        msgs32: *const *const c_uchar,
+        enckeys: *const *const PublicKey,
+        n_sigs: size_t,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_compute_attestation_points"
+    )]
+    // Computes the n_points = base^n_digits adaptor points of a numeric oracle
+    // event, sharing the partial sums of common digit prefixes.
+    pub fn secp256k1_ecdsa_adaptor_compute_attestation_points(
+        cx: *const Context,
+        digit_points: *mut PublicKey,
+        points: *mut PublicKey,
+        oracle_pubkey: *const XOnlyPublicKey,
+        nonces: *const XOnlyPublicKey,
+        n_digits: size_t,
+        outcome_msgs32: *const *const c_uchar,
+        base: size_t,
+        n_points: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_ecdsa_adaptor_decrypt"
@@ -366,6 +602,45 @@ extern "C" {
         n_pubkeys: size_t,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_pubkey_prepare"
+    )]
+    pub fn secp256k1_musig_pubkey_prepare(
+        cx: *const Context,
+        prepared: *mut MusigPreparedPubkey,
+        pubkey: *const PublicKey,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_prepared"
+    )]
+    pub fn secp256k1_musig_pubkey_agg_prepared(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        combined_pk: *mut XOnlyPublicKey,
+        keyagg_cache: *mut MusigKeyAggCache,
+        prepared: *const *const MusigPreparedPubkey,
+        n_pubkeys: size_t,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_pubkey_agg_subsets"
+    )]
+    pub fn secp256k1_musig_pubkey_agg_subsets(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        combined_pks: *mut XOnlyPublicKey,
+        keyagg_caches: *mut MusigKeyAggCache,
+        n_subsets: *mut size_t,
+        subset: *mut size_t,
+        k: size_t,
+        prepared: *const *const MusigPreparedPubkey,
+        n_pubkeys: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_whitelist_signature_serialize"
@@ -431,6 +706,21 @@ extern "C" {
         extra_input32: *const c_uchar,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_nonce_gen_batch"
+    )]
+    pub fn secp256k1_musig_nonce_gen_batch(
+        cx: *const Context,
+        secnonces: *mut MusigSecNonce,
+        pubnonces: *mut MusigPubNonce,
+        session_ids32: *const *const c_uchar,
+        seckey: *const c_uchar,
+        pubkey: *const PublicKey,
+        extra_input32: *const c_uchar,
+        n: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_whitelist_verify"
@@ -455,6 +745,19 @@ extern "C" {
         n_pubnonces: size_t,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_nonce_agg_batch"
+    )]
+    pub fn secp256k1_musig_nonce_agg_batch(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        aggnonces: *mut MusigAggNonce,
+        pubnonces: *const *const MusigPubNonce,
+        n_pubnonces: *const size_t,
+        n_sessions: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_musig_nonce_process"
@@ -609,6 +912,23 @@ extern "C" {
         negate_seckey: c_int,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sign_batch"
+    )]
+    pub fn secp256k1_blinded_musig_partial_sign_batch(
+        cx: *const Context,
+        scratch: *mut ScratchSpace,
+        partial_sigs: *mut MusigPartialSignature,
+        secnonces: *mut MusigSecNonce,
+        keypair: *const Keypair,
+        sessions: *const MusigSession,
+        pubnonces: *const MusigPubNonce,
+        keyaggcoef: *const MusigKeyAggCoef,
+        negate_seckey: c_int,
+        n: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_blinded_musig_partial_sig_verify"
@@ -636,6 +956,30 @@ extern "C" {
         session: *const MusigSession,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_signer_table_create"
+    )]
+    pub fn secp256k1_musig_signer_table_create(
+        cx: *const Context,
+        table: *mut MusigSignerTable,
+        pubkey: *const PublicKey,
+        keyagg_cache: *const MusigKeyAggCache,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_table"
+    )]
+    pub fn secp256k1_musig_partial_sig_verify_table(
+        cx: *const Context,
+        partial_sig: *const MusigPartialSignature,
+        pubnonce: *const MusigPubNonce,
+        table: *const MusigSignerTable,
+        keyagg_cache: *const MusigKeyAggCache,
+        session: *const MusigSession,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg"
@@ -648,6 +992,65 @@ extern "C" {
         n_sigs: size_t,
     ) -> c_int;
 
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_session_expand"
+    )]
+    pub fn secp256k1_musig_session_expand(
+        cx: *const Context,
+        expanded: *mut MusigExpandedSession,
+        keyagg_cache: *const MusigKeyAggCache,
+        session: *const MusigSession,
+        signer: *const PublicKey,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_expanded_session_get"
+    )]
+    pub fn secp256k1_musig_expanded_session_get(
+        cx: *const Context,
+        keyagg_cache: *mut MusigKeyAggCache,
+        session: *mut MusigSession,
+        expanded: *const MusigExpandedSession,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_partial_sign_expanded"
+    )]
+    pub fn secp256k1_musig_partial_sign_expanded(
+        cx: *const Context,
+        partial_sig: *mut MusigPartialSignature,
+        secnonce: *mut MusigSecNonce,
+        keypair: *const Keypair,
+        expanded: *const MusigExpandedSession,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_partial_sig_verify_expanded"
+    )]
+    pub fn secp256k1_musig_partial_sig_verify_expanded(
+        cx: *const Context,
+        partial_sig: *const MusigPartialSignature,
+        pubnonce: *const MusigPubNonce,
+        pubkey: *const PublicKey,
+        expanded: *const MusigExpandedSession,
+    ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_musig_partial_sig_agg_expanded"
+    )]
+    pub fn secp256k1_musig_partial_sig_agg_expanded(
+        cx: *const Context,
+        sig64: *mut c_uchar,
+        expanded: *const MusigExpandedSession,
+        partial_sigs: *const *const MusigPartialSignature,
+        n_sigs: size_t,
+    ) -> c_int;
+
     #[cfg_attr(
         not(feature = "external-symbols"),
         link_name = "rustsecp256k1zkp_v0_8_1_musig_nonce_parity"
@@ -724,6 +1127,20 @@ extern "C" {
         pre_sig64: *const c_uchar,
         nonce_parity: c_int,
     ) -> c_int;
+
+    #[cfg_attr(
+        not(feature = "external-symbols"),
+        link_name = "rustsecp256k1zkp_v0_8_1_schnorrsig_sign_batch"
+    )]
+    pub fn secp256k1_schnorrsig_sign_batch(
+        cx: *const Context,
+        sig64: *mut c_uchar,
+        msgs: *const *const c_uchar,
+        msglens: *const size_t,
+        keypair: *const Keypair,
+        aux_rands32: *const *const c_uchar,
+        n: size_t,
+    ) -> c_int;
 }
 
 #[repr(C)]
@@ -901,6 +1318,30 @@ impl Hash for PedersenCommitment {
     }
 }
 
+pub const PEDERSEN_BLIND_ACCUMULATOR_LEN: usize = 36;
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct PedersenBlindAccumulator([c_uchar; PEDERSEN_BLIND_ACCUMULATOR_LEN]);
+impl_array_newtype!(
+    PedersenBlindAccumulator,
+    c_uchar,
+    PEDERSEN_BLIND_ACCUMULATOR_LEN
+);
+impl_raw_debug!(PedersenBlindAccumulator);
+
+impl PedersenBlindAccumulator {
+    pub fn new() -> Self {
+        PedersenBlindAccumulator([0; PEDERSEN_BLIND_ACCUMULATOR_LEN])
+    }
+}
+
+impl Default for PedersenBlindAccumulator {
+    fn default() -> Self {
+        PedersenBlindAccumulator::new()
+    }
+}
+
 /// A ring signature for the "whitelist" scheme.
 #[repr(C)]
 #[derive(Clone)]
@@ -990,16 +1431,46 @@ impl PartialEq for EcdsaAdaptorSignature {
 #[cfg(not(fuzzing))]
 impl Eq for EcdsaAdaptorSignature {}
 
+pub const ECDSA_ADAPTOR_PREPARED_ENCKEY_LEN: usize = 65668;
+
+/// An encryption key with a precomputed multiplication table. Too large to be
+/// kept on the stack.
+#[repr(C)]
+pub struct EcdsaAdaptorPreparedEncKey([c_uchar; ECDSA_ADAPTOR_PREPARED_ENCKEY_LEN]);
+
+impl EcdsaAdaptorPreparedEncKey {
+    pub fn new() -> Self {
+        EcdsaAdaptorPreparedEncKey([0; ECDSA_ADAPTOR_PREPARED_ENCKEY_LEN])
+    }
+}
+
 #[repr(C)]
 pub struct ScratchSpace(c_int);
 
+/// Provides at least `*size` bytes of memory to a growable scratch space, and stores the number
+/// of bytes provided in `*size`. Returns null if no memory is available.
+pub type ScratchGrowFn =
+    Option<unsafe extern "C" fn(size: *mut size_t, data: *mut c_void) -> *mut c_void>;
+
+pub type ScratchRunFn = Option<
+    unsafe extern "C" fn(
+        task: unsafe extern "C" fn(index: size_t, task_data: *mut c_void),
+        task_data: *mut c_void,
+        n_tasks: size_t,
+        data: *mut c_void,
+    ),
+>;
+
 pub const MUSIG_KEYAGG_LEN: usize = 197;
+pub const MUSIG_PREPARED_PUBKEY_LEN: usize = 101;
+pub const MUSIG_SIGNER_TABLE_LEN: usize = 33316;
 pub const MUSIG_SECNONCE_LEN: usize = 132;
 pub const MUSIG_PUBNONCE_LEN: usize = 132;
 pub const MUSIG_AGGNONCE_LEN: usize = 132;
 pub const MUSIG_AGGNONCE_SERIALIZED_LEN: usize = 66;
 pub const MUSIG_PUBNONCE_SERIALIZED_LEN: usize = 66;
 pub const MUSIG_SESSION_LEN: usize = 133;
+pub const MUSIG_EXPANDED_SESSION_LEN: usize = 512;
 pub const MUSIG_PART_SIG_LEN: usize = 36;
 pub const MUSIG_KEYAGG_COEF_LEN: usize = 32;
 
@@ -1025,6 +1496,30 @@ impl MusigKeyAggCache {
     }
 }
 
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct MusigPreparedPubkey([c_uchar; MUSIG_PREPARED_PUBKEY_LEN]);
+impl_array_newtype!(MusigPreparedPubkey, c_uchar, MUSIG_PREPARED_PUBKEY_LEN);
+impl_raw_debug!(MusigPreparedPubkey);
+
+impl MusigPreparedPubkey {
+    pub fn new() -> Self {
+        MusigPreparedPubkey([0; MUSIG_PREPARED_PUBKEY_LEN])
+    }
+}
+
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct MusigSignerTable([c_uchar; MUSIG_SIGNER_TABLE_LEN]);
+impl_array_newtype!(MusigSignerTable, c_uchar, MUSIG_SIGNER_TABLE_LEN);
+impl_raw_debug!(MusigSignerTable);
+
+impl MusigSignerTable {
+    pub fn new() -> Self {
+        MusigSignerTable([0; MUSIG_SIGNER_TABLE_LEN])
+    }
+}
+
 #[repr(C)]
 #[derive(Copy, Clone)]
 pub struct MusigSecNonce(pub [c_uchar; MUSIG_SECNONCE_LEN]);
@@ -1113,6 +1608,18 @@ impl MusigSession {
     }
 }
 
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct MusigExpandedSession(pub [c_uchar; MUSIG_EXPANDED_SESSION_LEN]);
+impl_array_newtype!(MusigExpandedSession, c_uchar, MUSIG_EXPANDED_SESSION_LEN);
+impl_raw_debug!(MusigExpandedSession);
+
+impl MusigExpandedSession {
+    pub fn new() -> Self {
+        MusigExpandedSession([0; MUSIG_EXPANDED_SESSION_LEN])
+    }
+}
+
 #[repr(C)]
 #[derive(Copy, Clone)]
 pub struct MusigPartialSignature([c_uchar; MUSIG_PART_SIG_LEN]);
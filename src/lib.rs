@@ -103,6 +103,14 @@ pub enum Error {
     CannotRecoverAdaptorSecret,
     /// Given adaptor signature is not valid for the provided combination of public key, encryption key and message
     CannotVerifyAdaptorSignature,
+    /// Failed to compute oracle attestation points, because there were no nonces, fewer than two
+    /// outcome messages, too many outcomes or a point was the point at infinity
+    CannotComputeAttestationPoints,
+    /// The requested generator table is not compiled into `libsecp256k1-zkp`
+    SignTableUnavailable,
+    /// The file could not be mapped or does not hold valid precomputed tables for this build, or
+    /// tables were already loaded
+    InvalidEcmultTables,
     /// Given bytes don't represent a valid whitelist signature
     InvalidWhitelistSignature,
     /// Invalid PAK list
@@ -127,6 +135,9 @@ impl fmt::Display for Error {
             Error::CannotDecryptAdaptorSignature => "failed to decrypt adaptor signature",
             Error::CannotRecoverAdaptorSecret => "failed to recover adaptor secret",
             Error::CannotVerifyAdaptorSignature => "failed to verify adaptor signature",
+            Error::CannotComputeAttestationPoints => "failed to compute attestation points",
+            Error::SignTableUnavailable => "generator table not available in this build",
+            Error::InvalidEcmultTables => "invalid precomputed tables file",
             Error::Upstream(inner) => return write!(f, "{}", inner),
             Error::InvalidTweakLength => "Tweak must of size 32",
             Error::TweakOutOfBounds => "Tweak must be less than secp curve order",
@@ -0,0 +1,61 @@
+use crate::ffi;
+use crate::{Context, Secp256k1};
+
+/// The optional implementations the library uses on this machine.
+///
+/// Implementations that need instructions beyond the baseline of the target are compiled in
+/// next to the portable code, and the fastest one the CPU supports is selected the first time
+/// it is needed or [`backends`] is called. The contexts of this crate are created by the
+/// `secp256k1` crate, so the selection is not made up front. It is made once, even if several
+/// threads need it at the same time, and is the same for all contexts.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct Backends(ffi::types::c_uint);
+
+impl Backends {
+    /// Whether the field and scalar arithmetic uses the x86_64 assembly. This is chosen when
+    /// the library is built.
+    pub fn asm_x86_64(&self) -> bool {
+        self.0 & ffi::SECP256K1_BACKEND_ASM_X86_64 != 0
+    }
+
+    /// Whether SHA256 uses the SHA instructions of the CPU.
+    pub fn sha256_hw(&self) -> bool {
+        self.0 & ffi::SECP256K1_BACKEND_SHA256_HW != 0
+    }
+
+    /// Whether many SHA256 hashes are computed at once with AVX2, as when verifying range proofs.
+    pub fn sha256_lanes_avx2(&self) -> bool {
+        self.0 & ffi::SECP256K1_BACKEND_SHA256_LANES_AVX2 != 0
+    }
+
+    /// Whether batches of field multiplications use AVX-512 IFMA, as when converting many points
+    /// to affine coordinates.
+    pub fn field_ifma(&self) -> bool {
+        self.0 & ffi::SECP256K1_BACKEND_FIELD_IFMA != 0
+    }
+}
+
+/// Returns the optional implementations the library selected for this CPU, selecting them first
+/// if no operation has needed them yet.
+pub fn backends<C: Context>(secp: &Secp256k1<C>) -> Backends {
+    Backends(unsafe { ffi::secp256k1_context_backends(secp.ctx().as_ptr()) })
+}
+
+#[cfg(all(test, feature = "global-context"))]
+mod tests {
+    use super::*;
+    use crate::SECP256K1;
+
+    #[test]
+    fn test_backends() {
+        let secp = Secp256k1::new();
+        let selected = backends(&secp);
+
+        assert_eq!(backends(&SECP256K1), selected);
+        #[cfg(not(target_arch = "x86_64"))]
+        {
+            assert!(!selected.sha256_lanes_avx2());
+            assert!(!selected.field_ifma());
+        }
+    }
+}
@@ -12,10 +12,14 @@ use crate::ffi::{self, CPtr, ECDSA_ADAPTOR_SIGNATURE_LENGTH};
 use crate::rand::thread_rng;
 #[cfg(feature = "actual-rand")]
 use crate::rand::{CryptoRng, Rng};
+#[cfg(feature = "std")]
+use crate::zkp::scratch::with_thread_scratch;
 use crate::{constants, PublicKey, Secp256k1, SecretKey};
 use crate::{ecdsa::Signature, Verification};
 use crate::{from_hex, Error};
 use crate::{Message, Signing};
+#[cfg(feature = "std")]
+use crate::{ScratchSpace, XOnlyPublicKey};
 use core::{fmt, ptr, str};
 
 /// Represents an adaptor signature and dleq proof.
@@ -216,6 +220,63 @@ impl EcdsaAdaptorSignature {
         EcdsaAdaptorSignature(adaptor_sig)
     }
 
+    /// Same as [`EcdsaAdaptorSignature::encrypt_no_aux_rand`], but uses an encryption key
+    /// prepared with [`PreparedEncryptionKey::new`].
+    #[cfg(feature = "std")]
+    pub fn encrypt_prepared_no_aux_rand<C: Signing>(
+        secp: &Secp256k1<C>,
+        msg: &Message,
+        sk: &SecretKey,
+        enckey: &PreparedEncryptionKey,
+    ) -> EcdsaAdaptorSignature {
+        EcdsaAdaptorSignature::encrypt_prepared_internal(secp, msg, sk, enckey, ptr::null_mut())
+    }
+
+    /// Same as [`EcdsaAdaptorSignature::encrypt_with_aux_rand`], but uses an encryption key
+    /// prepared with [`PreparedEncryptionKey::new`].
+    #[cfg(feature = "std")]
+    pub fn encrypt_prepared_with_aux_rand<C: Signing>(
+        secp: &Secp256k1<C>,
+        msg: &Message,
+        sk: &SecretKey,
+        enckey: &PreparedEncryptionKey,
+        aux_rand: &[u8; 32],
+    ) -> EcdsaAdaptorSignature {
+        EcdsaAdaptorSignature::encrypt_prepared_internal(
+            secp,
+            msg,
+            sk,
+            enckey,
+            aux_rand.as_c_ptr() as *mut ffi::types::c_void,
+        )
+    }
+
+    #[cfg(feature = "std")]
+    fn encrypt_prepared_internal<C: Signing>(
+        secp: &Secp256k1<C>,
+        msg: &Message,
+        sk: &SecretKey,
+        enckey: &PreparedEncryptionKey,
+        ndata: *mut ffi::types::c_void,
+    ) -> EcdsaAdaptorSignature {
+        let mut adaptor_sig = ffi::EcdsaAdaptorSignature::new();
+
+        let res = unsafe {
+            ffi::secp256k1_ecdsa_adaptor_encrypt_prepared(
+                secp.ctx().as_ptr(),
+                &mut adaptor_sig,
+                sk.as_c_ptr(),
+                &*enckey.prepared,
+                msg.as_c_ptr(),
+                ffi::secp256k1_nonce_function_ecdsa_adaptor,
+                ndata,
+            )
+        };
+        debug_assert_eq!(res, 1);
+
+        EcdsaAdaptorSignature(adaptor_sig)
+    }
+
     /// Creates an ECDSA signature from an adaptor signature and an adaptor secret.
     pub fn decrypt(&self, decryption_key: &SecretKey) -> Result<Signature, Error> {
         unsafe {
@@ -285,6 +346,178 @@ impl EcdsaAdaptorSignature {
 
         Ok(())
     }
+
+    /// Verifies many `(adaptor_signature, msg, pubkey, encryption_key)` tuples at once.
+    ///
+    /// Succeeds if and only if [`EcdsaAdaptorSignature::verify`] succeeds for every
+    /// tuple, but shares the work of checking the ECDSA equations across the batch.
+    #[cfg(feature = "std")]
+    pub fn verify_batch<C: Verification>(
+        secp: &Secp256k1<C>,
+        batch: &[(&EcdsaAdaptorSignature, &Message, &PublicKey, &PublicKey)],
+    ) -> Result<(), Error> {
+        with_thread_scratch(|scratch| {
+            EcdsaAdaptorSignature::verify_batch_with_scratch(secp, scratch, batch)
+        })
+    }
+
+    /// Like [`EcdsaAdaptorSignature::verify_batch`], but with the temporary data in `scratch`
+    /// instead of the scratch space of the current thread.
+    #[cfg(feature = "std")]
+    pub fn verify_batch_with_scratch<C: Verification>(
+        secp: &Secp256k1<C>,
+        scratch: &mut ScratchSpace,
+        batch: &[(&EcdsaAdaptorSignature, &Message, &PublicKey, &PublicKey)],
+    ) -> Result<(), Error> {
+        let sigs = batch.iter().map(|b| b.0.as_c_ptr()).collect::<Vec<_>>();
+        let msgs = batch.iter().map(|b| b.1.as_c_ptr()).collect::<Vec<_>>();
+        let pubkeys = batch.iter().map(|b| b.2.as_c_ptr()).collect::<Vec<_>>();
+        let enckeys = batch.iter().map(|b| b.3.as_c_ptr()).collect::<Vec<_>>();
+
+        let res = unsafe {
+            ffi::secp256k1_ecdsa_adaptor_verify_batch(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                sigs.as_ptr(),
+                pubkeys.as_ptr(),
+                msgs.as_ptr(),
+                enckeys.as_ptr(),
+                batch.len(),
+            )
+        };
+
+        if res != 1 {
+            return Err(Error::CannotVerifyAdaptorSignature);
+        };
+
+        Ok(())
+    }
+}
+
+/// The points computed by [`compute_attestation_points`].
+#[cfg(feature = "std")]
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct AttestationPoints {
+    /// The public signature point of digit `j` having value `d` at index
+    /// `j * outcome_msgs.len() + d`.
+    pub digit_points: Vec<PublicKey>,
+    /// The encryption keys of all outcomes, indexed by the outcome value with the first digit
+    /// being the most significant one.
+    pub outcome_points: Vec<PublicKey>,
+}
+
+/// Computes the adaptor encryption keys for all outcomes of a numeric oracle event.
+///
+/// The oracle attests to each of the `nonces.len()` digits of the outcome with a BIP-340
+/// signature under the corresponding nonce, signing `outcome_msgs[d]` if the digit has
+/// value `d`. The encryption key of an outcome is the sum of the public signature points
+/// of its digits. The points of all digits and the keys of all
+/// `outcome_msgs.len()^nonces.len()` outcomes are returned. Outcomes sharing a prefix
+/// share its partial sum, so this is much cheaper than computing each key on its own.
+#[cfg(feature = "std")]
+pub fn compute_attestation_points<C: Verification>(
+    secp: &Secp256k1<C>,
+    oracle_pubkey: &XOnlyPublicKey,
+    nonces: &[XOnlyPublicKey],
+    outcome_msgs: &[Message],
+) -> Result<AttestationPoints, Error> {
+    let base = outcome_msgs.len();
+    if nonces.is_empty() || base < 2 {
+        return Err(Error::CannotComputeAttestationPoints);
+    }
+    let mut n_points = 1usize;
+    for _ in nonces {
+        n_points = n_points
+            .checked_mul(base)
+            .ok_or(Error::CannotComputeAttestationPoints)?;
+    }
+
+    let nonces = nonces
+        .iter()
+        .map(|nonce| unsafe { *nonce.as_c_ptr() })
+        .collect::<Vec<_>>();
+    let msgs = outcome_msgs
+        .iter()
+        .map(|m| m.as_c_ptr())
+        .collect::<Vec<_>>();
+    let mut digit_points = vec![ffi::PublicKey::new(); nonces.len() * base];
+    let mut points = vec![ffi::PublicKey::new(); n_points];
+
+    let res = unsafe {
+        ffi::secp256k1_ecdsa_adaptor_compute_attestation_points(
+            secp.ctx().as_ptr(),
+            digit_points.as_mut_ptr(),
+            points.as_mut_ptr(),
+            oracle_pubkey.as_c_ptr(),
+            nonces.as_ptr(),
+            nonces.len(),
+            msgs.as_ptr(),
+            base,
+            n_points,
+        )
+    };
+
+    if res != 1 {
+        return Err(Error::CannotComputeAttestationPoints);
+    }
+
+    Ok(AttestationPoints {
+        digit_points: digit_points.into_iter().map(PublicKey::from).collect(),
+        outcome_points: points.into_iter().map(PublicKey::from).collect(),
+    })
+}
+
+/// An adaptor encryption key together with a precomputed multiplication table.
+///
+/// Creating adaptor signatures with a prepared key avoids the variable-base multiplications
+/// by the encryption key, which is worthwhile when the same key is used to encrypt many
+/// signatures. Preparing a key costs about as much as creating a few signatures and the
+/// table takes 64KiB.
+#[cfg(feature = "std")]
+pub struct PreparedEncryptionKey {
+    enckey: PublicKey,
+    prepared: Box<ffi::EcdsaAdaptorPreparedEncKey>,
+}
+
+#[cfg(feature = "std")]
+impl PreparedEncryptionKey {
+    /// Precomputes the multiplication table for `enckey`.
+    pub fn new<C: Signing>(secp: &Secp256k1<C>, enckey: &PublicKey) -> Self {
+        // Allocate the table on the heap directly instead of building it on the stack first.
+        // The object is a byte array, so zeroed bytes of its size have the same layout.
+        let table = vec![0u8; ffi::ECDSA_ADAPTOR_PREPARED_ENCKEY_LEN].into_boxed_slice();
+        let mut prepared = unsafe {
+            Box::from_raw(Box::into_raw(table) as *mut u8 as *mut ffi::EcdsaAdaptorPreparedEncKey)
+        };
+
+        let res = unsafe {
+            ffi::secp256k1_ecdsa_adaptor_enckey_prepare(
+                secp.ctx().as_ptr(),
+                &mut *prepared,
+                enckey.as_c_ptr(),
+            )
+        };
+        assert_eq!(res, 1, "public keys are always valid encryption keys");
+
+        PreparedEncryptionKey {
+            enckey: *enckey,
+            prepared,
+        }
+    }
+
+    /// Returns the encryption key this table was prepared for.
+    pub fn public_key(&self) -> PublicKey {
+        self.enckey
+    }
+}
+
+#[cfg(feature = "std")]
+impl fmt::Debug for PreparedEncryptionKey {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("PreparedEncryptionKey")
+            .field("enckey", &self.enckey)
+            .finish()
+    }
 }
 
 #[cfg(all(test, feature = "global-context"))]
@@ -293,6 +526,8 @@ mod tests {
     use super::*;
     #[cfg(not(rust_secp_fuzz))]
     use crate::rand::{rngs::ThreadRng, thread_rng, RngCore};
+    #[cfg(all(feature = "std", not(rust_secp_fuzz)))]
+    use crate::Keypair;
     use crate::SECP256K1;
 
     #[cfg(not(rust_secp_fuzz))]
@@ -387,6 +622,162 @@ mod tests {
         assert_eq!(expected_decryption_key, recovered);
     }
 
+    #[test]
+    #[cfg(all(feature = "std", not(rust_secp_fuzz)))]
+    fn test_ecdsa_adaptor_signature_verify_batch() {
+        let mut rng = thread_rng();
+        let (seckey, pubkey) = SECP256K1.generate_keypair(&mut rng);
+        let msgs = (1..=8u8)
+            .map(|i| Message::from_slice(&[i; 32]).unwrap())
+            .collect::<Vec<_>>();
+        let enckeys = msgs
+            .iter()
+            .map(|_| SECP256K1.generate_keypair(&mut rng).1)
+            .collect::<Vec<_>>();
+        let sigs = msgs
+            .iter()
+            .zip(enckeys.iter())
+            .map(|(msg, enckey)| {
+                EcdsaAdaptorSignature::encrypt_no_aux_rand(SECP256K1, msg, &seckey, enckey)
+            })
+            .collect::<Vec<_>>();
+
+        let mut batch = sigs
+            .iter()
+            .zip(msgs.iter())
+            .zip(enckeys.iter())
+            .map(|((sig, msg), enckey)| (sig, msg, &pubkey, enckey))
+            .collect::<Vec<_>>();
+        assert!(EcdsaAdaptorSignature::verify_batch(SECP256K1, &batch).is_ok());
+        assert!(EcdsaAdaptorSignature::verify_batch(SECP256K1, &[]).is_ok());
+
+        batch[3].1 = &msgs[4];
+        assert!(EcdsaAdaptorSignature::verify_batch(SECP256K1, &batch).is_err());
+    }
+
+    #[test]
+    #[cfg(all(feature = "std", not(rust_secp_fuzz)))]
+    fn test_ecdsa_adaptor_signature_verify_batch_threads() {
+        let mut rng = thread_rng();
+        let (seckey, pubkey) = SECP256K1.generate_keypair(&mut rng);
+        let (_, enckey) = SECP256K1.generate_keypair(&mut rng);
+        let msgs = (0..1100u32)
+            .map(|i| {
+                let mut msg = [1; 32];
+                msg[..4].copy_from_slice(&i.to_le_bytes());
+                Message::from_slice(&msg).unwrap()
+            })
+            .collect::<Vec<_>>();
+        let sigs = msgs
+            .iter()
+            .map(|msg| EcdsaAdaptorSignature::encrypt_no_aux_rand(SECP256K1, msg, &seckey, &enckey))
+            .collect::<Vec<_>>();
+
+        let mut batch = sigs
+            .iter()
+            .zip(msgs.iter())
+            .map(|(sig, msg)| (sig, msg, &pubkey, &enckey))
+            .collect::<Vec<_>>();
+        let mut scratch = ScratchSpace::new();
+        scratch.set_threads(4);
+        assert!(
+            EcdsaAdaptorSignature::verify_batch_with_scratch(SECP256K1, &mut scratch, &batch)
+                .is_ok()
+        );
+
+        batch[1000].1 = &msgs[3];
+        assert!(
+            EcdsaAdaptorSignature::verify_batch_with_scratch(SECP256K1, &mut scratch, &batch)
+                .is_err()
+        );
+    }
+
+    #[test]
+    #[cfg(all(feature = "std", not(rust_secp_fuzz)))]
+    fn test_ecdsa_adaptor_signature_encrypt_prepared() {
+        let mut rng = thread_rng();
+        let (seckey, pubkey) = SECP256K1.generate_keypair(&mut rng);
+        let (_, enckey) = SECP256K1.generate_keypair(&mut rng);
+        let prepared = PreparedEncryptionKey::new(SECP256K1, &enckey);
+        assert_eq!(prepared.public_key(), enckey);
+
+        for i in 0..4u8 {
+            let msg = Message::from_slice(&[i + 1; 32]).unwrap();
+            let aux_rand = [i; 32];
+
+            let sig = EcdsaAdaptorSignature::encrypt_prepared_no_aux_rand(
+                SECP256K1, &msg, &seckey, &prepared,
+            );
+            let expected =
+                EcdsaAdaptorSignature::encrypt_no_aux_rand(SECP256K1, &msg, &seckey, &enckey);
+            assert_eq!(sig, expected);
+            assert!(sig.verify(SECP256K1, &msg, &pubkey, &enckey).is_ok());
+
+            let sig = EcdsaAdaptorSignature::encrypt_prepared_with_aux_rand(
+                SECP256K1, &msg, &seckey, &prepared, &aux_rand,
+            );
+            let expected = EcdsaAdaptorSignature::encrypt_with_aux_rand(
+                SECP256K1, &msg, &seckey, &enckey, &aux_rand,
+            );
+            assert_eq!(sig, expected);
+        }
+    }
+
+    #[test]
+    #[cfg(all(feature = "std", not(rust_secp_fuzz)))]
+    fn test_compute_attestation_points() {
+        let mut rng = thread_rng();
+        let oracle = Keypair::new(SECP256K1, &mut rng);
+        let (oracle_pk, _) = oracle.x_only_public_key();
+        let msgs = (0..3u8)
+            .map(|i| Message::from_slice(&[i + 1; 32]).unwrap())
+            .collect::<Vec<_>>();
+
+        // A single digit point is the public key of the oracle's attestation.
+        let sig = SECP256K1.sign_schnorr_no_aux_rand(&msgs[1], &oracle);
+        let nonce = XOnlyPublicKey::from_slice(&sig[..32]).unwrap();
+        let points = compute_attestation_points(SECP256K1, &oracle_pk, &[nonce], &msgs).unwrap();
+        assert_eq!(points.digit_points, points.outcome_points);
+        let points = points.outcome_points;
+        assert_eq!(points.len(), 3);
+        let attestation = SecretKey::from_slice(&sig[32..]).unwrap();
+        assert_eq!(
+            points[1],
+            PublicKey::from_secret_key(SECP256K1, &attestation)
+        );
+
+        // Outcome points are the sums of the digit points.
+        let nonces = (0..3)
+            .map(|_| Keypair::new(SECP256K1, &mut rng).x_only_public_key().0)
+            .collect::<Vec<_>>();
+        let digits = nonces
+            .iter()
+            .map(|nonce| {
+                compute_attestation_points(SECP256K1, &oracle_pk, &[*nonce], &msgs)
+                    .unwrap()
+                    .outcome_points
+            })
+            .collect::<Vec<_>>();
+        let points = compute_attestation_points(SECP256K1, &oracle_pk, &nonces, &msgs).unwrap();
+        assert_eq!(points.digit_points, digits.concat());
+        let points = points.outcome_points;
+        assert_eq!(points.len(), 27);
+        for (i, point) in points.iter().enumerate() {
+            let expected = PublicKey::combine_keys(&[
+                &digits[0][i / 9],
+                &digits[1][i / 3 % 3],
+                &digits[2][i % 3],
+            ])
+            .unwrap();
+            assert_eq!(*point, expected);
+        }
+
+        assert!(compute_attestation_points(SECP256K1, &oracle_pk, &[], &msgs).is_err());
+        assert!(compute_attestation_points(SECP256K1, &oracle_pk, &nonces, &msgs[..1]).is_err());
+        let too_many = vec![nonce; 64];
+        assert!(compute_attestation_points(SECP256K1, &oracle_pk, &too_many, &msgs).is_err());
+    }
+
     #[test]
     fn test_ecdsa_adaptor_signature_wrong_proof() {
         let msg = msg_from_str("8131e6f4b45754f2c90bd06688ceeabc0c45055460729928b4eecf11026a9e2d");
@@ -0,0 +1,126 @@
+use crate::ffi;
+#[cfg(all(unix, feature = "std"))]
+use crate::Error;
+use crate::{Context, Secp256k1};
+#[cfg(all(unix, feature = "std"))]
+use core::sync::atomic::{AtomicBool, Ordering};
+
+/// Describes the precomputed tables used for multiplications with the generator.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct EcmultTablesInfo {
+    /// The size of the tables in bytes.
+    pub size: usize,
+    /// The SHA256 of the tables, as stored in a table file.
+    pub checksum: [u8; 32],
+    /// The window size of the tables used for verification.
+    pub window: u32,
+}
+
+/// Whether [`load_ecmult_tables`] has replaced the compiled-in tables.
+#[cfg(all(unix, feature = "std"))]
+static TABLES_LOADED: AtomicBool = AtomicBool::new(false);
+
+/// The info of the compiled-in tables, which is only computed once as their checksum is the
+/// hash of about 1 MiB.
+#[cfg(feature = "std")]
+static BUILTIN_INFO_ONCE: std::sync::Once = std::sync::Once::new();
+#[cfg(feature = "std")]
+static mut BUILTIN_INFO: EcmultTablesInfo = EcmultTablesInfo {
+    size: 0,
+    checksum: [0; 32],
+    window: 0,
+};
+
+/// Returns the size, checksum and window size of the precomputed tables in use.
+///
+/// For the compiled-in tables, the checksum is the one of the table file `precompute_ecmult`
+/// writes for the same window size. Computing it hashes the tables, so with the `std` feature
+/// the result is computed on the first call only.
+pub fn ecmult_tables_info<C: Context>(secp: &Secp256k1<C>) -> EcmultTablesInfo {
+    #[cfg(all(unix, feature = "std"))]
+    {
+        // The checksum of loaded tables is stored with them, so this is cheap.
+        if TABLES_LOADED.load(Ordering::Acquire) {
+            return query_ecmult_tables_info(secp);
+        }
+    }
+    #[cfg(feature = "std")]
+    unsafe {
+        BUILTIN_INFO_ONCE.call_once(|| BUILTIN_INFO = query_ecmult_tables_info(secp));
+        return BUILTIN_INFO;
+    }
+    #[cfg(not(feature = "std"))]
+    return query_ecmult_tables_info(secp);
+}
+
+fn query_ecmult_tables_info<C: Context>(secp: &Secp256k1<C>) -> EcmultTablesInfo {
+    let mut info = EcmultTablesInfo {
+        size: 0,
+        checksum: [0; 32],
+        window: 0,
+    };
+
+    let ret = unsafe {
+        ffi::secp256k1_ecmult_tables_info(
+            secp.ctx().as_ptr(),
+            &mut info.size,
+            info.checksum.as_mut_ptr(),
+            &mut info.window,
+        )
+    };
+    assert_eq!(ret, 1);
+
+    info
+}
+
+/// Maps a table file written by `precompute_ecmult` and uses its tables from now on.
+///
+/// Tables can be loaded once per process; later calls return [`Error::InvalidEcmultTables`].
+/// Other threads may use this crate while the tables are loaded, and each operation uses either
+/// the compiled-in tables or the loaded ones. The file can hold tables with a larger window size
+/// than the compiled-in ones. It stays mapped
+/// until the process exits and is shared with all other processes mapping the same file. The
+/// tables are used by the functions of this crate; verification through the `secp256k1` crate is
+/// not affected.
+///
+/// The checksum in the file only detects corrupted files and files written for a different
+/// build. It does not authenticate the tables: the file is mapped, not copied, so whoever can
+/// write to it can change the tables after they were checked and make verification accept
+/// invalid signatures. Only load files that no untrusted user can write to.
+///
+/// # Safety
+///
+/// The file must not be modified while the process runs.
+#[cfg(all(unix, feature = "std"))]
+pub unsafe fn load_ecmult_tables<C: Context>(
+    secp: &Secp256k1<C>,
+    path: &std::path::Path,
+) -> Result<(), Error> {
+    use std::os::unix::ffi::OsStrExt;
+
+    let path = std::ffi::CString::new(path.as_os_str().as_bytes())
+        .map_err(|_| Error::InvalidEcmultTables)?;
+    let ret = ffi::secp256k1_ecmult_tables_mmap(secp.ctx().as_ptr(), path.as_ptr());
+
+    if ret == 1 {
+        TABLES_LOADED.store(true, Ordering::Release);
+        Ok(())
+    } else {
+        Err(Error::InvalidEcmultTables)
+    }
+}
+
+#[cfg(all(test, feature = "global-context"))]
+mod tests {
+    use super::*;
+    use crate::SECP256K1;
+
+    #[test]
+    fn test_ecmult_tables_info() {
+        let info = ecmult_tables_info(&SECP256K1);
+
+        assert!(info.window >= 2);
+        assert!(info.size >= 2 * (1 << (info.window - 2)) * 64);
+        assert_eq!(info, ecmult_tables_info(&SECP256K1));
+    }
+}
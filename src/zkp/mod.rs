@@ -1,26 +1,40 @@
+mod backends;
 mod ecdsa_adaptor;
+mod ecmult_tables;
 mod generator;
 #[cfg(feature = "std")]
 pub mod musig;
 #[cfg(feature = "std")]
-pub use self::musig::new_musig_nonce_pair;
+pub use self::musig::{new_musig_nonce_pair, new_musig_nonce_pairs};
 
 #[cfg(feature = "std")]
 mod pedersen;
 #[cfg(feature = "std")]
 mod rangeproof;
 #[cfg(feature = "std")]
+mod schnorrsig;
+#[cfg(feature = "std")]
+mod scratch;
+mod sign_table;
+#[cfg(feature = "std")]
 mod surjection_proof;
 mod tag;
 mod whitelist;
 
+pub use self::backends::*;
 pub use self::ecdsa_adaptor::*;
+pub use self::ecmult_tables::*;
 pub use self::generator::*;
 #[cfg(feature = "std")]
 pub use self::pedersen::*;
 #[cfg(feature = "std")]
 pub use self::rangeproof::*;
 #[cfg(feature = "std")]
+pub use self::schnorrsig::*;
+#[cfg(feature = "std")]
+pub use self::scratch::*;
+pub use self::sign_table::*;
+#[cfg(feature = "std")]
 pub use self::surjection_proof::*;
 pub use self::tag::*;
 pub use self::whitelist::*;
@@ -9,9 +9,12 @@
 //! for advanced use-cases. A full description of the C API usage along with security considerations
 //! can be found in [C-musig.md](secp256k1-sys/depend/secp256k1/src/modules/musig/musig.md).
 use core::fmt;
+use std::collections::VecDeque;
+use std::sync::Mutex;
 use {core, std};
 
 use crate::ffi::{self, CPtr};
+use crate::zkp::scratch::{with_thread_scratch, ScratchSpace};
 use crate::ZERO_TWEAK;
 use crate::{schnorr, Keypair, XOnlyPublicKey};
 use crate::{Message, PublicKey, Secp256k1, SecretKey, Tweak};
@@ -362,6 +365,214 @@ impl MusigKeyAggCache {
     }
 }
 
+/// Aggregates the public keys of a changing list of signers.
+///
+/// The builder keeps every key parsed and serialized, so that [`MusigKeyAggBuilder::agg`] only
+/// hashes the key list and computes the aggregate key. Adding or removing a signer changes the
+/// hash of the list and with it the coefficient of every key, so nothing else carries over from
+/// one aggregation to the next.
+#[derive(Debug, Clone, Default)]
+pub struct MusigKeyAggBuilder {
+    pub_keys: Vec<PublicKey>,
+    prepared: Vec<ffi::MusigPreparedPubkey>,
+}
+
+impl MusigKeyAggBuilder {
+    /// Creates a builder without keys.
+    pub fn new() -> Self {
+        MusigKeyAggBuilder::default()
+    }
+
+    /// Creates a builder with the keys in `pub_keys`.
+    pub fn from_pub_keys(pub_keys: &[PublicKey]) -> Self {
+        MusigKeyAggBuilder {
+            pub_keys: pub_keys.to_vec(),
+            prepared: pub_keys.iter().map(prepare_pub_key).collect(),
+        }
+    }
+
+    /// The keys in the order they are aggregated in.
+    pub fn pub_keys(&self) -> &[PublicKey] {
+        &self.pub_keys
+    }
+
+    /// The number of keys.
+    pub fn len(&self) -> usize {
+        self.pub_keys.len()
+    }
+
+    /// Whether there are no keys.
+    pub fn is_empty(&self) -> bool {
+        self.pub_keys.is_empty()
+    }
+
+    /// Appends a key.
+    pub fn push(&mut self, pub_key: PublicKey) {
+        self.prepared.push(prepare_pub_key(&pub_key));
+        self.pub_keys.push(pub_key);
+    }
+
+    /// Inserts a key at position `index`.
+    ///
+    /// # Panics
+    ///
+    /// If `index` is greater than the number of keys.
+    pub fn insert(&mut self, index: usize, pub_key: PublicKey) {
+        self.prepared.insert(index, prepare_pub_key(&pub_key));
+        self.pub_keys.insert(index, pub_key);
+    }
+
+    /// Removes and returns the key at position `index`.
+    ///
+    /// # Panics
+    ///
+    /// If `index` is out of bounds.
+    pub fn remove(&mut self, index: usize) -> PublicKey {
+        self.prepared.remove(index);
+        self.pub_keys.remove(index)
+    }
+
+    /// Aggregates the keys, with the same result as [`MusigKeyAggCache::new`].
+    ///
+    /// # Panics
+    ///
+    /// If there are no keys.
+    pub fn agg<C: Verification>(&self, secp: &Secp256k1<C>) -> MusigKeyAggCache {
+        assert!(!self.is_empty(), "no keys to aggregate");
+        let prepared_ptrs = self
+            .prepared
+            .iter()
+            .map(|p| p as *const _)
+            .collect::<Vec<_>>();
+        let mut key_agg_cache = ffi::MusigKeyAggCache::new();
+        let mut agg_pk = ffi::XOnlyPublicKey::new();
+        let ret = with_thread_scratch(|scratch| unsafe {
+            ffi::secp256k1_musig_pubkey_agg_prepared(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                &mut agg_pk,
+                &mut key_agg_cache,
+                prepared_ptrs.as_ptr(),
+                prepared_ptrs.len(),
+            )
+        });
+        assert_eq!(ret, 1);
+        MusigKeyAggCache(key_agg_cache, XOnlyPublicKey::from(agg_pk))
+    }
+
+    /// Returns an iterator over the aggregates of all subsets of `k` keys, for example to search
+    /// for a `k`-of-`n` signing set.
+    ///
+    /// The subsets are lists of `k` increasing positions into [`MusigKeyAggBuilder::pub_keys`]
+    /// in lexicographic order, and each is returned with the [`MusigKeyAggCache`] of its keys.
+    /// There are no subsets if `k` is zero or greater than the number of keys.
+    pub fn subsets<'a, C: Verification>(
+        &'a self,
+        secp: &'a Secp256k1<C>,
+        k: usize,
+    ) -> MusigKeyAggSubsets<'a, C> {
+        let n = self.len();
+        MusigKeyAggSubsets {
+            secp,
+            builder: self,
+            next: if k > 0 && k <= n {
+                (0..k).collect()
+            } else {
+                vec![n; k]
+            },
+            done: VecDeque::new(),
+        }
+    }
+}
+
+fn prepare_pub_key(pub_key: &PublicKey) -> ffi::MusigPreparedPubkey {
+    let mut prepared = ffi::MusigPreparedPubkey::new();
+    unsafe {
+        if ffi::secp256k1_musig_pubkey_prepare(
+            ffi::secp256k1_context_no_precomp,
+            &mut prepared,
+            pub_key.as_c_ptr(),
+        ) == 0
+        {
+            unreachable!("Impossible to construct an invalid PublicKey in safe rust")
+        }
+    }
+    prepared
+}
+
+/// The number of subsets [`MusigKeyAggSubsets`] aggregates at a time.
+const MUSIG_SUBSETS_PER_CALL: usize = 64;
+
+/// Iterator over the aggregates of subsets of keys, see [`MusigKeyAggBuilder::subsets`].
+pub struct MusigKeyAggSubsets<'a, C: Verification> {
+    secp: &'a Secp256k1<C>,
+    builder: &'a MusigKeyAggBuilder,
+    /// The next subset to aggregate, which is all `n` after the last one.
+    next: Vec<usize>,
+    done: VecDeque<(Vec<usize>, MusigKeyAggCache)>,
+}
+
+impl<'a, C: Verification> MusigKeyAggSubsets<'a, C> {
+    fn aggregate_more(&mut self) {
+        let prepared = self
+            .builder
+            .prepared
+            .iter()
+            .map(|p| p as *const _)
+            .collect::<Vec<_>>();
+        let n = prepared.len();
+        let mut subset = self.next.clone();
+        let mut key_agg_caches = vec![ffi::MusigKeyAggCache::new(); MUSIG_SUBSETS_PER_CALL];
+        let mut agg_pks = vec![ffi::XOnlyPublicKey::new(); MUSIG_SUBSETS_PER_CALL];
+        let mut n_subsets = MUSIG_SUBSETS_PER_CALL;
+        let secp = self.secp;
+        let next = &mut self.next;
+        let ret = with_thread_scratch(|scratch| unsafe {
+            ffi::secp256k1_musig_pubkey_agg_subsets(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                agg_pks.as_mut_ptr(),
+                key_agg_caches.as_mut_ptr(),
+                &mut n_subsets,
+                next.as_mut_ptr(),
+                next.len(),
+                prepared.as_ptr(),
+                n,
+            )
+        });
+        assert_eq!(ret, 1);
+        for (key_agg_cache, agg_pk) in key_agg_caches.into_iter().zip(agg_pks).take(n_subsets) {
+            self.done.push_back((
+                subset.clone(),
+                MusigKeyAggCache(key_agg_cache, XOnlyPublicKey::from(agg_pk)),
+            ));
+            next_subset(&mut subset, n);
+        }
+    }
+}
+
+/// Advances `subset` to the next subset of the same size of `0..n` in lexicographic order.
+fn next_subset(subset: &mut [usize], n: usize) {
+    let k = subset.len();
+    if let Some(pos) = (0..k).rev().find(|&i| subset[i] != n - k + i) {
+        subset[pos] += 1;
+        for i in pos + 1..k {
+            subset[i] = subset[i - 1] + 1;
+        }
+    }
+}
+
+impl<'a, C: Verification> Iterator for MusigKeyAggSubsets<'a, C> {
+    type Item = (Vec<usize>, MusigKeyAggCache);
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.done.is_empty() && self.next.first().map_or(false, |&i| i < self.builder.len()) {
+            self.aggregate_more();
+        }
+        self.done.pop_front()
+    }
+}
+
 /// Musig tweaking related errors.
 #[derive(Debug, Clone, Copy, Eq, PartialEq, PartialOrd, Ord, Hash)]
 pub enum MusigTweakErr {
@@ -508,6 +719,160 @@ pub fn new_musig_nonce_pair<C: Signing>(
     }
 }
 
+/// Generates a nonce pair for every session id in `session_ids`, for the signer with the
+/// given keys.
+///
+/// Every pair is the same as the one [`new_musig_nonce_pair`] returns for its session id
+/// without a key aggregation cache and message, but the public nonces are computed together,
+/// which is faster than generating them one by one. Use this to generate nonces before the
+/// sessions they are used in are known, as [`MusigNoncePool`] does. The rules for
+/// `session_id` of [`new_musig_nonce_pair`] apply to every session id.
+///
+/// # Errors:
+///
+/// * `ZeroSession`: if one of the session ids is all zeros and no `sec_key` is given.
+pub fn new_musig_nonce_pairs<C: Signing>(
+    secp: &Secp256k1<C>,
+    session_ids: Vec<MusigSessionId>,
+    sec_key: Option<SecretKey>,
+    pub_key: PublicKey,
+    extra_rand: Option<[u8; 32]>,
+) -> Result<Vec<(MusigSecNonce, MusigPubNonce)>, MusigNonceGenError> {
+    let extra_ptr = extra_rand
+        .as_ref()
+        .map(|e| e.as_ptr())
+        .unwrap_or(core::ptr::null());
+    let sk_ptr = sec_key
+        .as_ref()
+        .map(|e| e.as_c_ptr())
+        .unwrap_or(core::ptr::null());
+    let session_id_ptrs = session_ids
+        .iter()
+        .map(|id| id.0.as_ptr())
+        .collect::<Vec<_>>();
+    let mut sec_nonces = vec![ffi::MusigSecNonce::new(); session_ids.len()];
+    let mut pub_nonces = vec![ffi::MusigPubNonce::new(); session_ids.len()];
+    unsafe {
+        if ffi::secp256k1_musig_nonce_gen_batch(
+            secp.ctx().as_ptr(),
+            sec_nonces.as_mut_ptr(),
+            pub_nonces.as_mut_ptr(),
+            session_id_ptrs.as_ptr(),
+            sk_ptr,
+            pub_key.as_c_ptr(),
+            extra_ptr,
+            session_ids.len(),
+        ) == 0
+        {
+            // As in new_musig_nonce_pair, this can only happen when a session id is all zeros.
+            // The library has invalidated the secret nonces.
+            Err(MusigNonceGenError::ZeroSession)
+        } else {
+            Ok(sec_nonces
+                .into_iter()
+                .map(MusigSecNonce)
+                .zip(pub_nonces.into_iter().map(MusigPubNonce))
+                .collect())
+        }
+    }
+}
+
+/// A queue of nonce pairs of one signer that are generated ahead of the sessions they are
+/// used in, so that starting a session does not wait for nonce generation.
+///
+/// The nonces are bound to the signer's key and their session id when they are generated,
+/// by [`new_musig_nonce_pairs`]. [`MusigNoncePool::take`] removes a pair from the pool, so
+/// every pair is handed out at most once, and the secret nonce is consumed when signing. As
+/// the pool can be shared between threads, one thread can keep it filled with
+/// [`MusigNoncePool::refill`] while others take nonces.
+///
+/// Since the message and the aggregate public key are not known in advance, they are not
+/// used to derive the nonces, which is why the session ids must be uniformly random.
+pub struct MusigNoncePool {
+    sec_key: Option<SecretKey>,
+    pub_key: PublicKey,
+    nonces: Mutex<VecDeque<(MusigSecNonce, MusigPubNonce)>>,
+}
+
+impl MusigNoncePool {
+    /// Creates an empty pool for the signer with the public key `pub_key`. Provide its
+    /// `sec_key` for maximal misuse resistance.
+    pub fn new(sec_key: Option<SecretKey>, pub_key: PublicKey) -> MusigNoncePool {
+        MusigNoncePool {
+            sec_key,
+            pub_key,
+            nonces: Mutex::new(VecDeque::new()),
+        }
+    }
+
+    /// The public key the nonces of this pool can sign for.
+    pub fn pub_key(&self) -> PublicKey {
+        self.pub_key
+    }
+
+    /// The number of nonce pairs in the pool.
+    pub fn len(&self) -> usize {
+        self.nonces.lock().unwrap().len()
+    }
+
+    /// Whether the pool is empty.
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Adds a nonce pair for every session id in `session_ids` to the pool, see
+    /// [`new_musig_nonce_pairs`]. The nonces are generated before the pool is locked, so
+    /// taking nonces is not held up meanwhile.
+    ///
+    /// # Errors:
+    ///
+    /// * `ZeroSession`: if one of the session ids is all zeros and the pool has no secret
+    /// key. No nonces are added in this case.
+    pub fn refill<C: Signing>(
+        &self,
+        secp: &Secp256k1<C>,
+        session_ids: Vec<MusigSessionId>,
+        extra_rand: Option<[u8; 32]>,
+    ) -> Result<(), MusigNonceGenError> {
+        let pairs =
+            new_musig_nonce_pairs(secp, session_ids, self.sec_key, self.pub_key, extra_rand)?;
+        self.nonces.lock().unwrap().extend(pairs);
+        Ok(())
+    }
+
+    /// Adds nonce pairs with random session ids from the thread local rng until the pool
+    /// holds at least `len` pairs. Unlike [`MusigNoncePool::refill`], the pool stays locked
+    /// while the nonces are generated, so that concurrent calls do not add more pairs than
+    /// needed.
+    #[cfg(feature = "rand-std")]
+    #[cfg_attr(docsrs, doc(cfg(feature = "rand-std")))]
+    pub fn refill_to<C: Signing>(&self, secp: &Secp256k1<C>, len: usize) {
+        let mut nonces = self.nonces.lock().unwrap();
+        let missing = len.saturating_sub(nonces.len());
+        let session_ids = (0..missing).map(|_| MusigSessionId::random()).collect();
+        let pairs = new_musig_nonce_pairs(secp, session_ids, self.sec_key, self.pub_key, None)
+            .expect("random session ids are not zero");
+        nonces.extend(pairs);
+    }
+
+    /// Removes the oldest nonce pair from the pool and returns it, or `None` if the pool is
+    /// empty. The public nonce is sent to the other signers of the session and the secret
+    /// nonce is used to sign in that session only.
+    pub fn take(&self) -> Option<(MusigSecNonce, MusigPubNonce)> {
+        self.nonces.lock().unwrap().pop_front()
+    }
+}
+
+impl fmt::Debug for MusigNoncePool {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        // Neither the secret key nor the secret nonces are printed.
+        f.debug_struct("MusigNoncePool")
+            .field("pub_key", &self.pub_key)
+            .field("len", &self.len())
+            .finish()
+    }
+}
+
 /// A Musig partial signature.
 #[derive(Debug, Clone, Copy, Eq, PartialEq)]
 pub struct MusigPartialSignature(ffi::MusigPartialSignature);
@@ -1077,6 +1442,57 @@ impl MusigAggNonce {
         }
     }
 
+    /// Combine the public nonces of each of many sessions into an aggregated nonce per session.
+    ///
+    /// The result is the same as calling [`MusigAggNonce::new`] on every element of
+    /// `sessions`, but the aggregated nonces of all sessions are normalized together, which
+    /// makes this faster for a party that coordinates many sessions.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a session has no nonces.
+    pub fn new_batch<C: Signing>(secp: &Secp256k1<C>, sessions: &[&[MusigPubNonce]]) -> Vec<Self> {
+        with_thread_scratch(|scratch| {
+            MusigAggNonce::new_batch_with_scratch(secp, scratch, sessions)
+        })
+    }
+
+    /// Like [`MusigAggNonce::new_batch`], but with the temporary data in `scratch` instead of
+    /// the scratch space of the current thread.
+    pub fn new_batch_with_scratch<C: Signing>(
+        secp: &Secp256k1<C>,
+        scratch: &mut ScratchSpace,
+        sessions: &[&[MusigPubNonce]],
+    ) -> Vec<Self> {
+        assert!(
+            sessions.iter().all(|nonces| !nonces.is_empty()),
+            "every session needs at least one nonce"
+        );
+        let mut aggnonces = vec![ffi::MusigAggNonce::new(); sessions.len()];
+        let nonce_ptrs = sessions
+            .iter()
+            .flat_map(|nonces| nonces.iter().map(|n| n.as_ptr()))
+            .collect::<Vec<_>>();
+        let n_nonces = sessions
+            .iter()
+            .map(|nonces| nonces.len())
+            .collect::<Vec<_>>();
+        unsafe {
+            if ffi::secp256k1_musig_nonce_agg_batch(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                aggnonces.as_mut_ptr(),
+                nonce_ptrs.as_ptr(),
+                n_nonces.as_ptr(),
+                sessions.len(),
+            ) == 0
+            {
+                unreachable!("Public key nonces are well-formed and valid in rust typesystem")
+            }
+        }
+        aggnonces.into_iter().map(MusigAggNonce).collect()
+    }
+
     /// Serialize a MusigAggNonce into a 66 bytes array.
     pub fn serialize(&self) -> [u8; ffi::MUSIG_AGGNONCE_SERIALIZED_LEN] {
         let mut data = [0; ffi::MUSIG_AGGNONCE_SERIALIZED_LEN];
@@ -1731,6 +2147,111 @@ impl MusigSession {
         }
     }
 
+    /// Produces the partial signatures of one signer for many blinded sessions at once.
+    ///
+    /// Session `i` is signed with `sec_nonces[i]` like [`MusigSession::blinded_partial_sign`],
+    /// or like [`MusigSession::blinded_partial_sign_without_keyaggcoeff`] if `key_agg_coef` is
+    /// `None`, but the key pair is loaded and multiplied by the key aggregation coefficient
+    /// only once. All partial signatures are then verified against `pub_nonces` together,
+    /// which is much faster than verifying them one by one, so that a computation error can't
+    /// leak the secret key.
+    ///
+    /// All secret nonces are consumed, even if signing fails.
+    ///
+    /// # Errors:
+    ///
+    /// - [`MusigSignError::NonceReuse`] if a secret nonce was already used, in which case
+    /// nothing is signed
+    /// - [`MusigSignError::PartialSignatureInvalid`] if a partial signature does not verify,
+    /// which means that a public nonce does not belong to the secret nonce of its session
+    ///
+    /// # Panics
+    ///
+    /// Panics if the numbers of sessions and nonces differ, or if a secret nonce was not
+    /// generated for `keypair`.
+    pub fn blinded_partial_sign_batch<C: Signing>(
+        secp: &Secp256k1<C>,
+        sessions: &[MusigSession],
+        sec_nonces: Vec<MusigSecNonce>,
+        pub_nonces: &[MusigPubNonce],
+        keypair: &Keypair,
+        key_agg_coef: Option<&MusigKeyAggCoef>,
+        negate_seckey: bool,
+    ) -> Result<Vec<MusigPartialSignature>, MusigSignError> {
+        with_thread_scratch(|scratch| {
+            MusigSession::blinded_partial_sign_batch_with_scratch(
+                secp,
+                scratch,
+                sessions,
+                sec_nonces,
+                pub_nonces,
+                keypair,
+                key_agg_coef,
+                negate_seckey,
+            )
+        })
+    }
+
+    /// Like [`MusigSession::blinded_partial_sign_batch`], but with the temporary data in
+    /// `scratch` instead of the scratch space of the current thread.
+    pub fn blinded_partial_sign_batch_with_scratch<C: Signing>(
+        secp: &Secp256k1<C>,
+        scratch: &mut ScratchSpace,
+        sessions: &[MusigSession],
+        sec_nonces: Vec<MusigSecNonce>,
+        pub_nonces: &[MusigPubNonce],
+        keypair: &Keypair,
+        key_agg_coef: Option<&MusigKeyAggCoef>,
+        negate_seckey: bool,
+    ) -> Result<Vec<MusigPartialSignature>, MusigSignError> {
+        assert_eq!(sessions.len(), sec_nonces.len());
+        assert_eq!(sessions.len(), pub_nonces.len());
+        // Signing zeroes both scalars of a secret nonce, which follow its 4-byte magic.
+        // Rejecting used nonces here leaves a failed verification as the only reason
+        // for the batch to fail below.
+        if sec_nonces
+            .iter()
+            .any(|nonce| nonce.0 .0[4..68].iter().fold(0, |acc, b| acc | b) == 0)
+        {
+            return Err(MusigSignError::NonceReuse);
+        }
+        let n = sessions.len();
+        let sessions = sessions.iter().map(|s| s.0).collect::<Vec<_>>();
+        let pub_nonces = pub_nonces.iter().map(|nonce| nonce.0).collect::<Vec<_>>();
+        let mut sec_nonces = sec_nonces
+            .into_iter()
+            .map(|nonce| nonce.0)
+            .collect::<Vec<_>>();
+        let mut partial_sigs = vec![ffi::MusigPartialSignature::new(); n];
+        let coef_ptr = key_agg_coef
+            .map(|c| c.as_ptr())
+            .unwrap_or(core::ptr::null());
+        let negation = if negate_seckey { 1 } else { 0 };
+        unsafe {
+            if ffi::secp256k1_blinded_musig_partial_sign_batch(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                partial_sigs.as_mut_ptr(),
+                sec_nonces.as_mut_ptr(),
+                keypair.as_c_ptr(),
+                sessions.as_ptr(),
+                pub_nonces.as_ptr(),
+                coef_ptr,
+                negation,
+                n,
+            ) == 0
+            {
+                // Used secret nonces were rejected above and the other arguments are valid
+                // in safe rust, so the partial signatures did not verify.
+                return Err(MusigSignError::PartialSignatureInvalid);
+            }
+        }
+        Ok(partial_sigs
+            .into_iter()
+            .map(MusigPartialSignature)
+            .collect())
+    }
+
     /// Checks that an individual partial signature verifies
     ///
     /// This function is essential when using protocols with adaptor signatures.
@@ -1829,6 +2350,32 @@ impl MusigSession {
         }
     }
 
+    /// Checks that an individual partial signature verifies, like
+    /// [`MusigSession::partial_verify`], but with the signer's public key taken from a
+    /// [`MusigSignerTable`]. This is faster than [`MusigSession::partial_verify`].
+    ///
+    /// Returns `false` if the table was created for a different list of keys than
+    /// `key_agg_cache`.
+    pub fn partial_verify_with_table<C: Signing>(
+        &self,
+        secp: &Secp256k1<C>,
+        key_agg_cache: &MusigKeyAggCache,
+        partial_sig: MusigPartialSignature,
+        pub_nonce: MusigPubNonce,
+        table: &MusigSignerTable,
+    ) -> bool {
+        unsafe {
+            ffi::secp256k1_musig_partial_sig_verify_table(
+                secp.ctx().as_ptr(),
+                partial_sig.as_ptr(),
+                pub_nonce.as_ptr(),
+                &*table.0,
+                key_agg_cache.as_ptr(),
+                self.as_ptr(),
+            ) == 1
+        }
+    }
+
     /// Checks that an individual partial signature verifies
     pub fn blinded_musig_partial_sig_verify<C: Signing>(
         &self,
@@ -2016,6 +2563,184 @@ impl MusigSession {
     }
 }
 
+/// A [`MusigSession`] together with its [`MusigKeyAggCache`] in the form the library computes
+/// with.
+///
+/// Signing, verifying partial signatures and aggregating them with a [`MusigSession`] parses
+/// the session and the key aggregation cache on every call. An expanded session does this once,
+/// which saves the parsing when many partial signatures of the same session are verified, for
+/// example by a coordinator. A session expanded with [`MusigExpandedSession::for_signer`]
+/// additionally holds the signer's key aggregation coefficient, so
+/// [`MusigExpandedSession::partial_sign`] with that signer's keypair skips hashing the key list
+/// again. Its contents are only meaningful to the running process, so it has
+/// no serialization; keep the [`MusigSession`] for that.
+#[derive(Debug, Clone, Copy)]
+pub struct MusigExpandedSession(ffi::MusigExpandedSession);
+
+impl MusigExpandedSession {
+    /// Expands `session`, which must have been created with `key_agg_cache`.
+    pub fn new(session: &MusigSession, key_agg_cache: &MusigKeyAggCache) -> Self {
+        Self::expand(session, key_agg_cache, core::ptr::null())
+    }
+
+    /// Expands `session` like [`MusigExpandedSession::new`], and caches the key aggregation
+    /// coefficient of `pub_key` for signing with the matching keypair.
+    pub fn for_signer(
+        session: &MusigSession,
+        key_agg_cache: &MusigKeyAggCache,
+        pub_key: &PublicKey,
+    ) -> Self {
+        Self::expand(session, key_agg_cache, pub_key.as_c_ptr())
+    }
+
+    fn expand(
+        session: &MusigSession,
+        key_agg_cache: &MusigKeyAggCache,
+        signer: *const ffi::PublicKey,
+    ) -> Self {
+        let mut expanded = MusigExpandedSession(ffi::MusigExpandedSession::new());
+        unsafe {
+            if ffi::secp256k1_musig_session_expand(
+                ffi::secp256k1_context_no_precomp,
+                &mut expanded.0,
+                key_agg_cache.as_ptr(),
+                session.as_ptr(),
+                signer,
+            ) == 0
+            {
+                unreachable!("Well-typed and valid arguments to the function")
+            }
+        }
+        expanded
+    }
+
+    /// Returns the session this was expanded from.
+    pub fn session(&self) -> MusigSession {
+        let mut session = MusigSession(ffi::MusigSession::new());
+        unsafe {
+            if ffi::secp256k1_musig_expanded_session_get(
+                ffi::secp256k1_context_no_precomp,
+                core::ptr::null_mut(),
+                session.as_mut_ptr(),
+                &self.0,
+            ) == 0
+            {
+                unreachable!("Well-typed and valid arguments to the function")
+            }
+        }
+        session
+    }
+
+    /// Produces a partial signature like [`MusigSession::partial_sign`].
+    ///
+    /// # Errors:
+    ///
+    /// - If the provided [`MusigSecNonce`] has already been used for signing
+    pub fn partial_sign<C: Signing>(
+        &self,
+        secp: &Secp256k1<C>,
+        mut secnonce: MusigSecNonce,
+        keypair: &Keypair,
+    ) -> Result<MusigPartialSignature, MusigSignError> {
+        unsafe {
+            let mut partial_sig = MusigPartialSignature(ffi::MusigPartialSignature::new());
+            if ffi::secp256k1_musig_partial_sign_expanded(
+                secp.ctx().as_ptr(),
+                partial_sig.as_mut_ptr(),
+                secnonce.as_mut_ptr(),
+                keypair.as_c_ptr(),
+                &self.0,
+            ) == 0
+            {
+                Err(MusigSignError::NonceReuse)
+            } else {
+                Ok(partial_sig)
+            }
+        }
+    }
+
+    /// Checks that an individual partial signature verifies, like
+    /// [`MusigSession::partial_verify`].
+    pub fn partial_verify<C: Signing>(
+        &self,
+        secp: &Secp256k1<C>,
+        partial_sig: MusigPartialSignature,
+        pub_nonce: MusigPubNonce,
+        pub_key: PublicKey,
+    ) -> bool {
+        unsafe {
+            ffi::secp256k1_musig_partial_sig_verify_expanded(
+                secp.ctx().as_ptr(),
+                partial_sig.as_ptr(),
+                pub_nonce.as_ptr(),
+                pub_key.as_c_ptr(),
+                &self.0,
+            ) == 1
+        }
+    }
+
+    /// Aggregates partial signatures like [`MusigSession::partial_sig_agg`].
+    pub fn partial_sig_agg(&self, partial_sigs: &[MusigPartialSignature]) -> schnorr::Signature {
+        let part_sigs = partial_sigs.iter().map(|s| s.as_ptr()).collect::<Vec<_>>();
+        let mut sig = [0u8; 64];
+        unsafe {
+            if ffi::secp256k1_musig_partial_sig_agg_expanded(
+                ffi::secp256k1_context_no_precomp,
+                sig.as_mut_ptr(),
+                &self.0,
+                part_sigs.as_ptr(),
+                part_sigs.len(),
+            ) == 0
+            {
+                unreachable!("Impossible to construct invalid(not well-typed) partial signatures")
+            } else {
+                schnorr::Signature::from_slice(&sig)
+                    .expect("Resulting signature must be well-typed")
+            }
+        }
+    }
+}
+
+/// Precomputed multiples of a signer's public key for verifying its partial signatures with
+/// [`MusigSession::partial_verify_with_table`].
+///
+/// A table depends on the signer's key and on the list of keys aggregated into the
+/// [`MusigKeyAggCache`], but not on tweaks, so one table serves all sessions of the same
+/// signers. It takes about 33 kB.
+#[derive(Clone)]
+pub struct MusigSignerTable(Box<ffi::MusigSignerTable>);
+
+impl MusigSignerTable {
+    /// Creates the table of `pub_key`, which must be one of the keys aggregated into
+    /// `key_agg_cache`.
+    pub fn new<C: Verification>(
+        secp: &Secp256k1<C>,
+        key_agg_cache: &MusigKeyAggCache,
+        pub_key: PublicKey,
+    ) -> Self {
+        let mut table = Box::new(ffi::MusigSignerTable::new());
+        unsafe {
+            if ffi::secp256k1_musig_signer_table_create(
+                secp.ctx().as_ptr(),
+                &mut *table,
+                pub_key.as_c_ptr(),
+                key_agg_cache.as_ptr(),
+            ) == 0
+            {
+                // Only fails with negligible probability for valid arguments.
+                unreachable!("Well-typed and valid arguments to the function")
+            }
+        }
+        MusigSignerTable(table)
+    }
+}
+
+impl fmt::Debug for MusigSignerTable {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        f.debug_struct("MusigSignerTable").finish()
+    }
+}
+
 /// Musig Signing errors
 #[derive(Debug, Clone, Copy, Eq, PartialEq, PartialOrd, Ord, Hash)]
 pub enum MusigSignError {
@@ -2025,6 +2750,8 @@ pub enum MusigSignError {
     // Note: Because of the current borrowing rules around nonce, this should be impossible.
     // Maybe, we can just unwrap this and not have error at all?
     NonceReuse,
+    /// A partial signature did not verify against the public nonce it was created for.
+    PartialSignatureInvalid,
 }
 
 #[cfg(feature = "std")]
@@ -2034,6 +2761,9 @@ impl fmt::Display for MusigSignError {
     fn fmt(&self, f: &mut fmt::Formatter) -> Result<(), fmt::Error> {
         match self {
             MusigSignError::NonceReuse => write!(f, "Musig signing nonce re-used"),
+            MusigSignError::PartialSignatureInvalid => {
+                write!(f, "Musig partial signature does not verify")
+            }
         }
     }
 }
@@ -2072,4 +2802,373 @@ mod tests {
 
         assert_eq!(parsed_pubnonce, pubnonce);
     }
+
+    #[test]
+    fn test_nonce_pool() {
+        let secp = Secp256k1::new();
+        let mut sec_bytes = [0; 32];
+        thread_rng().fill_bytes(&mut sec_bytes);
+        let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+        let pub_key = PublicKey::from_secret_key(&secp, &sec_key);
+
+        // Generating nonces together gives the same nonces as generating them one by one.
+        let ids = (1..40u8).map(|i| [i; 32]).collect::<Vec<_>>();
+        let pairs = new_musig_nonce_pairs(
+            &secp,
+            ids.iter()
+                .map(|id| MusigSessionId::assume_unique_per_nonce_gen(*id))
+                .collect(),
+            Some(sec_key),
+            pub_key,
+            None,
+        )
+        .unwrap();
+        assert_eq!(pairs.len(), ids.len());
+        for (id, (sec_nonce, pub_nonce)) in ids.iter().zip(pairs) {
+            let session_id = MusigSessionId::assume_unique_per_nonce_gen(*id);
+            let expected =
+                new_musig_nonce_pair(&secp, session_id, None, Some(sec_key), pub_key, None, None)
+                    .unwrap();
+            assert_eq!((sec_nonce, pub_nonce), expected);
+        }
+
+        let pool = MusigNoncePool::new(None, pub_key);
+        let zero = vec![
+            MusigSessionId::random(),
+            MusigSessionId::assume_unique_per_nonce_gen([0; 32]),
+        ];
+        assert_eq!(
+            pool.refill(&secp, zero, None),
+            Err(MusigNonceGenError::ZeroSession)
+        );
+        assert!(pool.is_empty());
+
+        pool.refill_to(&secp, 20);
+        assert_eq!(pool.len(), 20);
+        pool.refill_to(&secp, 10);
+        assert_eq!(pool.len(), 20);
+        assert_eq!(
+            format!("{:?}", pool),
+            format!("MusigNoncePool {{ pub_key: {:?}, len: 20 }}", pub_key)
+        );
+        let (_, first) = pool.take().unwrap();
+        let mut pub_nonces = vec![first];
+        while let Some((_, pub_nonce)) = pool.take() {
+            assert!(!pub_nonces.contains(&pub_nonce));
+            pub_nonces.push(pub_nonce);
+        }
+        assert_eq!(pub_nonces.len(), 20);
+    }
+
+    #[test]
+    fn test_aggnonce_batch() {
+        let secp = Secp256k1::new();
+        let mut sec_bytes = [0; 32];
+        thread_rng().fill_bytes(&mut sec_bytes);
+        let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+        let pub_key = PublicKey::from_secret_key(&secp, &sec_key);
+        let pool = MusigNoncePool::new(Some(sec_key), pub_key);
+        pool.refill_to(&secp, 100);
+        let pub_nonces = (0..100).map(|_| pool.take().unwrap().1).collect::<Vec<_>>();
+
+        let sessions = pub_nonces.chunks(3).collect::<Vec<_>>();
+        let aggnonces = MusigAggNonce::new_batch(&secp, &sessions);
+        assert_eq!(aggnonces.len(), sessions.len());
+        for (aggnonce, nonces) in aggnonces.iter().zip(&sessions) {
+            assert_eq!(*aggnonce, MusigAggNonce::new(&secp, nonces));
+        }
+        assert!(MusigAggNonce::new_batch(&secp, &[]).is_empty());
+    }
+
+    #[test]
+    fn test_expanded_session() {
+        let secp = Secp256k1::new();
+        let mut sec_keys = Vec::new();
+        let mut pub_keys = Vec::new();
+        for _ in 0..3 {
+            let mut sec_bytes = [0; 32];
+            thread_rng().fill_bytes(&mut sec_bytes);
+            let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+            pub_keys.push(PublicKey::from_secret_key(&secp, &sec_key));
+            sec_keys.push(sec_key);
+        }
+        let key_agg_cache = MusigKeyAggCache::new(&secp, &pub_keys);
+        let msg = Message::from_slice(&[7; 32]).unwrap();
+        let mut sec_nonces = Vec::new();
+        let mut pub_nonces = Vec::new();
+        for pub_key in &pub_keys {
+            let mut session_id = [0; 32];
+            thread_rng().fill_bytes(&mut session_id);
+            let session_id = MusigSessionId::assume_unique_per_nonce_gen(session_id);
+            let (sec_nonce, pub_nonce) = key_agg_cache
+                .nonce_gen(&secp, session_id, *pub_key, msg, None)
+                .unwrap();
+            sec_nonces.push(sec_nonce);
+            pub_nonces.push(pub_nonce);
+        }
+        let agg_nonce = MusigAggNonce::new(&secp, &pub_nonces);
+        let session = MusigSession::new(&secp, &key_agg_cache, agg_nonce, msg);
+        let expanded = MusigExpandedSession::new(&session, &key_agg_cache);
+        assert_eq!(expanded.session(), session);
+
+        let mut partial_sigs = Vec::new();
+        for (i, sec_nonce) in sec_nonces.into_iter().enumerate() {
+            let keypair = Keypair::from_secret_key(&secp, &sec_keys[i]);
+            let copy = MusigSecNonce::from_slice(sec_nonce.serialize());
+            let signer_copy = MusigSecNonce::from_slice(sec_nonce.serialize());
+            let partial_sig = expanded.partial_sign(&secp, sec_nonce, &keypair).unwrap();
+            assert_eq!(
+                session.partial_sign(&secp, copy, &keypair, &key_agg_cache),
+                Ok(partial_sig)
+            );
+            let for_signer =
+                MusigExpandedSession::for_signer(&session, &key_agg_cache, &pub_keys[i]);
+            assert_eq!(
+                for_signer.partial_sign(&secp, signer_copy, &keypair),
+                Ok(partial_sig)
+            );
+            assert!(expanded.partial_verify(&secp, partial_sig, pub_nonces[i], pub_keys[i]));
+            assert!(!expanded.partial_verify(
+                &secp,
+                partial_sig,
+                pub_nonces[i],
+                pub_keys[(i + 1) % 3]
+            ));
+            partial_sigs.push(partial_sig);
+        }
+        let sig = expanded.partial_sig_agg(&partial_sigs);
+        assert_eq!(sig, session.partial_sig_agg(&partial_sigs));
+        assert!(secp
+            .verify_schnorr(&sig, &msg, &key_agg_cache.agg_pk())
+            .is_ok());
+    }
+
+    #[test]
+    fn test_key_agg_builder() {
+        let secp = Secp256k1::new();
+        let pub_keys = (0..6)
+            .map(|_| {
+                let mut sec_bytes = [0; 32];
+                thread_rng().fill_bytes(&mut sec_bytes);
+                let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+                PublicKey::from_secret_key(&secp, &sec_key)
+            })
+            .collect::<Vec<_>>();
+
+        let mut builder = MusigKeyAggBuilder::from_pub_keys(&pub_keys[..5]);
+        assert_eq!(
+            builder.agg(&secp),
+            MusigKeyAggCache::new(&secp, &pub_keys[..5])
+        );
+        builder.push(pub_keys[5]);
+        assert_eq!(builder.agg(&secp), MusigKeyAggCache::new(&secp, &pub_keys));
+        assert_eq!(builder.remove(2), pub_keys[2]);
+        let mut without = pub_keys.clone();
+        without.remove(2);
+        assert_eq!(builder.agg(&secp), MusigKeyAggCache::new(&secp, &without));
+        builder.insert(2, pub_keys[2]);
+        assert_eq!(builder.pub_keys(), &pub_keys[..]);
+
+        let subsets = builder.subsets(&secp, 4).collect::<Vec<_>>();
+        assert_eq!(subsets.len(), 15);
+        for (indices, key_agg_cache) in &subsets {
+            let keys = indices.iter().map(|&i| pub_keys[i]).collect::<Vec<_>>();
+            assert_eq!(*key_agg_cache, MusigKeyAggCache::new(&secp, &keys));
+        }
+        assert_eq!(subsets[0].0, vec![0, 1, 2, 3]);
+        assert_eq!(subsets[14].0, vec![2, 3, 4, 5]);
+
+        let builder = MusigKeyAggBuilder::from_pub_keys(&pub_keys.repeat(20));
+        assert_eq!(builder.subsets(&secp, 2).count(), 120 * 119 / 2);
+        assert_eq!(builder.subsets(&secp, 0).count(), 0);
+        assert_eq!(builder.subsets(&secp, 121).count(), 0);
+    }
+
+    #[test]
+    fn test_signer_table() {
+        let secp = Secp256k1::new();
+        let mut sec_keys = Vec::new();
+        let mut pub_keys = Vec::new();
+        for _ in 0..3 {
+            let mut sec_bytes = [0; 32];
+            thread_rng().fill_bytes(&mut sec_bytes);
+            let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+            pub_keys.push(PublicKey::from_secret_key(&secp, &sec_key));
+            sec_keys.push(sec_key);
+        }
+        let mut key_agg_cache = MusigKeyAggCache::new(&secp, &pub_keys);
+        let tables = pub_keys
+            .iter()
+            .map(|pub_key| MusigSignerTable::new(&secp, &key_agg_cache, *pub_key))
+            .collect::<Vec<_>>();
+        // Tables do not depend on tweaks.
+        let tweak = SecretKey::from_slice(&[3; 32]).unwrap();
+        key_agg_cache.pubkey_xonly_tweak_add(&secp, tweak).unwrap();
+
+        let msg = Message::from_slice(&[7; 32]).unwrap();
+        let mut sec_nonces = Vec::new();
+        let mut pub_nonces = Vec::new();
+        for pub_key in &pub_keys {
+            let mut session_id = [0; 32];
+            thread_rng().fill_bytes(&mut session_id);
+            let session_id = MusigSessionId::assume_unique_per_nonce_gen(session_id);
+            let (sec_nonce, pub_nonce) = key_agg_cache
+                .nonce_gen(&secp, session_id, *pub_key, msg, None)
+                .unwrap();
+            sec_nonces.push(sec_nonce);
+            pub_nonces.push(pub_nonce);
+        }
+        let agg_nonce = MusigAggNonce::new(&secp, &pub_nonces);
+        let session = MusigSession::new(&secp, &key_agg_cache, agg_nonce, msg);
+        let mut partial_sigs = Vec::new();
+        for (i, sec_nonce) in sec_nonces.into_iter().enumerate() {
+            let keypair = Keypair::from_secret_key(&secp, &sec_keys[i]);
+            let partial_sig = session
+                .partial_sign(&secp, sec_nonce, &keypair, &key_agg_cache)
+                .unwrap();
+            for (j, table) in tables.iter().enumerate() {
+                assert_eq!(
+                    session.partial_verify_with_table(
+                        &secp,
+                        &key_agg_cache,
+                        partial_sig,
+                        pub_nonces[i],
+                        table
+                    ),
+                    i == j
+                );
+            }
+            partial_sigs.push(partial_sig);
+        }
+
+        // A table for a different list of keys
+        let other_cache = MusigKeyAggCache::new(&secp, &pub_keys[..2]);
+        let other_table = MusigSignerTable::new(&secp, &other_cache, pub_keys[0]);
+        assert!(!session.partial_verify_with_table(
+            &secp,
+            &key_agg_cache,
+            partial_sigs[0],
+            pub_nonces[0],
+            &other_table
+        ));
+    }
+
+    #[test]
+    fn test_blinded_partial_sign_batch() {
+        let secp = Secp256k1::new();
+        let mut sec_keys = Vec::new();
+        let mut pub_keys = Vec::new();
+        for _ in 0..2 {
+            let mut sec_bytes = [0; 32];
+            thread_rng().fill_bytes(&mut sec_bytes);
+            let sec_key = SecretKey::from_slice(&sec_bytes).unwrap();
+            pub_keys.push(PublicKey::from_secret_key(&secp, &sec_key));
+            sec_keys.push(sec_key);
+        }
+        let key_agg_cache = MusigKeyAggCache::new(&secp, &pub_keys);
+        let keypair = Keypair::from_secret_key(&secp, &sec_keys[0]);
+
+        let mut session_ids = [[0; 32]; 20];
+        for session_id in session_ids.iter_mut() {
+            thread_rng().fill_bytes(session_id);
+        }
+        // Generates the same nonces for the same signer every time.
+        let nonce_pairs = |signer: usize| {
+            let ids = session_ids[signer * 10..(signer + 1) * 10]
+                .iter()
+                .map(|id| MusigSessionId::assume_unique_per_nonce_gen(*id))
+                .collect();
+            new_musig_nonce_pairs(&secp, ids, Some(sec_keys[signer]), pub_keys[signer], None)
+                .unwrap()
+        };
+        let sec_nonces = || {
+            nonce_pairs(0)
+                .into_iter()
+                .map(|(sec_nonce, _)| sec_nonce)
+                .collect::<Vec<_>>()
+        };
+        let pub_nonces = nonce_pairs(0)
+            .into_iter()
+            .map(|(_, pub_nonce)| pub_nonce)
+            .collect::<Vec<_>>();
+        let sessions = pub_nonces
+            .iter()
+            .zip(nonce_pairs(1))
+            .enumerate()
+            .map(|(i, (pub_nonce, (_, other_pub_nonce)))| {
+                let agg_nonce = MusigAggNonce::new(&secp, &[*pub_nonce, other_pub_nonce]);
+                let msg = Message::from_slice(&[i as u8 + 1; 32]).unwrap();
+                MusigSession::new(&secp, &key_agg_cache, agg_nonce, msg)
+            })
+            .collect::<Vec<_>>();
+        let (key_agg_coef, negate_seckey) =
+            sessions[0].get_keyaggcoef_and_negation_seckey(&secp, &key_agg_cache, &pub_keys[0]);
+
+        let partial_sigs = MusigSession::blinded_partial_sign_batch(
+            &secp,
+            &sessions,
+            sec_nonces(),
+            &pub_nonces,
+            &keypair,
+            Some(&key_agg_coef),
+            negate_seckey,
+        )
+        .unwrap();
+        for (i, sec_nonce) in sec_nonces().into_iter().enumerate() {
+            let partial_sig = sessions[i]
+                .partial_sign(&secp, sec_nonce, &keypair, &key_agg_cache)
+                .unwrap();
+            assert_eq!(partial_sigs[i], partial_sig);
+        }
+
+        // Without a key aggregation coefficient
+        let partial_sigs = MusigSession::blinded_partial_sign_batch(
+            &secp,
+            &sessions,
+            sec_nonces(),
+            &pub_nonces,
+            &keypair,
+            None,
+            negate_seckey,
+        )
+        .unwrap();
+        for (i, sec_nonce) in sec_nonces().into_iter().enumerate() {
+            let partial_sig = sessions[i]
+                .blinded_partial_sign_without_keyaggcoeff(&secp, sec_nonce, &keypair, negate_seckey)
+                .unwrap();
+            assert_eq!(partial_sigs[i], partial_sig);
+        }
+
+        // Public nonces that do not belong to the secret nonces
+        let mut wrong_pub_nonces = pub_nonces.clone();
+        wrong_pub_nonces.swap(3, 4);
+        assert_eq!(
+            MusigSession::blinded_partial_sign_batch(
+                &secp,
+                &sessions,
+                sec_nonces(),
+                &wrong_pub_nonces,
+                &keypair,
+                Some(&key_agg_coef),
+                negate_seckey,
+            ),
+            Err(MusigSignError::PartialSignatureInvalid)
+        );
+
+        // A secret nonce that was already used
+        let mut used_sec_nonces = sec_nonces();
+        used_sec_nonces[5] = MusigSecNonce::from_slice([0; MUSIG_SECNONCE_LEN]);
+        assert_eq!(
+            MusigSession::blinded_partial_sign_batch(
+                &secp,
+                &sessions,
+                used_sec_nonces,
+                &pub_nonces,
+                &keypair,
+                Some(&key_agg_coef),
+                negate_seckey,
+            ),
+            Err(MusigSignError::NonceReuse)
+        );
+    }
 }
@@ -1,7 +1,8 @@
 use ffi::CPtr;
 
 use crate::ffi;
-use crate::{from_hex, Error, Generator, Secp256k1, Signing, Tweak, ZERO_TWEAK};
+use crate::zkp::scratch::with_thread_scratch;
+use crate::{from_hex, Error, Generator, ScratchSpace, Secp256k1, Signing, Tweak, ZERO_TWEAK};
 use core::{fmt, slice, str};
 
 /// Represents a commitment to a single u64 value.
@@ -75,6 +76,54 @@ impl PedersenCommitment {
         PedersenCommitment(commitment)
     }
 
+    /// Create one [`PedersenCommitment`] for each `(value, blinding_factor, generator)`.
+    ///
+    /// The result is the same as calling [`PedersenCommitment::new`] on every element,
+    /// but all commitments are normalized together and consecutive elements that
+    /// share a generator reuse the precomputation for it, so group them if possible.
+    pub fn new_batch<C: Signing>(
+        secp: &Secp256k1<C>,
+        secrets: &[(u64, Tweak, Generator)],
+    ) -> Vec<Self> {
+        with_thread_scratch(|scratch| {
+            PedersenCommitment::new_batch_with_scratch(secp, scratch, secrets)
+        })
+    }
+
+    /// Like [`PedersenCommitment::new_batch`], but with the temporary data in `scratch`
+    /// instead of the scratch space of the current thread.
+    pub fn new_batch_with_scratch<C: Signing>(
+        secp: &Secp256k1<C>,
+        scratch: &mut ScratchSpace,
+        secrets: &[(u64, Tweak, Generator)],
+    ) -> Vec<Self> {
+        let mut commitments = vec![ffi::PedersenCommitment::default(); secrets.len()];
+        let values = secrets.iter().map(|s| s.0).collect::<Vec<_>>();
+        let blinds = secrets.iter().map(|s| s.1.as_c_ptr()).collect::<Vec<_>>();
+        let gens = secrets
+            .iter()
+            .map(|s| s.2.as_inner() as *const _)
+            .collect::<Vec<_>>();
+
+        let ret = unsafe {
+            ffi::secp256k1_pedersen_commit_batch(
+                secp.ctx().as_ptr(),
+                scratch.as_mut_ptr(),
+                commitments.as_mut_ptr(),
+                blinds.as_ptr(),
+                values.as_ptr(),
+                gens.as_ptr(),
+                secrets.len(),
+            )
+        };
+        assert_eq!(
+            ret, 1,
+            "failed to create pedersen commitments, likely a bad blinding factor"
+        );
+
+        commitments.into_iter().map(PedersenCommitment).collect()
+    }
+
     /// Create a new [`PedersenCommitment`] that commits to the given value
     /// with a zero blinding factor and the [`Generator`].
     pub fn new_unblinded<C: Signing>(
@@ -118,6 +167,105 @@ impl CommitmentSecrets {
     }
 }
 
+/// Running sum of the blinding factors of a set of commitments.
+///
+/// Commitments can be added and removed one at a time, which allows computing the
+/// blinding factor of a final output with [`BlindingFactorAccumulator::finalize`] without
+/// re-summing all commitments whenever the set changes. Adding `set_a` as inputs and
+/// `set_b` as outputs gives the same result as [`compute_adaptive_blinding_factor`].
+#[derive(Clone)]
+pub struct BlindingFactorAccumulator(ffi::PedersenBlindAccumulator);
+
+impl BlindingFactorAccumulator {
+    /// Creates an empty accumulator.
+    pub fn new() -> Self {
+        let mut acc = ffi::PedersenBlindAccumulator::new();
+
+        let ret = unsafe {
+            ffi::secp256k1_pedersen_blind_accumulator_init(
+                ffi::secp256k1_context_no_precomp,
+                &mut acc,
+            )
+        };
+        assert_eq!(ret, 1, "failed to initialize blinding factor accumulator");
+
+        BlindingFactorAccumulator(acc)
+    }
+
+    /// Adds the secrets of a commitment on the `set_a` side.
+    pub fn add_input(&mut self, secrets: &CommitmentSecrets) {
+        self.update(secrets, true, false)
+    }
+
+    /// Adds the secrets of a commitment on the `set_b` side.
+    pub fn add_output(&mut self, secrets: &CommitmentSecrets) {
+        self.update(secrets, false, false)
+    }
+
+    /// Removes secrets previously added with [`BlindingFactorAccumulator::add_input`].
+    pub fn remove_input(&mut self, secrets: &CommitmentSecrets) {
+        self.update(secrets, true, true)
+    }
+
+    /// Removes secrets previously added with [`BlindingFactorAccumulator::add_output`].
+    pub fn remove_output(&mut self, secrets: &CommitmentSecrets) {
+        self.update(secrets, false, true)
+    }
+
+    fn update(&mut self, secrets: &CommitmentSecrets, is_input: bool, remove: bool) {
+        let f = if remove {
+            ffi::secp256k1_pedersen_blind_accumulator_remove
+        } else {
+            ffi::secp256k1_pedersen_blind_accumulator_add
+        };
+        let ret = unsafe {
+            f(
+                ffi::secp256k1_context_no_precomp,
+                &mut self.0,
+                secrets.value,
+                secrets.generator_blinding_factor.as_c_ptr(),
+                secrets.value_blinding_factor.as_c_ptr(),
+                is_input as i32,
+            )
+        };
+        assert_eq!(ret, 1, "tweaks are always valid scalars");
+    }
+
+    /// Computes the blinding factor of a final output with the given value and generator
+    /// blinding factor such that the sums of blinding factors on both sides are equal.
+    ///
+    /// The accumulator is left unchanged.
+    pub fn finalize(&self, value: u64, generator_blinding_factor: Tweak) -> Tweak {
+        let mut out = [0u8; 32];
+
+        let ret = unsafe {
+            ffi::secp256k1_pedersen_blind_accumulator_finalize(
+                ffi::secp256k1_context_no_precomp,
+                out.as_mut_ptr(),
+                &self.0,
+                value,
+                generator_blinding_factor.as_c_ptr(),
+            )
+        };
+        assert_eq!(ret, 1, "failed to compute blinding factor");
+
+        Tweak::from_slice(&out).expect("data is always 32 bytes")
+    }
+}
+
+impl fmt::Debug for BlindingFactorAccumulator {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        // The running sum of blinding factors is secret and not printed.
+        f.debug_struct("BlindingFactorAccumulator").finish()
+    }
+}
+
+impl Default for BlindingFactorAccumulator {
+    fn default() -> Self {
+        BlindingFactorAccumulator::new()
+    }
+}
+
 /// Compute a blinding factor such that the sum of all blinding factors in both sets is equal.
 pub fn compute_adaptive_blinding_factor<C: Signing>(
     secp: &Secp256k1<C>,
@@ -285,6 +433,30 @@ mod tests {
         assert!(commitment_sums_are_equal);
     }
 
+    #[test]
+    fn test_pedersen_commitment_batch() {
+        let tag_1 = Tag::random();
+        let tag_2 = Tag::random();
+        let secrets = (0..20u64)
+            .map(|i| {
+                let secrets = CommitmentSecrets::random(i * 1000);
+                let tag = if i < 12 { tag_1 } else { tag_2 };
+                let generator =
+                    Generator::new_blinded(SECP256K1, tag, secrets.generator_blinding_factor);
+                (secrets.value, secrets.value_blinding_factor, generator)
+            })
+            .collect::<Vec<_>>();
+
+        let batch = PedersenCommitment::new_batch(SECP256K1, &secrets);
+
+        assert_eq!(batch.len(), secrets.len());
+        for (commitment, (value, blind, generator)) in batch.iter().zip(secrets.iter()) {
+            let single = PedersenCommitment::new(SECP256K1, *value, *blind, *generator);
+            assert_eq!(commitment.serialize(), single.serialize());
+        }
+        assert!(PedersenCommitment::new_batch(SECP256K1, &[]).is_empty());
+    }
+
     #[test]
     fn test_serialize_and_parse_pedersen_commitment() {
         let commitment = CommitmentSecrets::random(1000).commit(Tag::random());
@@ -328,6 +500,38 @@ mod tests {
         assert!(commitment_sums_are_equal);
     }
 
+    #[test]
+    fn test_blinding_factor_accumulator() {
+        let secrets = [
+            CommitmentSecrets::random(1000),
+            CommitmentSecrets::random(2000),
+            CommitmentSecrets::random(500),
+            CommitmentSecrets::random(700),
+        ];
+        let extra = CommitmentSecrets::random(42);
+        let tbf = Tweak::new(&mut thread_rng());
+
+        let expected =
+            compute_adaptive_blinding_factor(SECP256K1, 1800, tbf, &secrets[..2], &secrets[2..]);
+
+        let mut acc = BlindingFactorAccumulator::new();
+        acc.add_input(&secrets[0]);
+        acc.add_output(&secrets[2]);
+        acc.add_input(&extra);
+        acc.add_output(&secrets[3]);
+        acc.add_input(&secrets[1]);
+        assert_ne!(acc.finalize(1800, tbf), expected);
+
+        acc.remove_input(&extra);
+        assert_eq!(acc.finalize(1800, tbf), expected);
+
+        acc.add_output(&extra);
+        acc.remove_output(&extra);
+        assert_eq!(acc.finalize(1800, tbf), expected);
+
+        assert_eq!(format!("{:?}", acc), "BlindingFactorAccumulator");
+    }
+
     #[test]
     fn test_pedersen_from_str() {
         let commitment = CommitmentSecrets::random(1000).commit(Tag::random());
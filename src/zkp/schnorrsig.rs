@@ -0,0 +1,90 @@
+//! Creating many BIP-340 signatures with one key pair.
+
+use core::ptr;
+
+use crate::ffi::{self, CPtr};
+use crate::{schnorr, Keypair, Message, Secp256k1, Signing};
+
+/// Signs all `msgs` with `keypair`, giving the same signatures as
+/// `Secp256k1::sign_schnorr_with_aux_rand` with the corresponding entry of `aux_rands`, or as
+/// `Secp256k1::sign_schnorr_no_aux_rand` if `aux_rands` is `None`.
+///
+/// The key pair is loaded once for all messages and the nonce points are converted to affine
+/// coordinates together. Without auxiliary randomness, the hash of the secret key that all
+/// nonces start with is computed only once as well.
+///
+/// # Panics
+///
+/// Panics if `aux_rands` is given and its length differs from that of `msgs`.
+pub fn sign_schnorr_batch<C: Signing>(
+    secp: &Secp256k1<C>,
+    msgs: &[Message],
+    keypair: &Keypair,
+    aux_rands: Option<&[[u8; 32]]>,
+) -> Vec<schnorr::Signature> {
+    let msg_ptrs = msgs.iter().map(|msg| msg.as_c_ptr()).collect::<Vec<_>>();
+    let msg_lens = vec![32; msgs.len()];
+    let aux_rand_ptrs = aux_rands.map(|aux_rands| {
+        assert_eq!(aux_rands.len(), msgs.len(), "one aux_rand per message");
+        aux_rands.iter().map(|aux| aux.as_ptr()).collect::<Vec<_>>()
+    });
+    let mut sigs = vec![[0u8; 64]; msgs.len()];
+
+    let ret = unsafe {
+        ffi::secp256k1_schnorrsig_sign_batch(
+            secp.ctx().as_ptr(),
+            sigs.as_mut_ptr() as *mut u8,
+            msg_ptrs.as_ptr(),
+            msg_lens.as_ptr(),
+            keypair.as_c_ptr(),
+            aux_rand_ptrs
+                .as_ref()
+                .map_or(ptr::null(), |ptrs| ptrs.as_ptr()),
+            msgs.len(),
+        )
+    };
+    if ret == 0 {
+        // Only fails when the arguments are invalid which is not possible in safe rust
+        unreachable!("Arguments must be valid and well-typed")
+    }
+
+    sigs.iter()
+        .map(|sig| schnorr::Signature::from_slice(sig).expect("signatures are 64 bytes"))
+        .collect()
+}
+
+#[cfg(all(test, feature = "global-context"))]
+mod tests {
+    use super::*;
+    use crate::XOnlyPublicKey;
+    use rand::{thread_rng, RngCore};
+
+    #[test]
+    fn test_sign_schnorr_batch() {
+        let secp = Secp256k1::new();
+        let mut sec_bytes = [0u8; 32];
+        thread_rng().fill_bytes(&mut sec_bytes);
+        let keypair = Keypair::from_seckey_slice(&secp, &sec_bytes).unwrap();
+        let (pk, _) = XOnlyPublicKey::from_keypair(&keypair);
+        let mut msgs = Vec::new();
+        let mut aux_rands = vec![[0u8; 32]; 40];
+        for aux in aux_rands.iter_mut() {
+            let mut msg = [0u8; 32];
+            thread_rng().fill_bytes(&mut msg);
+            thread_rng().fill_bytes(aux);
+            msgs.push(Message::from_slice(&msg).unwrap());
+        }
+
+        let sigs = sign_schnorr_batch(&secp, &msgs, &keypair, None);
+        for (sig, msg) in sigs.iter().zip(msgs.iter()) {
+            assert_eq!(*sig, secp.sign_schnorr_no_aux_rand(msg, &keypair));
+            assert!(secp.verify_schnorr(sig, msg, &pk).is_ok());
+        }
+        let sigs = sign_schnorr_batch(&secp, &msgs, &keypair, Some(&aux_rands));
+        for ((sig, msg), aux) in sigs.iter().zip(msgs.iter()).zip(aux_rands.iter()) {
+            assert_eq!(*sig, secp.sign_schnorr_with_aux_rand(msg, &keypair, aux));
+            assert!(secp.verify_schnorr(sig, msg, &pk).is_ok());
+        }
+        assert!(sign_schnorr_batch(&secp, &[], &keypair, None).is_empty());
+    }
+}
@@ -0,0 +1,322 @@
+use core::cell::RefCell;
+use core::ops::{Deref, DerefMut};
+use core::{cmp, ptr};
+use std::sync::Mutex;
+use std::thread;
+
+use crate::ffi::{
+    self,
+    types::{c_void, size_t},
+};
+
+/// The size and alignment of the units a scratch space's memory is allocated in. The library
+/// expects memory aligned for any type.
+const BLOCK_SIZE: usize = 64;
+
+#[repr(C, align(64))]
+#[derive(Clone, Copy)]
+struct Block([u8; BLOCK_SIZE]);
+
+fn blocks(size: usize) -> Vec<Block> {
+    vec![Block([0; BLOCK_SIZE]); (size + BLOCK_SIZE - 1) / BLOCK_SIZE]
+}
+
+/// The memory of a scratch space. It is kept at a fixed address, which is passed to [`grow`].
+struct Memory {
+    /// Holds the scratch space object and the memory it starts with.
+    first: Vec<Block>,
+    /// The memory obtained through [`grow`].
+    chunks: Vec<Vec<Block>>,
+    /// The total size of `first` and `chunks` in bytes.
+    capacity: usize,
+}
+
+unsafe extern "C" fn grow(size: *mut size_t, data: *mut c_void) -> *mut c_void {
+    let memory = &mut *(data as *mut Memory);
+    // Grow geometrically, so that repeated use needs a few chunks at most.
+    let chunk_size = cmp::max(*size, memory.capacity);
+    if chunk_size > ::core::isize::MAX as usize / 2 {
+        return ptr::null_mut();
+    }
+    let mut chunk = blocks(chunk_size);
+    let ret = chunk.as_mut_ptr() as *mut c_void;
+    *size = chunk.len() * BLOCK_SIZE;
+    memory.capacity += *size;
+    memory.chunks.push(chunk);
+    ret
+}
+
+/// A task of the library that [`run_tasks`] runs on another thread.
+struct Task {
+    task: unsafe extern "C" fn(size_t, *mut c_void),
+    task_data: *mut c_void,
+    index: size_t,
+}
+
+// The library lets the tasks of one call run on any thread.
+unsafe impl Send for Task {}
+
+impl Task {
+    fn run(self) {
+        unsafe { (self.task)(self.index, self.task_data) }
+    }
+}
+
+unsafe extern "C" fn run_tasks(
+    task: unsafe extern "C" fn(size_t, *mut c_void),
+    task_data: *mut c_void,
+    n_tasks: size_t,
+    _data: *mut c_void,
+) {
+    let handles = (1..n_tasks)
+        .map(|index| {
+            let t = Task {
+                task,
+                task_data,
+                index,
+            };
+            thread::Builder::new().spawn(move || t.run())
+        })
+        .collect::<Vec<_>>();
+    task(0, task_data);
+    for (index, handle) in (1..n_tasks).zip(handles) {
+        match handle {
+            // A task that panicked has not reported success, so the operation fails.
+            Ok(handle) => drop(handle.join()),
+            // The task runs here if no thread could be started for it.
+            Err(_) => task(index, task_data),
+        }
+    }
+}
+
+/// Memory for the temporary data of batch operations, such as the multi-exponentiation in
+/// [`EcdsaAdaptorSignature::verify_batch_with_scratch`](crate::EcdsaAdaptorSignature::verify_batch_with_scratch).
+///
+/// A scratch space grows whenever an operation needs more memory than it has and keeps the
+/// memory for the next operation, so operations never fall back to slower algorithms because
+/// of its size.
+pub struct ScratchSpace {
+    ptr: *mut ffi::ScratchSpace,
+    memory: *mut Memory,
+}
+
+// The scratch space owns all of its memory.
+unsafe impl Send for ScratchSpace {}
+
+impl ScratchSpace {
+    /// Creates an empty scratch space.
+    pub fn new() -> ScratchSpace {
+        ScratchSpace::with_capacity(0)
+    }
+
+    /// Creates a scratch space that can hold `size` bytes before it grows.
+    pub fn with_capacity(size: usize) -> ScratchSpace {
+        let prealloc_size = unsafe { ffi::secp256k1_scratch_space_preallocated_size(size) };
+        assert_ne!(prealloc_size, 0, "scratch space size overflow");
+        let memory = Box::into_raw(Box::new(Memory {
+            first: blocks(prealloc_size),
+            chunks: Vec::new(),
+            capacity: size,
+        }));
+        let ptr = unsafe {
+            ffi::secp256k1_scratch_space_preallocated_create(
+                ffi::secp256k1_context_no_precomp,
+                (*memory).first.as_mut_ptr() as *mut c_void,
+                size,
+                ::core::usize::MAX,
+                Some(grow),
+                memory as *mut c_void,
+            )
+        };
+        assert!(!ptr.is_null());
+
+        ScratchSpace { ptr, memory }
+    }
+
+    /// Creates a scratch space that can hold a multi-exponentiation of `n_points` points
+    /// before it grows. Verifying a batch of `n` ECDSA adaptor signatures is a
+    /// multi-exponentiation of `2 * n` points.
+    pub fn with_points(n_points: usize) -> ScratchSpace {
+        ScratchSpace::with_capacity(unsafe { ffi::secp256k1_scratch_space_ecmult_size(n_points) })
+    }
+
+    /// The number of bytes the scratch space holds.
+    pub fn capacity(&self) -> usize {
+        unsafe { (*self.memory).capacity }
+    }
+
+    /// Splits the multi-exponentiations of operations using this scratch space over up to
+    /// `n_threads` threads. Only multi-exponentiations of at least 2048 points are split, such
+    /// as verifying a batch of 1024 ECDSA adaptor signatures, and each thread gets a part of the
+    /// scratch space, which grows accordingly. With `n_threads` at most 1, which is the default,
+    /// everything is computed in the calling thread.
+    pub fn set_threads(&mut self, n_threads: usize) {
+        let ret = unsafe {
+            if n_threads > 1 {
+                ffi::secp256k1_scratch_space_set_workers(
+                    ffi::secp256k1_context_no_precomp,
+                    self.ptr,
+                    Some(run_tasks),
+                    ptr::null_mut(),
+                    n_threads,
+                )
+            } else {
+                ffi::secp256k1_scratch_space_set_workers(
+                    ffi::secp256k1_context_no_precomp,
+                    self.ptr,
+                    None,
+                    ptr::null_mut(),
+                    0,
+                )
+            }
+        };
+        debug_assert_eq!(ret, 1);
+    }
+
+    pub(crate) fn as_mut_ptr(&mut self) -> *mut ffi::ScratchSpace {
+        self.ptr
+    }
+}
+
+impl Default for ScratchSpace {
+    fn default() -> ScratchSpace {
+        ScratchSpace::new()
+    }
+}
+
+impl Drop for ScratchSpace {
+    fn drop(&mut self) {
+        unsafe {
+            ffi::secp256k1_scratch_space_preallocated_destroy(
+                ffi::secp256k1_context_no_precomp,
+                self.ptr,
+            );
+            drop(Box::from_raw(self.memory));
+        }
+    }
+}
+
+impl ::core::fmt::Debug for ScratchSpace {
+    fn fmt(&self, f: &mut ::core::fmt::Formatter) -> ::core::fmt::Result {
+        f.debug_struct("ScratchSpace")
+            .field("capacity", &self.capacity())
+            .finish()
+    }
+}
+
+/// A set of scratch spaces shared by threads.
+///
+/// [`ScratchPool::get`] hands out a scratch space that no other thread is using and takes it
+/// back when the returned guard is dropped, so each thread running batch operations
+/// concurrently gets its own memory and it is reused afterwards.
+#[derive(Debug, Default)]
+pub struct ScratchPool {
+    spaces: Mutex<Vec<ScratchSpace>>,
+}
+
+impl ScratchPool {
+    /// Creates an empty pool.
+    pub fn new() -> ScratchPool {
+        ScratchPool::default()
+    }
+
+    /// Returns a scratch space from the pool that can hold a multi-exponentiation of
+    /// `n_points` points, see [`ScratchSpace::with_points`].
+    pub fn get(&self, n_points: usize) -> PooledScratchSpace {
+        let size = unsafe { ffi::secp256k1_scratch_space_ecmult_size(n_points) };
+        let space = self.spaces.lock().unwrap().pop();
+        let space = match space {
+            Some(space) if space.capacity() >= size => space,
+            _ => ScratchSpace::with_capacity(size),
+        };
+
+        PooledScratchSpace {
+            pool: self,
+            space: Some(space),
+        }
+    }
+}
+
+/// A scratch space borrowed from a [`ScratchPool`], which returns it to the pool when dropped.
+#[derive(Debug)]
+pub struct PooledScratchSpace<'a> {
+    pool: &'a ScratchPool,
+    space: Option<ScratchSpace>,
+}
+
+impl<'a> Deref for PooledScratchSpace<'a> {
+    type Target = ScratchSpace;
+
+    fn deref(&self) -> &ScratchSpace {
+        self.space.as_ref().unwrap()
+    }
+}
+
+impl<'a> DerefMut for PooledScratchSpace<'a> {
+    fn deref_mut(&mut self) -> &mut ScratchSpace {
+        self.space.as_mut().unwrap()
+    }
+}
+
+impl<'a> Drop for PooledScratchSpace<'a> {
+    fn drop(&mut self) {
+        if let (Some(space), Ok(mut spaces)) = (self.space.take(), self.pool.spaces.lock()) {
+            spaces.push(space);
+        }
+    }
+}
+
+/// The largest scratch space kept for a thread by [`with_thread_scratch`] between calls.
+const THREAD_SCRATCH_MAX_KEPT: usize = 1 << 20;
+
+thread_local! {
+    static THREAD_SCRATCH: RefCell<Option<ScratchSpace>> = RefCell::new(None);
+}
+
+/// Calls `f` with the scratch space of the current thread.
+pub(crate) fn with_thread_scratch<R, F: FnOnce(&mut ScratchSpace) -> R>(f: F) -> R {
+    THREAD_SCRATCH.with(|cell| match cell.try_borrow_mut() {
+        Ok(mut kept) => {
+            let mut space = kept.take().unwrap_or_default();
+            let ret = f(&mut space);
+            if space.capacity() <= THREAD_SCRATCH_MAX_KEPT {
+                *kept = Some(space);
+            }
+            ret
+        }
+        // Only reachable if f itself uses the thread's scratch space.
+        Err(_) => f(&mut ScratchSpace::new()),
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_scratch_space_grows() {
+        let space = ScratchSpace::new();
+        assert_eq!(space.capacity(), 0);
+        let space = ScratchSpace::with_points(100);
+        assert!(space.capacity() > 0);
+        assert!(ScratchSpace::with_points(1000).capacity() > space.capacity());
+    }
+
+    #[test]
+    fn test_scratch_pool() {
+        let pool = ScratchPool::new();
+        {
+            let a = pool.get(10);
+            let b = pool.get(10);
+            assert!(a.capacity() > 0);
+            assert!(b.capacity() > 0);
+        }
+        assert_eq!(pool.spaces.lock().unwrap().len(), 2);
+        let c = pool.get(10);
+        assert_eq!(pool.spaces.lock().unwrap().len(), 1);
+        drop(c);
+        // A scratch space that is too small for the request is replaced.
+        let big = pool.get(10_000);
+        assert!(big.capacity() >= unsafe { ffi::secp256k1_scratch_space_ecmult_size(10_000) });
+    }
+}
@@ -0,0 +1,66 @@
+use crate::ffi;
+use crate::{Error, Secp256k1, Signing};
+
+/// The precomputed table a context uses for multiplications with the generator.
+///
+/// These multiplications are done when creating blinded generators, commitments, range proofs
+/// and adaptor signatures. The table only affects the functions of this crate; signing through
+/// the `secp256k1` crate keeps using the default table.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum SignTable {
+    /// The 32 KiB table.
+    Small,
+    /// The 64 KiB table every context starts with.
+    Default,
+    /// The 512 KiB table. It needs fewer point additions but reads more memory per
+    /// multiplication, so whether it is faster than the default table depends on the CPU.
+    Large,
+}
+
+impl SignTable {
+    fn flags(self) -> ffi::types::c_uint {
+        match self {
+            SignTable::Small => ffi::SECP256K1_CONTEXT_SIGN_TABLE_SMALL,
+            SignTable::Default => ffi::SECP256K1_START_NONE,
+            SignTable::Large => ffi::SECP256K1_CONTEXT_SIGN_TABLE_LARGE,
+        }
+    }
+}
+
+/// Selects the precomputed table `secp` uses for multiplications with the generator.
+///
+/// Returns [`Error::SignTableUnavailable`] if the table is not compiled in. The small and large
+/// tables are only compiled in with the `sign-tables` feature and without `lowmemory`.
+pub fn set_sign_table<C: Signing>(secp: &mut Secp256k1<C>, table: SignTable) -> Result<(), Error> {
+    let ret = unsafe { ffi::secp256k1_context_set_sign_table(secp.ctx().as_ptr(), table.flags()) };
+
+    if ret == 1 {
+        Ok(())
+    } else {
+        Err(Error::SignTableUnavailable)
+    }
+}
+
+#[cfg(all(test, feature = "global-context"))]
+mod tests {
+    use super::*;
+    use crate::{Generator, Tag, Tweak};
+
+    #[test]
+    fn test_sign_table() {
+        let mut secp = Secp256k1::new();
+        let tag = Tag::from([1u8; 32]);
+        let tweak = Tweak::from_inner([2u8; 32]).unwrap();
+        let expected = Generator::new_blinded(&secp, tag, tweak);
+
+        for table in [SignTable::Small, SignTable::Large, SignTable::Default].iter() {
+            match set_sign_table(&mut secp, *table) {
+                Ok(()) => assert_eq!(Generator::new_blinded(&secp, tag, tweak), expected),
+                Err(e) => {
+                    assert_ne!(*table, SignTable::Default);
+                    assert_eq!(e, Error::SignTableUnavailable);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,16 @@
+//! Loading tables changes them for the whole process, so these tests run in their own binary
+//! instead of next to the unit tests.
+
+#![cfg(all(unix, feature = "std"))]
+
+use secp256k1_zkp::{ecmult_tables_info, load_ecmult_tables, Error, Secp256k1};
+
+#[test]
+fn test_load_ecmult_tables_invalid() {
+    let secp = Secp256k1::new();
+    let before = ecmult_tables_info(&secp);
+
+    let res = unsafe { load_ecmult_tables(&secp, std::path::Path::new("/nonexistent")) };
+    assert_eq!(res, Err(Error::InvalidEcmultTables));
+    assert_eq!(ecmult_tables_info(&secp), before);
+}